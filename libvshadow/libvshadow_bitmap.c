@@ -0,0 +1,667 @@
+/*
+ * Bitmap functions
+ *
+ * Copyright (C) 2011-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libvshadow_bitmap.h"
+#include "libvshadow_libcerror.h"
+
+/* Creates a bitmap
+ * Make sure the value bitmap is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_bitmap_initialize(
+     libvshadow_bitmap_t **bitmap,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_bitmap_initialize";
+
+	if( bitmap == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bitmap.",
+		 function );
+
+		return( -1 );
+	}
+	if( *bitmap != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid bitmap value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*bitmap = memory_allocate_structure(
+	           libvshadow_bitmap_t );
+
+	if( *bitmap == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create bitmap.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *bitmap,
+	     0,
+	     sizeof( libvshadow_bitmap_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear bitmap.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *bitmap != NULL )
+	{
+		memory_free(
+		 *bitmap );
+
+		*bitmap = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a bitmap
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_bitmap_free(
+     libvshadow_bitmap_t **bitmap,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_bitmap_free";
+
+	if( bitmap == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bitmap.",
+		 function );
+
+		return( -1 );
+	}
+	if( *bitmap != NULL )
+	{
+		if( ( *bitmap )->data != NULL )
+		{
+			memory_free(
+			 ( *bitmap )->data );
+		}
+		memory_free(
+		 *bitmap );
+
+		*bitmap = NULL;
+	}
+	return( 1 );
+}
+
+/* Clears a bitmap
+ * Frees the data of the bitmap
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_bitmap_clear(
+     libvshadow_bitmap_t *bitmap,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_bitmap_clear";
+
+	if( bitmap == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bitmap.",
+		 function );
+
+		return( -1 );
+	}
+	if( bitmap->data != NULL )
+	{
+		memory_free(
+		 bitmap->data );
+
+		bitmap->data = NULL;
+	}
+	bitmap->data_size           = 0;
+	bitmap->allocated_data_size = 0;
+
+	return( 1 );
+}
+
+/* Appends data to the end of the bitmap
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_bitmap_append_data(
+     libvshadow_bitmap_t *bitmap,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	static char *function      = "libvshadow_bitmap_append_data";
+	uint8_t *reallocated_data  = NULL;
+	size_t allocated_data_size = 0;
+
+	if( bitmap == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bitmap.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size == 0 )
+	 || ( data_size > ( ( (size_t) SSIZE_MAX / 8 ) - bitmap->data_size ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( bitmap->data_size + data_size ) > bitmap->allocated_data_size )
+	{
+		if( bitmap->allocated_data_size == 0 )
+		{
+			allocated_data_size = 0x4000;
+		}
+		else
+		{
+			allocated_data_size = bitmap->allocated_data_size * 2;
+		}
+		while( allocated_data_size < ( bitmap->data_size + data_size ) )
+		{
+			allocated_data_size *= 2;
+		}
+		if( allocated_data_size > ( (size_t) SSIZE_MAX / 8 ) )
+		{
+			allocated_data_size = bitmap->data_size + data_size;
+		}
+		reallocated_data = (uint8_t *) memory_reallocate(
+		                                bitmap->data,
+		                                allocated_data_size );
+
+		if( reallocated_data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize data.",
+			 function );
+
+			return( -1 );
+		}
+		bitmap->data                = reallocated_data;
+		bitmap->allocated_data_size = allocated_data_size;
+	}
+	if( memory_copy(
+	     &( bitmap->data[ bitmap->data_size ] ),
+	     data,
+	     data_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy data.",
+		 function );
+
+		return( -1 );
+	}
+	bitmap->data_size += data_size;
+
+	return( 1 );
+}
+
+/* Retrieves the number of bits
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_bitmap_get_number_of_bits(
+     libvshadow_bitmap_t *bitmap,
+     size_t *number_of_bits,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_bitmap_get_number_of_bits";
+
+	if( bitmap == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bitmap.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_bits == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of bits.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_bits = bitmap->data_size * 8;
+
+	return( 1 );
+}
+
+/* Retrieves the value of a specific bit
+ * Returns 1 if successful, 0 if the bit index is beyond the end of the bitmap or -1 on error
+ */
+int libvshadow_bitmap_get_bit_value(
+     libvshadow_bitmap_t *bitmap,
+     size_t bit_index,
+     uint8_t *bit_value,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_bitmap_get_bit_value";
+
+	if( bitmap == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bitmap.",
+		 function );
+
+		return( -1 );
+	}
+	if( bit_value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bit value.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( bit_index / 8 ) >= bitmap->data_size )
+	{
+		return( 0 );
+	}
+	*bit_value = ( bitmap->data[ bit_index / 8 ] >> ( bit_index % 8 ) ) & 0x01;
+
+	return( 1 );
+}
+
+/* Retrieves the run of bits with the same value that starts at a specific bit index
+ * Returns 1 if successful, 0 if the bit index is beyond the end of the bitmap or -1 on error
+ */
+int libvshadow_bitmap_get_run_at_bit_index(
+     libvshadow_bitmap_t *bitmap,
+     size_t bit_index,
+     uint8_t *bit_value,
+     size_t *number_of_bits,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_bitmap_get_run_at_bit_index";
+
+	if( bitmap == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bitmap.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( bit_index / 8 ) >= bitmap->data_size )
+	{
+		return( 0 );
+	}
+	if( libvshadow_bitmap_get_run(
+	     bitmap->data,
+	     bitmap->data_size,
+	     bit_index,
+	     bit_value,
+	     number_of_bits,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve run at bit: %" PRIzd ".",
+		 function,
+		 bit_index );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the number of set bits
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_bitmap_get_number_of_set_bits(
+     libvshadow_bitmap_t *bitmap,
+     size_t *number_of_set_bits,
+     libcerror_error_t **error )
+{
+	static char *function      = "libvshadow_bitmap_get_number_of_set_bits";
+	size_t byte_index          = 0;
+	size_t safe_number_of_bits = 0;
+	uint64_t value_64bit        = 0;
+
+	if( bitmap == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bitmap.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_set_bits == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of set bits.",
+		 function );
+
+		return( -1 );
+	}
+	while( ( bitmap->data_size - byte_index ) >= 8 )
+	{
+		byte_stream_copy_to_uint64_little_endian(
+		 &( bitmap->data[ byte_index ] ),
+		 value_64bit );
+
+		safe_number_of_bits += libvshadow_bitmap_get_population_count(
+		                        value_64bit );
+
+		byte_index += 8;
+	}
+	while( byte_index < bitmap->data_size )
+	{
+		safe_number_of_bits += libvshadow_bitmap_get_population_count(
+		                        (uint64_t) bitmap->data[ byte_index ] );
+
+		byte_index += 1;
+	}
+	*number_of_set_bits = safe_number_of_bits;
+
+	return( 1 );
+}
+
+/* Retrieves the number of trailing zero bits of a 64-bit value
+ * Returns the number of trailing zero bits, which is 64 if the value is 0
+ */
+uint8_t libvshadow_bitmap_get_number_of_trailing_zero_bits(
+         uint64_t value )
+{
+	uint8_t number_of_bits = 0;
+
+	if( value == 0 )
+	{
+		return( 64 );
+	}
+#if defined( __GNUC__ )
+	number_of_bits = (uint8_t) __builtin_ctzll(
+	                            (unsigned long long) value );
+#else
+	if( ( value & 0xffffffffUL ) == 0 )
+	{
+		number_of_bits += 32;
+		value         >>= 32;
+	}
+	if( ( value & 0x0000ffffUL ) == 0 )
+	{
+		number_of_bits += 16;
+		value         >>= 16;
+	}
+	if( ( value & 0x000000ffUL ) == 0 )
+	{
+		number_of_bits += 8;
+		value         >>= 8;
+	}
+	if( ( value & 0x0000000fUL ) == 0 )
+	{
+		number_of_bits += 4;
+		value         >>= 4;
+	}
+	if( ( value & 0x00000003UL ) == 0 )
+	{
+		number_of_bits += 2;
+		value         >>= 2;
+	}
+	if( ( value & 0x00000001UL ) == 0 )
+	{
+		number_of_bits += 1;
+	}
+#endif
+	return( number_of_bits );
+}
+
+/* Retrieves the number of set bits of a 64-bit value
+ * Returns the number of set bits
+ */
+uint8_t libvshadow_bitmap_get_population_count(
+         uint64_t value )
+{
+#if defined( __GNUC__ )
+	return( (uint8_t) __builtin_popcountll(
+	                   (unsigned long long) value ) );
+#else
+	value = value - ( ( value >> 1 ) & 0x5555555555555555ULL );
+	value = ( value & 0x3333333333333333ULL ) + ( ( value >> 2 ) & 0x3333333333333333ULL );
+	value = ( value + ( value >> 4 ) ) & 0x0f0f0f0f0f0f0f0fULL;
+
+	return( (uint8_t) ( ( value * 0x0101010101010101ULL ) >> 56 ) );
+#endif
+}
+
+/* Retrieves the run of bits with the same value that starts at a specific bit index
+ * The bitmap data is stored as 64-bit little-endian values, where the least significant bit
+ * represents the first bit. The bitmap data is scanned 64-bit at a time, values that
+ * contain only bits of the same value as the run are skipped
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_bitmap_get_run(
+     const uint8_t *bitmap_data,
+     size_t bitmap_data_size,
+     size_t bit_index,
+     uint8_t *bit_value,
+     size_t *number_of_bits,
+     libcerror_error_t **error )
+{
+	static char *function       = "libvshadow_bitmap_get_run";
+	size_t byte_index           = 0;
+	size_t end_bit_index        = 0;
+	size_t last_bit_index       = 0;
+	uint64_t value_64bit        = 0;
+	uint8_t bit_shift           = 0;
+	uint8_t number_of_bytes     = 0;
+	uint8_t number_of_zero_bits = 0;
+	uint8_t safe_bit_value      = 0;
+
+	if( bitmap_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bitmap data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( bitmap_data_size == 0 )
+	 || ( bitmap_data_size > ( (size_t) SSIZE_MAX / 8 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid bitmap data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	last_bit_index = bitmap_data_size * 8;
+
+	if( bit_index >= last_bit_index )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid bit index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( bit_value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bit value.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_bits == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of bits.",
+		 function );
+
+		return( -1 );
+	}
+	safe_bit_value = ( bitmap_data[ bit_index / 8 ] >> ( bit_index % 8 ) ) & 0x01;
+	end_bit_index  = bit_index;
+
+	while( end_bit_index < last_bit_index )
+	{
+		byte_index = ( end_bit_index / 64 ) * 8;
+
+		if( ( bitmap_data_size - byte_index ) >= 8 )
+		{
+			byte_stream_copy_to_uint64_little_endian(
+			 &( bitmap_data[ byte_index ] ),
+			 value_64bit );
+		}
+		else
+		{
+			/* The remaining bitmap data is smaller than 64-bit
+			 */
+			value_64bit = 0;
+
+			for( number_of_bytes = (uint8_t) ( bitmap_data_size - byte_index );
+			     number_of_bytes > 0;
+			     number_of_bytes-- )
+			{
+				value_64bit <<= 8;
+				value_64bit  |= bitmap_data[ byte_index + number_of_bytes - 1 ];
+			}
+		}
+		/* Search for the first bit that differs from the bit value of the run
+		 */
+		if( safe_bit_value != 0 )
+		{
+			value_64bit = ~value_64bit;
+		}
+		bit_shift = (uint8_t) ( end_bit_index % 64 );
+
+		value_64bit >>= bit_shift;
+
+		number_of_zero_bits = libvshadow_bitmap_get_number_of_trailing_zero_bits(
+		                       value_64bit );
+
+		if( number_of_zero_bits < ( 64 - bit_shift ) )
+		{
+			end_bit_index += number_of_zero_bits;
+
+			break;
+		}
+		end_bit_index += 64 - bit_shift;
+	}
+	/* The bits after the end of the bitmap data are ignored
+	 */
+	if( end_bit_index > last_bit_index )
+	{
+		end_bit_index = last_bit_index;
+	}
+	*bit_value      = safe_bit_value;
+	*number_of_bits = end_bit_index - bit_index;
+
+	return( 1 );
+}
+
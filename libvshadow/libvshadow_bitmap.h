@@ -0,0 +1,113 @@
+/*
+ * Bitmap functions
+ *
+ * Copyright (C) 2011-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVSHADOW_BITMAP_H )
+#define _LIBVSHADOW_BITMAP_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvshadow_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libvshadow_bitmap libvshadow_bitmap_t;
+
+struct libvshadow_bitmap
+{
+	/* The data
+	 * Contains the bitmap as 64-bit little-endian values, where the least significant bit
+	 * represents the first bit
+	 */
+	uint8_t *data;
+
+	/* The data size
+	 */
+	size_t data_size;
+
+	/* The allocated data size
+	 */
+	size_t allocated_data_size;
+};
+
+int libvshadow_bitmap_initialize(
+     libvshadow_bitmap_t **bitmap,
+     libcerror_error_t **error );
+
+int libvshadow_bitmap_free(
+     libvshadow_bitmap_t **bitmap,
+     libcerror_error_t **error );
+
+int libvshadow_bitmap_clear(
+     libvshadow_bitmap_t *bitmap,
+     libcerror_error_t **error );
+
+int libvshadow_bitmap_append_data(
+     libvshadow_bitmap_t *bitmap,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int libvshadow_bitmap_get_number_of_bits(
+     libvshadow_bitmap_t *bitmap,
+     size_t *number_of_bits,
+     libcerror_error_t **error );
+
+int libvshadow_bitmap_get_bit_value(
+     libvshadow_bitmap_t *bitmap,
+     size_t bit_index,
+     uint8_t *bit_value,
+     libcerror_error_t **error );
+
+int libvshadow_bitmap_get_run_at_bit_index(
+     libvshadow_bitmap_t *bitmap,
+     size_t bit_index,
+     uint8_t *bit_value,
+     size_t *number_of_bits,
+     libcerror_error_t **error );
+
+int libvshadow_bitmap_get_number_of_set_bits(
+     libvshadow_bitmap_t *bitmap,
+     size_t *number_of_set_bits,
+     libcerror_error_t **error );
+
+uint8_t libvshadow_bitmap_get_number_of_trailing_zero_bits(
+         uint64_t value );
+
+uint8_t libvshadow_bitmap_get_population_count(
+         uint64_t value );
+
+int libvshadow_bitmap_get_run(
+     const uint8_t *bitmap_data,
+     size_t bitmap_data_size,
+     size_t bit_index,
+     uint8_t *bit_value,
+     size_t *number_of_bits,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVSHADOW_BITMAP_H ) */
+
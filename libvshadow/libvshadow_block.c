@@ -31,6 +31,7 @@
 
 /* Creates a block
  * Make sure the value block is referencing, is set to NULL
+ * The block contains a copy of the block descriptor
  * Returns 1 if successful or -1 on error
  */
 int libvshadow_block_initialize(
@@ -102,8 +103,20 @@ int libvshadow_block_initialize(
 
 		goto on_error;
 	}
-	internal_block->block_descriptor = block_descriptor;
+	if( libvshadow_block_descriptor_clone(
+	     &( internal_block->block_descriptor ),
+	     block_descriptor,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create block descriptor.",
+		 function );
 
+		goto on_error;
+	}
 	*block = (libvshadow_block_t *) internal_block;
 
 	return( 1 );
@@ -144,6 +157,19 @@ int libvshadow_block_free(
 		internal_block = (libvshadow_internal_block_t *) *block;
 		*block         = NULL;
 
+		if( libvshadow_block_descriptor_free(
+		     &( internal_block->block_descriptor ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free block descriptor.",
+			 function );
+
+			result = -1;
+		}
 		memory_free(
 		 internal_block );
 	}
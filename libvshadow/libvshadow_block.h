@@ -39,6 +39,7 @@ typedef struct libvshadow_internal_block libvshadow_internal_block_t;
 struct libvshadow_internal_block
 {
 	/* The block descriptor
+	 * Contains a copy of the block descriptor of the store
 	 */
 	libvshadow_block_descriptor_t *block_descriptor;
 };
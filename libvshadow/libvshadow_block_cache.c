@@ -0,0 +1,1095 @@
+/*
+ * Block cache functions
+ *
+ * Copyright (C) 2011-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libvshadow_block_cache.h"
+#include "libvshadow_libbfio.h"
+#include "libvshadow_libcerror.h"
+#include "libvshadow_libcthreads.h"
+
+/* Creates a block cache
+ * Make sure the value block_cache is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_block_cache_initialize(
+     libvshadow_block_cache_t **block_cache,
+     size64_t maximum_cache_size,
+     size_t block_size,
+     libcerror_error_t **error )
+{
+	static char *function              = "libvshadow_block_cache_initialize";
+	size64_t maximum_number_of_entries = 0;
+	size_t entries_size                = 0;
+	size_t hash_table_size             = 0;
+	int hash_bucket_index              = 0;
+
+	if( block_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *block_cache != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid block cache value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( block_size == 0 )
+	 || ( block_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid block size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	maximum_number_of_entries = maximum_cache_size / block_size;
+
+	if( ( maximum_number_of_entries == 0 )
+	 || ( maximum_number_of_entries > (size64_t) ( INT_MAX / 2 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum cache size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*block_cache = memory_allocate_structure(
+	                libvshadow_block_cache_t );
+
+	if( *block_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create block cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *block_cache,
+	     0,
+	     sizeof( libvshadow_block_cache_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear block cache.",
+		 function );
+
+		memory_free(
+		 *block_cache );
+
+		*block_cache = NULL;
+
+		return( -1 );
+	}
+	( *block_cache )->block_size                      = block_size;
+	( *block_cache )->maximum_number_of_entries       = (int) maximum_number_of_entries;
+	( *block_cache )->most_recently_used_entry_index  = -1;
+	( *block_cache )->least_recently_used_entry_index = -1;
+	( *block_cache )->number_of_hash_buckets          = 1;
+
+	while( ( *block_cache )->number_of_hash_buckets < ( *block_cache )->maximum_number_of_entries )
+	{
+		( *block_cache )->number_of_hash_buckets *= 2;
+	}
+	entries_size    = sizeof( libvshadow_block_cache_entry_t ) * ( *block_cache )->maximum_number_of_entries;
+	hash_table_size = sizeof( int ) * ( *block_cache )->number_of_hash_buckets;
+
+	if( ( entries_size > (size_t) SSIZE_MAX )
+	 || ( hash_table_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid maximum number of entries value exceeds maximum.",
+		 function );
+
+		goto on_error;
+	}
+	( *block_cache )->entries = (libvshadow_block_cache_entry_t *) memory_allocate(
+	                                                                entries_size );
+
+	if( ( *block_cache )->entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create entries.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *block_cache )->entries,
+	     0,
+	     entries_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear entries.",
+		 function );
+
+		goto on_error;
+	}
+	( *block_cache )->hash_table = (int *) memory_allocate(
+	                                        hash_table_size );
+
+	if( ( *block_cache )->hash_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create hash table.",
+		 function );
+
+		goto on_error;
+	}
+	for( hash_bucket_index = 0;
+	     hash_bucket_index < ( *block_cache )->number_of_hash_buckets;
+	     hash_bucket_index++ )
+	{
+		( *block_cache )->hash_table[ hash_bucket_index ] = -1;
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_initialize(
+	     &( ( *block_cache )->read_write_lock ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to intialize read/write lock.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( *block_cache != NULL )
+	{
+		if( ( *block_cache )->hash_table != NULL )
+		{
+			memory_free(
+			 ( *block_cache )->hash_table );
+		}
+		if( ( *block_cache )->entries != NULL )
+		{
+			memory_free(
+			 ( *block_cache )->entries );
+		}
+		memory_free(
+		 *block_cache );
+
+		*block_cache = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a block cache
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_block_cache_free(
+     libvshadow_block_cache_t **block_cache,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_block_cache_free";
+	int entry_index       = 0;
+	int result            = 1;
+
+	if( block_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *block_cache != NULL )
+	{
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_free(
+		     &( ( *block_cache )->read_write_lock ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read/write lock.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		for( entry_index = 0;
+		     entry_index < ( *block_cache )->number_of_entries;
+		     entry_index++ )
+		{
+			if( ( *block_cache )->entries[ entry_index ].data != NULL )
+			{
+				memory_free(
+				 ( *block_cache )->entries[ entry_index ].data );
+			}
+		}
+		memory_free(
+		 ( *block_cache )->hash_table );
+
+		memory_free(
+		 ( *block_cache )->entries );
+
+		memory_free(
+		 *block_cache );
+
+		*block_cache = NULL;
+	}
+	return( result );
+}
+
+/* Retrieves the index of the entry that contains the block at a specific (file) offset
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful, 0 if no such entry or -1 on error
+ */
+int libvshadow_block_cache_get_entry_index_by_offset(
+     libvshadow_block_cache_t *block_cache,
+     off64_t offset,
+     int *entry_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_block_cache_get_entry_index_by_offset";
+	int hash_bucket_index = 0;
+	int safe_entry_index  = 0;
+
+	if( block_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry index.",
+		 function );
+
+		return( -1 );
+	}
+	hash_bucket_index = (int) ( ( (uint64_t) offset / block_cache->block_size ) & ( block_cache->number_of_hash_buckets - 1 ) );
+
+	safe_entry_index = block_cache->hash_table[ hash_bucket_index ];
+
+	while( safe_entry_index != -1 )
+	{
+		if( block_cache->entries[ safe_entry_index ].offset == offset )
+		{
+			*entry_index = safe_entry_index;
+
+			return( 1 );
+		}
+		safe_entry_index = block_cache->entries[ safe_entry_index ].next_hash_entry_index;
+	}
+	return( 0 );
+}
+
+/* Marks an entry as most recently used
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_block_cache_set_most_recently_used_entry(
+     libvshadow_block_cache_t *block_cache,
+     int entry_index,
+     libcerror_error_t **error )
+{
+	libvshadow_block_cache_entry_t *entry = NULL;
+	static char *function                 = "libvshadow_block_cache_set_most_recently_used_entry";
+
+	if( block_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( entry_index < 0 )
+	 || ( entry_index >= block_cache->number_of_entries ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid entry index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_cache->most_recently_used_entry_index == entry_index )
+	{
+		return( 1 );
+	}
+	entry = &( block_cache->entries[ entry_index ] );
+
+	/* Remove the entry from the least recently used list
+	 */
+	if( entry->previous_entry_index != -1 )
+	{
+		block_cache->entries[ entry->previous_entry_index ].next_entry_index = entry->next_entry_index;
+	}
+	if( entry->next_entry_index != -1 )
+	{
+		block_cache->entries[ entry->next_entry_index ].previous_entry_index = entry->previous_entry_index;
+	}
+	if( block_cache->least_recently_used_entry_index == entry_index )
+	{
+		block_cache->least_recently_used_entry_index = entry->previous_entry_index;
+	}
+	/* Insert the entry at the front of the least recently used list
+	 */
+	entry->previous_entry_index = -1;
+	entry->next_entry_index     = block_cache->most_recently_used_entry_index;
+
+	if( block_cache->most_recently_used_entry_index != -1 )
+	{
+		block_cache->entries[ block_cache->most_recently_used_entry_index ].previous_entry_index = entry_index;
+	}
+	block_cache->most_recently_used_entry_index = entry_index;
+
+	if( block_cache->least_recently_used_entry_index == -1 )
+	{
+		block_cache->least_recently_used_entry_index = entry_index;
+	}
+	return( 1 );
+}
+
+/* Retrieves an unused entry
+ * If the cache is full the least recently used entry is reused
+ * The entry is not part of the hash table until its offset is set
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_block_cache_get_free_entry(
+     libvshadow_block_cache_t *block_cache,
+     int *entry_index,
+     libcerror_error_t **error )
+{
+	libvshadow_block_cache_entry_t *entry = NULL;
+	static char *function                 = "libvshadow_block_cache_get_free_entry";
+	int hash_bucket_index                 = 0;
+	int hash_entry_index                  = 0;
+	int safe_entry_index                  = 0;
+
+	if( block_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry index.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_cache->number_of_entries < block_cache->maximum_number_of_entries )
+	{
+		safe_entry_index = block_cache->number_of_entries;
+
+		entry = &( block_cache->entries[ safe_entry_index ] );
+
+		entry->data = (uint8_t *) memory_allocate(
+		                           sizeof( uint8_t ) * block_cache->block_size );
+
+		if( entry->data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create entry data.",
+			 function );
+
+			return( -1 );
+		}
+		entry->offset               = -1;
+		entry->previous_entry_index = -1;
+		entry->next_entry_index     = -1;
+
+		block_cache->number_of_entries += 1;
+	}
+	else
+	{
+		safe_entry_index = block_cache->least_recently_used_entry_index;
+
+		entry = &( block_cache->entries[ safe_entry_index ] );
+	}
+	if( entry->offset != -1 )
+	{
+		/* Remove the entry from its hash bucket
+		 */
+		hash_bucket_index = (int) ( ( (uint64_t) entry->offset / block_cache->block_size ) & ( block_cache->number_of_hash_buckets - 1 ) );
+
+		hash_entry_index = block_cache->hash_table[ hash_bucket_index ];
+
+		if( hash_entry_index == safe_entry_index )
+		{
+			block_cache->hash_table[ hash_bucket_index ] = entry->next_hash_entry_index;
+		}
+		else
+		{
+			while( block_cache->entries[ hash_entry_index ].next_hash_entry_index != safe_entry_index )
+			{
+				hash_entry_index = block_cache->entries[ hash_entry_index ].next_hash_entry_index;
+			}
+			block_cache->entries[ hash_entry_index ].next_hash_entry_index = entry->next_hash_entry_index;
+		}
+	}
+	entry->offset                = -1;
+	entry->data_size             = 0;
+	entry->next_hash_entry_index = -1;
+
+	if( libvshadow_block_cache_set_most_recently_used_entry(
+	     block_cache,
+	     safe_entry_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set most recently used entry.",
+		 function );
+
+		return( -1 );
+	}
+	*entry_index = safe_entry_index;
+
+	return( 1 );
+}
+
+/* Reads data at a specific (file) offset into a buffer using the block cache
+ * Reads larger than the block size are served block by block, consecutive blocks
+ * that are not cached are read with a single read and added to the cache
+ * The lock is not held while the data of the blocks is read from the file IO handle
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libvshadow_block_cache_read_buffer(
+         libvshadow_block_cache_t *block_cache,
+         libbfio_handle_t *file_io_handle,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libvshadow_block_cache_entry_t *entry = NULL;
+	uint8_t *run_data                     = NULL;
+	uint8_t *reallocation                 = NULL;
+	static char *function                 = "libvshadow_block_cache_read_buffer";
+	off64_t block_offset                  = 0;
+	size_t block_data_offset              = 0;
+	size_t block_data_size                = 0;
+	size_t buffer_offset                  = 0;
+	size_t read_size                      = 0;
+	size_t run_data_offset                = 0;
+	size_t run_data_size                  = 0;
+	size_t run_size                       = 0;
+	ssize_t read_count                    = 0;
+	int entry_index                       = 0;
+	int hash_bucket_index                 = 0;
+	int maximum_number_of_run_blocks      = 0;
+	int number_of_run_blocks              = 0;
+	int result                            = 0;
+	int run_block_index                   = 0;
+
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	uint8_t has_write_lock                = 0;
+#endif
+
+	if( block_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	while( buffer_offset < buffer_size )
+	{
+		block_data_offset = (size_t) ( (uint64_t) offset % block_cache->block_size );
+		block_offset      = offset - (off64_t) block_data_offset;
+
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_grab_for_write(
+		     block_cache->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab read/write lock for writing.",
+			 function );
+
+			goto on_error;
+		}
+		has_write_lock = 1;
+#endif
+		result = libvshadow_block_cache_get_entry_index_by_offset(
+		          block_cache,
+		          block_offset,
+		          &entry_index,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve entry for offset: 0x%08" PRIx64 ".",
+			 function,
+			 block_offset );
+
+			goto on_error;
+		}
+		else if( result != 0 )
+		{
+			block_cache->number_of_hits += 1;
+
+			if( libvshadow_block_cache_set_most_recently_used_entry(
+			     block_cache,
+			     entry_index,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set most recently used entry.",
+				 function );
+
+				goto on_error;
+			}
+			entry = &( block_cache->entries[ entry_index ] );
+
+			block_data_size = entry->data_size;
+			read_size       = 0;
+
+			if( block_data_offset < block_data_size )
+			{
+				read_size = block_data_size - block_data_offset;
+
+				if( read_size > ( buffer_size - buffer_offset ) )
+				{
+					read_size = buffer_size - buffer_offset;
+				}
+				/* The entry data can be reused once the lock is released
+				 */
+				if( memory_copy(
+				     &( buffer[ buffer_offset ] ),
+				     &( entry->data[ block_data_offset ] ),
+				     read_size ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+					 "%s: unable to copy block data to buffer.",
+					 function );
+
+					goto on_error;
+				}
+			}
+		}
+		else
+		{
+			/* Determine the run of consecutive blocks that are not cached
+			 * The run is limited to the number of entries so that it does not evict itself
+			 */
+			run_size = ( block_data_offset + ( buffer_size - buffer_offset ) + block_cache->block_size - 1 ) / block_cache->block_size;
+
+			if( run_size > (size_t) block_cache->maximum_number_of_entries )
+			{
+				run_size = (size_t) block_cache->maximum_number_of_entries;
+			}
+			maximum_number_of_run_blocks = (int) run_size;
+			for( number_of_run_blocks = 1;
+			     number_of_run_blocks < maximum_number_of_run_blocks;
+			     number_of_run_blocks++ )
+			{
+				result = libvshadow_block_cache_get_entry_index_by_offset(
+				          block_cache,
+				          block_offset + ( (off64_t) number_of_run_blocks * block_cache->block_size ),
+				          &entry_index,
+				          error );
+
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve entry for offset: 0x%08" PRIx64 ".",
+					 function,
+					 block_offset + ( (off64_t) number_of_run_blocks * block_cache->block_size ) );
+
+					goto on_error;
+				}
+				else if( result != 0 )
+				{
+					break;
+				}
+			}
+			result = 0;
+
+			block_cache->number_of_misses += (uint64_t) number_of_run_blocks;
+		}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_release_for_write(
+		     block_cache->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release read/write lock for writing.",
+			 function );
+
+			has_write_lock = 0;
+
+			goto on_error;
+		}
+		has_write_lock = 0;
+#endif
+		if( result == 0 )
+		{
+			run_size = (size_t) number_of_run_blocks * block_cache->block_size;
+
+			if( run_size > run_data_size )
+			{
+				reallocation = (uint8_t *) memory_reallocate(
+				                            run_data,
+				                            sizeof( uint8_t ) * run_size );
+
+				if( reallocation == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+					 "%s: unable to resize run data.",
+					 function );
+
+					goto on_error;
+				}
+				run_data      = reallocation;
+				run_data_size = run_size;
+			}
+			/* The run is read into a private buffer without holding the lock
+			 * The last block of the file can be smaller than the block size
+			 */
+			read_count = libbfio_handle_read_buffer_at_offset(
+			              file_io_handle,
+			              run_data,
+			              run_size,
+			              block_offset,
+			              error );
+
+			if( read_count < 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read blocks at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+				 function,
+				 block_offset,
+				 block_offset );
+
+				goto on_error;
+			}
+			read_size = 0;
+
+			if( block_data_offset < (size_t) read_count )
+			{
+				read_size = (size_t) read_count - block_data_offset;
+
+				if( read_size > ( buffer_size - buffer_offset ) )
+				{
+					read_size = buffer_size - buffer_offset;
+				}
+				if( memory_copy(
+				     &( buffer[ buffer_offset ] ),
+				     &( run_data[ block_data_offset ] ),
+				     read_size ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+					 "%s: unable to copy block data to buffer.",
+					 function );
+
+					goto on_error;
+				}
+			}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+			if( libcthreads_read_write_lock_grab_for_write(
+			     block_cache->read_write_lock,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to grab read/write lock for writing.",
+				 function );
+
+				goto on_error;
+			}
+			has_write_lock = 1;
+#endif
+			block_data_size = block_cache->block_size;
+			run_data_offset = 0;
+
+			for( run_block_index = 0;
+			     run_block_index < number_of_run_blocks;
+			     run_block_index++ )
+			{
+				block_data_size = 0;
+
+				if( run_data_offset < (size_t) read_count )
+				{
+					block_data_size = (size_t) read_count - run_data_offset;
+
+					if( block_data_size > block_cache->block_size )
+					{
+						block_data_size = block_cache->block_size;
+					}
+				}
+				/* Another thread could have inserted the same block in the meantime
+				 */
+				result = libvshadow_block_cache_get_entry_index_by_offset(
+				          block_cache,
+				          block_offset,
+				          &entry_index,
+				          error );
+
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve entry for offset: 0x%08" PRIx64 ".",
+					 function,
+					 block_offset );
+
+					goto on_error;
+				}
+				else if( result == 0 )
+				{
+					if( libvshadow_block_cache_get_free_entry(
+					     block_cache,
+					     &entry_index,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+						 "%s: unable to retrieve free entry.",
+						 function );
+
+						goto on_error;
+					}
+					entry = &( block_cache->entries[ entry_index ] );
+
+					if( block_data_size > 0 )
+					{
+						if( memory_copy(
+						     entry->data,
+						     &( run_data[ run_data_offset ] ),
+						     block_data_size ) == NULL )
+						{
+							libcerror_error_set(
+							 error,
+							 LIBCERROR_ERROR_DOMAIN_MEMORY,
+							 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+							 "%s: unable to copy block data to entry.",
+							 function );
+
+							goto on_error;
+						}
+					}
+					entry->offset    = block_offset;
+					entry->data_size = block_data_size;
+
+					hash_bucket_index = (int) ( ( (uint64_t) block_offset / block_cache->block_size ) & ( block_cache->number_of_hash_buckets - 1 ) );
+
+					entry->next_hash_entry_index                 = block_cache->hash_table[ hash_bucket_index ];
+					block_cache->hash_table[ hash_bucket_index ] = entry_index;
+				}
+				if( block_data_size < block_cache->block_size )
+				{
+					break;
+				}
+				block_offset    += (off64_t) block_cache->block_size;
+				run_data_offset += block_cache->block_size;
+			}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+			if( libcthreads_read_write_lock_release_for_write(
+			     block_cache->read_write_lock,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to release read/write lock for writing.",
+				 function );
+
+				has_write_lock = 0;
+
+				goto on_error;
+			}
+			has_write_lock = 0;
+#endif
+		}
+		if( read_size == 0 )
+		{
+			break;
+		}
+		offset        += (off64_t) read_size;
+		buffer_offset += read_size;
+
+		if( block_data_size < block_cache->block_size )
+		{
+			break;
+		}
+	}
+	if( run_data != NULL )
+	{
+		memory_free(
+		 run_data );
+	}
+	return( (ssize_t) buffer_offset );
+
+on_error:
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( has_write_lock != 0 )
+	{
+		libcthreads_read_write_lock_release_for_write(
+		 block_cache->read_write_lock,
+		 NULL );
+	}
+#endif
+	if( run_data != NULL )
+	{
+		memory_free(
+		 run_data );
+	}
+	return( -1 );
+}
+
+/* Retrieves the cache statistics
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_block_cache_get_statistics(
+     libvshadow_block_cache_t *block_cache,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_misses,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_block_cache_get_statistics";
+
+	if( block_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_hits == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of hits.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_misses == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of misses.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     block_cache->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*number_of_hits   = block_cache->number_of_hits;
+	*number_of_misses = block_cache->number_of_misses;
+
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     block_cache->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
@@ -0,0 +1,163 @@
+/*
+ * Block cache functions
+ *
+ * Copyright (C) 2011-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVSHADOW_BLOCK_CACHE_H )
+#define _LIBVSHADOW_BLOCK_CACHE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvshadow_libbfio.h"
+#include "libvshadow_libcerror.h"
+#include "libvshadow_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libvshadow_block_cache_entry libvshadow_block_cache_entry_t;
+
+struct libvshadow_block_cache_entry
+{
+	/* The (file) offset of the block
+	 * Contains -1 if the entry is not used
+	 */
+	off64_t offset;
+
+	/* The data
+	 */
+	uint8_t *data;
+
+	/* The data size
+	 */
+	size_t data_size;
+
+	/* The index of the previous entry in the least recently used list
+	 */
+	int previous_entry_index;
+
+	/* The index of the next entry in the least recently used list
+	 */
+	int next_entry_index;
+
+	/* The index of the next entry in the same hash bucket
+	 */
+	int next_hash_entry_index;
+};
+
+typedef struct libvshadow_block_cache libvshadow_block_cache_t;
+
+struct libvshadow_block_cache
+{
+	/* The block size
+	 */
+	size_t block_size;
+
+	/* The entries
+	 */
+	libvshadow_block_cache_entry_t *entries;
+
+	/* The number of used entries
+	 */
+	int number_of_entries;
+
+	/* The maximum number of entries
+	 */
+	int maximum_number_of_entries;
+
+	/* The hash table
+	 * Contains the index of the first entry of each hash bucket or -1
+	 */
+	int *hash_table;
+
+	/* The number of hash buckets
+	 */
+	int number_of_hash_buckets;
+
+	/* The index of the most recently used entry
+	 */
+	int most_recently_used_entry_index;
+
+	/* The index of the least recently used entry
+	 */
+	int least_recently_used_entry_index;
+
+	/* The number of cache hits
+	 */
+	uint64_t number_of_hits;
+
+	/* The number of cache misses
+	 */
+	uint64_t number_of_misses;
+
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	/* The read/write lock
+	 */
+	libcthreads_read_write_lock_t *read_write_lock;
+#endif
+};
+
+int libvshadow_block_cache_initialize(
+     libvshadow_block_cache_t **block_cache,
+     size64_t maximum_cache_size,
+     size_t block_size,
+     libcerror_error_t **error );
+
+int libvshadow_block_cache_free(
+     libvshadow_block_cache_t **block_cache,
+     libcerror_error_t **error );
+
+int libvshadow_block_cache_get_entry_index_by_offset(
+     libvshadow_block_cache_t *block_cache,
+     off64_t offset,
+     int *entry_index,
+     libcerror_error_t **error );
+
+int libvshadow_block_cache_set_most_recently_used_entry(
+     libvshadow_block_cache_t *block_cache,
+     int entry_index,
+     libcerror_error_t **error );
+
+int libvshadow_block_cache_get_free_entry(
+     libvshadow_block_cache_t *block_cache,
+     int *entry_index,
+     libcerror_error_t **error );
+
+ssize_t libvshadow_block_cache_read_buffer(
+         libvshadow_block_cache_t *block_cache,
+         libbfio_handle_t *file_io_handle,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+int libvshadow_block_cache_get_statistics(
+     libvshadow_block_cache_t *block_cache,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_misses,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVSHADOW_BLOCK_CACHE_H ) */
+
@@ -524,6 +524,178 @@ int libvshadow_block_descriptor_compare_range_by_relative_offset_value(
 	return( LIBCDATA_COMPARE_EQUAL );
 }
 
+/* Compares 2 block descriptor references by the original offset
+ * This function is used to sort arrays of block descriptor references
+ * Returns -1 if the first is less, 0 if equal or 1 if the first is greater than the second
+ */
+int libvshadow_block_descriptor_compare_references_by_original_offset(
+     const void *first_block_descriptor_reference,
+     const void *second_block_descriptor_reference )
+{
+	libvshadow_block_descriptor_t *first_block_descriptor  = NULL;
+	libvshadow_block_descriptor_t *second_block_descriptor = NULL;
+
+	first_block_descriptor  = *( (libvshadow_block_descriptor_t **) first_block_descriptor_reference );
+	second_block_descriptor = *( (libvshadow_block_descriptor_t **) second_block_descriptor_reference );
+
+	if( first_block_descriptor->original_offset < second_block_descriptor->original_offset )
+	{
+		return( -1 );
+	}
+	else if( first_block_descriptor->original_offset > second_block_descriptor->original_offset )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Compares 2 block descriptor references by the relative offset
+ * This function is used to sort arrays of block descriptor references
+ * Returns -1 if the first is less, 0 if equal or 1 if the first is greater than the second
+ */
+int libvshadow_block_descriptor_compare_references_by_relative_offset(
+     const void *first_block_descriptor_reference,
+     const void *second_block_descriptor_reference )
+{
+	libvshadow_block_descriptor_t *first_block_descriptor  = NULL;
+	libvshadow_block_descriptor_t *second_block_descriptor = NULL;
+
+	first_block_descriptor  = *( (libvshadow_block_descriptor_t **) first_block_descriptor_reference );
+	second_block_descriptor = *( (libvshadow_block_descriptor_t **) second_block_descriptor_reference );
+
+	if( first_block_descriptor->relative_offset < second_block_descriptor->relative_offset )
+	{
+		return( -1 );
+	}
+	else if( first_block_descriptor->relative_offset > second_block_descriptor->relative_offset )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Packs a block descriptor
+ * Only block descriptors with 16 KiB aligned offsets that fit in 32-bit block numbers and
+ * without a bitmap can be packed, otherwise LIBVSHADOW_PACKED_BLOCK_FLAG_IS_EXTENDED is set
+ * Returns 1 if successful, 0 if the block descriptor cannot be packed or -1 on error
+ */
+int libvshadow_block_descriptor_pack(
+     libvshadow_block_descriptor_t *block_descriptor,
+     libvshadow_packed_block_descriptor_t *packed_block_descriptor,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_block_descriptor_pack";
+	uint32_t overlay_flag = 0;
+
+	if( block_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( packed_block_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid packed block descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_descriptor->overlay != NULL )
+	{
+		overlay_flag = LIBVSHADOW_PACKED_BLOCK_FLAG_HAS_OVERLAY;
+	}
+	if( ( block_descriptor->original_offset < 0 )
+	 || ( block_descriptor->offset < 0 )
+	 || ( block_descriptor->relative_offset < 0 )
+	 || ( ( block_descriptor->original_offset % 0x4000 ) != 0 )
+	 || ( ( block_descriptor->offset % 0x4000 ) != 0 )
+	 || ( ( block_descriptor->relative_offset % 0x4000 ) != 0 )
+	 || ( ( block_descriptor->original_offset / 0x4000 ) > (off64_t) UINT32_MAX )
+	 || ( ( block_descriptor->offset / 0x4000 ) > (off64_t) UINT32_MAX )
+	 || ( ( block_descriptor->relative_offset / 0x4000 ) > (off64_t) UINT32_MAX )
+	 || ( ( block_descriptor->flags & LIBVSHADOW_PACKED_BLOCK_FLAGS_MASK ) != 0 )
+	 || ( block_descriptor->bitmap != 0 ) )
+	{
+		packed_block_descriptor->original_block_number = 0;
+		packed_block_descriptor->block_number          = 0;
+		packed_block_descriptor->relative_block_number = 0;
+		packed_block_descriptor->flags                 = LIBVSHADOW_PACKED_BLOCK_FLAG_IS_EXTENDED | overlay_flag;
+
+		return( 0 );
+	}
+	packed_block_descriptor->original_block_number = (uint32_t) ( block_descriptor->original_offset / 0x4000 );
+	packed_block_descriptor->block_number          = (uint32_t) ( block_descriptor->offset / 0x4000 );
+	packed_block_descriptor->relative_block_number = (uint32_t) ( block_descriptor->relative_offset / 0x4000 );
+	packed_block_descriptor->flags                 = block_descriptor->flags | overlay_flag;
+
+	return( 1 );
+}
+
+/* Unpacks a block descriptor
+ * The overlay of the block descriptor is not set
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_block_descriptor_unpack(
+     libvshadow_block_descriptor_t *block_descriptor,
+     libvshadow_packed_block_descriptor_t *packed_block_descriptor,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_block_descriptor_unpack";
+
+	if( block_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( packed_block_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid packed block descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( packed_block_descriptor->flags & LIBVSHADOW_PACKED_BLOCK_FLAG_IS_EXTENDED ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported packed block descriptor - extended flag is set.",
+		 function );
+
+		return( -1 );
+	}
+	block_descriptor->original_offset = (off64_t) packed_block_descriptor->original_block_number * 0x4000;
+	block_descriptor->offset          = (off64_t) packed_block_descriptor->block_number * 0x4000;
+	block_descriptor->relative_offset = (off64_t) packed_block_descriptor->relative_block_number * 0x4000;
+	block_descriptor->flags           = packed_block_descriptor->flags & ~( LIBVSHADOW_PACKED_BLOCK_FLAGS_MASK );
+	block_descriptor->bitmap          = 0;
+	block_descriptor->index           = -1;
+	block_descriptor->reverse_index   = -1;
+	block_descriptor->overlay         = NULL;
+
+	return( 1 );
+}
+
 /* Reads the block descriptor
  * Returns 1 if successful, 0 if block list entry is empty or -1 on error
  */
@@ -68,6 +68,31 @@ struct libvshadow_block_descriptor
 	libvshadow_block_descriptor_t *overlay;
 };
 
+typedef struct libvshadow_packed_block_descriptor libvshadow_packed_block_descriptor_t;
+
+struct libvshadow_packed_block_descriptor
+{
+	/* The original (volume) block number
+	 * Contains the original offset in units of 16 KiB
+	 */
+	uint32_t original_block_number;
+
+	/* The (store) block number
+	 * Contains the offset in units of 16 KiB
+	 */
+	uint32_t block_number;
+
+	/* The relative (store) block number
+	 * Contains the relative offset in units of 16 KiB
+	 */
+	uint32_t relative_block_number;
+
+	/* The (block) flags
+	 * The upper 2 bits contain the packed block descriptor flags
+	 */
+	uint32_t flags;
+};
+
 int libvshadow_block_descriptor_initialize(
      libvshadow_block_descriptor_t **block_descriptor,
      libcerror_error_t **error );
@@ -110,6 +135,24 @@ int libvshadow_block_descriptor_compare_range_by_relative_offset_value(
      libvshadow_block_descriptor_t *block_descriptor,
      libcerror_error_t **error );
 
+int libvshadow_block_descriptor_compare_references_by_original_offset(
+     const void *first_block_descriptor_reference,
+     const void *second_block_descriptor_reference );
+
+int libvshadow_block_descriptor_compare_references_by_relative_offset(
+     const void *first_block_descriptor_reference,
+     const void *second_block_descriptor_reference );
+
+int libvshadow_block_descriptor_pack(
+     libvshadow_block_descriptor_t *block_descriptor,
+     libvshadow_packed_block_descriptor_t *packed_block_descriptor,
+     libcerror_error_t **error );
+
+int libvshadow_block_descriptor_unpack(
+     libvshadow_block_descriptor_t *block_descriptor,
+     libvshadow_packed_block_descriptor_t *packed_block_descriptor,
+     libcerror_error_t **error );
+
 int libvshadow_block_descriptor_read_data(
      libvshadow_block_descriptor_t *block_descriptor,
      const uint8_t *data,
@@ -0,0 +1,425 @@
+/*
+ * Block descriptor arena functions
+ *
+ * Copyright (C) 2011-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libvshadow_block_descriptor.h"
+#include "libvshadow_block_descriptor_arena.h"
+#include "libvshadow_definitions.h"
+#include "libvshadow_libcerror.h"
+
+/* Creates a block descriptor arena
+ * Make sure the value block_descriptor_arena is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_block_descriptor_arena_initialize(
+     libvshadow_block_descriptor_arena_t **block_descriptor_arena,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_block_descriptor_arena_initialize";
+
+	if( block_descriptor_arena == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block descriptor arena.",
+		 function );
+
+		return( -1 );
+	}
+	if( *block_descriptor_arena != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid block descriptor arena value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*block_descriptor_arena = memory_allocate_structure(
+	                           libvshadow_block_descriptor_arena_t );
+
+	if( *block_descriptor_arena == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create block descriptor arena.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *block_descriptor_arena,
+	     0,
+	     sizeof( libvshadow_block_descriptor_arena_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear block descriptor arena.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *block_descriptor_arena != NULL )
+	{
+		memory_free(
+		 *block_descriptor_arena );
+
+		*block_descriptor_arena = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a block descriptor arena
+ * This frees all the block descriptors allocated from the arena
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_block_descriptor_arena_free(
+     libvshadow_block_descriptor_arena_t **block_descriptor_arena,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_block_descriptor_arena_free";
+	int slab_index        = 0;
+
+	if( block_descriptor_arena == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block descriptor arena.",
+		 function );
+
+		return( -1 );
+	}
+	if( *block_descriptor_arena != NULL )
+	{
+		if( ( *block_descriptor_arena )->slabs != NULL )
+		{
+			for( slab_index = 0;
+			     slab_index < ( *block_descriptor_arena )->number_of_slabs;
+			     slab_index++ )
+			{
+				memory_free(
+				 ( *block_descriptor_arena )->slabs[ slab_index ] );
+			}
+			memory_free(
+			 ( *block_descriptor_arena )->slabs );
+		}
+		memory_free(
+		 *block_descriptor_arena );
+
+		*block_descriptor_arena = NULL;
+	}
+	return( 1 );
+}
+
+/* Allocates a block descriptor from the block descriptor arena
+ * The block descriptor remains owned by the arena and must not be freed by libvshadow_block_descriptor_free
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_block_descriptor_arena_allocate(
+     libvshadow_block_descriptor_arena_t *block_descriptor_arena,
+     libvshadow_block_descriptor_t **block_descriptor,
+     libcerror_error_t **error )
+{
+	libvshadow_block_descriptor_t **slabs = NULL;
+	libvshadow_block_descriptor_t *slab   = NULL;
+	static char *function                 = "libvshadow_block_descriptor_arena_allocate";
+	size_t slabs_size                     = 0;
+	int number_of_allocated_slabs         = 0;
+
+	if( block_descriptor_arena == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block descriptor arena.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( *block_descriptor != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid block descriptor value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( block_descriptor_arena->number_of_slabs == 0 )
+	 || ( block_descriptor_arena->last_slab_number_of_block_descriptors >= LIBVSHADOW_BLOCK_DESCRIPTOR_ARENA_SLAB_SIZE ) )
+	{
+		if( block_descriptor_arena->number_of_slabs >= block_descriptor_arena->number_of_allocated_slabs )
+		{
+			if( block_descriptor_arena->number_of_allocated_slabs == 0 )
+			{
+				number_of_allocated_slabs = 16;
+			}
+			else if( block_descriptor_arena->number_of_allocated_slabs <= ( INT_MAX / 2 ) )
+			{
+				number_of_allocated_slabs = block_descriptor_arena->number_of_allocated_slabs * 2;
+			}
+			else
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+				 "%s: invalid block descriptor arena - number of allocated slabs value exceeds maximum.",
+				 function );
+
+				return( -1 );
+			}
+			if( (size_t) number_of_allocated_slabs > ( (size_t) SSIZE_MAX / sizeof( libvshadow_block_descriptor_t * ) ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+				 "%s: invalid slabs size value exceeds maximum.",
+				 function );
+
+				return( -1 );
+			}
+			slabs_size = sizeof( libvshadow_block_descriptor_t * ) * number_of_allocated_slabs;
+
+			slabs = (libvshadow_block_descriptor_t **) memory_reallocate(
+			                                            block_descriptor_arena->slabs,
+			                                            slabs_size );
+
+			if( slabs == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to resize slabs.",
+				 function );
+
+				return( -1 );
+			}
+			block_descriptor_arena->slabs                     = slabs;
+			block_descriptor_arena->number_of_allocated_slabs = number_of_allocated_slabs;
+		}
+		slab = (libvshadow_block_descriptor_t *) memory_allocate(
+		                                          sizeof( libvshadow_block_descriptor_t ) * LIBVSHADOW_BLOCK_DESCRIPTOR_ARENA_SLAB_SIZE );
+
+		if( slab == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create slab.",
+			 function );
+
+			return( -1 );
+		}
+		block_descriptor_arena->slabs[ block_descriptor_arena->number_of_slabs ] = slab;
+
+		block_descriptor_arena->number_of_slabs                      += 1;
+		block_descriptor_arena->last_slab_number_of_block_descriptors = 0;
+	}
+	slab = block_descriptor_arena->slabs[ block_descriptor_arena->number_of_slabs - 1 ];
+
+	*block_descriptor = &( slab[ block_descriptor_arena->last_slab_number_of_block_descriptors ] );
+
+	if( memory_set(
+	     *block_descriptor,
+	     0,
+	     sizeof( libvshadow_block_descriptor_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear block descriptor.",
+		 function );
+
+		*block_descriptor = NULL;
+
+		return( -1 );
+	}
+	( *block_descriptor )->index         = -1;
+	( *block_descriptor )->reverse_index = -1;
+
+	block_descriptor_arena->last_slab_number_of_block_descriptors += 1;
+
+	return( 1 );
+}
+
+/* Clones a block descriptor, including its overlay, into the block descriptor arena
+ * Make sure the value destination_block_descriptor is pointing to is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_block_descriptor_arena_clone(
+     libvshadow_block_descriptor_arena_t *block_descriptor_arena,
+     libvshadow_block_descriptor_t **destination_block_descriptor,
+     libvshadow_block_descriptor_t *source_block_descriptor,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_block_descriptor_arena_clone";
+
+	if( destination_block_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid destination block descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( *destination_block_descriptor != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid destination block descriptor value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( source_block_descriptor == NULL )
+	{
+		*destination_block_descriptor = NULL;
+
+		return( 1 );
+	}
+	if( libvshadow_block_descriptor_arena_allocate(
+	     block_descriptor_arena,
+	     destination_block_descriptor,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create destination block descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	( *destination_block_descriptor )->original_offset = source_block_descriptor->original_offset;
+	( *destination_block_descriptor )->offset          = source_block_descriptor->offset;
+	( *destination_block_descriptor )->relative_offset = source_block_descriptor->relative_offset;
+	( *destination_block_descriptor )->flags           = source_block_descriptor->flags;
+	( *destination_block_descriptor )->bitmap          = source_block_descriptor->bitmap;
+
+	if( source_block_descriptor->overlay != NULL )
+	{
+		if( libvshadow_block_descriptor_arena_clone(
+		     block_descriptor_arena,
+		     &( ( *destination_block_descriptor )->overlay ),
+		     source_block_descriptor->overlay,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create destination overlay block descriptor.",
+			 function );
+
+			*destination_block_descriptor = NULL;
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Retrieves the number of block descriptors allocated from the block descriptor arena
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_block_descriptor_arena_get_number_of_block_descriptors(
+     libvshadow_block_descriptor_arena_t *block_descriptor_arena,
+     int *number_of_block_descriptors,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_block_descriptor_arena_get_number_of_block_descriptors";
+
+	if( block_descriptor_arena == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block descriptor arena.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_block_descriptors == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of block descriptors.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_descriptor_arena->number_of_slabs == 0 )
+	{
+		*number_of_block_descriptors = 0;
+	}
+	else
+	{
+		*number_of_block_descriptors = ( ( block_descriptor_arena->number_of_slabs - 1 ) * LIBVSHADOW_BLOCK_DESCRIPTOR_ARENA_SLAB_SIZE )
+		                             + block_descriptor_arena->last_slab_number_of_block_descriptors;
+	}
+	return( 1 );
+}
+
@@ -0,0 +1,87 @@
+/*
+ * Block descriptor arena functions
+ *
+ * Copyright (C) 2011-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#if !defined( _LIBVSHADOW_BLOCK_DESCRIPTOR_ARENA_H )
+#define _LIBVSHADOW_BLOCK_DESCRIPTOR_ARENA_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvshadow_block_descriptor.h"
+#include "libvshadow_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libvshadow_block_descriptor_arena libvshadow_block_descriptor_arena_t;
+
+struct libvshadow_block_descriptor_arena
+{
+	/* The slabs
+	 * Contains arrays of LIBVSHADOW_BLOCK_DESCRIPTOR_ARENA_SLAB_SIZE block descriptors
+	 */
+	libvshadow_block_descriptor_t **slabs;
+
+	/* The number of slabs
+	 */
+	int number_of_slabs;
+
+	/* The number of allocated slabs
+	 */
+	int number_of_allocated_slabs;
+
+	/* The number of block descriptors used in the last slab
+	 */
+	int last_slab_number_of_block_descriptors;
+};
+
+int libvshadow_block_descriptor_arena_initialize(
+     libvshadow_block_descriptor_arena_t **block_descriptor_arena,
+     libcerror_error_t **error );
+
+int libvshadow_block_descriptor_arena_free(
+     libvshadow_block_descriptor_arena_t **block_descriptor_arena,
+     libcerror_error_t **error );
+
+int libvshadow_block_descriptor_arena_allocate(
+     libvshadow_block_descriptor_arena_t *block_descriptor_arena,
+     libvshadow_block_descriptor_t **block_descriptor,
+     libcerror_error_t **error );
+
+int libvshadow_block_descriptor_arena_clone(
+     libvshadow_block_descriptor_arena_t *block_descriptor_arena,
+     libvshadow_block_descriptor_t **destination_block_descriptor,
+     libvshadow_block_descriptor_t *source_block_descriptor,
+     libcerror_error_t **error );
+
+int libvshadow_block_descriptor_arena_get_number_of_block_descriptors(
+     libvshadow_block_descriptor_arena_t *block_descriptor_arena,
+     int *number_of_block_descriptors,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVSHADOW_BLOCK_DESCRIPTOR_ARENA_H ) */
+
@@ -0,0 +1,1289 @@
+/*
+ * Block index functions
+ *
+ * Copyright (C) 2011-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libvshadow_block_descriptor.h"
+#include "libvshadow_block_index.h"
+#include "libvshadow_definitions.h"
+#include "libvshadow_libcerror.h"
+
+/* Creates a block index
+ * Make sure the value block_index is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_block_index_initialize(
+     libvshadow_block_index_t **block_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_block_index_initialize";
+
+	if( block_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block index.",
+		 function );
+
+		return( -1 );
+	}
+	if( *block_index != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid block index value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*block_index = memory_allocate_structure(
+	                libvshadow_block_index_t );
+
+	if( *block_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create block index.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *block_index,
+	     0,
+	     sizeof( libvshadow_block_index_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear block index.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *block_index != NULL )
+	{
+		memory_free(
+		 *block_index );
+
+		*block_index = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a block index
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_block_index_free(
+     libvshadow_block_index_t **block_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_block_index_free";
+
+	if( block_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block index.",
+		 function );
+
+		return( -1 );
+	}
+	if( *block_index != NULL )
+	{
+		/* The block descriptors are stored by value, hence their overlays are not freed
+		 * by libvshadow_block_descriptor_free
+		 */
+		if( ( *block_index )->overlay_block_descriptors != NULL )
+		{
+			memory_free(
+			 ( *block_index )->overlay_block_descriptors );
+		}
+		if( ( *block_index )->extended_block_descriptors != NULL )
+		{
+			memory_free(
+			 ( *block_index )->extended_block_descriptors );
+		}
+		if( ( *block_index )->packed_block_descriptors != NULL )
+		{
+			memory_free(
+			 ( *block_index )->packed_block_descriptors );
+		}
+		if( ( *block_index )->block_offsets != NULL )
+		{
+			memory_free(
+			 ( *block_index )->block_offsets );
+		}
+		if( ( *block_index )->block_numbers != NULL )
+		{
+			memory_free(
+			 ( *block_index )->block_numbers );
+		}
+		memory_free(
+		 *block_index );
+
+		*block_index = NULL;
+	}
+	return( 1 );
+}
+
+/* Sets the (lookup) keys
+ * The block descriptors must be sorted by the offset used as key, which is the original offset
+ * or the relative offset. The keys are stored as block numbers if all of them are 16 KiB aligned
+ * and fit in 32-bit, otherwise as offsets
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_block_index_set_keys(
+     libvshadow_block_index_t *block_index,
+     libvshadow_block_descriptor_t **block_descriptors_array,
+     int number_of_block_descriptors,
+     uint8_t use_relative_offset,
+     libcerror_error_t **error )
+{
+	libvshadow_block_descriptor_t *block_descriptor = NULL;
+	static char *function                           = "libvshadow_block_index_set_keys";
+	off64_t key_offset                              = 0;
+	off64_t previous_key_offset                     = 0;
+	uint8_t use_block_numbers                       = 1;
+	int block_descriptor_index                      = 0;
+
+	if( block_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block index.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( block_index->block_numbers != NULL )
+	 || ( block_index->block_offsets != NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid block index - keys value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_descriptors_array == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block descriptors array.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_block_descriptors <= 0 )
+	 || ( (size_t) number_of_block_descriptors > ( (size_t) SSIZE_MAX / sizeof( off64_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of block descriptors value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	for( block_descriptor_index = 0;
+	     block_descriptor_index < number_of_block_descriptors;
+	     block_descriptor_index++ )
+	{
+		block_descriptor = block_descriptors_array[ block_descriptor_index ];
+
+		if( block_descriptor == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing block descriptor: %d.",
+			 function,
+			 block_descriptor_index );
+
+			return( -1 );
+		}
+		if( use_relative_offset != 0 )
+		{
+			key_offset = block_descriptor->relative_offset;
+		}
+		else
+		{
+			key_offset = block_descriptor->original_offset;
+		}
+		if( ( block_descriptor_index > 0 )
+		 && ( key_offset < previous_key_offset ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported block descriptor: %d - not sorted by %s offset.",
+			 function,
+			 block_descriptor_index,
+			 ( use_relative_offset != 0 ) ? "relative" : "original" );
+
+			return( -1 );
+		}
+		if( ( key_offset < 0 )
+		 || ( ( key_offset % 0x4000 ) != 0 )
+		 || ( ( key_offset / 0x4000 ) > (off64_t) UINT32_MAX ) )
+		{
+			use_block_numbers = 0;
+		}
+		previous_key_offset = key_offset;
+	}
+	if( use_block_numbers != 0 )
+	{
+		block_index->block_numbers = (uint32_t *) memory_allocate(
+		                                           sizeof( uint32_t ) * number_of_block_descriptors );
+
+		if( block_index->block_numbers == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create block numbers.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	else
+	{
+		block_index->block_offsets = (off64_t *) memory_allocate(
+		                                          sizeof( off64_t ) * number_of_block_descriptors );
+
+		if( block_index->block_offsets == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create block offsets.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	for( block_descriptor_index = 0;
+	     block_descriptor_index < number_of_block_descriptors;
+	     block_descriptor_index++ )
+	{
+		block_descriptor = block_descriptors_array[ block_descriptor_index ];
+
+		if( use_relative_offset != 0 )
+		{
+			key_offset = block_descriptor->relative_offset;
+		}
+		else
+		{
+			key_offset = block_descriptor->original_offset;
+		}
+		if( use_block_numbers != 0 )
+		{
+			block_index->block_numbers[ block_descriptor_index ] = (uint32_t) ( key_offset / 0x4000 );
+		}
+		else
+		{
+			block_index->block_offsets[ block_descriptor_index ] = key_offset;
+		}
+	}
+	return( 1 );
+}
+
+/* Sets the forward block descriptors
+ * The block descriptors must be sorted by original offset, they are copied
+ * including their overlay block descriptors and keyed by original offset
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_block_index_set_forward_block_descriptors(
+     libvshadow_block_index_t *block_index,
+     libvshadow_block_descriptor_t **block_descriptors_array,
+     int number_of_block_descriptors,
+     libcerror_error_t **error )
+{
+	libvshadow_block_descriptor_t *block_descriptor      = NULL;
+	libvshadow_block_descriptor_t *side_block_descriptor = NULL;
+	static char *function                                = "libvshadow_block_index_set_forward_block_descriptors";
+	int block_descriptor_index                           = 0;
+	int extended_block_descriptor_index                  = 0;
+	int number_of_extended_block_descriptors             = 0;
+	int number_of_overlay_block_descriptors              = 0;
+	int overlay_block_descriptor_index                   = 0;
+	int result                                           = 0;
+
+	if( block_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block index.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( block_index->block_numbers != NULL )
+	 || ( block_index->block_offsets != NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid block index - keys value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_block_descriptors < 0 )
+	 || ( (size_t) number_of_block_descriptors > ( (size_t) SSIZE_MAX / sizeof( libvshadow_block_descriptor_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of block descriptors value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_block_descriptors == 0 )
+	{
+		return( 1 );
+	}
+	if( libvshadow_block_index_set_keys(
+	     block_index,
+	     block_descriptors_array,
+	     number_of_block_descriptors,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set keys.",
+		 function );
+
+		goto on_error;
+	}
+	block_index->packed_block_descriptors = (libvshadow_packed_block_descriptor_t *) memory_allocate(
+	                                                                                  sizeof( libvshadow_packed_block_descriptor_t ) * number_of_block_descriptors );
+
+	if( block_index->packed_block_descriptors == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create packed block descriptors.",
+		 function );
+
+		goto on_error;
+	}
+	for( block_descriptor_index = 0;
+	     block_descriptor_index < number_of_block_descriptors;
+	     block_descriptor_index++ )
+	{
+		block_descriptor = block_descriptors_array[ block_descriptor_index ];
+
+		result = libvshadow_block_descriptor_pack(
+		          block_descriptor,
+		          &( block_index->packed_block_descriptors[ block_descriptor_index ] ),
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to pack block descriptor: %d.",
+			 function,
+			 block_descriptor_index );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			number_of_extended_block_descriptors++;
+		}
+		if( block_descriptor->overlay != NULL )
+		{
+			number_of_overlay_block_descriptors++;
+		}
+	}
+	if( number_of_extended_block_descriptors > 0 )
+	{
+		block_index->extended_block_descriptors = (libvshadow_block_descriptor_t *) memory_allocate(
+		                                                                             sizeof( libvshadow_block_descriptor_t ) * number_of_extended_block_descriptors );
+
+		if( block_index->extended_block_descriptors == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create extended block descriptors.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( number_of_overlay_block_descriptors > 0 )
+	{
+		block_index->overlay_block_descriptors = (libvshadow_block_descriptor_t *) memory_allocate(
+		                                                                            sizeof( libvshadow_block_descriptor_t ) * number_of_overlay_block_descriptors );
+
+		if( block_index->overlay_block_descriptors == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create overlay block descriptors.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	for( block_descriptor_index = 0;
+	     block_descriptor_index < number_of_block_descriptors;
+	     block_descriptor_index++ )
+	{
+		block_descriptor = block_descriptors_array[ block_descriptor_index ];
+
+		if( ( block_index->packed_block_descriptors[ block_descriptor_index ].flags & LIBVSHADOW_PACKED_BLOCK_FLAG_IS_EXTENDED ) != 0 )
+		{
+			side_block_descriptor = &( block_index->extended_block_descriptors[ extended_block_descriptor_index++ ] );
+
+			if( memory_copy(
+			     side_block_descriptor,
+			     block_descriptor,
+			     sizeof( libvshadow_block_descriptor_t ) ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy extended block descriptor: %d.",
+				 function,
+				 block_descriptor_index );
+
+				goto on_error;
+			}
+			side_block_descriptor->index         = block_descriptor_index;
+			side_block_descriptor->reverse_index = -1;
+			side_block_descriptor->overlay       = NULL;
+		}
+		if( block_descriptor->overlay != NULL )
+		{
+			side_block_descriptor = &( block_index->overlay_block_descriptors[ overlay_block_descriptor_index++ ] );
+
+			if( memory_copy(
+			     side_block_descriptor,
+			     block_descriptor->overlay,
+			     sizeof( libvshadow_block_descriptor_t ) ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy overlay block descriptor: %d.",
+				 function,
+				 block_descriptor_index );
+
+				goto on_error;
+			}
+			/* Overlay block descriptors do not have overlays themselves
+			 */
+			side_block_descriptor->index         = block_descriptor_index;
+			side_block_descriptor->reverse_index = -1;
+			side_block_descriptor->overlay       = NULL;
+		}
+	}
+	block_index->number_of_extended_block_descriptors = number_of_extended_block_descriptors;
+	block_index->number_of_overlay_block_descriptors  = number_of_overlay_block_descriptors;
+	block_index->number_of_blocks                     = number_of_block_descriptors;
+
+	return( 1 );
+
+on_error:
+	if( block_index->overlay_block_descriptors != NULL )
+	{
+		memory_free(
+		 block_index->overlay_block_descriptors );
+
+		block_index->overlay_block_descriptors = NULL;
+	}
+	if( block_index->extended_block_descriptors != NULL )
+	{
+		memory_free(
+		 block_index->extended_block_descriptors );
+
+		block_index->extended_block_descriptors = NULL;
+	}
+	if( block_index->packed_block_descriptors != NULL )
+	{
+		memory_free(
+		 block_index->packed_block_descriptors );
+
+		block_index->packed_block_descriptors = NULL;
+	}
+	if( block_index->block_offsets != NULL )
+	{
+		memory_free(
+		 block_index->block_offsets );
+
+		block_index->block_offsets = NULL;
+	}
+	if( block_index->block_numbers != NULL )
+	{
+		memory_free(
+		 block_index->block_numbers );
+
+		block_index->block_numbers = NULL;
+	}
+	return( -1 );
+}
+
+/* Sets the reverse block descriptors
+ * The block descriptors must be sorted by relative offset, only their relative offsets are stored
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_block_index_set_reverse_block_descriptors(
+     libvshadow_block_index_t *block_index,
+     libvshadow_block_descriptor_t **block_descriptors_array,
+     int number_of_block_descriptors,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_block_index_set_reverse_block_descriptors";
+
+	if( block_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block index.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( block_index->block_numbers != NULL )
+	 || ( block_index->block_offsets != NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid block index - keys value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_block_descriptors < 0 )
+	 || ( (size_t) number_of_block_descriptors > ( (size_t) SSIZE_MAX / sizeof( off64_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of block descriptors value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_block_descriptors == 0 )
+	{
+		return( 1 );
+	}
+	if( libvshadow_block_index_set_keys(
+	     block_index,
+	     block_descriptors_array,
+	     number_of_block_descriptors,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set keys.",
+		 function );
+
+		return( -1 );
+	}
+	block_index->number_of_blocks = number_of_block_descriptors;
+
+	return( 1 );
+}
+
+/* Appends a block descriptor
+ * The block descriptor is packed if possible otherwise it is copied into the extended block descriptors,
+ * the appended block descriptors are not keyed and their overlay block descriptors are not stored
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_block_index_append_block_descriptor(
+     libvshadow_block_index_t *block_index,
+     libvshadow_block_descriptor_t *block_descriptor,
+     libcerror_error_t **error )
+{
+	libvshadow_block_descriptor_t *extended_block_descriptors     = NULL;
+	libvshadow_packed_block_descriptor_t *packed_block_descriptor  = NULL;
+	libvshadow_packed_block_descriptor_t *packed_block_descriptors = NULL;
+	static char *function                                          = "libvshadow_block_index_append_block_descriptor";
+	size_t block_descriptors_size                                  = 0;
+	int number_of_allocated_blocks                                 = 0;
+	int number_of_allocated_extended_block_descriptors             = 0;
+	int result                                                     = 0;
+
+	if( block_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block index.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( block_index->block_numbers != NULL )
+	 || ( block_index->block_offsets != NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid block index - keys value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_index->number_of_blocks >= block_index->number_of_allocated_blocks )
+	{
+		if( block_index->number_of_allocated_blocks == 0 )
+		{
+			number_of_allocated_blocks = 256;
+		}
+		else if( block_index->number_of_allocated_blocks < ( INT_MAX / 2 ) )
+		{
+			number_of_allocated_blocks = block_index->number_of_allocated_blocks * 2;
+		}
+		else
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid block index - number of allocated blocks value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		if( (size_t) number_of_allocated_blocks > ( (size_t) SSIZE_MAX / sizeof( libvshadow_packed_block_descriptor_t ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid packed block descriptors size value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		block_descriptors_size = sizeof( libvshadow_packed_block_descriptor_t ) * number_of_allocated_blocks;
+
+		packed_block_descriptors = (libvshadow_packed_block_descriptor_t *) memory_reallocate(
+		                                                                     block_index->packed_block_descriptors,
+		                                                                     block_descriptors_size );
+
+		if( packed_block_descriptors == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize packed block descriptors.",
+			 function );
+
+			return( -1 );
+		}
+		block_index->packed_block_descriptors   = packed_block_descriptors;
+		block_index->number_of_allocated_blocks = number_of_allocated_blocks;
+	}
+	packed_block_descriptor = &( block_index->packed_block_descriptors[ block_index->number_of_blocks ] );
+
+	result = libvshadow_block_descriptor_pack(
+	          block_descriptor,
+	          packed_block_descriptor,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to pack block descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	packed_block_descriptor->flags &= ~( LIBVSHADOW_PACKED_BLOCK_FLAG_HAS_OVERLAY );
+
+	if( result == 0 )
+	{
+		if( block_index->number_of_extended_block_descriptors >= block_index->number_of_allocated_extended_block_descriptors )
+		{
+			if( block_index->number_of_allocated_extended_block_descriptors == 0 )
+			{
+				number_of_allocated_extended_block_descriptors = 16;
+			}
+			else if( block_index->number_of_allocated_extended_block_descriptors < ( INT_MAX / 2 ) )
+			{
+				number_of_allocated_extended_block_descriptors = block_index->number_of_allocated_extended_block_descriptors * 2;
+			}
+			else
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+				 "%s: invalid block index - number of allocated extended block descriptors value exceeds maximum.",
+				 function );
+
+				return( -1 );
+			}
+			if( (size_t) number_of_allocated_extended_block_descriptors > ( (size_t) SSIZE_MAX / sizeof( libvshadow_block_descriptor_t ) ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+				 "%s: invalid extended block descriptors size value exceeds maximum.",
+				 function );
+
+				return( -1 );
+			}
+			block_descriptors_size = sizeof( libvshadow_block_descriptor_t ) * number_of_allocated_extended_block_descriptors;
+
+			extended_block_descriptors = (libvshadow_block_descriptor_t *) memory_reallocate(
+			                                                                block_index->extended_block_descriptors,
+			                                                                block_descriptors_size );
+
+			if( extended_block_descriptors == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to resize extended block descriptors.",
+				 function );
+
+				return( -1 );
+			}
+			block_index->extended_block_descriptors                     = extended_block_descriptors;
+			block_index->number_of_allocated_extended_block_descriptors = number_of_allocated_extended_block_descriptors;
+		}
+		extended_block_descriptors = &( block_index->extended_block_descriptors[ block_index->number_of_extended_block_descriptors ] );
+
+		if( memory_copy(
+		     extended_block_descriptors,
+		     block_descriptor,
+		     sizeof( libvshadow_block_descriptor_t ) ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy extended block descriptor.",
+			 function );
+
+			return( -1 );
+		}
+		/* The block descriptors are appended in order hence the extended block descriptors remain sorted by index
+		 */
+		extended_block_descriptors->index         = block_index->number_of_blocks;
+		extended_block_descriptors->reverse_index = -1;
+		extended_block_descriptors->overlay       = NULL;
+
+		block_index->number_of_extended_block_descriptors += 1;
+	}
+	block_index->number_of_blocks += 1;
+
+	return( 1 );
+}
+
+/* Retrieves the index of the first block that ends after a specific offset
+ * The entry index is set to the number of blocks if there is no such block
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_block_index_get_index_by_offset(
+     libvshadow_block_index_t *block_index,
+     off64_t offset,
+     int *entry_index,
+     libcerror_error_t **error )
+{
+	off64_t *block_offsets  = NULL;
+	uint32_t *block_numbers = NULL;
+	static char *function   = "libvshadow_block_index_get_index_by_offset";
+	off64_t block_number    = 0;
+	int base_index          = 0;
+	int half_size           = 0;
+	int search_size         = 0;
+
+	if( block_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block index.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry index.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_index->number_of_blocks == 0 )
+	{
+		*entry_index = 0;
+
+		return( 1 );
+	}
+	search_size = block_index->number_of_blocks;
+
+	/* The search narrows the range without a data dependent branch, which allows
+	 * the compiler to use a conditional move and keeps the loop count fixed
+	 */
+	if( block_index->block_numbers != NULL )
+	{
+		/* A block ends at or before the offset if its block number is less than
+		 * the block number that contains the offset
+		 */
+		block_numbers = block_index->block_numbers;
+		block_number  = offset / 0x4000;
+
+		while( search_size > 1 )
+		{
+			half_size = search_size / 2;
+
+			base_index  += ( (off64_t) block_numbers[ base_index + half_size ] < block_number ) ? half_size : 0;
+			search_size -= half_size;
+		}
+		base_index += ( (off64_t) block_numbers[ base_index ] < block_number ) ? 1 : 0;
+	}
+	else
+	{
+		block_offsets = block_index->block_offsets;
+
+		while( search_size > 1 )
+		{
+			half_size = search_size / 2;
+
+			base_index  += ( ( block_offsets[ base_index + half_size ] + 0x4000 ) <= offset ) ? half_size : 0;
+			search_size -= half_size;
+		}
+		base_index += ( ( block_offsets[ base_index ] + 0x4000 ) <= offset ) ? 1 : 0;
+	}
+	*entry_index = base_index;
+
+	return( 1 );
+}
+
+/* Retrieves the (key) offset of a specific block
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_block_index_get_offset_by_index(
+     libvshadow_block_index_t *block_index,
+     int entry_index,
+     off64_t *offset,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_block_index_get_offset_by_index";
+
+	if( block_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block index.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( entry_index < 0 )
+	 || ( entry_index >= block_index->number_of_blocks ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid entry index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_index->block_numbers != NULL )
+	{
+		*offset = (off64_t) block_index->block_numbers[ entry_index ] * 0x4000;
+	}
+	else
+	{
+		*offset = block_index->block_offsets[ entry_index ];
+	}
+	return( 1 );
+}
+
+/* Searches block descriptors sorted by index for a specific index
+ * Returns 1 if successful, 0 if no such block descriptor or -1 on error
+ */
+int libvshadow_block_index_search_block_descriptors(
+     libvshadow_block_descriptor_t *block_descriptors,
+     int number_of_block_descriptors,
+     int entry_index,
+     libvshadow_block_descriptor_t **block_descriptor,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_block_index_search_block_descriptors";
+	int lower_index       = 0;
+	int middle_index      = 0;
+	int upper_index       = 0;
+
+	if( block_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( block_descriptors == NULL )
+	 && ( number_of_block_descriptors > 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block descriptors.",
+		 function );
+
+		return( -1 );
+	}
+	upper_index = number_of_block_descriptors;
+
+	while( lower_index < upper_index )
+	{
+		middle_index = lower_index + ( ( upper_index - lower_index ) / 2 );
+
+		if( block_descriptors[ middle_index ].index < entry_index )
+		{
+			lower_index = middle_index + 1;
+		}
+		else if( block_descriptors[ middle_index ].index > entry_index )
+		{
+			upper_index = middle_index;
+		}
+		else
+		{
+			*block_descriptor = &( block_descriptors[ middle_index ] );
+
+			return( 1 );
+		}
+	}
+	return( 0 );
+}
+
+/* Retrieves a specific block descriptor
+ * The block descriptor is unpacked into the value block_descriptor is pointing to,
+ * its overlay references the overlay block descriptor stored in the block index
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_block_index_get_block_descriptor_by_index(
+     libvshadow_block_index_t *block_index,
+     int entry_index,
+     libvshadow_block_descriptor_t *block_descriptor,
+     libcerror_error_t **error )
+{
+	libvshadow_packed_block_descriptor_t *packed_block_descriptor = NULL;
+	libvshadow_block_descriptor_t *side_block_descriptor          = NULL;
+	static char *function                                         = "libvshadow_block_index_get_block_descriptor_by_index";
+	int result                                                    = 0;
+
+	if( block_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block index.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_index->packed_block_descriptors == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid block index - missing packed block descriptors.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( entry_index < 0 )
+	 || ( entry_index >= block_index->number_of_blocks ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid entry index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	packed_block_descriptor = &( block_index->packed_block_descriptors[ entry_index ] );
+
+	if( ( packed_block_descriptor->flags & LIBVSHADOW_PACKED_BLOCK_FLAG_IS_EXTENDED ) != 0 )
+	{
+		result = libvshadow_block_index_search_block_descriptors(
+		          block_index->extended_block_descriptors,
+		          block_index->number_of_extended_block_descriptors,
+		          entry_index,
+		          &side_block_descriptor,
+		          error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve extended block descriptor: %d.",
+			 function,
+			 entry_index );
+
+			return( -1 );
+		}
+		if( memory_copy(
+		     block_descriptor,
+		     side_block_descriptor,
+		     sizeof( libvshadow_block_descriptor_t ) ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy extended block descriptor: %d.",
+			 function,
+			 entry_index );
+
+			return( -1 );
+		}
+	}
+	else if( libvshadow_block_descriptor_unpack(
+	          block_descriptor,
+	          packed_block_descriptor,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to unpack block descriptor: %d.",
+		 function,
+		 entry_index );
+
+		return( -1 );
+	}
+	block_descriptor->index         = entry_index;
+	block_descriptor->reverse_index = -1;
+	block_descriptor->overlay       = NULL;
+
+	if( ( packed_block_descriptor->flags & LIBVSHADOW_PACKED_BLOCK_FLAG_HAS_OVERLAY ) != 0 )
+	{
+		result = libvshadow_block_index_search_block_descriptors(
+		          block_index->overlay_block_descriptors,
+		          block_index->number_of_overlay_block_descriptors,
+		          entry_index,
+		          &( block_descriptor->overlay ),
+		          error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve overlay block descriptor: %d.",
+			 function,
+			 entry_index );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Retrieves the size of the memory used by the block index
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_block_index_get_memory_size(
+     libvshadow_block_index_t *block_index,
+     size64_t *memory_size,
+     libcerror_error_t **error )
+{
+	static char *function                    = "libvshadow_block_index_get_memory_size";
+	size64_t safe_memory_size                = 0;
+	int number_of_blocks                     = 0;
+	int number_of_extended_block_descriptors = 0;
+
+	if( block_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block index.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid memory size.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_blocks                     = block_index->number_of_blocks;
+	number_of_extended_block_descriptors = block_index->number_of_extended_block_descriptors;
+
+	/* Appended block descriptors are stored in arrays that can be larger than needed
+	 */
+	if( block_index->number_of_allocated_blocks > number_of_blocks )
+	{
+		number_of_blocks = block_index->number_of_allocated_blocks;
+	}
+	if( block_index->number_of_allocated_extended_block_descriptors > number_of_extended_block_descriptors )
+	{
+		number_of_extended_block_descriptors = block_index->number_of_allocated_extended_block_descriptors;
+	}
+	safe_memory_size = sizeof( libvshadow_block_index_t );
+
+	if( block_index->block_numbers != NULL )
+	{
+		safe_memory_size += (size64_t) block_index->number_of_blocks * sizeof( uint32_t );
+	}
+	if( block_index->block_offsets != NULL )
+	{
+		safe_memory_size += (size64_t) block_index->number_of_blocks * sizeof( off64_t );
+	}
+	if( block_index->packed_block_descriptors != NULL )
+	{
+		safe_memory_size += (size64_t) number_of_blocks * sizeof( libvshadow_packed_block_descriptor_t );
+	}
+	safe_memory_size += (size64_t) number_of_extended_block_descriptors * sizeof( libvshadow_block_descriptor_t );
+	safe_memory_size += (size64_t) block_index->number_of_overlay_block_descriptors * sizeof( libvshadow_block_descriptor_t );
+
+	*memory_size = safe_memory_size;
+
+	return( 1 );
+}
+
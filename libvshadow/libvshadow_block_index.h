@@ -0,0 +1,154 @@
+/*
+ * Block index functions
+ *
+ * Copyright (C) 2011-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVSHADOW_BLOCK_INDEX_H )
+#define _LIBVSHADOW_BLOCK_INDEX_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvshadow_block_descriptor.h"
+#include "libvshadow_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libvshadow_block_index libvshadow_block_index_t;
+
+struct libvshadow_block_index
+{
+	/* The block numbers
+	 * Contains the sorted (lookup) keys of the blocks in units of 16 KiB
+	 */
+	uint32_t *block_numbers;
+
+	/* The block offsets
+	 * Contains the sorted (lookup) keys of the blocks, only used if one of the keys cannot be stored as a block number
+	 */
+	off64_t *block_offsets;
+
+	/* The packed block descriptors
+	 * Contains the block descriptors in the same order as the keys
+	 */
+	libvshadow_packed_block_descriptor_t *packed_block_descriptors;
+
+	/* The extended block descriptors
+	 * Contains the block descriptors that cannot be packed, sorted by index
+	 */
+	libvshadow_block_descriptor_t *extended_block_descriptors;
+
+	/* The number of extended block descriptors
+	 */
+	int number_of_extended_block_descriptors;
+
+	/* The overlay block descriptors
+	 * Contains the overlay block descriptors, sorted by the index of the block descriptor they overlay
+	 */
+	libvshadow_block_descriptor_t *overlay_block_descriptors;
+
+	/* The number of overlay block descriptors
+	 */
+	int number_of_overlay_block_descriptors;
+
+	/* The number of blocks
+	 */
+	int number_of_blocks;
+
+	/* The number of allocated blocks
+	 * Only used if the block descriptors are appended
+	 */
+	int number_of_allocated_blocks;
+
+	/* The number of allocated extended block descriptors
+	 * Only used if the block descriptors are appended
+	 */
+	int number_of_allocated_extended_block_descriptors;
+};
+
+int libvshadow_block_index_initialize(
+     libvshadow_block_index_t **block_index,
+     libcerror_error_t **error );
+
+int libvshadow_block_index_free(
+     libvshadow_block_index_t **block_index,
+     libcerror_error_t **error );
+
+int libvshadow_block_index_set_keys(
+     libvshadow_block_index_t *block_index,
+     libvshadow_block_descriptor_t **block_descriptors_array,
+     int number_of_block_descriptors,
+     uint8_t use_relative_offset,
+     libcerror_error_t **error );
+
+int libvshadow_block_index_set_forward_block_descriptors(
+     libvshadow_block_index_t *block_index,
+     libvshadow_block_descriptor_t **block_descriptors_array,
+     int number_of_block_descriptors,
+     libcerror_error_t **error );
+
+int libvshadow_block_index_set_reverse_block_descriptors(
+     libvshadow_block_index_t *block_index,
+     libvshadow_block_descriptor_t **block_descriptors_array,
+     int number_of_block_descriptors,
+     libcerror_error_t **error );
+
+int libvshadow_block_index_append_block_descriptor(
+     libvshadow_block_index_t *block_index,
+     libvshadow_block_descriptor_t *block_descriptor,
+     libcerror_error_t **error );
+
+int libvshadow_block_index_get_index_by_offset(
+     libvshadow_block_index_t *block_index,
+     off64_t offset,
+     int *entry_index,
+     libcerror_error_t **error );
+
+int libvshadow_block_index_get_offset_by_index(
+     libvshadow_block_index_t *block_index,
+     int entry_index,
+     off64_t *offset,
+     libcerror_error_t **error );
+
+int libvshadow_block_index_search_block_descriptors(
+     libvshadow_block_descriptor_t *block_descriptors,
+     int number_of_block_descriptors,
+     int entry_index,
+     libvshadow_block_descriptor_t **block_descriptor,
+     libcerror_error_t **error );
+
+int libvshadow_block_index_get_block_descriptor_by_index(
+     libvshadow_block_index_t *block_index,
+     int entry_index,
+     libvshadow_block_descriptor_t *block_descriptor,
+     libcerror_error_t **error );
+
+int libvshadow_block_index_get_memory_size(
+     libvshadow_block_index_t *block_index,
+     size64_t *memory_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVSHADOW_BLOCK_INDEX_H ) */
+
@@ -20,9 +20,15 @@
  */
 
 #include <common.h>
+#include <memory.h>
 #include <types.h>
 
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
 #include "libvshadow_block_descriptor.h"
+#include "libvshadow_block_descriptor_arena.h"
 #include "libvshadow_definitions.h"
 #include "libvshadow_libcdata.h"
 #include "libvshadow_libcerror.h"
@@ -30,11 +36,13 @@
 #include "libvshadow_unused.h"
 
 /* Inserts a block descriptor in the block tree
+ * The block descriptor is cloned into the block descriptor arena, which owns the block descriptors in the trees
  * Returns 1 if successful or -1 on error
  */
 int libvshadow_block_tree_insert(
      libcdata_btree_t *forward_block_tree,
      libcdata_btree_t *reverse_block_tree,
+     libvshadow_block_descriptor_arena_t *block_descriptor_arena,
      libvshadow_block_descriptor_t *block_descriptor,
      int store_index LIBVSHADOW_ATTRIBUTE_UNUSED,
      libcerror_error_t **error )
@@ -72,6 +80,17 @@ int libvshadow_block_tree_insert(
 
 		return( -1 );
 	}
+	if( block_descriptor_arena == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block descriptor arena.",
+		 function );
+
+		return( -1 );
+	}
 	if( block_descriptor == NULL )
 	{
 		libcerror_error_set(
@@ -98,7 +117,8 @@ int libvshadow_block_tree_insert(
 #endif
 		return( 1 );
 	}
-	if( libvshadow_block_descriptor_clone(
+	if( libvshadow_block_descriptor_arena_clone(
+	     block_descriptor_arena,
 	     &new_block_descriptor,
 	     block_descriptor,
 	     error ) != 1 )
@@ -182,22 +202,6 @@ int libvshadow_block_tree_insert(
 
 				goto on_error;
 			}
-			if( reverse_block_descriptor->index == -1 )
-			{
-				if( libvshadow_block_descriptor_free(
-				     &reverse_block_descriptor,
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-					 "%s: unable to free reverse block descriptor.",
-					 function );
-
-					goto on_error;
-				}
-			}
 		}
 	}
 	if( ( new_block_descriptor->flags & LIBVSHADOW_BLOCK_FLAG_IS_FORWARDER ) != 0 )
@@ -215,19 +219,6 @@ int libvshadow_block_tree_insert(
 				 "\n" );
 			}
 #endif
-			if( libvshadow_block_descriptor_free(
-			     &new_block_descriptor,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-				 "%s: unable to free block descriptor.",
-				 function );
-
-				goto on_error;
-			}
 			return( 1 );
 		}
 	}
@@ -310,20 +301,6 @@ int libvshadow_block_tree_insert(
 				}
 #endif
 				overlay_block_descriptor->bitmap |= new_block_descriptor->bitmap;
-
-				if( libvshadow_block_descriptor_free(
-				     &new_block_descriptor,
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-					 "%s: unable to free block descriptor.",
-					 function );
-
-					goto on_error;
-				}
 			}
 			else
 			{
@@ -422,23 +399,6 @@ int libvshadow_block_tree_insert(
 			 */
 			new_block_descriptor->overlay      = existing_block_descriptor->overlay;
 			existing_block_descriptor->overlay = NULL;
-
-			if( existing_block_descriptor->reverse_index == -1 )
-			{
-				if( libvshadow_block_descriptor_free(
-				     &existing_block_descriptor,
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-					 "%s: unable to free existing block descriptor.",
-					 function );
-
-					goto on_error;
-				}
-			}
 		}
 	}
 #if defined( HAVE_DEBUG_OUTPUT )
@@ -470,8 +430,6 @@ int libvshadow_block_tree_insert(
 			 "%s: unable to insert block descriptor in reverse block tree.",
 			 function );
 
-			new_block_descriptor = NULL;
-
 			goto on_error;
 		}
 		else if( result == 0 )
@@ -485,8 +443,6 @@ int libvshadow_block_tree_insert(
 				 "%s: missing reverse block descriptor.",
 				 function );
 
-				new_block_descriptor = NULL;
-
 				goto on_error;
 			}
 #if defined( HAVE_DEBUG_OUTPUT )
@@ -516,26 +472,8 @@ int libvshadow_block_tree_insert(
 				 function,
 				 reverse_block_descriptor->reverse_index );
 
-				new_block_descriptor = NULL;
-
 				goto on_error;
 			}
-			if( reverse_block_descriptor->index == -1 )
-			{
-				if( libvshadow_block_descriptor_free(
-				     &reverse_block_descriptor,
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-					 "%s: unable to free reverse block descriptor.",
-					 function );
-
-					goto on_error;
-				}
-			}
 		}
 #if defined( HAVE_DEBUG_OUTPUT )
 		else if( libcnotify_verbose != 0 )
@@ -557,11 +495,172 @@ int libvshadow_block_tree_insert(
 	return( 1 );
 
 on_error:
-	if( new_block_descriptor != NULL )
+	return( -1 );
+}
+
+/* Retrieves the block descriptors in the block tree as a sorted array
+ * The array contains references to the block descriptors, which remain owned by the block tree
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_block_tree_get_sorted_block_descriptors(
+     libcdata_btree_t *block_tree,
+     int (*compare_function)(
+            const void *first_block_descriptor_reference,
+            const void *second_block_descriptor_reference ),
+     libvshadow_block_descriptor_t ***block_descriptors_array,
+     int *number_of_block_descriptors,
+     libcerror_error_t **error )
+{
+	libvshadow_block_descriptor_t **safe_block_descriptors_array = NULL;
+	libvshadow_block_descriptor_t *block_descriptor              = NULL;
+	static char *function                                        = "libvshadow_block_tree_get_sorted_block_descriptors";
+	int number_of_values                                         = 0;
+	int safe_number_of_block_descriptors                         = 0;
+	int value_index                                              = 0;
+
+	if( block_tree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block tree.",
+		 function );
+
+		return( -1 );
+	}
+	if( compare_function == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compare function.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_descriptors_array == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block descriptors array.",
+		 function );
+
+		return( -1 );
+	}
+	if( *block_descriptors_array != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid block descriptors array value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_block_descriptors == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of block descriptors.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_btree_get_number_of_values(
+	     block_tree,
+	     &number_of_values,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of values from block tree.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( number_of_values < 0 )
+	 || ( (size_t) number_of_values > ( (size_t) SSIZE_MAX / sizeof( libvshadow_block_descriptor_t * ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of values value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	if( number_of_values > 0 )
+	{
+		safe_block_descriptors_array = (libvshadow_block_descriptor_t **) memory_allocate(
+		                                                                   sizeof( libvshadow_block_descriptor_t * ) * number_of_values );
+
+		if( safe_block_descriptors_array == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create block descriptors array.",
+			 function );
+
+			goto on_error;
+		}
+		for( value_index = 0;
+		     value_index < number_of_values;
+		     value_index++ )
+		{
+			if( libcdata_btree_get_value_by_index(
+			     block_tree,
+			     value_index,
+			     (intptr_t **) &block_descriptor,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve value: %d from block tree.",
+				 function,
+				 value_index );
+
+				goto on_error;
+			}
+			/* Values that were removed from the tree are stored as NULL
+			 */
+			if( block_descriptor != NULL )
+			{
+				safe_block_descriptors_array[ safe_number_of_block_descriptors++ ] = block_descriptor;
+			}
+		}
+		if( safe_number_of_block_descriptors > 1 )
+		{
+			qsort(
+			 safe_block_descriptors_array,
+			 (size_t) safe_number_of_block_descriptors,
+			 sizeof( libvshadow_block_descriptor_t * ),
+			 compare_function );
+		}
+	}
+	*block_descriptors_array     = safe_block_descriptors_array;
+	*number_of_block_descriptors = safe_number_of_block_descriptors;
+
+	return( 1 );
+
+on_error:
+	if( safe_block_descriptors_array != NULL )
 	{
-		libvshadow_block_descriptor_free(
-		 &new_block_descriptor,
-		 NULL );
+		memory_free(
+		 safe_block_descriptors_array );
 	}
 	return( -1 );
 }
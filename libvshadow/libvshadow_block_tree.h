@@ -26,6 +26,7 @@
 #include <types.h>
 
 #include "libvshadow_block_descriptor.h"
+#include "libvshadow_block_descriptor_arena.h"
 #include "libvshadow_libcdata.h"
 #include "libvshadow_libcerror.h"
 
@@ -36,10 +37,20 @@ extern "C" {
 int libvshadow_block_tree_insert(
      libcdata_btree_t *forward_block_tree,
      libcdata_btree_t *reverse_block_tree,
+     libvshadow_block_descriptor_arena_t *block_descriptor_arena,
      libvshadow_block_descriptor_t *block_descriptor,
      int store_index,
      libcerror_error_t **error );
 
+int libvshadow_block_tree_get_sorted_block_descriptors(
+     libcdata_btree_t *block_tree,
+     int (*compare_function)(
+            const void *first_block_descriptor_reference,
+            const void *second_block_descriptor_reference ),
+     libvshadow_block_descriptor_t ***block_descriptors_array,
+     int *number_of_block_descriptors,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
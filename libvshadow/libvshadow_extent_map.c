@@ -0,0 +1,444 @@
+/*
+ * Extent map functions
+ *
+ * Copyright (C) 2011-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libvshadow_definitions.h"
+#include "libvshadow_extent_map.h"
+#include "libvshadow_libcerror.h"
+
+/* Creates an extent map
+ * Make sure the value extent_map is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_extent_map_initialize(
+     libvshadow_extent_map_t **extent_map,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_extent_map_initialize";
+
+	if( extent_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent map.",
+		 function );
+
+		return( -1 );
+	}
+	if( *extent_map != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid extent map value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*extent_map = memory_allocate_structure(
+	               libvshadow_extent_map_t );
+
+	if( *extent_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create extent map.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *extent_map,
+	     0,
+	     sizeof( libvshadow_extent_map_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear extent map.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *extent_map != NULL )
+	{
+		memory_free(
+		 *extent_map );
+
+		*extent_map = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees an extent map
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_extent_map_free(
+     libvshadow_extent_map_t **extent_map,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_extent_map_free";
+
+	if( extent_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent map.",
+		 function );
+
+		return( -1 );
+	}
+	if( *extent_map != NULL )
+	{
+		if( ( *extent_map )->extents != NULL )
+		{
+			memory_free(
+			 ( *extent_map )->extents );
+		}
+		memory_free(
+		 *extent_map );
+
+		*extent_map = NULL;
+	}
+	return( 1 );
+}
+
+/* Appends an extent to the end of the extent map
+ * The extent is merged with the last extent if the data of both is contiguous
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_extent_map_append_extent(
+     libvshadow_extent_map_t *extent_map,
+     size64_t size,
+     off64_t data_offset,
+     uint8_t type,
+     libcerror_error_t **error )
+{
+	libvshadow_extent_t *extent     = NULL;
+	libvshadow_extent_t *extents    = NULL;
+	static char *function           = "libvshadow_extent_map_append_extent";
+	size_t extents_size             = 0;
+	int number_of_allocated_extents = 0;
+
+	if( extent_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent map.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( size == 0 )
+	 || ( size > (size64_t) INT64_MAX )
+	 || ( extent_map->size > ( (size64_t) INT64_MAX - size ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( type != LIBVSHADOW_EXTENT_TYPE_VOLUME_DATA )
+	 && ( type != LIBVSHADOW_EXTENT_TYPE_STORE_DATA )
+	 && ( type != LIBVSHADOW_EXTENT_TYPE_SPARSE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported extent type: 0x%02" PRIx8 ".",
+		 function,
+		 type );
+
+		return( -1 );
+	}
+	if( type == LIBVSHADOW_EXTENT_TYPE_SPARSE )
+	{
+		data_offset = 0;
+	}
+	if( extent_map->number_of_extents > 0 )
+	{
+		extent = &( extent_map->extents[ extent_map->number_of_extents - 1 ] );
+
+		if( ( extent->type == type )
+		 && ( ( type == LIBVSHADOW_EXTENT_TYPE_SPARSE )
+		  ||  ( (size64_t) data_offset == ( (size64_t) extent->data_offset + extent->size ) ) ) )
+		{
+			extent->size     += size;
+			extent_map->size += size;
+
+			return( 1 );
+		}
+	}
+	if( extent_map->number_of_extents >= extent_map->number_of_allocated_extents )
+	{
+		if( extent_map->number_of_allocated_extents == 0 )
+		{
+			number_of_allocated_extents = 256;
+		}
+		else if( extent_map->number_of_allocated_extents < ( INT_MAX / 2 ) )
+		{
+			number_of_allocated_extents = extent_map->number_of_allocated_extents * 2;
+		}
+		else
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid number of allocated extents value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		extents_size = sizeof( libvshadow_extent_t ) * (size_t) number_of_allocated_extents;
+
+		if( extents_size > (size_t) SSIZE_MAX )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid extents size value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		extents = (libvshadow_extent_t *) memory_reallocate(
+		                                   extent_map->extents,
+		                                   extents_size );
+
+		if( extents == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize extents.",
+			 function );
+
+			return( -1 );
+		}
+		extent_map->extents                     = extents;
+		extent_map->number_of_allocated_extents = number_of_allocated_extents;
+	}
+	extent = &( extent_map->extents[ extent_map->number_of_extents ] );
+
+	extent->offset      = (off64_t) extent_map->size;
+	extent->size        = size;
+	extent->data_offset = data_offset;
+	extent->type        = type;
+
+	extent_map->number_of_extents += 1;
+	extent_map->size              += size;
+
+	return( 1 );
+}
+
+/* Retrieves the number of extents
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_extent_map_get_number_of_extents(
+     libvshadow_extent_map_t *extent_map,
+     int *number_of_extents,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_extent_map_get_number_of_extents";
+
+	if( extent_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent map.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_extents == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of extents.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_extents = extent_map->number_of_extents;
+
+	return( 1 );
+}
+
+/* Retrieves a specific extent
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_extent_map_get_extent_by_index(
+     libvshadow_extent_map_t *extent_map,
+     int extent_index,
+     libvshadow_extent_t **extent,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_extent_map_get_extent_by_index";
+
+	if( extent_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent map.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( extent_index < 0 )
+	 || ( extent_index >= extent_map->number_of_extents ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid extent index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent.",
+		 function );
+
+		return( -1 );
+	}
+	*extent = &( extent_map->extents[ extent_index ] );
+
+	return( 1 );
+}
+
+/* Retrieves the index of the extent that contains a specific offset
+ * Returns 1 if successful, 0 if no such extent or -1 on error
+ */
+int libvshadow_extent_map_get_extent_index_at_offset(
+     libvshadow_extent_map_t *extent_map,
+     off64_t offset,
+     int *extent_index,
+     libcerror_error_t **error )
+{
+	libvshadow_extent_t *extent = NULL;
+	static char *function       = "libvshadow_extent_map_get_extent_index_at_offset";
+	int lower_index             = 0;
+	int middle_index            = 0;
+	int upper_index             = 0;
+
+	if( extent_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent map.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent index.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( offset < 0 )
+	 || ( (size64_t) offset >= extent_map->size ) )
+	{
+		return( 0 );
+	}
+	/* The extents are contiguous and sorted by offset
+	 */
+	upper_index = extent_map->number_of_extents - 1;
+
+	while( lower_index < upper_index )
+	{
+		middle_index = lower_index + ( ( upper_index - lower_index + 1 ) / 2 );
+
+		if( extent_map->extents[ middle_index ].offset <= offset )
+		{
+			lower_index = middle_index;
+		}
+		else
+		{
+			upper_index = middle_index - 1;
+		}
+	}
+	extent = &( extent_map->extents[ lower_index ] );
+
+	if( ( offset < extent->offset )
+	 || ( (size64_t) offset >= ( (size64_t) extent->offset + extent->size ) ) )
+	{
+		return( 0 );
+	}
+	*extent_index = lower_index;
+
+	return( 1 );
+}
+
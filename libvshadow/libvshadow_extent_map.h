@@ -0,0 +1,114 @@
+/*
+ * Extent map functions
+ *
+ * Copyright (C) 2011-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVSHADOW_EXTENT_MAP_H )
+#define _LIBVSHADOW_EXTENT_MAP_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvshadow_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libvshadow_extent libvshadow_extent_t;
+
+struct libvshadow_extent
+{
+	/* The (store) offset
+	 */
+	off64_t offset;
+
+	/* The size
+	 */
+	size64_t size;
+
+	/* The data offset
+	 * Contains the offset of the data relative to the start of the volume
+	 */
+	off64_t data_offset;
+
+	/* The extent type
+	 */
+	uint8_t type;
+};
+
+typedef struct libvshadow_extent_map libvshadow_extent_map_t;
+
+struct libvshadow_extent_map
+{
+	/* The extents
+	 */
+	libvshadow_extent_t *extents;
+
+	/* The number of extents
+	 */
+	int number_of_extents;
+
+	/* The number of allocated extents
+	 */
+	int number_of_allocated_extents;
+
+	/* The mapped size
+	 */
+	size64_t size;
+};
+
+int libvshadow_extent_map_initialize(
+     libvshadow_extent_map_t **extent_map,
+     libcerror_error_t **error );
+
+int libvshadow_extent_map_free(
+     libvshadow_extent_map_t **extent_map,
+     libcerror_error_t **error );
+
+int libvshadow_extent_map_append_extent(
+     libvshadow_extent_map_t *extent_map,
+     size64_t size,
+     off64_t data_offset,
+     uint8_t type,
+     libcerror_error_t **error );
+
+int libvshadow_extent_map_get_number_of_extents(
+     libvshadow_extent_map_t *extent_map,
+     int *number_of_extents,
+     libcerror_error_t **error );
+
+int libvshadow_extent_map_get_extent_by_index(
+     libvshadow_extent_map_t *extent_map,
+     int extent_index,
+     libvshadow_extent_t **extent,
+     libcerror_error_t **error );
+
+int libvshadow_extent_map_get_extent_index_at_offset(
+     libvshadow_extent_map_t *extent_map,
+     off64_t offset,
+     int *extent_index,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVSHADOW_EXTENT_MAP_H ) */
+
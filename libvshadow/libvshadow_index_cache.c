@@ -0,0 +1,2008 @@
+/*
+ * Index cache functions
+ *
+ * Copyright (C) 2011-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libvshadow_bitmap.h"
+#include "libvshadow_block_descriptor.h"
+#include "libvshadow_block_descriptor_arena.h"
+#include "libvshadow_block_index.h"
+#include "libvshadow_index_cache.h"
+#include "libvshadow_libbfio.h"
+#include "libvshadow_libcdata.h"
+#include "libvshadow_libcerror.h"
+#include "libvshadow_libcnotify.h"
+#include "libvshadow_libcthreads.h"
+#include "libvshadow_store_descriptor.h"
+
+#include "vshadow_index_cache.h"
+
+const uint8_t vshadow_index_cache_signature[ 8 ] = {
+	'v', 's', 'h', 'i', 'd', 'x', 'c', 0 };
+
+/* Retrieves the size of the index cache data of a store
+ * The block descriptors of the store must have been read
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_index_cache_get_store_data_size(
+     libvshadow_store_descriptor_t *store_descriptor,
+     size_t *data_size,
+     libcerror_error_t **error )
+{
+	static char *function    = "libvshadow_index_cache_get_store_data_size";
+	size64_t store_data_size = 0;
+
+	if( store_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( store_descriptor->block_descriptors_read == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid store descriptor - block descriptors have not been read.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( store_descriptor->bitmap == NULL )
+	 || ( store_descriptor->previous_bitmap == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid store descriptor - missing bitmaps.",
+		 function );
+
+		return( -1 );
+	}
+	if( store_descriptor->block_list_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid store descriptor - missing block list index.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( store_descriptor->bitmap->data_size > (size_t) UINT32_MAX )
+	 || ( store_descriptor->previous_bitmap->data_size > (size_t) UINT32_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid store descriptor - bitmap data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data size.",
+		 function );
+
+		return( -1 );
+	}
+	store_data_size = sizeof( vshadow_index_cache_store_header_t );
+
+	if( store_descriptor->forward_block_index != NULL )
+	{
+		store_data_size += (size64_t) store_descriptor->forward_block_index->number_of_blocks * sizeof( vshadow_index_cache_block_descriptor_t );
+		store_data_size += (size64_t) store_descriptor->forward_block_index->number_of_overlay_block_descriptors * sizeof( vshadow_index_cache_overlay_block_descriptor_t );
+	}
+	if( store_descriptor->reverse_block_index != NULL )
+	{
+		store_data_size += (size64_t) store_descriptor->reverse_block_index->number_of_blocks * 8;
+	}
+	store_data_size += (size64_t) store_descriptor->block_list_index->number_of_blocks * sizeof( vshadow_index_cache_block_descriptor_t );
+
+	/* The bitmaps are padded to a multitude of 8 bytes
+	 */
+	store_data_size += ( (size64_t) store_descriptor->bitmap->data_size + 7 ) & ~( (size64_t) 7 );
+	store_data_size += ( (size64_t) store_descriptor->previous_bitmap->data_size + 7 ) & ~( (size64_t) 7 );
+
+	if( store_data_size > (size64_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid store data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	*data_size = (size_t) store_data_size;
+
+	return( 1 );
+}
+
+/* Writes the index cache data of a store
+ * The block descriptors of the store must have been read
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_index_cache_write_store_data(
+     libvshadow_store_descriptor_t *store_descriptor,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	libvshadow_block_descriptor_t block_descriptor_value;
+
+	libvshadow_block_descriptor_t *block_descriptor     = NULL;
+	vshadow_index_cache_block_descriptor_t *block_data  = NULL;
+	vshadow_index_cache_store_header_t *store_header    = NULL;
+	static char *function                               = "libvshadow_index_cache_write_store_data";
+	size_t bitmap_data_size                             = 0;
+	size_t data_offset                                  = 0;
+	size_t store_data_size                              = 0;
+	off64_t relative_offset                             = 0;
+	int block_descriptor_index                          = 0;
+	int number_of_forward_block_descriptors             = 0;
+	int number_of_overlay_block_descriptors             = 0;
+	int number_of_reverse_block_descriptors             = 0;
+
+	if( libvshadow_index_cache_get_store_data_size(
+	     store_descriptor,
+	     &store_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve store data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size < store_data_size )
+	 || ( data_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     data,
+	     0,
+	     store_data_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear data.",
+		 function );
+
+		return( -1 );
+	}
+	if( store_descriptor->forward_block_index != NULL )
+	{
+		number_of_forward_block_descriptors = store_descriptor->forward_block_index->number_of_blocks;
+		number_of_overlay_block_descriptors = store_descriptor->forward_block_index->number_of_overlay_block_descriptors;
+	}
+	if( store_descriptor->reverse_block_index != NULL )
+	{
+		number_of_reverse_block_descriptors = store_descriptor->reverse_block_index->number_of_blocks;
+	}
+	store_header = (vshadow_index_cache_store_header_t *) data;
+
+	if( memory_copy(
+	     store_header->identifier,
+	     store_descriptor->identifier,
+	     16 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy identifier.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint64_little_endian(
+	 store_header->creation_time,
+	 store_descriptor->creation_time );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 store_header->store_block_list_offset,
+	 store_descriptor->store_block_list_offset );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 store_header->store_block_range_list_offset,
+	 store_descriptor->store_block_range_list_offset );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 store_header->store_bitmap_offset,
+	 store_descriptor->store_bitmap_offset );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 store_header->store_previous_bitmap_offset,
+	 store_descriptor->store_previous_bitmap_offset );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 store_header->number_of_forward_block_descriptors,
+	 number_of_forward_block_descriptors );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 store_header->number_of_overlay_block_descriptors,
+	 number_of_overlay_block_descriptors );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 store_header->number_of_reverse_block_descriptors,
+	 number_of_reverse_block_descriptors );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 store_header->bitmap_size,
+	 store_descriptor->bitmap->data_size );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 store_header->previous_bitmap_size,
+	 store_descriptor->previous_bitmap->data_size );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 store_header->number_of_block_descriptors,
+	 store_descriptor->block_list_index->number_of_blocks );
+
+	data_offset = sizeof( vshadow_index_cache_store_header_t );
+
+	for( block_descriptor_index = 0;
+	     block_descriptor_index < number_of_forward_block_descriptors;
+	     block_descriptor_index++ )
+	{
+		if( libvshadow_block_index_get_block_descriptor_by_index(
+		     store_descriptor->forward_block_index,
+		     block_descriptor_index,
+		     &block_descriptor_value,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve forward block descriptor: %d.",
+			 function,
+			 block_descriptor_index );
+
+			return( -1 );
+		}
+		block_descriptor = &block_descriptor_value;
+		block_data       = (vshadow_index_cache_block_descriptor_t *) &( data[ data_offset ] );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 block_data->original_offset,
+		 block_descriptor->original_offset );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 block_data->offset,
+		 block_descriptor->offset );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 block_data->relative_offset,
+		 block_descriptor->relative_offset );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 block_data->flags,
+		 block_descriptor->flags );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 block_data->bitmap,
+		 block_descriptor->bitmap );
+
+		data_offset += sizeof( vshadow_index_cache_block_descriptor_t );
+	}
+	/* The overlay block descriptors are stored sorted by the index of the forward block descriptor
+	 */
+	for( block_descriptor_index = 0;
+	     block_descriptor_index < number_of_overlay_block_descriptors;
+	     block_descriptor_index++ )
+	{
+		block_descriptor = &( store_descriptor->forward_block_index->overlay_block_descriptors[ block_descriptor_index ] );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 ( (vshadow_index_cache_overlay_block_descriptor_t *) &( data[ data_offset ] ) )->block_index,
+		 block_descriptor->index );
+
+		block_data = &( ( (vshadow_index_cache_overlay_block_descriptor_t *) &( data[ data_offset ] ) )->block_descriptor );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 block_data->original_offset,
+		 block_descriptor->original_offset );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 block_data->offset,
+		 block_descriptor->offset );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 block_data->relative_offset,
+		 block_descriptor->relative_offset );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 block_data->flags,
+		 block_descriptor->flags );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 block_data->bitmap,
+		 block_descriptor->bitmap );
+
+		data_offset += sizeof( vshadow_index_cache_overlay_block_descriptor_t );
+	}
+	for( block_descriptor_index = 0;
+	     block_descriptor_index < number_of_reverse_block_descriptors;
+	     block_descriptor_index++ )
+	{
+		if( libvshadow_block_index_get_offset_by_index(
+		     store_descriptor->reverse_block_index,
+		     block_descriptor_index,
+		     &relative_offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve reverse block descriptor: %d offset.",
+			 function,
+			 block_descriptor_index );
+
+			return( -1 );
+		}
+		byte_stream_copy_from_uint64_little_endian(
+		 &( data[ data_offset ] ),
+		 relative_offset );
+
+		data_offset += 8;
+	}
+	for( block_descriptor_index = 0;
+	     block_descriptor_index < store_descriptor->block_list_index->number_of_blocks;
+	     block_descriptor_index++ )
+	{
+		if( libvshadow_block_index_get_block_descriptor_by_index(
+		     store_descriptor->block_list_index,
+		     block_descriptor_index,
+		     &block_descriptor_value,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve block descriptor: %d from block list index.",
+			 function,
+			 block_descriptor_index );
+
+			return( -1 );
+		}
+		block_descriptor = &block_descriptor_value;
+		block_data       = (vshadow_index_cache_block_descriptor_t *) &( data[ data_offset ] );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 block_data->original_offset,
+		 block_descriptor->original_offset );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 block_data->offset,
+		 block_descriptor->offset );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 block_data->relative_offset,
+		 block_descriptor->relative_offset );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 block_data->flags,
+		 block_descriptor->flags );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 block_data->bitmap,
+		 block_descriptor->bitmap );
+
+		data_offset += sizeof( vshadow_index_cache_block_descriptor_t );
+	}
+	bitmap_data_size = store_descriptor->bitmap->data_size;
+
+	if( bitmap_data_size > 0 )
+	{
+		if( memory_copy(
+		     &( data[ data_offset ] ),
+		     store_descriptor->bitmap->data,
+		     bitmap_data_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy bitmap data.",
+			 function );
+
+			return( -1 );
+		}
+		data_offset += ( bitmap_data_size + 7 ) & ~( (size_t) 7 );
+	}
+	bitmap_data_size = store_descriptor->previous_bitmap->data_size;
+
+	if( bitmap_data_size > 0 )
+	{
+		if( memory_copy(
+		     &( data[ data_offset ] ),
+		     store_descriptor->previous_bitmap->data,
+		     bitmap_data_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy previous bitmap data.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Checks if the index cache data of a store matches the store descriptor
+ * Returns 1 if the data matches, 0 if not or -1 on error
+ */
+int libvshadow_index_cache_check_store_data(
+     libvshadow_store_descriptor_t *store_descriptor,
+     const uint8_t *data,
+     size_t data_size,
+     size_t *store_data_size,
+     libcerror_error_t **error )
+{
+	vshadow_index_cache_overlay_block_descriptor_t *overlay_data = NULL;
+	vshadow_index_cache_block_descriptor_t *block_data           = NULL;
+	vshadow_index_cache_store_header_t *store_header             = NULL;
+	static char *function                                        = "libvshadow_index_cache_check_store_data";
+	size64_t required_data_size                                  = 0;
+	size_t data_offset                                           = 0;
+	size_t forward_data_offset                                   = 0;
+	uint64_t creation_time                                       = 0;
+	uint64_t forward_original_offset                             = 0;
+	uint64_t original_offset                                     = 0;
+	uint64_t store_bitmap_offset                                 = 0;
+	uint64_t store_block_list_offset                             = 0;
+	uint64_t store_block_range_list_offset                       = 0;
+	uint64_t store_previous_bitmap_offset                        = 0;
+	uint32_t bitmap_size                                         = 0;
+	uint32_t block_index                                         = 0;
+	uint32_t number_of_block_descriptors                         = 0;
+	uint32_t number_of_forward_block_descriptors                 = 0;
+	uint32_t number_of_overlay_block_descriptors                 = 0;
+	uint32_t number_of_reverse_block_descriptors                 = 0;
+	uint32_t overlay_block_descriptor_index                      = 0;
+	uint32_t previous_bitmap_size                                = 0;
+	int64_t previous_block_index                                 = -1;
+
+	if( store_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size < sizeof( vshadow_index_cache_store_header_t ) )
+	 || ( data_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( store_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store data size.",
+		 function );
+
+		return( -1 );
+	}
+	store_header = (vshadow_index_cache_store_header_t *) data;
+
+	byte_stream_copy_to_uint64_little_endian(
+	 store_header->creation_time,
+	 creation_time );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 store_header->store_block_list_offset,
+	 store_block_list_offset );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 store_header->store_block_range_list_offset,
+	 store_block_range_list_offset );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 store_header->store_bitmap_offset,
+	 store_bitmap_offset );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 store_header->store_previous_bitmap_offset,
+	 store_previous_bitmap_offset );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 store_header->number_of_forward_block_descriptors,
+	 number_of_forward_block_descriptors );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 store_header->number_of_overlay_block_descriptors,
+	 number_of_overlay_block_descriptors );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 store_header->number_of_reverse_block_descriptors,
+	 number_of_reverse_block_descriptors );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 store_header->bitmap_size,
+	 bitmap_size );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 store_header->previous_bitmap_size,
+	 previous_bitmap_size );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 store_header->number_of_block_descriptors,
+	 number_of_block_descriptors );
+
+	/* The forward and overlay block descriptors are read into a single array
+	 */
+	if( ( number_of_forward_block_descriptors > (uint32_t) INT_MAX )
+	 || ( number_of_overlay_block_descriptors > number_of_forward_block_descriptors )
+	 || ( number_of_overlay_block_descriptors > ( (uint32_t) INT_MAX - number_of_forward_block_descriptors ) )
+	 || ( number_of_reverse_block_descriptors > (uint32_t) INT_MAX )
+	 || ( number_of_block_descriptors > (uint32_t) INT_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of block descriptors value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	required_data_size = sizeof( vshadow_index_cache_store_header_t )
+	                   + ( (size64_t) number_of_forward_block_descriptors * sizeof( vshadow_index_cache_block_descriptor_t ) )
+	                   + ( (size64_t) number_of_overlay_block_descriptors * sizeof( vshadow_index_cache_overlay_block_descriptor_t ) )
+	                   + ( (size64_t) number_of_reverse_block_descriptors * 8 )
+	                   + ( (size64_t) number_of_block_descriptors * sizeof( vshadow_index_cache_block_descriptor_t ) )
+	                   + ( ( (size64_t) bitmap_size + 7 ) & ~( (size64_t) 7 ) )
+	                   + ( ( (size64_t) previous_bitmap_size + 7 ) & ~( (size64_t) 7 ) );
+
+	if( required_data_size > (size64_t) data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid store data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*store_data_size = (size_t) required_data_size;
+
+	if( memory_compare(
+	     store_header->identifier,
+	     store_descriptor->identifier,
+	     16 ) != 0 )
+	{
+		return( 0 );
+	}
+	if( ( creation_time != store_descriptor->creation_time )
+	 || ( (off64_t) store_block_list_offset != store_descriptor->store_block_list_offset )
+	 || ( (off64_t) store_block_range_list_offset != store_descriptor->store_block_range_list_offset )
+	 || ( (off64_t) store_bitmap_offset != store_descriptor->store_bitmap_offset )
+	 || ( (off64_t) store_previous_bitmap_offset != store_descriptor->store_previous_bitmap_offset ) )
+	{
+		return( 0 );
+	}
+	/* An overlay block descriptor must refer to a forward block descriptor with the same original offset
+	 */
+	data_offset = sizeof( vshadow_index_cache_store_header_t )
+	            + ( (size_t) number_of_forward_block_descriptors * sizeof( vshadow_index_cache_block_descriptor_t ) );
+
+	for( overlay_block_descriptor_index = 0;
+	     overlay_block_descriptor_index < number_of_overlay_block_descriptors;
+	     overlay_block_descriptor_index++ )
+	{
+		overlay_data = (vshadow_index_cache_overlay_block_descriptor_t *) &( data[ data_offset ] );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 overlay_data->block_index,
+		 block_index );
+
+		if( ( (int64_t) block_index <= previous_block_index )
+		 || ( block_index >= number_of_forward_block_descriptors ) )
+		{
+			return( 0 );
+		}
+		previous_block_index = (int64_t) block_index;
+
+		forward_data_offset = sizeof( vshadow_index_cache_store_header_t )
+		                    + ( (size_t) block_index * sizeof( vshadow_index_cache_block_descriptor_t ) );
+
+		block_data = (vshadow_index_cache_block_descriptor_t *) &( data[ forward_data_offset ] );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 block_data->original_offset,
+		 forward_original_offset );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 overlay_data->block_descriptor.original_offset,
+		 original_offset );
+
+		if( original_offset != forward_original_offset )
+		{
+			return( 0 );
+		}
+		data_offset += sizeof( vshadow_index_cache_overlay_block_descriptor_t );
+	}
+	return( 1 );
+}
+
+/* Reads the index cache data of a store
+ * The block indexes and bitmaps are only set when the block descriptors of the store have not been read yet
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_index_cache_read_store_data(
+     libvshadow_store_descriptor_t *store_descriptor,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	libvshadow_block_descriptor_t block_descriptor_value;
+
+	libvshadow_bitmap_t *bitmap                             = NULL;
+	libvshadow_bitmap_t *previous_bitmap                    = NULL;
+	libvshadow_bitmap_t *swap_bitmap                        = NULL;
+	libvshadow_block_descriptor_t **block_descriptors_array = NULL;
+	libvshadow_block_descriptor_t *block_descriptors        = NULL;
+	libvshadow_block_descriptor_t *block_descriptor         = NULL;
+	libvshadow_block_index_t *block_list_index              = NULL;
+	libvshadow_block_index_t *forward_block_index           = NULL;
+	libvshadow_block_index_t *reverse_block_index           = NULL;
+	libvshadow_block_index_t *swap_block_index              = NULL;
+	vshadow_index_cache_block_descriptor_t *block_data      = NULL;
+	vshadow_index_cache_store_header_t *store_header        = NULL;
+	static char *function                                   = "libvshadow_index_cache_read_store_data";
+	size_t data_offset                                      = 0;
+	size_t store_data_size                                  = 0;
+	uint32_t bitmap_size                                    = 0;
+	uint32_t block_index                                    = 0;
+	uint32_t previous_bitmap_size                           = 0;
+	int block_descriptor_index                              = 0;
+	int number_of_block_descriptors                         = 0;
+	int number_of_forward_block_descriptors                 = 0;
+	int number_of_overlay_block_descriptors                 = 0;
+	int number_of_reverse_block_descriptors                 = 0;
+	int number_of_store_block_descriptors                   = 0;
+	int previous_block_index                                = -1;
+	int result                                              = 0;
+
+	result = libvshadow_index_cache_check_store_data(
+	          store_descriptor,
+	          data,
+	          data_size,
+	          &store_data_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to check store data.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: store data does not match store descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	store_header = (vshadow_index_cache_store_header_t *) data;
+
+	byte_stream_copy_to_uint32_little_endian(
+	 store_header->number_of_forward_block_descriptors,
+	 number_of_forward_block_descriptors );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 store_header->number_of_overlay_block_descriptors,
+	 number_of_overlay_block_descriptors );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 store_header->number_of_reverse_block_descriptors,
+	 number_of_reverse_block_descriptors );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 store_header->bitmap_size,
+	 bitmap_size );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 store_header->previous_bitmap_size,
+	 previous_bitmap_size );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 store_header->number_of_block_descriptors,
+	 number_of_store_block_descriptors );
+
+	if( number_of_overlay_block_descriptors > ( INT_MAX - number_of_forward_block_descriptors ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of overlay block descriptors value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	/* The block descriptors contain the forward block descriptors followed by the overlay block descriptors
+	 */
+	number_of_block_descriptors = number_of_forward_block_descriptors + number_of_overlay_block_descriptors;
+
+	if( number_of_reverse_block_descriptors > number_of_block_descriptors )
+	{
+		number_of_block_descriptors = number_of_reverse_block_descriptors;
+	}
+	if( number_of_block_descriptors > 0 )
+	{
+		block_descriptors = (libvshadow_block_descriptor_t *) memory_allocate(
+		                                                       sizeof( libvshadow_block_descriptor_t ) * number_of_block_descriptors );
+
+		if( block_descriptors == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create block descriptors.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_set(
+		     block_descriptors,
+		     0,
+		     sizeof( libvshadow_block_descriptor_t ) * number_of_block_descriptors ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear block descriptors.",
+			 function );
+
+			goto on_error;
+		}
+		block_descriptors_array = (libvshadow_block_descriptor_t **) memory_allocate(
+		                                                              sizeof( libvshadow_block_descriptor_t * ) * number_of_block_descriptors );
+
+		if( block_descriptors_array == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create block descriptors array.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	data_offset = sizeof( vshadow_index_cache_store_header_t );
+
+	for( block_descriptor_index = 0;
+	     block_descriptor_index < number_of_forward_block_descriptors;
+	     block_descriptor_index++ )
+	{
+		block_descriptor = &( block_descriptors[ block_descriptor_index ] );
+		block_data       = (vshadow_index_cache_block_descriptor_t *) &( data[ data_offset ] );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 block_data->original_offset,
+		 block_descriptor->original_offset );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 block_data->offset,
+		 block_descriptor->offset );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 block_data->relative_offset,
+		 block_descriptor->relative_offset );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 block_data->flags,
+		 block_descriptor->flags );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 block_data->bitmap,
+		 block_descriptor->bitmap );
+
+		block_descriptors_array[ block_descriptor_index ] = block_descriptor;
+
+		data_offset += sizeof( vshadow_index_cache_block_descriptor_t );
+	}
+	for( block_descriptor_index = 0;
+	     block_descriptor_index < number_of_overlay_block_descriptors;
+	     block_descriptor_index++ )
+	{
+		byte_stream_copy_to_uint32_little_endian(
+		 ( (vshadow_index_cache_overlay_block_descriptor_t *) &( data[ data_offset ] ) )->block_index,
+		 block_index );
+
+		/* The overlay block descriptors are stored in the order of their forward block descriptor
+		 */
+		if( ( (int) block_index <= previous_block_index )
+		 || ( block_index >= (uint32_t) number_of_forward_block_descriptors ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid overlay block descriptor: %d - block index value out of bounds.",
+			 function,
+			 block_descriptor_index );
+
+			goto on_error;
+		}
+		previous_block_index = (int) block_index;
+
+		block_descriptor = &( block_descriptors[ number_of_forward_block_descriptors + block_descriptor_index ] );
+		block_data       = &( ( (vshadow_index_cache_overlay_block_descriptor_t *) &( data[ data_offset ] ) )->block_descriptor );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 block_data->original_offset,
+		 block_descriptor->original_offset );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 block_data->offset,
+		 block_descriptor->offset );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 block_data->relative_offset,
+		 block_descriptor->relative_offset );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 block_data->flags,
+		 block_descriptor->flags );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 block_data->bitmap,
+		 block_descriptor->bitmap );
+
+		if( block_descriptor->original_offset != block_descriptors[ block_index ].original_offset )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: invalid overlay block descriptor: %d - original offset value mismatch.",
+			 function,
+			 block_descriptor_index );
+
+			goto on_error;
+		}
+		block_descriptors[ block_index ].overlay = block_descriptor;
+
+		data_offset += sizeof( vshadow_index_cache_overlay_block_descriptor_t );
+	}
+	if( libvshadow_block_index_initialize(
+	     &forward_block_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create forward block index.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvshadow_block_index_set_forward_block_descriptors(
+	     forward_block_index,
+	     block_descriptors_array,
+	     number_of_forward_block_descriptors,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set forward block descriptors in block index.",
+		 function );
+
+		goto on_error;
+	}
+	/* The reverse block index only stores the relative offsets
+	 */
+	for( block_descriptor_index = 0;
+	     block_descriptor_index < number_of_reverse_block_descriptors;
+	     block_descriptor_index++ )
+	{
+		block_descriptor = &( block_descriptors[ block_descriptor_index ] );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 &( data[ data_offset ] ),
+		 block_descriptor->relative_offset );
+
+		block_descriptors_array[ block_descriptor_index ] = block_descriptor;
+
+		data_offset += 8;
+	}
+	if( libvshadow_block_index_initialize(
+	     &reverse_block_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create reverse block index.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvshadow_block_index_set_reverse_block_descriptors(
+	     reverse_block_index,
+	     block_descriptors_array,
+	     number_of_reverse_block_descriptors,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set reverse block descriptors in block index.",
+		 function );
+
+		goto on_error;
+	}
+	/* The block descriptors in the order of the store block list
+	 */
+	if( libvshadow_block_index_initialize(
+	     &block_list_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create block list index.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     &block_descriptor_value,
+	     0,
+	     sizeof( libvshadow_block_descriptor_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear block descriptor.",
+		 function );
+
+		goto on_error;
+	}
+	block_descriptor = &block_descriptor_value;
+
+	for( block_descriptor_index = 0;
+	     block_descriptor_index < number_of_store_block_descriptors;
+	     block_descriptor_index++ )
+	{
+		block_data = (vshadow_index_cache_block_descriptor_t *) &( data[ data_offset ] );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 block_data->original_offset,
+		 block_descriptor->original_offset );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 block_data->offset,
+		 block_descriptor->offset );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 block_data->relative_offset,
+		 block_descriptor->relative_offset );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 block_data->flags,
+		 block_descriptor->flags );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 block_data->bitmap,
+		 block_descriptor->bitmap );
+
+		if( libvshadow_block_index_append_block_descriptor(
+		     block_list_index,
+		     block_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append block descriptor: %d to block list index.",
+			 function,
+			 block_descriptor_index );
+
+			goto on_error;
+		}
+		data_offset += sizeof( vshadow_index_cache_block_descriptor_t );
+	}
+	if( block_descriptors_array != NULL )
+	{
+		memory_free(
+		 block_descriptors_array );
+
+		block_descriptors_array = NULL;
+	}
+	if( block_descriptors != NULL )
+	{
+		memory_free(
+		 block_descriptors );
+
+		block_descriptors = NULL;
+	}
+	if( libvshadow_bitmap_initialize(
+	     &bitmap,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create bitmap.",
+		 function );
+
+		goto on_error;
+	}
+	if( bitmap_size > 0 )
+	{
+		if( libvshadow_bitmap_append_data(
+		     bitmap,
+		     &( data[ data_offset ] ),
+		     (size_t) bitmap_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append bitmap data.",
+			 function );
+
+			goto on_error;
+		}
+		data_offset += ( (size_t) bitmap_size + 7 ) & ~( (size_t) 7 );
+	}
+	if( libvshadow_bitmap_initialize(
+	     &previous_bitmap,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create previous bitmap.",
+		 function );
+
+		goto on_error;
+	}
+	if( previous_bitmap_size > 0 )
+	{
+		if( libvshadow_bitmap_append_data(
+		     previous_bitmap,
+		     &( data[ data_offset ] ),
+		     (size_t) previous_bitmap_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append previous bitmap data.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     store_descriptor->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	/* The block indexes and bitmaps are swapped in only when the block descriptors
+	 * have not been read, otherwise they are freed below
+	 */
+	result = 1;
+
+	if( ( store_descriptor->block_descriptors_read == 0 )
+	 && ( store_descriptor->forward_block_index == NULL )
+	 && ( store_descriptor->reverse_block_index == NULL )
+	 && ( store_descriptor->block_list_index->number_of_blocks == 0 ) )
+	{
+		/* The block descriptors trees and arena are not used when the block indexes are read from the index cache
+		 */
+		if( libcdata_btree_free(
+		     &( store_descriptor->reverse_block_descriptors_tree ),
+		     NULL,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free reverse block descriptors tree.",
+			 function );
+
+			result = -1;
+		}
+		else if( libcdata_btree_free(
+		          &( store_descriptor->forward_block_descriptors_tree ),
+		          NULL,
+		          error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free forward block descriptors tree.",
+			 function );
+
+			result = -1;
+		}
+		else if( libvshadow_block_descriptor_arena_free(
+		          &( store_descriptor->block_descriptor_arena ),
+		          error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free block descriptor arena.",
+			 function );
+
+			result = -1;
+		}
+		else
+		{
+			swap_bitmap              = store_descriptor->bitmap;
+			store_descriptor->bitmap = bitmap;
+			bitmap                   = swap_bitmap;
+
+			swap_bitmap                       = store_descriptor->previous_bitmap;
+			store_descriptor->previous_bitmap = previous_bitmap;
+			previous_bitmap                   = swap_bitmap;
+
+			store_descriptor->forward_block_index = forward_block_index;
+			store_descriptor->reverse_block_index = reverse_block_index;
+
+			forward_block_index = NULL;
+			reverse_block_index = NULL;
+
+			swap_block_index                   = store_descriptor->block_list_index;
+			store_descriptor->block_list_index = block_list_index;
+			block_list_index                   = swap_block_index;
+
+			store_descriptor->block_descriptors_read = 1;
+			store_descriptor->block_list_read        = 1;
+		}
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     store_descriptor->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		result = -1;
+	}
+#endif
+	if( libvshadow_block_index_free(
+	     &block_list_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free block list index.",
+		 function );
+
+		result = -1;
+	}
+	if( libvshadow_bitmap_free(
+	     &previous_bitmap,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free previous bitmap.",
+		 function );
+
+		result = -1;
+	}
+	if( libvshadow_bitmap_free(
+	     &bitmap,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free bitmap.",
+		 function );
+
+		result = -1;
+	}
+	if( reverse_block_index != NULL )
+	{
+		if( libvshadow_block_index_free(
+		     &reverse_block_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free reverse block index.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( forward_block_index != NULL )
+	{
+		if( libvshadow_block_index_free(
+		     &forward_block_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free forward block index.",
+			 function );
+
+			result = -1;
+		}
+	}
+	return( result );
+
+on_error:
+	if( block_list_index != NULL )
+	{
+		libvshadow_block_index_free(
+		 &block_list_index,
+		 NULL );
+	}
+	if( previous_bitmap != NULL )
+	{
+		libvshadow_bitmap_free(
+		 &previous_bitmap,
+		 NULL );
+	}
+	if( bitmap != NULL )
+	{
+		libvshadow_bitmap_free(
+		 &bitmap,
+		 NULL );
+	}
+	if( reverse_block_index != NULL )
+	{
+		libvshadow_block_index_free(
+		 &reverse_block_index,
+		 NULL );
+	}
+	if( forward_block_index != NULL )
+	{
+		libvshadow_block_index_free(
+		 &forward_block_index,
+		 NULL );
+	}
+	if( block_descriptors_array != NULL )
+	{
+		memory_free(
+		 block_descriptors_array );
+	}
+	if( block_descriptors != NULL )
+	{
+		memory_free(
+		 block_descriptors );
+	}
+	return( -1 );
+}
+
+/* Writes the index cache to a file IO handle
+ * The block descriptors of all the stores must have been read
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_index_cache_write_file_io_handle(
+     libbfio_handle_t *file_io_handle,
+     size64_t volume_size,
+     off64_t catalog_offset,
+     libcdata_array_t *store_descriptors_array,
+     libcerror_error_t **error )
+{
+	libvshadow_store_descriptor_t *store_descriptor = NULL;
+	vshadow_index_cache_file_header_t *file_header  = NULL;
+	uint8_t *data                                   = NULL;
+	static char *function                           = "libvshadow_index_cache_write_file_io_handle";
+	size64_t data_size                              = 0;
+	size_t data_offset                              = 0;
+	size_t store_data_size                          = 0;
+	ssize_t write_count                             = 0;
+	int number_of_stores                            = 0;
+	int store_index                                 = 0;
+
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     store_descriptors_array,
+	     &number_of_stores,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of store descriptors.",
+		 function );
+
+		goto on_error;
+	}
+	data_size = sizeof( vshadow_index_cache_file_header_t );
+
+	for( store_index = 0;
+	     store_index < number_of_stores;
+	     store_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     store_descriptors_array,
+		     store_index,
+		     (intptr_t **) &store_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve store descriptor: %d.",
+			 function,
+			 store_index );
+
+			goto on_error;
+		}
+		if( libvshadow_index_cache_get_store_data_size(
+		     store_descriptor,
+		     &store_data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve store: %d data size.",
+			 function,
+			 store_index );
+
+			goto on_error;
+		}
+		data_size += store_data_size;
+
+		if( data_size > (size64_t) SSIZE_MAX )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid data size value exceeds maximum.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	data = (uint8_t *) memory_allocate(
+	                    sizeof( uint8_t ) * (size_t) data_size );
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create data.",
+		 function );
+
+		goto on_error;
+	}
+	file_header = (vshadow_index_cache_file_header_t *) data;
+
+	if( memory_copy(
+	     file_header->signature,
+	     vshadow_index_cache_signature,
+	     8 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy signature.",
+		 function );
+
+		goto on_error;
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 file_header->format_version,
+	 2 );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 file_header->number_of_stores,
+	 number_of_stores );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 file_header->volume_size,
+	 volume_size );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 file_header->catalog_offset,
+	 catalog_offset );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 file_header->file_size,
+	 data_size );
+
+	data_offset = sizeof( vshadow_index_cache_file_header_t );
+
+	for( store_index = 0;
+	     store_index < number_of_stores;
+	     store_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     store_descriptors_array,
+		     store_index,
+		     (intptr_t **) &store_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve store descriptor: %d.",
+			 function,
+			 store_index );
+
+			goto on_error;
+		}
+		if( libvshadow_index_cache_get_store_data_size(
+		     store_descriptor,
+		     &store_data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve store: %d data size.",
+			 function,
+			 store_index );
+
+			goto on_error;
+		}
+		if( libvshadow_index_cache_write_store_data(
+		     store_descriptor,
+		     &( data[ data_offset ] ),
+		     (size_t) data_size - data_offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to write store: %d data.",
+			 function,
+			 store_index );
+
+			goto on_error;
+		}
+		data_offset += store_data_size;
+	}
+	if( libbfio_handle_seek_offset(
+	     file_io_handle,
+	     0,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek start of index cache.",
+		 function );
+
+		goto on_error;
+	}
+	write_count = libbfio_handle_write_buffer(
+	               file_io_handle,
+	               data,
+	               (size_t) data_size,
+	               error );
+
+	if( write_count != (ssize_t) data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write index cache.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 data );
+
+	return( 1 );
+
+on_error:
+	if( data != NULL )
+	{
+		memory_free(
+		 data );
+	}
+	return( -1 );
+}
+
+/* Reads the index cache from a file IO handle
+ * The index cache is only used when it matches the volume and all its stores
+ * Returns 1 if successful, 0 if the index cache does not match or -1 on error
+ */
+int libvshadow_index_cache_read_file_io_handle(
+     libbfio_handle_t *file_io_handle,
+     size64_t volume_size,
+     off64_t catalog_offset,
+     libcdata_array_t *store_descriptors_array,
+     libcerror_error_t **error )
+{
+	libvshadow_store_descriptor_t *store_descriptor = NULL;
+	vshadow_index_cache_file_header_t *file_header  = NULL;
+	uint8_t *data                                   = NULL;
+	static char *function                           = "libvshadow_index_cache_read_file_io_handle";
+	size64_t file_size                              = 0;
+	size_t data_offset                              = 0;
+	size_t store_data_size                          = 0;
+	ssize_t read_count                              = 0;
+	uint64_t stored_catalog_offset                  = 0;
+	uint64_t stored_file_size                       = 0;
+	uint64_t stored_volume_size                     = 0;
+	uint32_t format_version                         = 0;
+	uint32_t stored_number_of_stores                = 0;
+	int number_of_stores                            = 0;
+	int result                                      = 0;
+	int store_index                                 = 0;
+
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     store_descriptors_array,
+	     &number_of_stores,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of store descriptors.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_get_size(
+	     file_io_handle,
+	     &file_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve index cache size.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( file_size < (size64_t) sizeof( vshadow_index_cache_file_header_t ) )
+	 || ( file_size > (size64_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid index cache size value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	/* The index cache is read at once so the store data can be parsed in place
+	 */
+	data = (uint8_t *) memory_allocate(
+	                    sizeof( uint8_t ) * (size_t) file_size );
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create data.",
+		 function );
+
+		goto on_error;
+	}
+	read_count = libbfio_handle_read_buffer_at_offset(
+	              file_io_handle,
+	              data,
+	              (size_t) file_size,
+	              0,
+	              error );
+
+	if( read_count != (ssize_t) file_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read index cache.",
+		 function );
+
+		goto on_error;
+	}
+	file_header = (vshadow_index_cache_file_header_t *) data;
+
+	if( memory_compare(
+	     file_header->signature,
+	     vshadow_index_cache_signature,
+	     8 ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid index cache signature.",
+		 function );
+
+		goto on_error;
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 file_header->format_version,
+	 format_version );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 file_header->number_of_stores,
+	 stored_number_of_stores );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 file_header->volume_size,
+	 stored_volume_size );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 file_header->catalog_offset,
+	 stored_catalog_offset );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 file_header->file_size,
+	 stored_file_size );
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: format version\t\t\t: %" PRIu32 "\n",
+		 function,
+		 format_version );
+
+		libcnotify_printf(
+		 "%s: number of stores\t\t\t: %" PRIu32 "\n",
+		 function,
+		 stored_number_of_stores );
+
+		libcnotify_printf(
+		 "%s: volume size\t\t\t: %" PRIu64 "\n",
+		 function,
+		 stored_volume_size );
+
+		libcnotify_printf(
+		 "%s: catalog offset\t\t\t: 0x%08" PRIx64 "\n",
+		 function,
+		 stored_catalog_offset );
+
+		libcnotify_printf(
+		 "%s: file size\t\t\t\t: %" PRIu64 "\n",
+		 function,
+		 stored_file_size );
+
+		libcnotify_printf(
+		 "\n" );
+	}
+#endif
+	if( stored_file_size != (uint64_t) file_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid index cache - file size value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( format_version != 2 )
+	 || ( stored_number_of_stores != (uint32_t) number_of_stores )
+	 || ( stored_volume_size != (uint64_t) volume_size )
+	 || ( stored_catalog_offset != (uint64_t) catalog_offset ) )
+	{
+		memory_free(
+		 data );
+
+		return( 0 );
+	}
+	/* All the stores are checked before any of them is read so that
+	 * a stale index cache does not leave the volume partially read
+	 */
+	data_offset = sizeof( vshadow_index_cache_file_header_t );
+
+	for( store_index = 0;
+	     store_index < number_of_stores;
+	     store_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     store_descriptors_array,
+		     store_index,
+		     (intptr_t **) &store_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve store descriptor: %d.",
+			 function,
+			 store_index );
+
+			goto on_error;
+		}
+		result = libvshadow_index_cache_check_store_data(
+		          store_descriptor,
+		          &( data[ data_offset ] ),
+		          (size_t) file_size - data_offset,
+		          &store_data_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to check store: %d data.",
+			 function,
+			 store_index );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			memory_free(
+			 data );
+
+			return( 0 );
+		}
+		data_offset += store_data_size;
+	}
+	if( data_offset != (size_t) file_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid index cache - trailing data.",
+		 function );
+
+		goto on_error;
+	}
+	data_offset = sizeof( vshadow_index_cache_file_header_t );
+
+	for( store_index = 0;
+	     store_index < number_of_stores;
+	     store_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     store_descriptors_array,
+		     store_index,
+		     (intptr_t **) &store_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve store descriptor: %d.",
+			 function,
+			 store_index );
+
+			goto on_error;
+		}
+		if( libvshadow_index_cache_read_store_data(
+		     store_descriptor,
+		     &( data[ data_offset ] ),
+		     (size_t) file_size - data_offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read store: %d data.",
+			 function,
+			 store_index );
+
+			goto on_error;
+		}
+		if( libvshadow_index_cache_check_store_data(
+		     store_descriptor,
+		     &( data[ data_offset ] ),
+		     (size_t) file_size - data_offset,
+		     &store_data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve store: %d data size.",
+			 function,
+			 store_index );
+
+			goto on_error;
+		}
+		data_offset += store_data_size;
+	}
+	memory_free(
+	 data );
+
+	return( 1 );
+
+on_error:
+	if( data != NULL )
+	{
+		memory_free(
+		 data );
+	}
+	return( -1 );
+}
+
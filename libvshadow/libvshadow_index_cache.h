@@ -0,0 +1,82 @@
+/*
+ * Index cache functions
+ *
+ * Copyright (C) 2011-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVSHADOW_INDEX_CACHE_H )
+#define _LIBVSHADOW_INDEX_CACHE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvshadow_libbfio.h"
+#include "libvshadow_libcdata.h"
+#include "libvshadow_libcerror.h"
+#include "libvshadow_store_descriptor.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+extern const uint8_t vshadow_index_cache_signature[ 8 ];
+
+int libvshadow_index_cache_get_store_data_size(
+     libvshadow_store_descriptor_t *store_descriptor,
+     size_t *data_size,
+     libcerror_error_t **error );
+
+int libvshadow_index_cache_write_store_data(
+     libvshadow_store_descriptor_t *store_descriptor,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int libvshadow_index_cache_check_store_data(
+     libvshadow_store_descriptor_t *store_descriptor,
+     const uint8_t *data,
+     size_t data_size,
+     size_t *store_data_size,
+     libcerror_error_t **error );
+
+int libvshadow_index_cache_read_store_data(
+     libvshadow_store_descriptor_t *store_descriptor,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int libvshadow_index_cache_write_file_io_handle(
+     libbfio_handle_t *file_io_handle,
+     size64_t volume_size,
+     off64_t catalog_offset,
+     libcdata_array_t *store_descriptors_array,
+     libcerror_error_t **error );
+
+int libvshadow_index_cache_read_file_io_handle(
+     libbfio_handle_t *file_io_handle,
+     size64_t volume_size,
+     off64_t catalog_offset,
+     libcdata_array_t *store_descriptors_array,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVSHADOW_INDEX_CACHE_H ) */
+
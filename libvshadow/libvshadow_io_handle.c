@@ -33,6 +33,7 @@
 #include "libvshadow_libcnotify.h"
 #include "libvshadow_libfdatetime.h"
 #include "libvshadow_libfguid.h"
+#include "libvshadow_metadata_reader.h"
 #include "libvshadow_store_descriptor.h"
 
 #include "vshadow_catalog.h"
@@ -240,25 +241,11 @@ int libvshadow_io_handle_read_ntfs_volume_header(
 		 function );
 	}
 #endif
-	if( libbfio_handle_seek_offset(
-	     file_io_handle,
-	     0,
-	     SEEK_SET,
-	     error ) == -1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek NTFS volume header offset: 0.",
-		 function );
-
-		return( -1 );
-	}
-	read_count = libbfio_handle_read_buffer(
+	read_count = libbfio_handle_read_buffer_at_offset(
 	              file_io_handle,
 	              (uint8_t *) &volume_header,
 	              sizeof( vshadow_ntfs_volume_header_t ),
+	              0,
 	              error );
 
 	if( read_count != (ssize_t) sizeof( vshadow_ntfs_volume_header_t ) )
@@ -267,7 +254,7 @@ int libvshadow_io_handle_read_ntfs_volume_header(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
 		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read NTFS volume header data.",
+		 "%s: unable to read NTFS volume header data at offset: 0 (0x00000000).",
 		 function );
 
 		return( -1 );
@@ -324,27 +311,12 @@ int libvshadow_io_handle_read_ntfs_volume_header(
 		 backup_ntfs_volume_header_offset );
 	}
 #endif
-	if( libbfio_handle_seek_offset(
-	     file_io_handle,
-	     backup_ntfs_volume_header_offset,
-	     SEEK_SET,
-	     error ) == -1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek NTFS backup volume header offset: %" PRIi64 ".",
-		 function,
-		 backup_ntfs_volume_header_offset );
-
-		return( -1 );
-	}
-	read_count = libbfio_handle_read_buffer(
-		      file_io_handle,
-		      (uint8_t *) &volume_header,
-		      sizeof( vshadow_ntfs_volume_header_t ),
-		      error );
+	read_count = libbfio_handle_read_buffer_at_offset(
+	              file_io_handle,
+	              (uint8_t *) &volume_header,
+	              sizeof( vshadow_ntfs_volume_header_t ),
+	              backup_ntfs_volume_header_offset,
+	              error );
 
 	if( read_count == 0 )
 	{
@@ -356,8 +328,10 @@ int libvshadow_io_handle_read_ntfs_volume_header(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
 		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read NTFS backup volume header data.",
-		 function );
+		 "%s: unable to read NTFS backup volume header data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 backup_ntfs_volume_header_offset,
+		 backup_ntfs_volume_header_offset );
 
 		return( -1 );
 	}
@@ -444,26 +418,11 @@ int libvshadow_io_handle_read_volume_header(
 		 file_offset );
 	}
 #endif
-	if( libbfio_handle_seek_offset(
-	     file_io_handle,
-	     file_offset,
-	     SEEK_SET,
-	     error ) == -1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek volume header offset: %" PRIi64 ".",
-		 function,
-		 file_offset );
-
-		return( -1 );
-	}
-	read_count = libbfio_handle_read_buffer(
+	read_count = libbfio_handle_read_buffer_at_offset(
 	              file_io_handle,
 	              (uint8_t *) &volume_header,
 	              sizeof( vshadow_volume_header_t ),
+	              file_offset,
 	              error );
 
 	if( read_count != (ssize_t) sizeof( vshadow_volume_header_t ) )
@@ -472,8 +431,10 @@ int libvshadow_io_handle_read_volume_header(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
 		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read volume header data.",
-		 function );
+		 "%s: unable to read volume header data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 file_offset,
+		 file_offset );
 
 		return( -1 );
 	}
@@ -763,6 +724,7 @@ int libvshadow_io_handle_read_volume_header_data(
 int libvshadow_io_handle_read_catalog(
      libvshadow_io_handle_t *io_handle,
      libbfio_handle_t *file_io_handle,
+     libvshadow_metadata_reader_t *metadata_reader,
      off64_t file_offset,
      size64_t *volume_size,
      libcdata_array_t *store_descriptors_array,
@@ -770,12 +732,11 @@ int libvshadow_io_handle_read_catalog(
 {
 	libvshadow_store_descriptor_t *last_store_descriptor = NULL;
 	libvshadow_store_descriptor_t *store_descriptor      = NULL;
-	uint8_t *catalog_block_data                          = NULL;
+	const uint8_t *catalog_block_data                    = NULL;
 	static char *function                                = "libvshadow_io_handle_read_catalog";
 	off64_t next_offset                                  = 0;
 	size_t catalog_block_offset                          = 0;
 	size_t catalog_block_size                            = 0;
-	ssize_t read_count                                   = 0;
 	uint64_t catalog_entry_type                          = 0;
 	int result                                           = 0;
 	int store_descriptor_index                           = 0;
@@ -802,19 +763,27 @@ int libvshadow_io_handle_read_catalog(
 
 		return( -1 );
 	}
-	catalog_block_data = (uint8_t *) memory_allocate(
-	                                  sizeof( uint8_t ) * io_handle->block_size );
+	if( metadata_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata reader.",
+		 function );
 
-	if( catalog_block_data == NULL )
+		return( -1 );
+	}
+	if( metadata_reader->block_size != io_handle->block_size )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-		 "%s: unable to catalog block data.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid metadata reader - block size value out of bounds.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
 	do
 	{
@@ -830,39 +799,24 @@ int libvshadow_io_handle_read_catalog(
 			 file_offset );
 		}
 #endif
-		if( libbfio_handle_seek_offset(
+		if( libvshadow_metadata_reader_read_block_data(
+		     metadata_reader,
 		     file_io_handle,
 		     file_offset,
-		     SEEK_SET,
-		     error ) == -1 )
+		     &catalog_block_data,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_SEEK_FAILED,
-			 "%s: unable to seek catalog block offset: %" PRIi64 ".",
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read catalog block data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
 			 function,
+			 file_offset,
 			 file_offset );
 
 			goto on_error;
 		}
-		read_count = libbfio_handle_read_buffer(
-			      file_io_handle,
-			      catalog_block_data,
-			      catalog_block_size,
-			      error );
-
-		if( read_count != (ssize_t) catalog_block_size )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read catalog block data.",
-			 function );
-
-			goto on_error;
-		}
 		if( libvshadow_io_handle_read_catalog_header_data(
 		     io_handle,
 		     catalog_block_data,
@@ -1028,9 +982,6 @@ int libvshadow_io_handle_read_catalog(
 			goto on_error;
 		}
 	}
-	memory_free(
-	 catalog_block_data );
-
 	return( 1 );
 
 on_error:
@@ -1040,11 +991,6 @@ on_error:
 		 &store_descriptor,
 		 NULL );
 	}
-	if( catalog_block_data != NULL )
-	{
-		memory_free(
-		 catalog_block_data );
-	}
 	return( -1 );
 }
 
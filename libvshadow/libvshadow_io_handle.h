@@ -28,6 +28,7 @@
 #include "libvshadow_libbfio.h"
 #include "libvshadow_libcdata.h"
 #include "libvshadow_libcerror.h"
+#include "libvshadow_metadata_reader.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -83,6 +84,7 @@ int libvshadow_io_handle_read_volume_header_data(
 int libvshadow_io_handle_read_catalog(
      libvshadow_io_handle_t *io_handle,
      libbfio_handle_t *file_io_handle,
+     libvshadow_metadata_reader_t *metadata_reader,
      off64_t file_offset,
      size64_t *volume_size,
      libcdata_array_t *store_descriptors_array,
@@ -0,0 +1,441 @@
+/*
+ * Metadata reader functions
+ *
+ * Copyright (C) 2011-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libvshadow_libbfio.h"
+#include "libvshadow_libcerror.h"
+#include "libvshadow_libcnotify.h"
+#include "libvshadow_metadata_reader.h"
+#include "libvshadow_store_block.h"
+
+/* Creates a metadata reader
+ * Make sure the value metadata_reader is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_metadata_reader_initialize(
+     libvshadow_metadata_reader_t **metadata_reader,
+     size_t block_size,
+     int maximum_number_of_blocks,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_metadata_reader_initialize";
+
+	if( metadata_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( *metadata_reader != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid metadata reader value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid block size value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_blocks <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid maximum number of blocks value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size_t) maximum_number_of_blocks > ( (size_t) SSIZE_MAX / block_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid maximum number of blocks value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	*metadata_reader = memory_allocate_structure(
+	                    libvshadow_metadata_reader_t );
+
+	if( *metadata_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create metadata reader.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *metadata_reader,
+	     0,
+	     sizeof( libvshadow_metadata_reader_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear metadata reader.",
+		 function );
+
+		memory_free(
+		 *metadata_reader );
+
+		*metadata_reader = NULL;
+
+		return( -1 );
+	}
+	( *metadata_reader )->buffer = (uint8_t *) memory_allocate(
+	                                            sizeof( uint8_t ) * block_size * maximum_number_of_blocks );
+
+	if( ( *metadata_reader )->buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffer.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvshadow_store_block_initialize(
+	     &( ( *metadata_reader )->store_block ),
+	     block_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create store block.",
+		 function );
+
+		goto on_error;
+	}
+	( *metadata_reader )->block_size               = block_size;
+	( *metadata_reader )->maximum_number_of_blocks = maximum_number_of_blocks;
+
+	/* Initially the block and the next block are read
+	 */
+	( *metadata_reader )->number_of_blocks = ( maximum_number_of_blocks < 2 ) ? maximum_number_of_blocks : 2;
+
+	return( 1 );
+
+on_error:
+	if( *metadata_reader != NULL )
+	{
+		if( ( *metadata_reader )->buffer != NULL )
+		{
+			memory_free(
+			 ( *metadata_reader )->buffer );
+		}
+		memory_free(
+		 *metadata_reader );
+
+		*metadata_reader = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a metadata reader
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_metadata_reader_free(
+     libvshadow_metadata_reader_t **metadata_reader,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_metadata_reader_free";
+	int result            = 1;
+
+	if( metadata_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( *metadata_reader != NULL )
+	{
+		if( libvshadow_store_block_free(
+		     &( ( *metadata_reader )->store_block ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free store block.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 ( *metadata_reader )->buffer );
+
+		memory_free(
+		 *metadata_reader );
+
+		*metadata_reader = NULL;
+	}
+	return( result );
+}
+
+/* Reads the data of a metadata block
+ * The block is read from the buffer if it contains the block, otherwise the block
+ * and the blocks that follow it are read into the buffer. The number of blocks read
+ * ahead is doubled, up to the maximum, every time the next block that is not in the
+ * buffer directly follows the buffered blocks and reset otherwise
+ * The block data remains valid until the next read
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_metadata_reader_read_block_data(
+     libvshadow_metadata_reader_t *metadata_reader,
+     libbfio_handle_t *file_io_handle,
+     off64_t file_offset,
+     const uint8_t **block_data,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_metadata_reader_read_block_data";
+	size_t read_size      = 0;
+	ssize_t read_count    = 0;
+
+	if( metadata_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid file offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( metadata_reader->buffer_size < metadata_reader->block_size )
+	 || ( file_offset < metadata_reader->buffer_offset )
+	 || ( file_offset > (off64_t) ( metadata_reader->buffer_offset + metadata_reader->buffer_size - metadata_reader->block_size ) ) )
+	{
+		if( metadata_reader->buffer_size != 0 )
+		{
+			if( file_offset == (off64_t) ( metadata_reader->buffer_offset + metadata_reader->buffer_size ) )
+			{
+				if( metadata_reader->number_of_blocks <= ( metadata_reader->maximum_number_of_blocks / 2 ) )
+				{
+					metadata_reader->number_of_blocks *= 2;
+				}
+				else
+				{
+					metadata_reader->number_of_blocks = metadata_reader->maximum_number_of_blocks;
+				}
+			}
+			else
+			{
+				metadata_reader->number_of_blocks = ( metadata_reader->maximum_number_of_blocks < 2 ) ? metadata_reader->maximum_number_of_blocks : 2;
+			}
+		}
+		read_size = metadata_reader->block_size * metadata_reader->number_of_blocks;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: reading %d metadata blocks at offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
+			 function,
+			 metadata_reader->number_of_blocks,
+			 file_offset,
+			 file_offset );
+		}
+#endif
+		metadata_reader->buffer_size = 0;
+
+		/* The blocks read ahead can be beyond the end of the data
+		 */
+		read_count = libbfio_handle_read_buffer_at_offset(
+		              file_io_handle,
+		              metadata_reader->buffer,
+		              read_size,
+		              file_offset,
+		              error );
+
+		if( ( read_count < 0 )
+		 || ( (size_t) read_count < metadata_reader->block_size ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read metadata block data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 file_offset,
+			 file_offset );
+
+			return( -1 );
+		}
+		metadata_reader->buffer_offset = file_offset;
+		metadata_reader->buffer_size   = (size_t) read_count;
+
+		metadata_reader->number_of_reads += 1;
+	}
+	*block_data = &( metadata_reader->buffer[ file_offset - metadata_reader->buffer_offset ] );
+
+	return( 1 );
+}
+
+/* Reads a store block
+ * The store block is owned by the metadata reader and remains valid until the next read
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_metadata_reader_read_store_block(
+     libvshadow_metadata_reader_t *metadata_reader,
+     libbfio_handle_t *file_io_handle,
+     off64_t file_offset,
+     libvshadow_store_block_t **store_block,
+     libcerror_error_t **error )
+{
+	const uint8_t *block_data = NULL;
+	static char *function     = "libvshadow_metadata_reader_read_store_block";
+
+	if( metadata_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( store_block == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store block.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvshadow_metadata_reader_read_block_data(
+	     metadata_reader,
+	     file_io_handle,
+	     file_offset,
+	     &block_data,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read block data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 file_offset,
+		 file_offset );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     metadata_reader->store_block->data,
+	     block_data,
+	     metadata_reader->block_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy store block data.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvshadow_store_block_read_header_data(
+	     metadata_reader->store_block,
+	     metadata_reader->store_block->data,
+	     metadata_reader->store_block->data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read store block header.",
+		 function );
+
+		return( -1 );
+	}
+	*store_block = metadata_reader->store_block;
+
+	return( 1 );
+}
+
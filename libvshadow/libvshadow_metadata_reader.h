@@ -0,0 +1,105 @@
+/*
+ * Metadata reader functions
+ *
+ * Copyright (C) 2011-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVSHADOW_METADATA_READER_H )
+#define _LIBVSHADOW_METADATA_READER_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvshadow_libbfio.h"
+#include "libvshadow_libcerror.h"
+#include "libvshadow_store_block.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libvshadow_metadata_reader libvshadow_metadata_reader_t;
+
+struct libvshadow_metadata_reader
+{
+	/* The block size
+	 */
+	size_t block_size;
+
+	/* The maximum number of blocks that are read at once
+	 */
+	int maximum_number_of_blocks;
+
+	/* The number of blocks that are read on the next buffer miss
+	 * This value grows while the blocks are read sequentially
+	 */
+	int number_of_blocks;
+
+	/* The buffer
+	 * Contains the data of maximum number of blocks
+	 */
+	uint8_t *buffer;
+
+	/* The offset of the buffered data
+	 */
+	off64_t buffer_offset;
+
+	/* The size of the buffered data
+	 */
+	size_t buffer_size;
+
+	/* The store block
+	 * Contains the last store block that was read
+	 */
+	libvshadow_store_block_t *store_block;
+
+	/* The number of reads
+	 */
+	uint64_t number_of_reads;
+};
+
+int libvshadow_metadata_reader_initialize(
+     libvshadow_metadata_reader_t **metadata_reader,
+     size_t block_size,
+     int maximum_number_of_blocks,
+     libcerror_error_t **error );
+
+int libvshadow_metadata_reader_free(
+     libvshadow_metadata_reader_t **metadata_reader,
+     libcerror_error_t **error );
+
+int libvshadow_metadata_reader_read_block_data(
+     libvshadow_metadata_reader_t *metadata_reader,
+     libbfio_handle_t *file_io_handle,
+     off64_t file_offset,
+     const uint8_t **block_data,
+     libcerror_error_t **error );
+
+int libvshadow_metadata_reader_read_store_block(
+     libvshadow_metadata_reader_t *metadata_reader,
+     libbfio_handle_t *file_io_handle,
+     off64_t file_offset,
+     libvshadow_store_block_t **store_block,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVSHADOW_METADATA_READER_H ) */
+
@@ -0,0 +1,652 @@
+/*
+ * Read list functions
+ *
+ * Copyright (C) 2011-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "libvshadow_block_cache.h"
+#include "libvshadow_definitions.h"
+#include "libvshadow_extent_map.h"
+#include "libvshadow_libbfio.h"
+#include "libvshadow_libcerror.h"
+#include "libvshadow_libcnotify.h"
+#include "libvshadow_read_list.h"
+#include "libvshadow_read_segment.h"
+
+/* Creates a read list
+ * Make sure the value read_list is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_read_list_initialize(
+     libvshadow_read_list_t **read_list,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_read_list_initialize";
+
+	if( read_list == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read list.",
+		 function );
+
+		return( -1 );
+	}
+	if( *read_list != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid read list value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*read_list = memory_allocate_structure(
+	              libvshadow_read_list_t );
+
+	if( *read_list == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create read list.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *read_list,
+	     0,
+	     sizeof( libvshadow_read_list_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear read list.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *read_list != NULL )
+	{
+		memory_free(
+		 *read_list );
+
+		*read_list = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a read list
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_read_list_free(
+     libvshadow_read_list_t **read_list,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_read_list_free";
+
+	if( read_list == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read list.",
+		 function );
+
+		return( -1 );
+	}
+	if( *read_list != NULL )
+	{
+		if( ( *read_list )->merged_data != NULL )
+		{
+			memory_free(
+			 ( *read_list )->merged_data );
+		}
+		if( ( *read_list )->segments != NULL )
+		{
+			memory_free(
+			 ( *read_list )->segments );
+		}
+		memory_free(
+		 *read_list );
+
+		*read_list = NULL;
+	}
+	return( 1 );
+}
+
+/* Appends a read segment to the end of the read list
+ * The segment is merged with the last segment if the data is contiguous both in the volume and in the buffer
+ * and the last segment is not stored before the first segment index, which prevents segments of
+ * different stores to be merged
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_read_list_append_segment(
+     libvshadow_read_list_t *read_list,
+     int first_segment_index,
+     off64_t data_offset,
+     size_t size,
+     uint8_t *buffer,
+     libcerror_error_t **error )
+{
+	libvshadow_read_segment_t *segment  = NULL;
+	libvshadow_read_segment_t *segments = NULL;
+	static char *function               = "libvshadow_read_list_append_segment";
+	size_t segments_size                = 0;
+	int number_of_allocated_segments    = 0;
+
+	if( read_list == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read list.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( first_segment_index < 0 )
+	 || ( first_segment_index > read_list->number_of_segments ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid first segment index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size == 0 )
+	{
+		return( 1 );
+	}
+	if( read_list->number_of_segments > first_segment_index )
+	{
+		segment = &( read_list->segments[ read_list->number_of_segments - 1 ] );
+
+		if( ( ( segment->data_offset + (off64_t) segment->size ) == data_offset )
+		 && ( &( segment->buffer[ segment->size ] ) == buffer )
+		 && ( segment->size <= ( (size_t) SSIZE_MAX - size ) ) )
+		{
+			segment->size += size;
+
+			return( 1 );
+		}
+	}
+	if( read_list->number_of_segments >= read_list->number_of_allocated_segments )
+	{
+		if( read_list->number_of_allocated_segments == 0 )
+		{
+			number_of_allocated_segments = 16;
+		}
+		else if( read_list->number_of_allocated_segments <= ( INT_MAX / 2 ) )
+		{
+			number_of_allocated_segments = read_list->number_of_allocated_segments * 2;
+		}
+		else
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid read list - number of allocated segments value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		if( (size_t) number_of_allocated_segments > ( (size_t) SSIZE_MAX / sizeof( libvshadow_read_segment_t ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid segments size value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		segments_size = sizeof( libvshadow_read_segment_t ) * number_of_allocated_segments;
+
+		segments = (libvshadow_read_segment_t *) memory_reallocate(
+		                                          read_list->segments,
+		                                          segments_size );
+
+		if( segments == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize segments.",
+			 function );
+
+			return( -1 );
+		}
+		read_list->segments                     = segments;
+		read_list->number_of_allocated_segments = number_of_allocated_segments;
+	}
+	segment = &( read_list->segments[ read_list->number_of_segments ] );
+
+	segment->data_offset = data_offset;
+	segment->size        = size;
+	segment->buffer      = buffer;
+
+	read_list->number_of_segments += 1;
+
+	return( 1 );
+}
+
+/* Appends the read segments of a (store) range to the read list
+ * The range is resolved using the extent map, where the sparse data is set directly in the buffer
+ * Segments stored before the first segment index are not merged with the segments of the range
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_read_list_append_range(
+     libvshadow_read_list_t *read_list,
+     int first_segment_index,
+     libvshadow_extent_map_t *extent_map,
+     uint8_t *buffer,
+     size_t buffer_size,
+     off64_t offset,
+     libcerror_error_t **error )
+{
+	libvshadow_extent_t *extent = NULL;
+	static char *function       = "libvshadow_read_list_append_range";
+	off64_t data_offset         = 0;
+	size_t buffer_offset        = 0;
+	size_t read_size            = 0;
+	uint8_t extent_type         = 0;
+	int extent_index            = 0;
+	int result                  = 0;
+
+	if( read_list == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read list.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent map.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size == 0 )
+	{
+		return( 1 );
+	}
+	result = libvshadow_extent_map_get_extent_index_at_offset(
+	          extent_map,
+	          offset,
+	          &extent_index,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve extent for offset: 0x%08" PRIx64 ".",
+		 function,
+		 offset );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		extent_index = extent_map->number_of_extents;
+	}
+	while( buffer_offset < buffer_size )
+	{
+		read_size = buffer_size - buffer_offset;
+
+		/* The data beyond the extent map is not defined by the store
+		 */
+		if( extent_index >= extent_map->number_of_extents )
+		{
+			extent_type = LIBVSHADOW_EXTENT_TYPE_VOLUME_DATA;
+			data_offset = offset;
+		}
+		else
+		{
+			extent = &( extent_map->extents[ extent_index ] );
+
+			extent_type = extent->type;
+			data_offset = extent->data_offset + ( offset - extent->offset );
+
+			if( (size64_t) read_size > ( extent->size - (size64_t) ( offset - extent->offset ) ) )
+			{
+				read_size = (size_t) ( extent->size - (size64_t) ( offset - extent->offset ) );
+			}
+			extent_index++;
+		}
+		if( extent_type == LIBVSHADOW_EXTENT_TYPE_SPARSE )
+		{
+			if( memory_set(
+			     &( buffer[ buffer_offset ] ),
+			     0,
+			     read_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+				 "%s: unable to clear buffer.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		else if( libvshadow_read_list_append_segment(
+		          read_list,
+		          first_segment_index,
+		          data_offset,
+		          read_size,
+		          &( buffer[ buffer_offset ] ),
+		          error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append read segment.",
+			 function );
+
+			return( -1 );
+		}
+		offset        += read_size;
+		buffer_offset += read_size;
+	}
+	return( 1 );
+}
+
+/* Reads the data of the read segments in the read list
+ * The segments are read in order of the data offset, where segments that overlap or are adjacent
+ * in the volume are read with a single read of at most LIBVSHADOW_MAXIMUM_MERGED_READ_SIZE,
+ * unless the segments are contained in the first segment of the read
+ * The segments are sorted by this function
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_read_list_read(
+     libvshadow_read_list_t *read_list,
+     libbfio_handle_t *file_io_handle,
+     libvshadow_block_cache_t *block_cache,
+     libcerror_error_t **error )
+{
+	libvshadow_read_segment_t *segment = NULL;
+	uint8_t *merged_data               = NULL;
+	uint8_t *read_buffer               = NULL;
+	static char *function              = "libvshadow_read_list_read";
+	size_t read_size                   = 0;
+	ssize_t read_count                 = 0;
+	off64_t merged_data_offset         = 0;
+	off64_t merged_end_offset          = 0;
+	off64_t segment_end_offset         = 0;
+	int first_segment_index            = 0;
+	int segment_index                  = 0;
+
+	if( read_list == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read list.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_list->number_of_segments > 1 )
+	{
+		qsort(
+		 read_list->segments,
+		 (size_t) read_list->number_of_segments,
+		 sizeof( libvshadow_read_segment_t ),
+		 &libvshadow_read_segment_compare_by_data_offset );
+	}
+	while( segment_index < read_list->number_of_segments )
+	{
+		first_segment_index = segment_index;
+
+		segment = &( read_list->segments[ segment_index++ ] );
+
+		merged_data_offset = segment->data_offset;
+		merged_end_offset  = segment->data_offset + (off64_t) segment->size;
+
+		while( segment_index < read_list->number_of_segments )
+		{
+			segment = &( read_list->segments[ segment_index ] );
+
+			if( segment->data_offset > merged_end_offset )
+			{
+				break;
+			}
+			segment_end_offset = segment->data_offset + (off64_t) segment->size;
+
+			/* Segments that are contained in the merged read are always added
+			 */
+			if( segment_end_offset > merged_end_offset )
+			{
+				if( (size64_t) ( segment_end_offset - merged_data_offset ) > (size64_t) LIBVSHADOW_MAXIMUM_MERGED_READ_SIZE )
+				{
+					break;
+				}
+				merged_end_offset = segment_end_offset;
+			}
+			segment_index++;
+		}
+		read_size = (size_t) ( merged_end_offset - merged_data_offset );
+
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: reading data offset: 0x%08" PRIx64 " - 0x%08" PRIx64 " size: %" PRIzd " for %d segments\n",
+			 function,
+			 merged_data_offset,
+			 merged_end_offset,
+			 read_size,
+			 segment_index - first_segment_index );
+		}
+#endif
+		/* If the first segment covers the merged read its data is read directly into its buffer
+		 */
+		if( read_list->segments[ first_segment_index ].size == read_size )
+		{
+			read_buffer = read_list->segments[ first_segment_index ].buffer;
+
+			first_segment_index++;
+		}
+		else
+		{
+			if( read_size > read_list->merged_data_size )
+			{
+				merged_data = (uint8_t *) memory_reallocate(
+				                           read_list->merged_data,
+				                           sizeof( uint8_t ) * read_size );
+
+				if( merged_data == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+					 "%s: unable to resize merged data.",
+					 function );
+
+					return( -1 );
+				}
+				read_list->merged_data      = merged_data;
+				read_list->merged_data_size = read_size;
+			}
+			read_buffer = read_list->merged_data;
+		}
+		if( block_cache != NULL )
+		{
+			read_count = libvshadow_block_cache_read_buffer(
+			              block_cache,
+			              file_io_handle,
+			              read_buffer,
+			              read_size,
+			              merged_data_offset,
+			              error );
+		}
+		else
+		{
+			read_count = libbfio_handle_read_buffer_at_offset(
+			              file_io_handle,
+			              read_buffer,
+			              read_size,
+			              merged_data_offset,
+			              error );
+		}
+		if( read_count != (ssize_t) read_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read buffer from file IO handle at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 merged_data_offset,
+			 merged_data_offset );
+
+			return( -1 );
+		}
+		while( first_segment_index < segment_index )
+		{
+			segment = &( read_list->segments[ first_segment_index++ ] );
+
+			if( memory_copy(
+			     segment->buffer,
+			     &( read_buffer[ segment->data_offset - merged_data_offset ] ),
+			     segment->size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy merged data.",
+				 function );
+
+				return( -1 );
+			}
+		}
+	}
+	return( 1 );
+}
+
@@ -0,0 +1,101 @@
+/*
+ * Read list functions
+ *
+ * Copyright (C) 2011-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#if !defined( _LIBVSHADOW_READ_LIST_H )
+#define _LIBVSHADOW_READ_LIST_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvshadow_block_cache.h"
+#include "libvshadow_extent_map.h"
+#include "libvshadow_libbfio.h"
+#include "libvshadow_libcerror.h"
+#include "libvshadow_read_segment.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libvshadow_read_list libvshadow_read_list_t;
+
+struct libvshadow_read_list
+{
+	/* The read segments
+	 */
+	libvshadow_read_segment_t *segments;
+
+	/* The number of read segments
+	 */
+	int number_of_segments;
+
+	/* The number of allocated read segments
+	 */
+	int number_of_allocated_segments;
+
+	/* The merged data
+	 * Contains the data of a merged read of multiple read segments
+	 */
+	uint8_t *merged_data;
+
+	/* The merged data size
+	 */
+	size_t merged_data_size;
+};
+
+int libvshadow_read_list_initialize(
+     libvshadow_read_list_t **read_list,
+     libcerror_error_t **error );
+
+int libvshadow_read_list_free(
+     libvshadow_read_list_t **read_list,
+     libcerror_error_t **error );
+
+int libvshadow_read_list_append_segment(
+     libvshadow_read_list_t *read_list,
+     int first_segment_index,
+     off64_t data_offset,
+     size_t size,
+     uint8_t *buffer,
+     libcerror_error_t **error );
+
+int libvshadow_read_list_append_range(
+     libvshadow_read_list_t *read_list,
+     int first_segment_index,
+     libvshadow_extent_map_t *extent_map,
+     uint8_t *buffer,
+     size_t buffer_size,
+     off64_t offset,
+     libcerror_error_t **error );
+
+int libvshadow_read_list_read(
+     libvshadow_read_list_t *read_list,
+     libbfio_handle_t *file_io_handle,
+     libvshadow_block_cache_t *block_cache,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVSHADOW_READ_LIST_H ) */
+
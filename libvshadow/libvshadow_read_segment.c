@@ -0,0 +1,62 @@
+/*
+ * Read segment functions
+ *
+ * Copyright (C) 2011-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <common.h>
+#include <types.h>
+
+#include "libvshadow_read_segment.h"
+
+/* Compares 2 read segments by the data offset
+ * This function is used to sort arrays of read segments
+ * Returns -1 if the first is less, 0 if equal or 1 if the first is greater than the second
+ */
+int libvshadow_read_segment_compare_by_data_offset(
+     const void *first_read_segment,
+     const void *second_read_segment )
+{
+	const libvshadow_read_segment_t *first_segment  = NULL;
+	const libvshadow_read_segment_t *second_segment = NULL;
+
+	first_segment  = (const libvshadow_read_segment_t *) first_read_segment;
+	second_segment = (const libvshadow_read_segment_t *) second_read_segment;
+
+	if( first_segment->data_offset < second_segment->data_offset )
+	{
+		return( -1 );
+	}
+	else if( first_segment->data_offset > second_segment->data_offset )
+	{
+		return( 1 );
+	}
+	/* Sort the larger segment first so it covers the segments it overlaps
+	 */
+	if( first_segment->size > second_segment->size )
+	{
+		return( -1 );
+	}
+	else if( first_segment->size < second_segment->size )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
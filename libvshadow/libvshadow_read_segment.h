@@ -0,0 +1,60 @@
+/*
+ * Read segment functions
+ *
+ * Copyright (C) 2011-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#if !defined( _LIBVSHADOW_READ_SEGMENT_H )
+#define _LIBVSHADOW_READ_SEGMENT_H
+
+#include <common.h>
+#include <types.h>
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libvshadow_read_segment libvshadow_read_segment_t;
+
+struct libvshadow_read_segment
+{
+	/* The data offset
+	 * Contains the offset of the data relative to the start of the volume
+	 */
+	off64_t data_offset;
+
+	/* The size
+	 */
+	size_t size;
+
+	/* The buffer the data is read into
+	 */
+	uint8_t *buffer;
+};
+
+int libvshadow_read_segment_compare_by_data_offset(
+     const void *first_read_segment,
+     const void *second_read_segment );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVSHADOW_READ_SEGMENT_H ) */
+
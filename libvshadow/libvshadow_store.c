@@ -24,6 +24,7 @@
 #include <types.h>
 
 #include "libvshadow_block.h"
+#include "libvshadow_block_cache.h"
 #include "libvshadow_block_descriptor.h"
 #include "libvshadow_block_tree.h"
 #include "libvshadow_definitions.h"
@@ -287,19 +288,21 @@ int libvshadow_store_has_in_volume_data(
 	return( result );
 }
 
-/* Reads (store) data at the current offset into a buffer using a Basic File IO (bfio) handle
- * This function is not multi-thread safe acquire write lock before call
+/* Reads (store) data at a specific offset into a buffer using a Basic File IO (bfio) handle
+ * This function does not change the current offset
  * Returns the number of bytes read or -1 on error
  */
-ssize_t libvshadow_internal_store_read_buffer_from_file_io_handle(
+ssize_t libvshadow_internal_store_read_buffer_at_offset_from_file_io_handle(
          libvshadow_internal_store_t *internal_store,
          libbfio_handle_t *file_io_handle,
          void *buffer,
          size_t buffer_size,
+         off64_t offset,
          libcerror_error_t **error )
 {
+	libvshadow_block_cache_t *block_cache           = NULL;
 	libvshadow_store_descriptor_t *store_descriptor = NULL;
-	static char *function                           = "libvshadow_internal_store_read_buffer_from_file_io_handle";
+	static char *function                           = "libvshadow_internal_store_read_buffer_at_offset_from_file_io_handle";
 	ssize_t read_count                              = 0;
 
 	if( internal_store == NULL )
@@ -324,13 +327,13 @@ ssize_t libvshadow_internal_store_read_buffer_from_file_io_handle(
 
 		return( -1 );
 	}
-	if( internal_store->current_offset < 0 )
+	if( offset < 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid store - current offset value out of bounds.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
 		 function );
 
 		return( -1 );
@@ -339,13 +342,13 @@ ssize_t libvshadow_internal_store_read_buffer_from_file_io_handle(
 	{
 		return( 0 );
 	}
-	if( (size64_t) internal_store->current_offset >= internal_store->internal_volume->size )
+	if( (size64_t) offset >= internal_store->internal_volume->size )
 	{
 		return( 0 );
 	}
-	if( (size64_t) ( internal_store->current_offset + buffer_size ) > internal_store->internal_volume->size )
+	if( (size64_t) ( offset + buffer_size ) > internal_store->internal_volume->size )
 	{
-		buffer_size = (size_t) ( internal_store->internal_volume->size - internal_store->current_offset );
+		buffer_size = (size_t) ( internal_store->internal_volume->size - offset );
 	}
 	if( libcdata_array_get_entry_by_index(
 	     internal_store->internal_volume->store_descriptors_array,
@@ -363,15 +366,52 @@ ssize_t libvshadow_internal_store_read_buffer_from_file_io_handle(
 
 		return( -1 );
 	}
+	/* The block cache is keyed by the offsets in the volume, the file IO handle
+	 * provides the same data as the file IO handle of the volume, e.g. a clone
+	 */
+	block_cache = internal_store->internal_volume->block_cache;
+	/* The read lock of the volume prevents the store metadata from being released while it is used
+	 */
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_store->internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab volume read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
 	read_count = libvshadow_store_descriptor_read_buffer(
 		      store_descriptor,
 		      file_io_handle,
+		      block_cache,
 		      (uint8_t *) buffer,
 		      buffer_size,
-		      internal_store->current_offset,
-		      store_descriptor,
+		      offset,
 		      error );
 
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_store->internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release volume read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+
 	if( read_count != (ssize_t) buffer_size )
 	{
 		libcerror_error_set(
@@ -384,6 +424,80 @@ ssize_t libvshadow_internal_store_read_buffer_from_file_io_handle(
 
 		return( -1 );
 	}
+	if( libvshadow_internal_volume_mark_store_read(
+	     internal_store->internal_volume,
+	     internal_store->store_descriptor_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to mark store: %d as read.",
+		 function,
+		 internal_store->store_descriptor_index );
+
+		return( -1 );
+	}
+	return( read_count );
+}
+
+/* Reads (store) data at the current offset into a buffer using a Basic File IO (bfio) handle
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libvshadow_internal_store_read_buffer_from_file_io_handle(
+         libvshadow_internal_store_t *internal_store,
+         libbfio_handle_t *file_io_handle,
+         void *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	static char *function = "libvshadow_internal_store_read_buffer_from_file_io_handle";
+	ssize_t read_count    = 0;
+
+	if( internal_store == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_store->current_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid store - current offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	read_count = libvshadow_internal_store_read_buffer_at_offset_from_file_io_handle(
+		      internal_store,
+		      file_io_handle,
+		      buffer,
+		      buffer_size,
+		      internal_store->current_offset,
+		      error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer at offset: %" PRIi64 ".",
+		 function,
+		 internal_store->current_offset );
+
+		return( -1 );
+	}
 	internal_store->current_offset += read_count;
 
 	return( read_count );
@@ -544,18 +658,22 @@ ssize_t libvshadow_store_read_buffer_from_file_io_handle(
 	return( read_count );
 }
 
-/* Reads (store) data at a specific offset
+/* Reads (store) data at a specific offset into a buffer using a Basic File IO (bfio) handle
+ * The file IO handle must provide the same data as the file IO handle of the volume,
+ * which allows concurrent readers to each use their own file IO handle
+ * This function does not change the current offset
  * Returns the number of bytes read or -1 on error
  */
-ssize_t libvshadow_store_read_buffer_at_offset(
+ssize_t libvshadow_store_read_buffer_at_offset_from_file_io_handle(
          libvshadow_store_t *store,
+         libbfio_handle_t *file_io_handle,
          void *buffer,
          size_t buffer_size,
          off64_t offset,
          libcerror_error_t **error )
 {
 	libvshadow_internal_store_t *internal_store = NULL;
-	static char *function                       = "libvshadow_store_read_buffer_at_offset";
+	static char *function                       = "libvshadow_store_read_buffer_at_offset_from_file_io_handle";
 	ssize_t read_count                          = 0;
 
 	if( store == NULL )
@@ -571,41 +689,62 @@ ssize_t libvshadow_store_read_buffer_at_offset(
 	}
 	internal_store = (libvshadow_internal_store_t *) store;
 
-#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_store->read_write_lock,
-	     error ) != 1 )
+	read_count = libvshadow_internal_store_read_buffer_at_offset_from_file_io_handle(
+		      internal_store,
+		      file_io_handle,
+		      buffer,
+		      buffer_size,
+		      offset,
+		      error );
+
+	if( read_count == -1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	if( libvshadow_internal_store_seek_offset(
-	     internal_store,
-	     offset,
-	     SEEK_SET,
-	     error ) == -1 )
+	return( read_count );
+}
+
+/* Reads (store) data at a specific offset
+ * Only updating the current offset requires the write lock
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libvshadow_store_read_buffer_at_offset(
+         libvshadow_store_t *store,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libvshadow_internal_store_t *internal_store = NULL;
+	static char *function                       = "libvshadow_store_read_buffer_at_offset";
+	ssize_t read_count                          = 0;
+
+	if( store == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	read_count = libvshadow_internal_store_read_buffer_from_file_io_handle(
+	internal_store = (libvshadow_internal_store_t *) store;
+
+	read_count = libvshadow_internal_store_read_buffer_at_offset_from_file_io_handle(
 		      internal_store,
 		      internal_store->file_io_handle,
 		      buffer,
 		      buffer_size,
+		      offset,
 		      error );
 
 	if( read_count == -1 )
@@ -617,10 +756,10 @@ ssize_t libvshadow_store_read_buffer_at_offset(
 		 "%s: unable to read buffer.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
 #if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
+	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_store->read_write_lock,
 	     error ) != 1 )
 	{
@@ -628,36 +767,55 @@ ssize_t libvshadow_store_read_buffer_at_offset(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	return( read_count );
+	internal_store->current_offset = offset + read_count;
 
-on_error:
 #if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_write(
-	 internal_store->read_write_lock,
-	 NULL );
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_store->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
 #endif
-	return( -1 );
+	return( read_count );
 }
 
-/* Seeks a certain offset of the (store) data
- * This function is not multi-thread safe acquire write lock before call
- * Returns the offset if seek is successful or -1 on error
+/* Reads (store) data at specific offsets into multiple buffers
+ * All ranges are resolved and read in a single pass, where the data of ranges that overlap
+ * or are adjacent in the volume is read once. The data beyond the volume size is not read
+ * This function does not change the current offset
+ * Returns the number of bytes read or -1 on error
  */
-off64_t libvshadow_internal_store_seek_offset(
-         libvshadow_internal_store_t *internal_store,
-         off64_t offset,
-         int whence,
+ssize_t libvshadow_store_read_buffers_at_offsets(
+         libvshadow_store_t *store,
+         void **buffers,
+         size_t *buffer_sizes,
+         off64_t *offsets,
+         int number_of_buffers,
          libcerror_error_t **error )
 {
-	static char *function = "libvshadow_internal_store_seek_offset";
+	libvshadow_block_cache_t *block_cache           = NULL;
+	libvshadow_internal_store_t *internal_store     = NULL;
+	libvshadow_store_descriptor_t *store_descriptor = NULL;
+	size_t *read_sizes                              = NULL;
+	static char *function                           = "libvshadow_store_read_buffers_at_offsets";
+	ssize_t read_count                              = 0;
+	int buffer_index                                = 0;
 
-	if( internal_store == NULL )
+	if( store == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -668,6 +826,8 @@ off64_t libvshadow_internal_store_seek_offset(
 
 		return( -1 );
 	}
+	internal_store = (libvshadow_internal_store_t *) store;
+
 	if( internal_store->internal_volume == NULL )
 	{
 		libcerror_error_set(
@@ -679,86 +839,296 @@ off64_t libvshadow_internal_store_seek_offset(
 
 		return( -1 );
 	}
-	if( ( whence != SEEK_CUR )
-	 && ( whence != SEEK_END )
-	 && ( whence != SEEK_SET ) )
+	if( buffer_sizes == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported whence.",
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer sizes.",
 		 function );
 
 		return( -1 );
 	}
-	if( whence == SEEK_CUR )
-	{
-		offset += internal_store->current_offset;
-	}
-	else if( whence == SEEK_END )
-	{
-		offset += (off64_t) internal_store->internal_volume->size;
-	}
-	if( offset < 0 )
+	if( offsets == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid offset value out of bounds.",
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offsets.",
 		 function );
 
 		return( -1 );
 	}
-	internal_store->current_offset = offset;
-
-	return( offset );
-}
-
-/* Seeks a certain offset of the (store) data
- * Returns the offset if seek is successful or -1 on error
- */
-off64_t libvshadow_store_seek_offset(
-         libvshadow_store_t *store,
-         off64_t offset,
-         int whence,
-         libcerror_error_t **error )
-{
-	libvshadow_internal_store_t *internal_store = NULL;
-	static char *function                       = "libvshadow_store_seek_offset";
-
-	if( store == NULL )
+	if( ( number_of_buffers <= 0 )
+	 || ( (size_t) number_of_buffers > ( (size_t) SSIZE_MAX / sizeof( size_t ) ) ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid store.",
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of buffers value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-	internal_store = (libvshadow_internal_store_t *) store;
+	read_sizes = (size_t *) memory_allocate(
+	                         sizeof( size_t ) * number_of_buffers );
 
-#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_store->read_write_lock,
-	     error ) != 1 )
+	if( read_sizes == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create read sizes.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-#endif
-	offset = libvshadow_internal_store_seek_offset(
-	          internal_store,
-	          offset,
+	for( buffer_index = 0;
+	     buffer_index < number_of_buffers;
+	     buffer_index++ )
+	{
+		if( offsets[ buffer_index ] < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid offset: %d value out of bounds.",
+			 function,
+			 buffer_index );
+
+			goto on_error;
+		}
+		read_sizes[ buffer_index ] = buffer_sizes[ buffer_index ];
+
+		if( (size64_t) offsets[ buffer_index ] >= internal_store->internal_volume->size )
+		{
+			read_sizes[ buffer_index ] = 0;
+		}
+		else if( (size64_t) read_sizes[ buffer_index ] > ( internal_store->internal_volume->size - offsets[ buffer_index ] ) )
+		{
+			read_sizes[ buffer_index ] = (size_t) ( internal_store->internal_volume->size - offsets[ buffer_index ] );
+		}
+	}
+	if( libcdata_array_get_entry_by_index(
+	     internal_store->internal_volume->store_descriptors_array,
+	     internal_store->store_descriptor_index,
+	     (intptr_t **) &store_descriptor,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve store descriptor: %d.",
+		 function,
+		 internal_store->store_descriptor_index );
+
+		goto on_error;
+	}
+	block_cache = internal_store->internal_volume->block_cache;
+	/* The read lock of the volume prevents the store metadata from being released while it is used
+	 */
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_store->internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab volume read/write lock for reading.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	read_count = libvshadow_store_descriptor_read_buffers(
+		      store_descriptor,
+		      internal_store->file_io_handle,
+		      block_cache,
+		      (uint8_t **) buffers,
+		      read_sizes,
+		      offsets,
+		      number_of_buffers,
+		      error );
+
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_store->internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release volume read/write lock for reading.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffers from store descriptor: %d.",
+		 function,
+		 internal_store->store_descriptor_index );
+
+		goto on_error;
+	}
+	if( libvshadow_internal_volume_mark_store_read(
+	     internal_store->internal_volume,
+	     internal_store->store_descriptor_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to mark store: %d as read.",
+		 function,
+		 internal_store->store_descriptor_index );
+
+		goto on_error;
+	}
+	memory_free(
+	 read_sizes );
+
+	return( read_count );
+
+on_error:
+	if( read_sizes != NULL )
+	{
+		memory_free(
+		 read_sizes );
+	}
+	return( -1 );
+}
+
+/* Seeks a certain offset of the (store) data
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the offset if seek is successful or -1 on error
+ */
+off64_t libvshadow_internal_store_seek_offset(
+         libvshadow_internal_store_t *internal_store,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error )
+{
+	static char *function = "libvshadow_internal_store_seek_offset";
+
+	if( internal_store == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_store->internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid store - missing internal volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( whence != SEEK_CUR )
+	 && ( whence != SEEK_END )
+	 && ( whence != SEEK_SET ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported whence.",
+		 function );
+
+		return( -1 );
+	}
+	if( whence == SEEK_CUR )
+	{
+		offset += internal_store->current_offset;
+	}
+	else if( whence == SEEK_END )
+	{
+		offset += (off64_t) internal_store->internal_volume->size;
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	internal_store->current_offset = offset;
+
+	return( offset );
+}
+
+/* Seeks a certain offset of the (store) data
+ * Returns the offset if seek is successful or -1 on error
+ */
+off64_t libvshadow_store_seek_offset(
+         libvshadow_store_t *store,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error )
+{
+	libvshadow_internal_store_t *internal_store = NULL;
+	static char *function                       = "libvshadow_store_seek_offset";
+
+	if( store == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store.",
+		 function );
+
+		return( -1 );
+	}
+	internal_store = (libvshadow_internal_store_t *) store;
+
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_store->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	offset = libvshadow_internal_store_seek_offset(
+	          internal_store,
+	          offset,
 	          whence,
 	          error );
 
@@ -1417,7 +1787,8 @@ int libvshadow_store_get_block_by_index(
      libvshadow_block_t **block,
      libcerror_error_t **error )
 {
-	libvshadow_block_descriptor_t *block_descriptor = NULL;
+	libvshadow_block_descriptor_t block_descriptor;
+
 	libvshadow_internal_store_t *internal_store     = NULL;
 	libvshadow_store_descriptor_t *store_descriptor = NULL;
 	static char *function                           = "libvshadow_store_get_block_by_index";
@@ -1504,7 +1875,7 @@ int libvshadow_store_get_block_by_index(
 	}
 	if( libvshadow_block_initialize(
 	     block,
-	     block_descriptor,
+	     &block_descriptor,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
@@ -1520,3 +1891,426 @@ int libvshadow_store_get_block_by_index(
 	return( 1 );
 }
 
+/* Retrieves the values of a range of blocks
+ * The values are copied into the arrays, which must contain at least number of blocks entries,
+ * arrays of values that are not needed can be NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_store_get_block_values(
+     libvshadow_store_t *store,
+     int first_block_index,
+     int number_of_blocks,
+     off64_t *original_offsets,
+     off64_t *relative_offsets,
+     off64_t *offsets,
+     uint32_t *flags,
+     uint32_t *bitmaps,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_store_t *internal_store     = NULL;
+	libvshadow_store_descriptor_t *store_descriptor = NULL;
+	static char *function                           = "libvshadow_store_get_block_values";
+
+	if( store == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store.",
+		 function );
+
+		return( -1 );
+	}
+	internal_store = (libvshadow_internal_store_t *) store;
+
+	if( internal_store->internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid store - missing internal volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_entry_by_index(
+	     internal_store->internal_volume->store_descriptors_array,
+	     internal_store->store_descriptor_index,
+	     (intptr_t **) &store_descriptor,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve store descriptor: %d.",
+		 function,
+		 internal_store->store_descriptor_index );
+
+		return( -1 );
+	}
+	if( libvshadow_store_descriptor_get_block_values(
+	     store_descriptor,
+	     internal_store->file_io_handle,
+	     first_block_index,
+	     number_of_blocks,
+	     original_offsets,
+	     relative_offsets,
+	     offsets,
+	     flags,
+	     bitmaps,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve values of blocks: %d to %d from store descriptor: %d.",
+		 function,
+		 first_block_index,
+		 first_block_index + number_of_blocks - 1,
+		 internal_store->store_descriptor_index );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the extent at a specific offset
+ * The extent starts at the offset and contains the following adjacent extents of the same type
+ * that are contiguous in the volume, where extent data offset contains the offset of the data
+ * relative to the start of the volume. The data of a sparse extent consists of 0-byte values
+ * Returns 1 if successful, 0 if the offset is beyond the store size or -1 on error
+ */
+int libvshadow_store_get_extent_at_offset(
+     libvshadow_store_t *store,
+     off64_t offset,
+     size64_t *extent_size,
+     off64_t *extent_data_offset,
+     uint8_t *extent_type,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_store_t *internal_store     = NULL;
+	libvshadow_store_descriptor_t *store_descriptor = NULL;
+	static char *function                           = "libvshadow_store_get_extent_at_offset";
+	int result                                      = 0;
+
+	if( store == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store.",
+		 function );
+
+		return( -1 );
+	}
+	internal_store = (libvshadow_internal_store_t *) store;
+
+	if( internal_store->internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid store - missing internal volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_entry_by_index(
+	     internal_store->internal_volume->store_descriptors_array,
+	     internal_store->store_descriptor_index,
+	     (intptr_t **) &store_descriptor,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve store descriptor: %d.",
+		 function,
+		 internal_store->store_descriptor_index );
+
+		return( -1 );
+	}
+	/* The read lock of the volume prevents the store metadata from being released while it is used
+	 */
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_store->internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab volume read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libvshadow_store_descriptor_get_extent_at_offset(
+	          store_descriptor,
+	          internal_store->file_io_handle,
+	          offset,
+	          extent_size,
+	          extent_data_offset,
+	          extent_type,
+	          error );
+
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_store->internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release volume read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve extent at offset: %" PRIi64 " (0x%08" PRIx64 ") from store descriptor: %d.",
+		 function,
+		 offset,
+		 offset,
+		 internal_store->store_descriptor_index );
+
+		return( -1 );
+	}
+	if( libvshadow_internal_volume_mark_store_read(
+	     internal_store->internal_volume,
+	     internal_store->store_descriptor_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to mark store: %d as read.",
+		 function,
+		 internal_store->store_descriptor_index );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Retrieves the next range, at or after a specific offset, that contains data
+ * The data outside these ranges consists of 0-byte values, which allows to skip it
+ * Returns 1 if successful, 0 if no such range or -1 on error
+ */
+int libvshadow_store_get_next_data_range(
+     libvshadow_store_t *store,
+     off64_t offset,
+     off64_t *range_offset,
+     size64_t *range_size,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_store_t *internal_store     = NULL;
+	libvshadow_store_descriptor_t *store_descriptor = NULL;
+	static char *function                           = "libvshadow_store_get_next_data_range";
+	int result                                      = 0;
+
+	if( store == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store.",
+		 function );
+
+		return( -1 );
+	}
+	internal_store = (libvshadow_internal_store_t *) store;
+
+	if( internal_store->internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid store - missing internal volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_entry_by_index(
+	     internal_store->internal_volume->store_descriptors_array,
+	     internal_store->store_descriptor_index,
+	     (intptr_t **) &store_descriptor,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve store descriptor: %d.",
+		 function,
+		 internal_store->store_descriptor_index );
+
+		return( -1 );
+	}
+	/* The read lock of the volume prevents the store metadata from being released while it is used
+	 */
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_store->internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab volume read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libvshadow_store_descriptor_get_next_data_range(
+	          store_descriptor,
+	          internal_store->file_io_handle,
+	          offset,
+	          range_offset,
+	          range_size,
+	          error );
+
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_store->internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release volume read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve next data range at offset: %" PRIi64 " (0x%08" PRIx64 ") from store descriptor: %d.",
+		 function,
+		 offset,
+		 offset,
+		 internal_store->store_descriptor_index );
+
+		return( -1 );
+	}
+	if( libvshadow_internal_volume_mark_store_read(
+	     internal_store->internal_volume,
+	     internal_store->store_descriptor_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to mark store: %d as read.",
+		 function,
+		 internal_store->store_descriptor_index );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+
+/* Retrieves the size of the memory used by the metadata of the store
+ * This includes the block descriptors, block indexes, bitmaps and extent map
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_store_get_metadata_size(
+     libvshadow_store_t *store,
+     size64_t *metadata_size,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_store_t *internal_store     = NULL;
+	libvshadow_store_descriptor_t *store_descriptor = NULL;
+	static char *function                           = "libvshadow_store_get_metadata_size";
+	size64_t releasable_metadata_size               = 0;
+
+	if( store == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store.",
+		 function );
+
+		return( -1 );
+	}
+	internal_store = (libvshadow_internal_store_t *) store;
+
+	if( internal_store->internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid store - missing internal volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_entry_by_index(
+	     internal_store->internal_volume->store_descriptors_array,
+	     internal_store->store_descriptor_index,
+	     (intptr_t **) &store_descriptor,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve store descriptor: %d.",
+		 function,
+		 internal_store->store_descriptor_index );
+
+		return( -1 );
+	}
+	if( libvshadow_store_descriptor_get_metadata_size(
+	     store_descriptor,
+	     metadata_size,
+	     &releasable_metadata_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve metadata size of store descriptor: %d.",
+		 function,
+		 internal_store->store_descriptor_index );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
@@ -85,6 +85,14 @@ int libvshadow_store_has_in_volume_data(
      libvshadow_store_t *store,
      libcerror_error_t **error );
 
+ssize_t libvshadow_internal_store_read_buffer_at_offset_from_file_io_handle(
+         libvshadow_internal_store_t *internal_store,
+         libbfio_handle_t *file_io_handle,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error );
+
 ssize_t libvshadow_internal_store_read_buffer_from_file_io_handle(
          libvshadow_internal_store_t *internal_store,
          libbfio_handle_t *file_io_handle,
@@ -107,6 +115,15 @@ ssize_t libvshadow_store_read_buffer_from_file_io_handle(
          size_t buffer_size,
          libcerror_error_t **error );
 
+LIBVSHADOW_EXTERN \
+ssize_t libvshadow_store_read_buffer_at_offset_from_file_io_handle(
+         libvshadow_store_t *store,
+         libbfio_handle_t *file_io_handle,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error );
+
 LIBVSHADOW_EXTERN \
 ssize_t libvshadow_store_read_buffer_at_offset(
          libvshadow_store_t *store,
@@ -115,6 +132,15 @@ ssize_t libvshadow_store_read_buffer_at_offset(
          off64_t offset,
          libcerror_error_t **error );
 
+LIBVSHADOW_EXTERN \
+ssize_t libvshadow_store_read_buffers_at_offsets(
+         libvshadow_store_t *store,
+         void **buffers,
+         size_t *buffer_sizes,
+         off64_t *offsets,
+         int number_of_buffers,
+         libcerror_error_t **error );
+
 off64_t libvshadow_internal_store_seek_offset(
          libvshadow_internal_store_t *internal_store,
          off64_t offset,
@@ -192,6 +218,41 @@ int libvshadow_store_get_block_by_index(
      libvshadow_block_t **block,
      libcerror_error_t **error );
 
+LIBVSHADOW_EXTERN \
+int libvshadow_store_get_block_values(
+     libvshadow_store_t *store,
+     int first_block_index,
+     int number_of_blocks,
+     off64_t *original_offsets,
+     off64_t *relative_offsets,
+     off64_t *offsets,
+     uint32_t *flags,
+     uint32_t *bitmaps,
+     libcerror_error_t **error );
+
+LIBVSHADOW_EXTERN \
+int libvshadow_store_get_extent_at_offset(
+     libvshadow_store_t *store,
+     off64_t offset,
+     size64_t *extent_size,
+     off64_t *extent_data_offset,
+     uint8_t *extent_type,
+     libcerror_error_t **error );
+
+LIBVSHADOW_EXTERN \
+int libvshadow_store_get_next_data_range(
+     libvshadow_store_t *store,
+     off64_t offset,
+     off64_t *range_offset,
+     size64_t *range_size,
+     libcerror_error_t **error );
+
+LIBVSHADOW_EXTERN \
+int libvshadow_store_get_metadata_size(
+     libvshadow_store_t *store,
+     size64_t *metadata_size,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
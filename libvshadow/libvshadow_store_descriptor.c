@@ -23,7 +23,11 @@
 #include <memory.h>
 #include <types.h>
 
+#include "libvshadow_bitmap.h"
+#include "libvshadow_block_cache.h"
 #include "libvshadow_block_descriptor.h"
+#include "libvshadow_block_descriptor_arena.h"
+#include "libvshadow_block_index.h"
 #include "libvshadow_block_range_descriptor.h"
 #include "libvshadow_block_tree.h"
 #include "libvshadow_debug.h"
@@ -37,6 +41,8 @@
 #include "libvshadow_libfdatetime.h"
 #include "libvshadow_libfguid.h"
 #include "libvshadow_libuna.h"
+#include "libvshadow_metadata_reader.h"
+#include "libvshadow_read_list.h"
 #include "libvshadow_store_block.h"
 #include "libvshadow_store_descriptor.h"
 
@@ -107,21 +113,22 @@ int libvshadow_store_descriptor_initialize(
 
 		return( -1 );
 	}
-	if( libcdata_list_initialize(
-	     &( ( *store_descriptor )->block_descriptors_list ),
+	if( libcdata_btree_initialize(
+	     &( ( *store_descriptor )->forward_block_descriptors_tree ),
+	     LIBVSHADOW_BLOCK_DESCRIPTORS_TREE_MAXIMUM_NUMBER_OF_SUB_NODES,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create block descriptors list.",
+		 "%s: unable to create forward block descriptors tree.",
 		 function );
 
 		goto on_error;
 	}
 	if( libcdata_btree_initialize(
-	     &( ( *store_descriptor )->forward_block_descriptors_tree ),
+	     &( ( *store_descriptor )->reverse_block_descriptors_tree ),
 	     LIBVSHADOW_BLOCK_DESCRIPTORS_TREE_MAXIMUM_NUMBER_OF_SUB_NODES,
 	     error ) != 1 )
 	{
@@ -129,47 +136,59 @@ int libvshadow_store_descriptor_initialize(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create forward block descriptors tree.",
+		 "%s: unable to create reverse block descriptors tree.",
 		 function );
 
 		goto on_error;
 	}
-	if( libcdata_btree_initialize(
-	     &( ( *store_descriptor )->reverse_block_descriptors_tree ),
-	     LIBVSHADOW_BLOCK_DESCRIPTORS_TREE_MAXIMUM_NUMBER_OF_SUB_NODES,
+	if( libvshadow_block_descriptor_arena_initialize(
+	     &( ( *store_descriptor )->block_descriptor_arena ),
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create reverse block descriptors tree.",
+		 "%s: unable to create block descriptor arena.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvshadow_block_index_initialize(
+	     &( ( *store_descriptor )->block_list_index ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create block list index.",
 		 function );
 
 		goto on_error;
 	}
-	if( libcdata_range_list_initialize(
-	     &( ( *store_descriptor )->block_offset_list ),
+	if( libvshadow_bitmap_initialize(
+	     &( ( *store_descriptor )->bitmap ),
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create block offsets list.",
+		 "%s: unable to create bitmap.",
 		 function );
 
 		goto on_error;
 	}
-	if( libcdata_range_list_initialize(
-	     &( ( *store_descriptor )->previous_block_offset_list ),
+	if( libvshadow_bitmap_initialize(
+	     &( ( *store_descriptor )->previous_bitmap ),
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create previous block offsets list.",
+		 "%s: unable to create previous bitmap.",
 		 function );
 
 		goto on_error;
@@ -194,11 +213,28 @@ int libvshadow_store_descriptor_initialize(
 on_error:
 	if( *store_descriptor != NULL )
 	{
-		if( ( *store_descriptor )->block_offset_list != NULL )
+		if( ( *store_descriptor )->previous_bitmap != NULL )
 		{
-			libcdata_range_list_free(
-			 &( ( *store_descriptor )->block_offset_list ),
-			 NULL,
+			libvshadow_bitmap_free(
+			 &( ( *store_descriptor )->previous_bitmap ),
+			 NULL );
+		}
+		if( ( *store_descriptor )->bitmap != NULL )
+		{
+			libvshadow_bitmap_free(
+			 &( ( *store_descriptor )->bitmap ),
+			 NULL );
+		}
+		if( ( *store_descriptor )->block_list_index != NULL )
+		{
+			libvshadow_block_index_free(
+			 &( ( *store_descriptor )->block_list_index ),
+			 NULL );
+		}
+		if( ( *store_descriptor )->block_descriptor_arena != NULL )
+		{
+			libvshadow_block_descriptor_arena_free(
+			 &( ( *store_descriptor )->block_descriptor_arena ),
 			 NULL );
 		}
 		if( ( *store_descriptor )->reverse_block_descriptors_tree != NULL )
@@ -215,13 +251,6 @@ on_error:
 			 NULL,
 			 NULL );
 		}
-		if( ( *store_descriptor )->block_descriptors_list != NULL )
-		{
-			libcdata_list_free(
-			 &( ( *store_descriptor )->block_descriptors_list ),
-			 NULL,
-			 NULL );
-		}
 		memory_free(
 		 *store_descriptor );
 
@@ -278,9 +307,60 @@ int libvshadow_store_descriptor_free(
 			memory_free(
 			 ( *store_descriptor )->service_machine_string );
 		}
+		if( ( *store_descriptor )->extent_map != NULL )
+		{
+			if( libvshadow_extent_map_free(
+			     &( ( *store_descriptor )->extent_map ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free extent map.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *store_descriptor )->reverse_block_index != NULL )
+		{
+			if( libvshadow_block_index_free(
+			     &( ( *store_descriptor )->reverse_block_index ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free reverse block index.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *store_descriptor )->forward_block_index != NULL )
+		{
+			if( libvshadow_block_index_free(
+			     &( ( *store_descriptor )->forward_block_index ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free forward block index.",
+				 function );
+
+				result = -1;
+			}
+		}
+		/* The block descriptors trees and arena are freed once the block indexes have been built
+		 * The block descriptors in the trees are owned by the block descriptor arena
+		 */
 		if( libcdata_btree_free(
 		     &( ( *store_descriptor )->reverse_block_descriptors_tree ),
-		     (int (*)(intptr_t **, libcerror_error_t **)) &libvshadow_block_descriptor_free_reverse,
+		     NULL,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
@@ -294,7 +374,7 @@ int libvshadow_store_descriptor_free(
 		}
 		if( libcdata_btree_free(
 		     &( ( *store_descriptor )->forward_block_descriptors_tree ),
-		     (int (*)(intptr_t **, libcerror_error_t **)) &libvshadow_block_descriptor_free,
+		     NULL,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
@@ -306,44 +386,57 @@ int libvshadow_store_descriptor_free(
 
 			result = -1;
 		}
-		if( libcdata_list_free(
-		     &( ( *store_descriptor )->block_descriptors_list ),
-		     (int (*)(intptr_t **, libcerror_error_t **)) &libvshadow_block_descriptor_free,
+		if( ( *store_descriptor )->block_descriptor_arena != NULL )
+		{
+			if( libvshadow_block_descriptor_arena_free(
+			     &( ( *store_descriptor )->block_descriptor_arena ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free block descriptor arena.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( libvshadow_block_index_free(
+		     &( ( *store_descriptor )->block_list_index ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free forward block descriptors tree.",
+			 "%s: unable to free block list index.",
 			 function );
 
 			result = -1;
 		}
-		if( libcdata_range_list_free(
-		     &( ( *store_descriptor )->block_offset_list ),
-		     NULL,
+		if( libvshadow_bitmap_free(
+		     &( ( *store_descriptor )->bitmap ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free block offsets list.",
+			 "%s: unable to free bitmap.",
 			 function );
 
 			result = -1;
 		}
-		if( libcdata_range_list_free(
-		     &( ( *store_descriptor )->previous_block_offset_list ),
-		     NULL,
+		if( libvshadow_bitmap_free(
+		     &( ( *store_descriptor )->previous_bitmap ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free previous block offsets list.",
+			 "%s: unable to free previous bitmap.",
 			 function );
 
 			result = -1;
@@ -838,6 +931,7 @@ on_error:
 int libvshadow_store_descriptor_read_store_header(
      libvshadow_store_descriptor_t *store_descriptor,
      libbfio_handle_t *file_io_handle,
+     libvshadow_metadata_reader_t *metadata_reader,
      libcerror_error_t **error )
 {
 	libvshadow_store_block_t *store_block = NULL;
@@ -875,25 +969,12 @@ int libvshadow_store_descriptor_read_store_header(
 		return( -1 );
 	}
 #endif
-	if( libvshadow_store_block_initialize(
-	     &store_block,
-	     0x4000,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create store block.",
-		 function );
-
-		goto on_error;
-	}
-	if( libvshadow_store_block_read(
-	     store_block,
+	if( libvshadow_metadata_reader_read_store_block(
+	     metadata_reader,
 	     file_io_handle,
 	     store_descriptor->store_header_offset,
-	     error ) == -1 )
+	     &store_block,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
@@ -915,7 +996,7 @@ int libvshadow_store_descriptor_read_store_header(
 		 function,
 		 store_block->record_type );
 
-		return( -1 );
+		goto on_error;
 	}
 	store_header_data = &( store_block->data[ sizeof( vshadow_store_header_t ) ] );
 
@@ -1209,19 +1290,6 @@ int libvshadow_store_descriptor_read_store_header(
 		}
 	}
 #endif
-	if( libvshadow_store_block_free(
-	     &store_block,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free store block.",
-		 function );
-
-		goto on_error;
-	}
 #if defined( HAVE_DEBUG_OUTPUT )
 	if( libcnotify_verbose != 0 )
 	{
@@ -1247,12 +1315,6 @@ int libvshadow_store_descriptor_read_store_header(
 	return( 1 );
 
 on_error:
-	if( store_block != NULL )
-	{
-		libvshadow_store_block_free(
-		 &store_block,
-		 NULL );
-	}
 #if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
 	libcthreads_read_write_lock_release_for_write(
 	 store_descriptor->read_write_lock,
@@ -1262,25 +1324,31 @@ on_error:
 }
 
 /* Reads the store bitmap
+ * The bitmap data is appended to the bitmap
  * This function is not multi-thread safe acquire write lock before call
  * Returns 1 if successful or -1 on error
  */
 int libvshadow_store_descriptor_read_store_bitmap(
      libvshadow_store_descriptor_t *store_descriptor,
      libbfio_handle_t *file_io_handle,
+     libvshadow_metadata_reader_t *metadata_reader,
      off64_t file_offset,
-     libcdata_range_list_t *offset_list,
-     off64_t *bitmap_offset,
+     libvshadow_bitmap_t *bitmap,
      off64_t *next_offset,
      libcerror_error_t **error )
 {
 	libvshadow_store_block_t *store_block = NULL;
 	uint8_t *block_data                   = NULL;
 	static char *function                 = "libvshadow_store_descriptor_read_store_bitmap";
-	off64_t start_offset                  = 0;
-	uint32_t value_32bit                  = 0;
 	uint16_t block_size                   = 0;
-	uint8_t bit_index                     = 0;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	off64_t bitmap_offset                 = 0;
+	size_t bit_index                      = 0;
+	size_t number_of_bits                 = 0;
+	size_t run_number_of_bits             = 0;
+	uint8_t bit_value                     = 0;
+#endif
 
 	if( store_descriptor == NULL )
 	{
@@ -1293,13 +1361,13 @@ int libvshadow_store_descriptor_read_store_bitmap(
 
 		return( -1 );
 	}
-	if( bitmap_offset == NULL )
+	if( bitmap == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid bitmap offset.",
+		 "%s: invalid bitmap.",
 		 function );
 
 		return( -1 );
@@ -1315,25 +1383,12 @@ int libvshadow_store_descriptor_read_store_bitmap(
 
 		return( -1 );
 	}
-	if( libvshadow_store_block_initialize(
-	     &store_block,
-	     0x4000,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create store block.",
-		 function );
-
-		goto on_error;
-	}
-	if( libvshadow_store_block_read(
-	     store_block,
+	if( libvshadow_metadata_reader_read_store_block(
+	     metadata_reader,
 	     file_io_handle,
 	     file_offset,
-	     error ) == -1 )
+	     &store_block,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
@@ -1343,7 +1398,7 @@ int libvshadow_store_descriptor_read_store_bitmap(
 		 function,
 		 file_offset );
 
-		goto on_error;
+		return( -1 );
 	}
 	if( store_block->record_type != LIBVSHADOW_RECORD_TYPE_STORE_BITMAP )
 	{
@@ -1355,7 +1410,7 @@ int libvshadow_store_descriptor_read_store_bitmap(
 		 function,
 		 store_block->record_type );
 
-		goto on_error;
+		return( -1 );
 	}
 	*next_offset = store_block->next_offset;
 
@@ -1373,116 +1428,59 @@ int libvshadow_store_descriptor_read_store_bitmap(
 		 block_data,
 		 block_size,
 		 LIBCNOTIFY_PRINT_DATA_FLAG_GROUP_DATA );
-	}
-#endif
-	start_offset = -1;
 
-	while( block_size > 0 )
-	{
-		byte_stream_copy_to_uint32_little_endian(
-		 block_data,
-		 value_32bit );
+		bitmap_offset  = (off64_t) bitmap->data_size * 8 * 0x4000;
+		number_of_bits = (size_t) block_size * 8;
 
-		for( bit_index = 0;
-		     bit_index < 32;
-		     bit_index++ )
+		while( bit_index < number_of_bits )
 		{
-			if( ( value_32bit & 0x00000001UL ) == 0 )
+			if( libvshadow_bitmap_get_run(
+			     block_data,
+			     (size_t) block_size,
+			     bit_index,
+			     &bit_value,
+			     &run_number_of_bits,
+			     error ) != 1 )
 			{
-				if( start_offset >= 0 )
-				{
-#if defined( HAVE_DEBUG_OUTPUT )
-					if( libcnotify_verbose != 0 )
-					{
-						libcnotify_printf(
-						 "%s: store: %02d offset range\t: 0x%08" PRIx64 " - 0x%08" PRIx64 " (0x%08" PRIx64 ")\n",
-						 function,
-						 store_descriptor->index,
-						 start_offset,
-						 *bitmap_offset,
-						 *bitmap_offset - start_offset );
-					}
-#endif
-					if( libcdata_range_list_insert_range(
-					     offset_list,
-					     (uint64_t) start_offset,
-					     (uint64_t) ( *bitmap_offset - start_offset ),
-					     NULL,
-					     NULL,
-					     NULL,
-					     error ) != 1 )
-					{
-						libcerror_error_set(
-						 error,
-						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-						 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-						 "%s: unable to insert offset range to offset list.",
-						 function );
-
-						goto on_error;
-					}
-					start_offset = -1;
-				}
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve bitmap run at bit: %" PRIzd ".",
+				 function,
+				 bit_index );
+
+				return( -1 );
 			}
-			else
+			if( bit_value != 0 )
 			{
-				if( start_offset < 0 )
-				{
-					start_offset = *bitmap_offset;
-				}
+				libcnotify_printf(
+				 "%s: store: %02d offset range\t: 0x%08" PRIx64 " - 0x%08" PRIx64 " (0x%08" PRIx64 ")\n",
+				 function,
+				 store_descriptor->index,
+				 bitmap_offset,
+				 bitmap_offset + ( (off64_t) run_number_of_bits * 0x4000 ),
+				 (off64_t) run_number_of_bits * 0x4000 );
 			}
-			*bitmap_offset += 0x4000;
-
-			value_32bit >>= 1;
+			bitmap_offset += (off64_t) run_number_of_bits * 0x4000;
+			bit_index     += run_number_of_bits;
 		}
-		block_data += 4;
-		block_size -= 4;
 	}
-	if( start_offset >= 0 )
-	{
-#if defined( HAVE_DEBUG_OUTPUT )
-		if( libcnotify_verbose != 0 )
-		{
-			libcnotify_printf(
-			 "%s: store: %02d offset range\t: 0x%08" PRIx64 " - 0x%08" PRIx64 " (0x%08" PRIx64 ")\n",
-			 function,
-			 store_descriptor->index,
-			 start_offset,
-			 *bitmap_offset,
-			 *bitmap_offset - start_offset );
-		}
 #endif
-		if( libcdata_range_list_insert_range(
-		     offset_list,
-		     (uint64_t) start_offset,
-		     (uint64_t) ( *bitmap_offset - start_offset ),
-		     NULL,
-		     NULL,
-		     NULL,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-			 "%s: unable to append offset range to offset list.",
-			 function );
-
-			goto on_error;
-		}
-	}
-	if( libvshadow_store_block_free(
-	     &store_block,
+	if( libvshadow_bitmap_append_data(
+	     bitmap,
+	     block_data,
+	     (size_t) block_size,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free store block.",
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append block data to bitmap.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
 #if defined( HAVE_DEBUG_OUTPUT )
 	if( libcnotify_verbose != 0 )
@@ -1492,15 +1490,6 @@ int libvshadow_store_descriptor_read_store_bitmap(
 	}
 #endif
 	return( 1 );
-
-on_error:
-	if( store_block != NULL )
-	{
-		libvshadow_store_block_free(
-		 &store_block,
-		 NULL );
-	}
-	return( -1 );
 }
 
 /* Reads the store block list
@@ -1510,6 +1499,7 @@ on_error:
 int libvshadow_store_descriptor_read_store_block_list(
      libvshadow_store_descriptor_t *store_descriptor,
      libbfio_handle_t *file_io_handle,
+     libvshadow_metadata_reader_t *metadata_reader,
      off64_t file_offset,
      off64_t *next_offset,
      libcerror_error_t **error )
@@ -1543,25 +1533,12 @@ int libvshadow_store_descriptor_read_store_block_list(
 
 		return( -1 );
 	}
-	if( libvshadow_store_block_initialize(
-	     &store_block,
-	     0x4000,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create store block.",
-		 function );
-
-		goto on_error;
-	}
-	if( libvshadow_store_block_read(
-	     store_block,
+	if( libvshadow_metadata_reader_read_store_block(
+	     metadata_reader,
 	     file_io_handle,
 	     file_offset,
-	     error ) == -1 )
+	     &store_block,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
@@ -1590,21 +1567,24 @@ int libvshadow_store_descriptor_read_store_block_list(
 	block_data = &( store_block->data[ sizeof( vshadow_store_block_header_t ) ] );
 	block_size = (uint16_t) ( store_block->data_size - sizeof( vshadow_store_block_header_t ) );
 
-	while( block_size >= sizeof( vshadow_store_block_list_entry_t ) )
+	/* The block descriptor is reused for every entry, since the block descriptors
+	 * are cloned into the block descriptor arena and packed into the block list index
+	 */
+	if( libvshadow_block_descriptor_initialize(
+	     &block_descriptor,
+	     error ) != 1 )
 	{
-		if( libvshadow_block_descriptor_initialize(
-		     &block_descriptor,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create block descriptor.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create block descriptor.",
+		 function );
 
-			goto on_error;
-		}
+		goto on_error;
+	}
+	while( block_size >= sizeof( vshadow_store_block_list_entry_t ) )
+	{
 		result = libvshadow_block_descriptor_read_data(
 			  block_descriptor,
 			  block_data,
@@ -1628,6 +1608,7 @@ int libvshadow_store_descriptor_read_store_block_list(
 			if( libvshadow_block_tree_insert(
 			     store_descriptor->forward_block_descriptors_tree,
 			     store_descriptor->reverse_block_descriptors_tree,
+			     store_descriptor->block_descriptor_arena,
 			     block_descriptor,
 			     store_descriptor->index,
 			     error ) != 1 )
@@ -1641,53 +1622,33 @@ int libvshadow_store_descriptor_read_store_block_list(
 
 				goto on_error;
 			}
-			if( libcdata_list_append_value(
-			     store_descriptor->block_descriptors_list,
-			     (intptr_t *) block_descriptor,
+			if( libvshadow_store_descriptor_append_block_descriptor(
+			     store_descriptor,
+			     block_descriptor,
 			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-				 "%s: unable to append block descriptor to list.",
-				 function );
-
-				goto on_error;
-			}
-			block_descriptor = NULL;
-		}
-		if( block_descriptor != NULL )
-		{
-			if( libvshadow_block_descriptor_free(
-			     &block_descriptor,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-				 "%s: unable to free block descriptor.",
+				 "%s: unable to append block descriptor.",
 				 function );
 
-				block_descriptor = NULL;
-
 				goto on_error;
 			}
-			block_descriptor = NULL;
 		}
 		block_data += sizeof( vshadow_store_block_list_entry_t );
 		block_size -= sizeof( vshadow_store_block_list_entry_t );
 	}
-	if( libvshadow_store_block_free(
-	     &store_block,
+	if( libvshadow_block_descriptor_free(
+	     &block_descriptor,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free store block.",
+		 "%s: unable to free block descriptor.",
 		 function );
 
 		goto on_error;
@@ -1701,32 +1662,19 @@ on_error:
 		 &block_descriptor,
 		 NULL );
 	}
-	if( store_block != NULL )
-	{
-		libvshadow_store_block_free(
-		 &store_block,
-		 NULL );
-	}
 	return( -1 );
 }
 
-/* Reads the store block range list
+/* Appends a block descriptor to the block list index
  * This function is not multi-thread safe acquire write lock before call
  * Returns 1 if successful or -1 on error
  */
-int libvshadow_store_descriptor_read_store_block_range_list(
+int libvshadow_store_descriptor_append_block_descriptor(
      libvshadow_store_descriptor_t *store_descriptor,
-     libbfio_handle_t *file_io_handle,
-     off64_t file_offset,
-     off64_t *next_offset,
+     libvshadow_block_descriptor_t *block_descriptor,
      libcerror_error_t **error )
 {
-	libvshadow_store_block_t *store_block                       = NULL;
-	libvshadow_block_range_descriptor_t *block_range_descriptor = NULL;
-	uint8_t *block_data                                         = NULL;
-	static char *function                                       = "libvshadow_store_descriptor_read_store_block_range_list";
-	uint16_t block_size                                         = 0;
-	int result                                                  = 0;
+	static char *function = "libvshadow_store_descriptor_append_block_descriptor";
 
 	if( store_descriptor == NULL )
 	{
@@ -1739,36 +1687,70 @@ int libvshadow_store_descriptor_read_store_block_range_list(
 
 		return( -1 );
 	}
-	if( next_offset == NULL )
+	if( libvshadow_block_index_append_block_descriptor(
+	     store_descriptor->block_list_index,
+	     block_descriptor,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid next offset.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append block descriptor to block list index.",
 		 function );
 
 		return( -1 );
 	}
-	if( libvshadow_store_block_initialize(
-	     &store_block,
-	     0x4000,
-	     error ) != 1 )
+	return( 1 );
+}
+
+/* Reads the store block range list
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_store_descriptor_read_store_block_range_list(
+     libvshadow_store_descriptor_t *store_descriptor,
+     libbfio_handle_t *file_io_handle,
+     libvshadow_metadata_reader_t *metadata_reader,
+     off64_t file_offset,
+     off64_t *next_offset,
+     libcerror_error_t **error )
+{
+	libvshadow_store_block_t *store_block                       = NULL;
+	libvshadow_block_range_descriptor_t *block_range_descriptor = NULL;
+	uint8_t *block_data                                         = NULL;
+	static char *function                                       = "libvshadow_store_descriptor_read_store_block_range_list";
+	uint16_t block_size                                         = 0;
+	int result                                                  = 0;
+
+	if( store_descriptor == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create store block.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store descriptor.",
 		 function );
 
-		goto on_error;
+		return( -1 );
+	}
+	if( next_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid next offset.",
+		 function );
+
+		return( -1 );
 	}
-	if( libvshadow_store_block_read(
-	     store_block,
+	if( libvshadow_metadata_reader_read_store_block(
+	     metadata_reader,
 	     file_io_handle,
 	     file_offset,
-	     error ) == -1 )
+	     &store_block,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
@@ -1856,19 +1838,6 @@ int libvshadow_store_descriptor_read_store_block_range_list(
 		block_data += sizeof( vshadow_store_block_range_list_entry_t );
 		block_size -= sizeof( vshadow_store_block_range_list_entry_t );
 	}
-	if( libvshadow_store_block_free(
-	     &store_block,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free store block.",
-		 function );
-
-		goto on_error;
-	}
 	return( 1 );
 
 on_error:
@@ -1878,26 +1847,20 @@ on_error:
 		 &block_range_descriptor,
 		 NULL );
 	}
-	if( store_block != NULL )
-	{
-		libvshadow_store_block_free(
-		 &store_block,
-		 NULL );
-	}
 	return( -1 );
 }
 
-/* Reads the block descriptors
+/* Builds the block indexes from the block descriptors trees
+ * The block descriptors trees are freed afterwards since the block indexes replace them
  * Returns 1 if successful or -1 on error
  */
-int libvshadow_store_descriptor_read_block_descriptors(
+int libvshadow_store_descriptor_build_block_indexes(
      libvshadow_store_descriptor_t *store_descriptor,
-     libbfio_handle_t *file_io_handle,
      libcerror_error_t **error )
 {
-	static char *function      = "libvshadow_store_descriptor_read_block_descriptors";
-	off64_t bitmap_offset      = 0;
-	off64_t store_block_offset = 0;
+	libvshadow_block_descriptor_t **block_descriptors_array = NULL;
+	static char *function                                   = "libvshadow_store_descriptor_build_block_indexes";
+	int number_of_block_descriptors                         = 0;
 
 	if( store_descriptor == NULL )
 	{
@@ -1910,280 +1873,3042 @@ int libvshadow_store_descriptor_read_block_descriptors(
 
 		return( -1 );
 	}
-#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     store_descriptor->read_write_lock,
-	     error ) != 1 )
+	if( store_descriptor->forward_block_index != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid store descriptor - forward block index value already set.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	if( store_descriptor->block_descriptors_read == 0 )
+	if( store_descriptor->reverse_block_index != NULL )
 	{
-		bitmap_offset      = 0;
-		store_block_offset = store_descriptor->store_bitmap_offset;
-
-		while( store_block_offset != 0 )
-		{
-			if( libvshadow_store_descriptor_read_store_bitmap(
-			     store_descriptor,
-			     file_io_handle,
-			     store_block_offset,
-			     store_descriptor->block_offset_list,
-			     &bitmap_offset,
-			     &store_block_offset,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_IO,
-				 LIBCERROR_IO_ERROR_READ_FAILED,
-				 "%s: unable to read store bitmap.",
-				 function );
-
-				goto on_error;
-			}
-		}
-		bitmap_offset      = 0;
-		store_block_offset = store_descriptor->store_previous_bitmap_offset;
-
-		while( store_block_offset != 0 )
-		{
-			if( libvshadow_store_descriptor_read_store_bitmap(
-			     store_descriptor,
-			     file_io_handle,
-			     store_block_offset,
-			     store_descriptor->previous_block_offset_list,
-			     &bitmap_offset,
-			     &store_block_offset,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_IO,
-				 LIBCERROR_IO_ERROR_READ_FAILED,
-				 "%s: unable to read store previous bitmap.",
-				 function );
-
-				goto on_error;
-			}
-		}
-		store_block_offset = store_descriptor->store_block_list_offset;
-
-		while( store_block_offset != 0 )
-		{
-			if( libvshadow_store_descriptor_read_store_block_list(
-			     store_descriptor,
-			     file_io_handle,
-			     store_block_offset,
-			     &store_block_offset,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_IO,
-				 LIBCERROR_IO_ERROR_READ_FAILED,
-				 "%s: unable to read store block list.",
-				 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid store descriptor - reverse block index value already set.",
+		 function );
 
-				goto on_error;
-			}
-		}
-		store_block_offset = store_descriptor->store_block_range_list_offset;
+		return( -1 );
+	}
+	if( libvshadow_block_index_initialize(
+	     &( store_descriptor->forward_block_index ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create forward block index.",
+		 function );
 
-		while( store_block_offset != 0 )
-		{
-			if( libvshadow_store_descriptor_read_store_block_range_list(
-			     store_descriptor,
-			     file_io_handle,
-			     store_block_offset,
-			     &store_block_offset,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_IO,
-				 LIBCERROR_IO_ERROR_READ_FAILED,
-				 "%s: unable to read store block range list.",
-				 function );
+		goto on_error;
+	}
+	if( libvshadow_block_tree_get_sorted_block_descriptors(
+	     store_descriptor->forward_block_descriptors_tree,
+	     &libvshadow_block_descriptor_compare_references_by_original_offset,
+	     &block_descriptors_array,
+	     &number_of_block_descriptors,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve sorted forward block descriptors.",
+		 function );
 
-				goto on_error;
-			}
-		}
-		store_descriptor->block_descriptors_read = 1;
+		goto on_error;
 	}
-#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
-	     store_descriptor->read_write_lock,
+	if( libvshadow_block_index_set_forward_block_descriptors(
+	     store_descriptor->forward_block_index,
+	     block_descriptors_array,
+	     number_of_block_descriptors,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 "%s: unable to set forward block descriptors in block index.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-#endif
-	return( 1 );
-
-on_error:
-#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_write(
-	 store_descriptor->read_write_lock,
-	 NULL );
-#endif
-	return( -1 );
-}
-
-/* Reads data at the specified offset into a buffer
- * Returns the number of bytes read or -1 on error
- */
-ssize_t libvshadow_store_descriptor_read_buffer(
-         libvshadow_store_descriptor_t *store_descriptor,
-         libbfio_handle_t *file_io_handle,
-         uint8_t *buffer,
-         size_t buffer_size,
-         off64_t offset,
-         libvshadow_store_descriptor_t *active_store_descriptor,
-         libcerror_error_t **error )
-{
-	libcdata_tree_node_t *tree_node                         = NULL;
-	libvshadow_block_descriptor_t *block_descriptor         = NULL;
-	libvshadow_block_descriptor_t *overlay_block_descriptor = NULL;
-	libvshadow_block_descriptor_t *reverse_block_descriptor = NULL;
-	static char *function                                   = "libvshadow_store_descriptor_read_buffer";
-	intptr_t *value                                         = NULL;
-	off64_t block_descriptor_offset                         = 0;
-	off64_t block_offset                                    = 0;
-	off64_t block_range_offset                              = 0;
-	off64_t overlay_block_offset                            = 0;
-	off64_t previous_block_range_offset                     = 0;
-	size64_t block_range_size                               = 0;
-	size64_t previous_block_range_size                      = 0;
-	size_t buffer_offset                                    = 0;
-	size_t block_size                                       = 0;
-	size_t read_size                                        = 0;
-	ssize_t read_count                                      = 0;
-	uint32_t overlay_bitmap                                 = 0;
-	uint32_t relative_block_offset                          = 0;
-	uint8_t bit_count                                       = 0;
-	int in_block_descriptor_list                            = 0;
-	int in_current_bitmap                                   = 0;
-	int in_previous_bitmap                                  = 0;
-	int in_reverse_block_descriptor_list                    = 0;
-	int result                                              = 0;
+	if( block_descriptors_array != NULL )
+	{
+		memory_free(
+		 block_descriptors_array );
 
-	if( store_descriptor == NULL )
+		block_descriptors_array = NULL;
+	}
+	if( libvshadow_block_index_initialize(
+	     &( store_descriptor->reverse_block_index ),
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid store descriptor.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create reverse block index.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( store_descriptor->has_in_volume_store_data == 0 )
+	if( libvshadow_block_tree_get_sorted_block_descriptors(
+	     store_descriptor->reverse_block_descriptors_tree,
+	     &libvshadow_block_descriptor_compare_references_by_relative_offset,
+	     &block_descriptors_array,
+	     &number_of_block_descriptors,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid store descriptor - missing in-volume store data.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve sorted reverse block descriptors.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( active_store_descriptor == NULL )
+	if( libvshadow_block_index_set_reverse_block_descriptors(
+	     store_descriptor->reverse_block_index,
+	     block_descriptors_array,
+	     number_of_block_descriptors,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid active store descriptor.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set reverse block descriptors in block index.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	/* This function will acquire the write lock
+	if( block_descriptors_array != NULL )
+	{
+		memory_free(
+		 block_descriptors_array );
+
+		block_descriptors_array = NULL;
+	}
+	/* The block descriptors in the trees are owned by the block descriptor arena
 	 */
-	if( libvshadow_store_descriptor_read_block_descriptors(
-	     store_descriptor,
-	     file_io_handle,
+	if( libcdata_btree_free(
+	     &( store_descriptor->reverse_block_descriptors_tree ),
+	     NULL,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read block descriptors.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free reverse block descriptors tree.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
-	     store_descriptor->read_write_lock,
+	if( libcdata_btree_free(
+	     &( store_descriptor->forward_block_descriptors_tree ),
+	     NULL,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free forward block descriptors tree.",
 		 function );
 
-		return( -1 );
+		goto on_error;
+	}
+	if( libvshadow_block_descriptor_arena_free(
+	     &( store_descriptor->block_descriptor_arena ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free block descriptor arena.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( block_descriptors_array != NULL )
+	{
+		memory_free(
+		 block_descriptors_array );
+	}
+	if( store_descriptor->reverse_block_index != NULL )
+	{
+		libvshadow_block_index_free(
+		 &( store_descriptor->reverse_block_index ),
+		 NULL );
+	}
+	if( store_descriptor->forward_block_index != NULL )
+	{
+		libvshadow_block_index_free(
+		 &( store_descriptor->forward_block_index ),
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Inserts the block descriptors into the block descriptors trees
+ * This is used to rebuild the block indexes after the metadata has been released
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_store_descriptor_insert_block_descriptors(
+     libvshadow_store_descriptor_t *store_descriptor,
+     libcerror_error_t **error )
+{
+	libvshadow_block_descriptor_t block_descriptor;
+
+	static char *function      = "libvshadow_store_descriptor_insert_block_descriptors";
+	int block_descriptor_index = 0;
+
+	if( store_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( store_descriptor->block_list_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid store descriptor - missing block list index.",
+		 function );
+
+		return( -1 );
+	}
+	if( store_descriptor->forward_block_descriptors_tree == NULL )
+	{
+		if( libcdata_btree_initialize(
+		     &( store_descriptor->forward_block_descriptors_tree ),
+		     LIBVSHADOW_BLOCK_DESCRIPTORS_TREE_MAXIMUM_NUMBER_OF_SUB_NODES,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create forward block descriptors tree.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( store_descriptor->reverse_block_descriptors_tree == NULL )
+	{
+		if( libcdata_btree_initialize(
+		     &( store_descriptor->reverse_block_descriptors_tree ),
+		     LIBVSHADOW_BLOCK_DESCRIPTORS_TREE_MAXIMUM_NUMBER_OF_SUB_NODES,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create reverse block descriptors tree.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( store_descriptor->block_descriptor_arena == NULL )
+	{
+		if( libvshadow_block_descriptor_arena_initialize(
+		     &( store_descriptor->block_descriptor_arena ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create block descriptor arena.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	/* The block descriptors are stored in the order of the store block list
+	 * hence inserting them again results in the same trees
+	 */
+	for( block_descriptor_index = 0;
+	     block_descriptor_index < store_descriptor->block_list_index->number_of_blocks;
+	     block_descriptor_index++ )
+	{
+		if( libvshadow_block_index_get_block_descriptor_by_index(
+		     store_descriptor->block_list_index,
+		     block_descriptor_index,
+		     &block_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve block descriptor: %d from block list index.",
+			 function,
+			 block_descriptor_index );
+
+			goto on_error;
+		}
+		/* The block descriptor is cloned into the block descriptor arena
+		 */
+		if( libvshadow_block_tree_insert(
+		     store_descriptor->forward_block_descriptors_tree,
+		     store_descriptor->reverse_block_descriptors_tree,
+		     store_descriptor->block_descriptor_arena,
+		     &block_descriptor,
+		     store_descriptor->index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to insert block descriptor: %d in tree.",
+			 function,
+			 block_descriptor_index );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( store_descriptor->block_descriptor_arena != NULL )
+	{
+		libvshadow_block_descriptor_arena_free(
+		 &( store_descriptor->block_descriptor_arena ),
+		 NULL );
+	}
+	if( store_descriptor->reverse_block_descriptors_tree != NULL )
+	{
+		libcdata_btree_free(
+		 &( store_descriptor->reverse_block_descriptors_tree ),
+		 NULL,
+		 NULL );
+	}
+	if( store_descriptor->forward_block_descriptors_tree != NULL )
+	{
+		libcdata_btree_free(
+		 &( store_descriptor->forward_block_descriptors_tree ),
+		 NULL,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads the block descriptors
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_store_descriptor_read_block_descriptors(
+     libvshadow_store_descriptor_t *store_descriptor,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	libvshadow_metadata_reader_t *metadata_reader = NULL;
+	static char *function                         = "libvshadow_store_descriptor_read_block_descriptors";
+	off64_t store_block_offset                    = 0;
+	uint8_t block_descriptors_read                = 0;
+
+	if( store_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	/* The block descriptors are not changed once they have been read,
+	 * hence the write lock is only needed when they have not been read
+	 */
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     store_descriptor->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	block_descriptors_read = store_descriptor->block_descriptors_read;
+
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     store_descriptor->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( block_descriptors_read != 0 )
+	{
+		return( 1 );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     store_descriptor->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( store_descriptor->block_descriptors_read == 0 )
+	{
+		/* The store blocks of a store are mostly stored adjacent to each other
+		 * hence they are read ahead using a metadata reader
+		 */
+		if( libvshadow_metadata_reader_initialize(
+		     &metadata_reader,
+		     0x4000,
+		     LIBVSHADOW_METADATA_READER_MAXIMUM_NUMBER_OF_BLOCKS,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create metadata reader.",
+			 function );
+
+			goto on_error;
+		}
+		store_block_offset = store_descriptor->store_bitmap_offset;
+
+		while( store_block_offset != 0 )
+		{
+			if( libvshadow_store_descriptor_read_store_bitmap(
+			     store_descriptor,
+			     file_io_handle,
+			     metadata_reader,
+			     store_block_offset,
+			     store_descriptor->bitmap,
+			     &store_block_offset,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read store bitmap.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		store_block_offset = store_descriptor->store_previous_bitmap_offset;
+
+		while( store_block_offset != 0 )
+		{
+			if( libvshadow_store_descriptor_read_store_bitmap(
+			     store_descriptor,
+			     file_io_handle,
+			     metadata_reader,
+			     store_block_offset,
+			     store_descriptor->previous_bitmap,
+			     &store_block_offset,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read store previous bitmap.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		/* The store block list is only read once, after the metadata has been released
+		 * the block descriptors trees are rebuilt from the block descriptors
+		 */
+		if( store_descriptor->block_list_read == 0 )
+		{
+			store_block_offset = store_descriptor->store_block_list_offset;
+
+			while( store_block_offset != 0 )
+			{
+				if( libvshadow_store_descriptor_read_store_block_list(
+				     store_descriptor,
+				     file_io_handle,
+				     metadata_reader,
+				     store_block_offset,
+				     &store_block_offset,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read store block list.",
+					 function );
+
+					goto on_error;
+				}
+			}
+			store_block_offset = store_descriptor->store_block_range_list_offset;
+
+			while( store_block_offset != 0 )
+			{
+				if( libvshadow_store_descriptor_read_store_block_range_list(
+				     store_descriptor,
+				     file_io_handle,
+				     metadata_reader,
+				     store_block_offset,
+				     &store_block_offset,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read store block range list.",
+					 function );
+
+					goto on_error;
+				}
+			}
+			store_descriptor->block_list_read = 1;
+		}
+		else if( libvshadow_store_descriptor_insert_block_descriptors(
+		          store_descriptor,
+		          error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to insert block descriptors.",
+			 function );
+
+			goto on_error;
+		}
+		if( libvshadow_store_descriptor_build_block_indexes(
+		     store_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to build block indexes.",
+			 function );
+
+			goto on_error;
+		}
+		if( libvshadow_metadata_reader_free(
+		     &metadata_reader,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free metadata reader.",
+			 function );
+
+			goto on_error;
+		}
+		store_descriptor->block_descriptors_read = 1;
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     store_descriptor->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( metadata_reader != NULL )
+	{
+		libvshadow_metadata_reader_free(
+		 &metadata_reader,
+		 NULL );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 store_descriptor->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Releases the metadata
+ * Frees the extent map, block indexes and bitmaps, these are rebuilt when the block descriptors are read again
+ * The block list index is kept since the store block list is only read once
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_store_descriptor_release_metadata(
+     libvshadow_store_descriptor_t *store_descriptor,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_store_descriptor_release_metadata";
+	int result            = 1;
+
+	if( store_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store descriptor.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     store_descriptor->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( store_descriptor->block_descriptors_read != 0 )
+	{
+		if( store_descriptor->extent_map != NULL )
+		{
+			if( libvshadow_extent_map_free(
+			     &( store_descriptor->extent_map ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free extent map.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( store_descriptor->reverse_block_index != NULL )
+		{
+			if( libvshadow_block_index_free(
+			     &( store_descriptor->reverse_block_index ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free reverse block index.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( store_descriptor->forward_block_index != NULL )
+		{
+			if( libvshadow_block_index_free(
+			     &( store_descriptor->forward_block_index ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free forward block index.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( libvshadow_bitmap_clear(
+		     store_descriptor->bitmap,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to clear bitmap.",
+			 function );
+
+			result = -1;
+		}
+		if( libvshadow_bitmap_clear(
+		     store_descriptor->previous_bitmap,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to clear previous bitmap.",
+			 function );
+
+			result = -1;
+		}
+		store_descriptor->block_descriptors_read = 0;
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     store_descriptor->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the size of the memory used by the metadata
+ * The releasable metadata size only contains the metadata that is freed by libvshadow_store_descriptor_release_metadata
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_store_descriptor_get_metadata_size(
+     libvshadow_store_descriptor_t *store_descriptor,
+     size64_t *metadata_size,
+     size64_t *releasable_metadata_size,
+     libcerror_error_t **error )
+{
+	static char *function                  = "libvshadow_store_descriptor_get_metadata_size";
+	size64_t block_index_size              = 0;
+	size64_t safe_metadata_size            = 0;
+	size64_t safe_releasable_metadata_size = 0;
+	int number_of_descriptors              = 0;
+	int result                             = 1;
+
+	if( store_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( metadata_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata size.",
+		 function );
+
+		return( -1 );
+	}
+	if( releasable_metadata_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid releasable metadata size.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     store_descriptor->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( store_descriptor->forward_block_index != NULL )
+	{
+		if( libvshadow_block_index_get_memory_size(
+		     store_descriptor->forward_block_index,
+		     &block_index_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve forward block index memory size.",
+			 function );
+
+			result = -1;
+		}
+		safe_releasable_metadata_size += block_index_size;
+	}
+	if( ( result == 1 )
+	 && ( store_descriptor->reverse_block_index != NULL ) )
+	{
+		if( libvshadow_block_index_get_memory_size(
+		     store_descriptor->reverse_block_index,
+		     &block_index_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve reverse block index memory size.",
+			 function );
+
+			result = -1;
+		}
+		safe_releasable_metadata_size += block_index_size;
+	}
+	if( ( result == 1 )
+	 && ( store_descriptor->block_descriptor_arena != NULL ) )
+	{
+		if( libvshadow_block_descriptor_arena_get_number_of_block_descriptors(
+		     store_descriptor->block_descriptor_arena,
+		     &number_of_descriptors,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of block descriptors in arena.",
+			 function );
+
+			result = -1;
+		}
+		safe_metadata_size += (size64_t) number_of_descriptors * sizeof( libvshadow_block_descriptor_t );
+	}
+	if( store_descriptor->bitmap != NULL )
+	{
+		safe_releasable_metadata_size += store_descriptor->bitmap->allocated_data_size;
+	}
+	if( store_descriptor->previous_bitmap != NULL )
+	{
+		safe_releasable_metadata_size += store_descriptor->previous_bitmap->allocated_data_size;
+	}
+	if( store_descriptor->extent_map != NULL )
+	{
+		safe_releasable_metadata_size += (size64_t) store_descriptor->extent_map->number_of_allocated_extents * sizeof( libvshadow_extent_t );
+	}
+	/* The block list index and the block descriptor arena are not released,
+	 * hence they are not part of the releasable metadata
+	 */
+	if( ( result == 1 )
+	 && ( store_descriptor->block_list_index != NULL ) )
+	{
+		if( libvshadow_block_index_get_memory_size(
+		     store_descriptor->block_list_index,
+		     &block_index_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve block list index memory size.",
+			 function );
+
+			result = -1;
+		}
+		safe_metadata_size += block_index_size;
+	}
+	safe_metadata_size += safe_releasable_metadata_size;
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     store_descriptor->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( result == 1 )
+	{
+		*metadata_size            = safe_metadata_size;
+		*releasable_metadata_size = safe_releasable_metadata_size;
+	}
+	return( result );
+}
+
+/* Retrieves the index of the first forward block descriptor that ends after a specific offset
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_store_descriptor_get_forward_block_descriptor_index(
+     libvshadow_store_descriptor_t *store_descriptor,
+     off64_t offset,
+     int *block_descriptor_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_store_descriptor_get_forward_block_descriptor_index";
+
+	if( store_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_descriptor_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block descriptor index.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvshadow_block_index_get_index_by_offset(
+	     store_descriptor->forward_block_index,
+	     offset,
+	     block_descriptor_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve forward block index entry for offset: 0x%08" PRIx64 ".",
+		 function,
+		 offset );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Determines if an offset is in the reverse block descriptors
+ * The range end offset is set to the offset where this state changes
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_store_descriptor_get_reverse_block_descriptor_range(
+     libvshadow_store_descriptor_t *store_descriptor,
+     off64_t offset,
+     int *in_reverse_block_descriptors,
+     off64_t *range_end_offset,
+     libcerror_error_t **error )
+{
+	static char *function   = "libvshadow_store_descriptor_get_reverse_block_descriptor_range";
+	off64_t relative_offset = 0;
+	int entry_index         = 0;
+
+	if( store_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( in_reverse_block_descriptors == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid in reverse block descriptors.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_end_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range end offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvshadow_block_index_get_index_by_offset(
+	     store_descriptor->reverse_block_index,
+	     offset,
+	     &entry_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve reverse block index entry for offset: 0x%08" PRIx64 ".",
+		 function,
+		 offset );
+
+		return( -1 );
+	}
+	if( entry_index >= store_descriptor->reverse_block_index->number_of_blocks )
+	{
+		*in_reverse_block_descriptors = 0;
+		*range_end_offset             = INT64_MAX;
+
+		return( 1 );
+	}
+	if( libvshadow_block_index_get_offset_by_index(
+	     store_descriptor->reverse_block_index,
+	     entry_index,
+	     &relative_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve reverse block index entry: %d offset.",
+		 function,
+		 entry_index );
+
+		return( -1 );
+	}
+	if( offset >= relative_offset )
+	{
+		*in_reverse_block_descriptors = 1;
+		*range_end_offset             = relative_offset + 0x4000;
+	}
+	else
+	{
+		*in_reverse_block_descriptors = 0;
+		*range_end_offset             = relative_offset;
+	}
+	return( 1 );
+}
+
+/* Determines if an offset is in a store bitmap
+ * The range end offset is set to the offset where this state changes
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_store_descriptor_get_bitmap_range(
+     libvshadow_bitmap_t *bitmap,
+     off64_t offset,
+     int *in_bitmap,
+     off64_t *range_end_offset,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_store_descriptor_get_bitmap_range";
+	size_t bit_index      = 0;
+	size_t number_of_bits = 0;
+	uint8_t bit_value     = 0;
+	int result            = 0;
+
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( in_bitmap == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid in bitmap.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_end_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range end offset.",
+		 function );
+
+		return( -1 );
+	}
+	bit_index = (size_t) ( offset / 0x4000 );
+
+	result = libvshadow_bitmap_get_run_at_bit_index(
+	          bitmap,
+	          bit_index,
+	          &bit_value,
+	          &number_of_bits,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve bitmap run at offset: 0x%08" PRIx64 ".",
+		 function,
+		 offset );
+
+		return( -1 );
+	}
+	/* Offsets beyond the end of the bitmap are not in the bitmap
+	 */
+	if( result == 0 )
+	{
+		*in_bitmap        = 0;
+		*range_end_offset = INT64_MAX;
+	}
+	else if( ( bit_value == 0 )
+	      && ( ( ( bit_index + number_of_bits ) / 8 ) >= bitmap->data_size ) )
+	{
+		*in_bitmap        = 0;
+		*range_end_offset = INT64_MAX;
+	}
+	else
+	{
+		*in_bitmap        = (int) bit_value;
+		*range_end_offset = (off64_t) ( bit_index + number_of_bits ) * 0x4000;
+	}
+	return( 1 );
+}
+
+/* Appends the extents of a range that is not defined by the block descriptors of the store
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_store_descriptor_append_unmapped_extents(
+     libvshadow_store_descriptor_t *store_descriptor,
+     libvshadow_store_descriptor_t *active_store_descriptor,
+     libvshadow_extent_map_t *extent_map,
+     off64_t offset,
+     size64_t size,
+     libcerror_error_t **error )
+{
+	static char *function            = "libvshadow_store_descriptor_append_unmapped_extents";
+	off64_t current_range_end        = 0;
+	off64_t previous_range_end       = 0;
+	off64_t range_end                = 0;
+	off64_t reverse_range_end        = 0;
+	uint8_t extent_type              = 0;
+	int in_current_bitmap            = 0;
+	int in_previous_bitmap           = 0;
+	int in_reverse_block_descriptors = 0;
+
+	if( store_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( active_store_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid active store descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	/* Check if the next store defines the range
+	 */
+	if( store_descriptor->next_store_descriptor != NULL )
+	{
+		if( libvshadow_store_descriptor_append_extents(
+		     store_descriptor->next_store_descriptor,
+		     active_store_descriptor,
+		     extent_map,
+		     offset,
+		     size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append extents of next store.",
+			 function );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+	/* Only the most recent store seems to bother checking the current bitmap
+	 */
+	if( store_descriptor->index != active_store_descriptor->index )
+	{
+		if( libvshadow_extent_map_append_extent(
+		     extent_map,
+		     size,
+		     offset,
+		     LIBVSHADOW_EXTENT_TYPE_VOLUME_DATA,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append extent.",
+			 function );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+	while( size > 0 )
+	{
+		if( libvshadow_store_descriptor_get_reverse_block_descriptor_range(
+		     store_descriptor,
+		     offset,
+		     &in_reverse_block_descriptors,
+		     &reverse_range_end,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve reverse block descriptor range for offset: 0x%08" PRIx64 ".",
+			 function,
+			 offset );
+
+			return( -1 );
+		}
+		if( libvshadow_store_descriptor_get_bitmap_range(
+		     store_descriptor->bitmap,
+		     offset,
+		     &in_current_bitmap,
+		     &current_range_end,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve offset: 0x%08" PRIx64 " from bitmap.",
+			 function,
+			 offset );
+
+			return( -1 );
+		}
+		if( store_descriptor->store_previous_bitmap_offset != 0 )
+		{
+			if( libvshadow_store_descriptor_get_bitmap_range(
+			     store_descriptor->previous_bitmap,
+			     offset,
+			     &in_previous_bitmap,
+			     &previous_range_end,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve offset: 0x%08" PRIx64 " from previous bitmap.",
+				 function,
+				 offset );
+
+				return( -1 );
+			}
+		}
+		else
+		{
+			in_previous_bitmap = 1;
+			previous_range_end = INT64_MAX;
+		}
+		range_end = offset + (off64_t) size;
+
+		if( range_end > reverse_range_end )
+		{
+			range_end = reverse_range_end;
+		}
+		if( range_end > current_range_end )
+		{
+			range_end = current_range_end;
+		}
+		if( range_end > previous_range_end )
+		{
+			range_end = previous_range_end;
+		}
+		if( ( in_reverse_block_descriptors == 0 )
+		 && ( in_current_bitmap != 0 )
+		 && ( in_previous_bitmap != 0 ) )
+		{
+			extent_type = LIBVSHADOW_EXTENT_TYPE_SPARSE;
+		}
+		else
+		{
+			extent_type = LIBVSHADOW_EXTENT_TYPE_VOLUME_DATA;
+		}
+		if( libvshadow_extent_map_append_extent(
+		     extent_map,
+		     (size64_t) ( range_end - offset ),
+		     offset,
+		     extent_type,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append extent.",
+			 function );
+
+			return( -1 );
+		}
+		size  -= (size64_t) ( range_end - offset );
+		offset = range_end;
+	}
+	return( 1 );
+}
+
+/* Appends the extents of a range that is defined by a block descriptor
+ * This function ignores the overlay of the block descriptor
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_store_descriptor_append_block_descriptor_extents(
+     libvshadow_store_descriptor_t *store_descriptor,
+     libvshadow_store_descriptor_t *active_store_descriptor,
+     libvshadow_extent_map_t *extent_map,
+     libvshadow_block_descriptor_t *block_descriptor,
+     off64_t offset,
+     size64_t size,
+     libcerror_error_t **error )
+{
+	static char *function         = "libvshadow_store_descriptor_append_block_descriptor_extents";
+	off64_t relative_block_offset = 0;
+
+	if( store_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	relative_block_offset = offset - block_descriptor->original_offset;
+
+	if( ( block_descriptor->flags & LIBVSHADOW_BLOCK_FLAG_IS_FORWARDER ) != 0 )
+	{
+		if( store_descriptor->next_store_descriptor != NULL )
+		{
+			if( libvshadow_store_descriptor_append_extents(
+			     store_descriptor->next_store_descriptor,
+			     active_store_descriptor,
+			     extent_map,
+			     block_descriptor->relative_offset + relative_block_offset,
+			     size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append extents of next store.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		else if( libvshadow_extent_map_append_extent(
+		          extent_map,
+		          size,
+		          block_descriptor->relative_offset + relative_block_offset,
+		          LIBVSHADOW_EXTENT_TYPE_VOLUME_DATA,
+		          error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append extent.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	else if( libvshadow_extent_map_append_extent(
+	          extent_map,
+	          size,
+	          block_descriptor->offset + relative_block_offset,
+	          LIBVSHADOW_EXTENT_TYPE_STORE_DATA,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append extent.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Appends the extents of a range that is defined by a block descriptor and its overlay
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_store_descriptor_append_block_extents(
+     libvshadow_store_descriptor_t *store_descriptor,
+     libvshadow_store_descriptor_t *active_store_descriptor,
+     libvshadow_extent_map_t *extent_map,
+     libvshadow_block_descriptor_t *block_descriptor,
+     off64_t offset,
+     size64_t size,
+     libcerror_error_t **error )
+{
+	libvshadow_block_descriptor_t *overlay_block_descriptor = NULL;
+	static char *function                                   = "libvshadow_store_descriptor_append_block_extents";
+	off64_t range_end                                       = 0;
+	off64_t relative_block_offset                           = 0;
+	size64_t range_size                                     = 0;
+	uint32_t bit_value                                      = 0;
+	uint8_t bit_index                                       = 0;
+	uint8_t last_bit_index                                  = 0;
+	int result                                              = 0;
+
+	if( store_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( active_store_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid active store descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( block_descriptor->flags & LIBVSHADOW_BLOCK_FLAG_IS_OVERLAY ) != 0 )
+	{
+		overlay_block_descriptor = block_descriptor;
+	}
+	else
+	{
+		overlay_block_descriptor = block_descriptor->overlay;
+	}
+	if( overlay_block_descriptor == NULL )
+	{
+		result = libvshadow_store_descriptor_append_block_descriptor_extents(
+		          store_descriptor,
+		          active_store_descriptor,
+		          extent_map,
+		          block_descriptor,
+		          offset,
+		          size,
+		          error );
+	}
+	/* The overlay only applies to the store that is being read
+	 */
+	else if( store_descriptor->index != active_store_descriptor->index )
+	{
+		if( block_descriptor == overlay_block_descriptor )
+		{
+			result = libvshadow_store_descriptor_append_unmapped_extents(
+			          store_descriptor,
+			          active_store_descriptor,
+			          extent_map,
+			          offset,
+			          size,
+			          error );
+		}
+		else
+		{
+			result = libvshadow_store_descriptor_append_block_descriptor_extents(
+			          store_descriptor,
+			          active_store_descriptor,
+			          extent_map,
+			          block_descriptor,
+			          offset,
+			          size,
+			          error );
+		}
+	}
+	else
+	{
+		/* The overlay bitmap contains a bit per 512 bytes of the block
+		 */
+		result = 1;
+
+		while( size > 0 )
+		{
+			relative_block_offset = offset - overlay_block_descriptor->original_offset;
+
+			if( ( relative_block_offset < 0 )
+			 || ( relative_block_offset >= (off64_t) ( 32 * 512 ) ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid relative block offset value out of bounds.",
+				 function );
+
+				result = -1;
+
+				break;
+			}
+			bit_index = (uint8_t) ( relative_block_offset / 512 );
+			bit_value = ( overlay_block_descriptor->bitmap >> bit_index ) & 0x00000001UL;
+
+			for( last_bit_index = bit_index + 1;
+			     last_bit_index < 32;
+			     last_bit_index++ )
+			{
+				if( ( ( overlay_block_descriptor->bitmap >> last_bit_index ) & 0x00000001UL ) != bit_value )
+				{
+					break;
+				}
+			}
+			range_end  = overlay_block_descriptor->original_offset + ( (off64_t) last_bit_index * 512 );
+			range_size = (size64_t) ( range_end - offset );
+
+			if( range_size > size )
+			{
+				range_size = size;
+			}
+			if( bit_value != 0 )
+			{
+				result = libvshadow_extent_map_append_extent(
+				          extent_map,
+				          range_size,
+				          overlay_block_descriptor->offset + relative_block_offset,
+				          LIBVSHADOW_EXTENT_TYPE_STORE_DATA,
+				          error );
+			}
+			else if( block_descriptor == overlay_block_descriptor )
+			{
+				result = libvshadow_store_descriptor_append_unmapped_extents(
+				          store_descriptor,
+				          active_store_descriptor,
+				          extent_map,
+				          offset,
+				          range_size,
+				          error );
+			}
+			else
+			{
+				result = libvshadow_store_descriptor_append_block_descriptor_extents(
+				          store_descriptor,
+				          active_store_descriptor,
+				          extent_map,
+				          block_descriptor,
+				          offset,
+				          range_size,
+				          error );
+			}
+			if( result != 1 )
+			{
+				break;
+			}
+			offset += (off64_t) range_size;
+			size   -= range_size;
+		}
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append extents of block at offset: 0x%08" PRIx64 ".",
+		 function,
+		 offset );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Appends the extents of a range of the store to the extent map
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_store_descriptor_append_extents(
+     libvshadow_store_descriptor_t *store_descriptor,
+     libvshadow_store_descriptor_t *active_store_descriptor,
+     libvshadow_extent_map_t *extent_map,
+     off64_t offset,
+     size64_t size,
+     libcerror_error_t **error )
+{
+	libvshadow_block_descriptor_t block_descriptor_value;
+
+	libvshadow_block_descriptor_t *block_descriptor = NULL;
+	static char *function                           = "libvshadow_store_descriptor_append_extents";
+	off64_t relative_block_offset                   = 0;
+	size64_t range_size                             = 0;
+	int block_descriptor_index                      = 0;
+	int result                                      = 0;
+
+	if( store_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( store_descriptor->block_descriptors_read == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid store descriptor - block descriptors not read.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvshadow_store_descriptor_get_forward_block_descriptor_index(
+	     store_descriptor,
+	     offset,
+	     &block_descriptor_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve forward block descriptor index for offset: 0x%08" PRIx64 ".",
+		 function,
+		 offset );
+
+		return( -1 );
+	}
+	while( size > 0 )
+	{
+		block_descriptor = NULL;
+
+		if( block_descriptor_index < store_descriptor->forward_block_index->number_of_blocks )
+		{
+			if( libvshadow_block_index_get_block_descriptor_by_index(
+			     store_descriptor->forward_block_index,
+			     block_descriptor_index,
+			     &block_descriptor_value,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve forward block descriptor: %d.",
+				 function,
+				 block_descriptor_index );
+
+				return( -1 );
+			}
+			block_descriptor = &block_descriptor_value;
+		}
+		if( ( block_descriptor == NULL )
+		 || ( offset < block_descriptor->original_offset ) )
+		{
+			range_size = size;
+
+			if( ( block_descriptor != NULL )
+			 && ( (size64_t) ( block_descriptor->original_offset - offset ) < range_size ) )
+			{
+				range_size = (size64_t) ( block_descriptor->original_offset - offset );
+			}
+			result = libvshadow_store_descriptor_append_unmapped_extents(
+			          store_descriptor,
+			          active_store_descriptor,
+			          extent_map,
+			          offset,
+			          range_size,
+			          error );
+		}
+		else
+		{
+			relative_block_offset = offset - block_descriptor->original_offset;
+			range_size            = (size64_t) ( 0x4000 - relative_block_offset );
+
+			if( range_size > size )
+			{
+				range_size = size;
+			}
+			result = libvshadow_store_descriptor_append_block_extents(
+			          store_descriptor,
+			          active_store_descriptor,
+			          extent_map,
+			          block_descriptor,
+			          offset,
+			          range_size,
+			          error );
+
+			block_descriptor_index++;
+		}
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append extents for store: %02d at offset: 0x%08" PRIx64 ".",
+			 function,
+			 store_descriptor->index,
+			 offset );
+
+			return( -1 );
+		}
+		offset += (off64_t) range_size;
+		size   -= range_size;
+	}
+	return( 1 );
+}
+
+/* Reads the extent map
+ * The extent map contains the location of the data of the store as seen from the store
+ * and is resolved once, using the block descriptors of the store and the more recent stores
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_store_descriptor_read_extent_map(
+     libvshadow_store_descriptor_t *store_descriptor,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	libvshadow_extent_map_t *extent_map                  = NULL;
+	libvshadow_store_descriptor_t *next_store_descriptor = NULL;
+	static char *function                                = "libvshadow_store_descriptor_read_extent_map";
+
+	if( store_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	/* The extent map depends on the block descriptors of the store and all more recent stores
+	 * This function will acquire the write lock of each of these stores
+	 */
+	for( next_store_descriptor = store_descriptor;
+	     next_store_descriptor != NULL;
+	     next_store_descriptor = next_store_descriptor->next_store_descriptor )
+	{
+		if( libvshadow_store_descriptor_read_block_descriptors(
+		     next_store_descriptor,
+		     file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read block descriptors of store: %02d.",
+			 function,
+			 next_store_descriptor->index );
+
+			return( -1 );
+		}
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     store_descriptor->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( store_descriptor->extent_map == NULL )
+	{
+		if( libvshadow_extent_map_initialize(
+		     &extent_map,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create extent map.",
+			 function );
+
+			goto on_error;
+		}
+		if( ( store_descriptor->volume_size > 0 )
+		 && ( store_descriptor->volume_size <= (size64_t) INT64_MAX ) )
+		{
+			if( libvshadow_store_descriptor_append_extents(
+			     store_descriptor,
+			     store_descriptor,
+			     extent_map,
+			     0,
+			     store_descriptor->volume_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append extents.",
+				 function );
+
+				goto on_error;
+			}
+		}
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: store: %02d number of extents: %d\n",
+			 function,
+			 store_descriptor->index,
+			 extent_map->number_of_extents );
+		}
+#endif
+		store_descriptor->extent_map = extent_map;
+		extent_map                   = NULL;
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     store_descriptor->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( extent_map != NULL )
+	{
+		libvshadow_extent_map_free(
+		 &extent_map,
+		 NULL );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 store_descriptor->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Reads data at the specified offset into a buffer
+ * The block cache is optional and can be NULL
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libvshadow_store_descriptor_read_buffer(
+         libvshadow_store_descriptor_t *store_descriptor,
+         libbfio_handle_t *file_io_handle,
+         libvshadow_block_cache_t *block_cache,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libvshadow_extent_t *extent = NULL;
+	static char *function       = "libvshadow_store_descriptor_read_buffer";
+	off64_t data_offset         = 0;
+	size_t buffer_offset        = 0;
+	size_t read_size            = 0;
+	ssize_t read_count          = 0;
+	uint8_t extent_type         = 0;
+	int extent_index            = 0;
+	int result                  = 0;
+
+	if( store_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( store_descriptor->has_in_volume_store_data == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store descriptor - missing in-volume store data.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     store_descriptor->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	/* The extent map is not changed once it has been read,
+	 * hence the read lock is only released to read the extent map
+	 */
+	if( store_descriptor->extent_map == NULL )
+	{
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_release_for_read(
+		     store_descriptor->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release read/write lock for reading.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+		/* This function will acquire the write lock
+		 */
+		if( libvshadow_store_descriptor_read_extent_map(
+		     store_descriptor,
+		     file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read extent map.",
+			 function );
+
+			return( -1 );
+		}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_grab_for_read(
+		     store_descriptor->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab read/write lock for reading.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: store: %02d requested offset: 0x%08" PRIx64 "\n",
+		 function,
+		 store_descriptor->index,
+		 offset );
+	}
+#endif
+	result = libvshadow_extent_map_get_extent_index_at_offset(
+	          store_descriptor->extent_map,
+	          offset,
+	          &extent_index,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve extent for offset: 0x%08" PRIx64 ".",
+		 function,
+		 offset );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		extent_index = store_descriptor->extent_map->number_of_extents;
+	}
+	while( buffer_size > 0 )
+	{
+		/* The data beyond the extent map is not defined by the store
+		 */
+		if( extent_index >= store_descriptor->extent_map->number_of_extents )
+		{
+			extent_type = LIBVSHADOW_EXTENT_TYPE_VOLUME_DATA;
+			data_offset = offset;
+			read_size   = buffer_size;
+		}
+		else
+		{
+			extent = &( store_descriptor->extent_map->extents[ extent_index ] );
+
+			extent_type = extent->type;
+			data_offset = extent->data_offset + ( offset - extent->offset );
+			read_size   = buffer_size;
+
+			if( (size64_t) read_size > ( extent->size - (size64_t) ( offset - extent->offset ) ) )
+			{
+				read_size = (size_t) ( extent->size - (size64_t) ( offset - extent->offset ) );
+			}
+			extent_index++;
+		}
+		/* Volume and store data are both read from the file IO handle,
+		 * hence physically contiguous extents are read with a single read
+		 */
+		if( extent_type != LIBVSHADOW_EXTENT_TYPE_SPARSE )
+		{
+			while( ( read_size < buffer_size )
+			    && ( extent_index < store_descriptor->extent_map->number_of_extents ) )
+			{
+				extent = &( store_descriptor->extent_map->extents[ extent_index ] );
+
+				if( ( extent->type == LIBVSHADOW_EXTENT_TYPE_SPARSE )
+				 || ( extent->data_offset != ( data_offset + (off64_t) read_size ) ) )
+				{
+					break;
+				}
+				if( extent->size < (size64_t) ( buffer_size - read_size ) )
+				{
+					read_size += (size_t) extent->size;
+				}
+				else
+				{
+					read_size = buffer_size;
+				}
+				extent_index++;
+			}
+		}
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: store: %02d range: 0x%08" PRIx64 " - 0x%08" PRIx64 " size: %" PRIzd ", extent type: %" PRIu8 ", data offset: 0x%08" PRIx64 "\n",
+			 function,
+			 store_descriptor->index,
+			 offset,
+			 offset + read_size,
+			 read_size,
+			 extent_type,
+			 data_offset );
+		}
+#endif
+		if( extent_type == LIBVSHADOW_EXTENT_TYPE_SPARSE )
+		{
+			if( memory_set(
+			     &( buffer[ buffer_offset ] ),
+			     0,
+			     read_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+				 "%s: unable to clear buffer.",
+				 function );
+
+				goto on_error;
+			}
+			read_count = (ssize_t) read_size;
+		}
+		else
+		{
+			if( block_cache != NULL )
+			{
+				read_count = libvshadow_block_cache_read_buffer(
+				              block_cache,
+				              file_io_handle,
+				              &( buffer[ buffer_offset ] ),
+				              read_size,
+				              data_offset,
+				              error );
+			}
+			else
+			{
+				read_count = libbfio_handle_read_buffer_at_offset(
+				              file_io_handle,
+				              &( buffer[ buffer_offset ] ),
+				              read_size,
+				              data_offset,
+				              error );
+			}
+
+			if( read_count != (ssize_t) read_size )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read buffer from file IO handle at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+				 function,
+				 data_offset,
+				 data_offset );
+
+				goto on_error;
+			}
+		}
+		offset        += read_count;
+		buffer_offset += read_count;
+		buffer_size   -= read_count;
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     store_descriptor->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( (ssize_t) buffer_offset );
+
+on_error:
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_read(
+	 store_descriptor->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Reads (store) data at specific offsets into multiple buffers
+ * The ranges are resolved with a single acquisition of the read lock, the data of the ranges
+ * is read in order of the offset in the volume and overlapping or adjacent reads are merged
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libvshadow_store_descriptor_read_buffers(
+         libvshadow_store_descriptor_t *store_descriptor,
+         libbfio_handle_t *file_io_handle,
+         libvshadow_block_cache_t *block_cache,
+         uint8_t **buffers,
+         size_t *buffer_sizes,
+         off64_t *offsets,
+         int number_of_buffers,
+         libcerror_error_t **error )
+{
+	libvshadow_extent_map_t *extent_map = NULL;
+	libvshadow_read_list_t *read_list   = NULL;
+	static char *function               = "libvshadow_store_descriptor_read_buffers";
+	size_t total_read_size              = 0;
+	int buffer_index                    = 0;
+
+	if( store_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( store_descriptor->has_in_volume_store_data == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store descriptor - missing in-volume store data.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffers.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_sizes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer sizes.",
+		 function );
+
+		return( -1 );
+	}
+	if( offsets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offsets.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_buffers < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of buffers value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	for( buffer_index = 0;
+	     buffer_index < number_of_buffers;
+	     buffer_index++ )
+	{
+		if( buffer_sizes[ buffer_index ] > ( (size_t) SSIZE_MAX - total_read_size ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid buffer: %d size value exceeds maximum.",
+			 function,
+			 buffer_index );
+
+			return( -1 );
+		}
+		total_read_size += buffer_sizes[ buffer_index ];
+	}
+	if( total_read_size == 0 )
+	{
+		return( 0 );
+	}
+	/* This function will read the extent map if needed
+	 */
+	if( libvshadow_store_descriptor_get_extent_map(
+	     store_descriptor,
+	     file_io_handle,
+	     &extent_map,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve extent map.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvshadow_read_list_initialize(
+	     &read_list,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create read list.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     store_descriptor->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		libvshadow_read_list_free(
+		 &read_list,
+		 NULL );
+
+		return( -1 );
+	}
+#endif
+	for( buffer_index = 0;
+	     buffer_index < number_of_buffers;
+	     buffer_index++ )
+	{
+		if( libvshadow_read_list_append_range(
+		     read_list,
+		     0,
+		     extent_map,
+		     buffers[ buffer_index ],
+		     buffer_sizes[ buffer_index ],
+		     offsets[ buffer_index ],
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append range of buffer: %d to read list.",
+			 function,
+			 buffer_index );
+
+			goto on_error;
+		}
+	}
+	if( libvshadow_read_list_read(
+	     read_list,
+	     file_io_handle,
+	     block_cache,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read data of read list.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     store_descriptor->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		libvshadow_read_list_free(
+		 &read_list,
+		 NULL );
+
+		return( -1 );
+	}
+#endif
+	if( libvshadow_read_list_free(
+	     &read_list,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free read list.",
+		 function );
+
+		return( -1 );
+	}
+	return( (ssize_t) total_read_size );
+
+on_error:
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_read(
+	 store_descriptor->read_write_lock,
+	 NULL );
+#endif
+	libvshadow_read_list_free(
+	 &read_list,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Retrieves the extent at a specific offset
+ * The extent starts at the offset and contains the following adjacent extents of the same type
+ * that are contiguous in the volume, where extent data offset contains the offset of the data
+ * relative to the start of the volume. The data of a sparse extent consists of 0-byte values
+ * Returns 1 if successful, 0 if the offset is beyond the volume size or -1 on error
+ */
+int libvshadow_store_descriptor_get_extent_at_offset(
+     libvshadow_store_descriptor_t *store_descriptor,
+     libbfio_handle_t *file_io_handle,
+     off64_t offset,
+     size64_t *extent_size,
+     off64_t *extent_data_offset,
+     uint8_t *extent_type,
+     libcerror_error_t **error )
+{
+	libvshadow_extent_t *extent = NULL;
+	static char *function       = "libvshadow_store_descriptor_get_extent_at_offset";
+	off64_t data_offset         = 0;
+	size64_t size               = 0;
+	uint8_t type                = 0;
+	int extent_index            = 0;
+	int result                  = 0;
+
+	if( store_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( store_descriptor->has_in_volume_store_data == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store descriptor - missing in-volume store data.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent size.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_data_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent data offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_type == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent type.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size64_t) offset >= store_descriptor->volume_size )
+	{
+		return( 0 );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     store_descriptor->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
 	}
 #endif
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
+	/* The extent map is not changed once it has been read,
+	 * hence the read lock is only released to read the extent map
+	 */
+	if( store_descriptor->extent_map == NULL )
+	{
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_release_for_read(
+		     store_descriptor->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release read/write lock for reading.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+		/* This function will acquire the write lock
+		 */
+		if( libvshadow_store_descriptor_read_extent_map(
+		     store_descriptor,
+		     file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read extent map.",
+			 function );
+
+			return( -1 );
+		}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_grab_for_read(
+		     store_descriptor->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab read/write lock for reading.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+	}
+	result = libvshadow_extent_map_get_extent_index_at_offset(
+	          store_descriptor->extent_map,
+	          offset,
+	          &extent_index,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve extent for offset: 0x%08" PRIx64 ".",
+		 function,
+		 offset );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		/* The data beyond the extent map is not defined by the store
+		 */
+		type        = LIBVSHADOW_EXTENT_TYPE_VOLUME_DATA;
+		data_offset = offset;
+		size        = store_descriptor->volume_size - (size64_t) offset;
+	}
+	else
+	{
+		extent = &( store_descriptor->extent_map->extents[ extent_index ] );
+
+		type        = extent->type;
+		data_offset = extent->data_offset + ( offset - extent->offset );
+		size        = extent->size - (size64_t) ( offset - extent->offset );
+
+		for( extent_index = extent_index + 1;
+		     extent_index < store_descriptor->extent_map->number_of_extents;
+		     extent_index++ )
+		{
+			extent = &( store_descriptor->extent_map->extents[ extent_index ] );
+
+			if( extent->type != type )
+			{
+				break;
+			}
+			if( ( type != LIBVSHADOW_EXTENT_TYPE_SPARSE )
+			 && ( extent->data_offset != ( data_offset + (off64_t) size ) ) )
+			{
+				break;
+			}
+			size += extent->size;
+		}
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     store_descriptor->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( type == LIBVSHADOW_EXTENT_TYPE_SPARSE )
+	{
+		data_offset = 0;
+	}
+	*extent_size        = size;
+	*extent_data_offset = data_offset;
+	*extent_type        = type;
+
+	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_read(
+	 store_descriptor->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Retrieves the extent map
+ * The extent map is read if needed, it is not changed once it has been read
+ * but it can be released, hence hold the read lock of the volume while it is used
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_store_descriptor_get_extent_map(
+     libvshadow_store_descriptor_t *store_descriptor,
+     libbfio_handle_t *file_io_handle,
+     libvshadow_extent_map_t **extent_map,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_store_descriptor_get_extent_map";
+
+	if( store_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent map.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     store_descriptor->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*extent_map = store_descriptor->extent_map;
+
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     store_descriptor->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( *extent_map != NULL )
+	{
+		return( 1 );
+	}
+	/* This function will acquire the write lock
+	 */
+	if( libvshadow_store_descriptor_read_extent_map(
+	     store_descriptor,
+	     file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read extent map.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     store_descriptor->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*extent_map = store_descriptor->extent_map;
+
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     store_descriptor->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the next extent, at or after a specific offset, of which the data differs between 2 stores
+ * If other store descriptor is NULL the store is compared to the current volume
+ * The data is considered different when it is not resolved to the same location in the volume,
+ * hence the comparison only uses the metadata of the stores
+ * Returns 1 if successful, 0 if no such extent or -1 on error
+ */
+int libvshadow_store_descriptor_get_next_changed_extent(
+     libvshadow_store_descriptor_t *store_descriptor,
+     libvshadow_store_descriptor_t *other_store_descriptor,
+     libbfio_handle_t *file_io_handle,
+     off64_t offset,
+     off64_t *extent_offset,
+     size64_t *extent_size,
+     libcerror_error_t **error )
+{
+	libvshadow_extent_map_t *extent_maps[ 2 ] = { NULL, NULL };
+	libvshadow_extent_t *extent               = NULL;
+	static char *function                     = "libvshadow_store_descriptor_get_next_changed_extent";
+	off64_t changed_offset                    = -1;
+	off64_t data_offsets[ 2 ]                 = { 0, 0 };
+	off64_t end_offsets[ 2 ]                  = { 0, 0 };
+	off64_t next_offset                       = 0;
+	size64_t volume_size                      = 0;
+	uint8_t extent_types[ 2 ]                 = { 0, 0 };
+	int extent_indexes[ 2 ]                   = { 0, 0 };
+	int map_index                             = 0;
+	int result                                = 0;
+
+	if( store_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( store_descriptor->has_in_volume_store_data == 0 )
+	 || ( ( other_store_descriptor != NULL )
+	  &&  ( other_store_descriptor->has_in_volume_store_data == 0 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store descriptor - missing in-volume store data.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent size.",
+		 function );
+
+		return( -1 );
+	}
+	volume_size = store_descriptor->volume_size;
+
+	if( ( other_store_descriptor != NULL )
+	 && ( other_store_descriptor->volume_size > volume_size ) )
+	{
+		volume_size = other_store_descriptor->volume_size;
+	}
+	if( volume_size > (size64_t) INT64_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid store descriptor - volume size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size64_t) offset >= volume_size )
 	{
-		libcnotify_printf(
-		 "%s: store: %02d requested offset: 0x%08" PRIx64 "\n",
-		 function,
-		 store_descriptor->index,
-		 offset );
+		return( 0 );
 	}
-#endif
-	while( buffer_size > 0 )
+	if( libvshadow_store_descriptor_get_extent_map(
+	     store_descriptor,
+	     file_io_handle,
+	     &( extent_maps[ 0 ] ),
+	     error ) != 1 )
 	{
-		block_offset          = offset;
-		relative_block_offset = (uint32_t) (offset % 0x4000);
-		block_size            = 0x4000 - relative_block_offset;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve extent map of store: %02d.",
+		 function,
+		 store_descriptor->index );
 
-#if defined( HAVE_DEBUG_OUTPUT )
-		if( libcnotify_verbose != 0 )
+		return( -1 );
+	}
+	/* The current volume is represented by an empty extent map
+	 */
+	if( other_store_descriptor != NULL )
+	{
+		if( libvshadow_store_descriptor_get_extent_map(
+		     other_store_descriptor,
+		     file_io_handle,
+		     &( extent_maps[ 1 ] ),
+		     error ) != 1 )
 		{
-			libcnotify_printf(
-			 "%s: store: %02d block offset: 0x%08" PRIx64 "\n",
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve extent map of store: %02d.",
 			 function,
-			 store_descriptor->index,
-			 block_offset );
-		}
-#endif
-		in_block_descriptor_list         = 0;
-		in_reverse_block_descriptor_list = 0;
-		in_current_bitmap                = 0;
-		in_previous_bitmap               = 0;
+			 other_store_descriptor->index );
 
-		result = libcdata_btree_get_value_by_value(
-		          store_descriptor->forward_block_descriptors_tree,
-		          (intptr_t *) &block_offset,
-		          (int (*)(intptr_t *, intptr_t *, libcerror_error_t **)) &libvshadow_block_descriptor_compare_range_by_original_offset_value,
-		          &tree_node,
-		          (intptr_t **) &block_descriptor,
+			return( -1 );
+		}
+	}
+	for( map_index = 0;
+	     map_index < 2;
+	     map_index++ )
+	{
+		if( extent_maps[ map_index ] == NULL )
+		{
+			continue;
+		}
+		result = libvshadow_extent_map_get_extent_index_at_offset(
+		          extent_maps[ map_index ],
+		          offset,
+		          &( extent_indexes[ map_index ] ),
 		          error );
 
 		if( result == -1 )
@@ -2192,538 +4917,254 @@ ssize_t libvshadow_store_descriptor_read_buffer(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve block range for offset: 0x%08" PRIx64 ".",
+			 "%s: unable to retrieve extent for offset: 0x%08" PRIx64 ".",
 			 function,
-			 block_offset );
+			 offset );
 
-			goto on_error;
+			return( -1 );
 		}
-		else if( result != 0 )
+		else if( result == 0 )
+		{
+			extent_indexes[ map_index ] = extent_maps[ map_index ]->number_of_extents;
+		}
+	}
+	/* The extent maps are contiguous and sorted by offset, hence they can be walked side by side
+	 */
+	while( (size64_t) offset < volume_size )
+	{
+		for( map_index = 0;
+		     map_index < 2;
+		     map_index++ )
 		{
-			if( block_descriptor == NULL )
+			if( ( extent_maps[ map_index ] != NULL )
+			 && ( extent_indexes[ map_index ] < extent_maps[ map_index ]->number_of_extents ) )
 			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-				 "%s: missing block descriptor.",
-				 function );
-
-				goto on_error;
-			}
-			in_block_descriptor_list = 1;
+				extent = &( extent_maps[ map_index ]->extents[ extent_indexes[ map_index ] ] );
 
-			if( ( block_descriptor->flags & LIBVSHADOW_BLOCK_FLAG_IS_FORWARDER ) != 0 )
-			{
-				block_descriptor_offset = block_descriptor->relative_offset;
-			}
-			else
-			{
-				block_descriptor_offset = block_descriptor->offset;
-			}
-			if( ( block_descriptor->flags & LIBVSHADOW_BLOCK_FLAG_IS_OVERLAY ) != 0 )
-			{
-				overlay_block_descriptor = block_descriptor;
+				extent_types[ map_index ] = extent->type;
+				data_offsets[ map_index ] = extent->data_offset + ( offset - extent->offset );
+				end_offsets[ map_index ]  = extent->offset + (off64_t) extent->size;
 			}
 			else
 			{
-				overlay_block_descriptor = block_descriptor->overlay;
+				/* The data beyond the extent map is not defined by the store
+				 */
+				extent_types[ map_index ] = LIBVSHADOW_EXTENT_TYPE_VOLUME_DATA;
+				data_offsets[ map_index ] = offset;
+				end_offsets[ map_index ]  = (off64_t) volume_size;
 			}
-			if( overlay_block_descriptor != NULL )
+		}
+		next_offset = end_offsets[ 0 ];
+
+		if( end_offsets[ 1 ] < next_offset )
+		{
+			next_offset = end_offsets[ 1 ];
+		}
+		if( ( extent_types[ 0 ] == extent_types[ 1 ] )
+		 && ( ( extent_types[ 0 ] == LIBVSHADOW_EXTENT_TYPE_SPARSE )
+		  ||  ( data_offsets[ 0 ] == data_offsets[ 1 ] ) ) )
+		{
+			if( changed_offset != -1 )
 			{
-				if( store_descriptor->index != active_store_descriptor->index )
-				{
-					if( block_descriptor == overlay_block_descriptor )
-					{
-						block_descriptor         = NULL;
-						in_block_descriptor_list = 0;
-					}
-				}
-				else
-				{
-					overlay_block_offset = overlay_block_descriptor->original_offset;
-					overlay_bitmap       = overlay_block_descriptor->bitmap;
-
-					bit_count = 32;
-
-					while( overlay_block_offset < block_offset )
-					{
-						overlay_bitmap >>= 1;
-
-						overlay_block_offset += 512;
-
-						bit_count--;
-
-						if( bit_count == 0 )
-						{
-							break;
-						}
-					}
-					if( ( overlay_bitmap & 0x00000001UL ) != 0 )
-					{
-						block_descriptor_offset = overlay_block_descriptor->offset;
-						block_descriptor        = overlay_block_descriptor;
-
-						block_size = 0;
-
-						while( ( overlay_bitmap & 0x00000001UL ) != 0 )
-						{
-							overlay_bitmap >>= 1;
-
-							block_size += 512;
-
-							bit_count--;
-
-							if( bit_count == 0 )
-							{
-								break;
-							}
-						}
-					}
-					else
-					{
-						if( block_descriptor == overlay_block_descriptor )
-						{
-							block_descriptor         = NULL;
-							in_block_descriptor_list = 0;
-						}
-						block_size = 0;
-
-						while( ( overlay_bitmap & 0x00000001UL ) == 0 )
-						{
-							overlay_bitmap >>= 1;
-
-							block_size += 512;
-
-							bit_count--;
-
-							if( bit_count == 0 )
-							{
-								break;
-							}
-						}
-					}
-				}
+				break;
 			}
 		}
-		if( in_block_descriptor_list == 0 )
+		else if( changed_offset == -1 )
 		{
-			/* Only the most recent store seems to bother checking the current bitmap
-			 */
-			if( ( store_descriptor->next_store_descriptor == NULL )
-			 && ( store_descriptor->index == active_store_descriptor->index ) )
-			{
-				if( store_descriptor->reverse_block_descriptors_tree == NULL )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-					 "%s: invalid store descriptor - missing reverse block descriptors tree.",
-					 function );
+			changed_offset = offset;
+		}
+		offset = next_offset;
 
-					goto on_error;
-				}
-				result = libcdata_btree_get_value_by_value(
-					  store_descriptor->reverse_block_descriptors_tree,
-					  (intptr_t *) &block_offset,
-					  (int (*)(intptr_t *, intptr_t *, libcerror_error_t **)) &libvshadow_block_descriptor_compare_range_by_relative_offset_value,
-					  &tree_node,
-					  (intptr_t **) &reverse_block_descriptor,
-					  error );
-
-				if( result == -1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-					 "%s: unable to retrieve reverse block descriptor from root node.",
-					 function );
+		for( map_index = 0;
+		     map_index < 2;
+		     map_index++ )
+		{
+			if( ( extent_maps[ map_index ] != NULL )
+			 && ( offset >= end_offsets[ map_index ] ) )
+			{
+				extent_indexes[ map_index ] += 1;
+			}
+		}
+	}
+	if( changed_offset == -1 )
+	{
+		return( 0 );
+	}
+	*extent_offset = changed_offset;
+	*extent_size   = (size64_t) ( offset - changed_offset );
 
-					goto on_error;
-				}
-				in_reverse_block_descriptor_list = result;
+	return( 1 );
+}
 
-				result = libcdata_range_list_get_range_at_offset(
-					  store_descriptor->block_offset_list,
-					  (uint64_t) block_offset,
-					  (uint64_t *) &block_range_offset,
-					  (uint64_t *) &block_range_size,
-					  &value,
-					  error );
+/* Retrieves the next range, at or after a specific offset, that contains data
+ * The range does not contain sparse extents, of which the data consists of 0-byte values
+ * Returns 1 if successful, 0 if no such range or -1 on error
+ */
+int libvshadow_store_descriptor_get_next_data_range(
+     libvshadow_store_descriptor_t *store_descriptor,
+     libbfio_handle_t *file_io_handle,
+     off64_t offset,
+     off64_t *range_offset,
+     size64_t *range_size,
+     libcerror_error_t **error )
+{
+	libvshadow_extent_map_t *extent_map = NULL;
+	libvshadow_extent_t *extent         = NULL;
+	static char *function               = "libvshadow_store_descriptor_get_next_data_range";
+	off64_t data_offset                 = -1;
+	int extent_index                    = 0;
+	int result                          = 0;
 
-				if( result == -1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-					 "%s: unable to retrieve offset: 0x%08" PRIx64 " from block offset list.",
-					 function,
-					 offset );
+	if( store_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store descriptor.",
+		 function );
 
-					goto on_error;
-				}
-#if defined( HAVE_DEBUG_OUTPUT )
-				else if( result != 0 )
-				{
-					if( libcnotify_verbose != 0 )
-					{
-						libcnotify_printf(
-						 "%s: store: %02d block offset list: 0x%08" PRIx64 " - 0x%08" PRIx64 " (0x%08" PRIx64 ")\n",
-						 function,
-						 store_descriptor->index,
-						 block_range_offset,
-						 block_range_offset + block_range_size,
-						 block_range_size );
-					}
-				}
-#endif
-				in_current_bitmap = result;
+		return( -1 );
+	}
+	if( store_descriptor->has_in_volume_store_data == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store descriptor - missing in-volume store data.",
+		 function );
 
-				if( store_descriptor->store_previous_bitmap_offset != 0 )
-				{
-					result = libcdata_range_list_get_range_at_offset(
-						  store_descriptor->previous_block_offset_list,
-						  (uint64_t) block_offset,
-						  (uint64_t *) &previous_block_range_offset,
-						  (uint64_t *) &previous_block_range_size,
-						  &value,
-						  error );
-
-					if( result == -1 )
-					{
-						libcerror_error_set(
-						 error,
-						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-						 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-						 "%s: unable to retrieve offset: 0x%08" PRIx64 " from previous block offset list.",
-						 function,
-						 offset );
-
-						goto on_error;
-					}
-#if defined( HAVE_DEBUG_OUTPUT )
-					else if( result != 0 )
-					{
-						if( libcnotify_verbose != 0 )
-						{
-							libcnotify_printf(
-							 "%s: store: %02d previous block offset list: 0x%08" PRIx64 " - 0x%08" PRIx64 " (0x%08" PRIx64 ")\n",
-							 function,
-							 store_descriptor->index,
-							 previous_block_range_offset,
-							 previous_block_range_offset + previous_block_range_size,
-							 previous_block_range_size );
-						}
-					}
-#endif
-					in_previous_bitmap = result;
-				}
-				else
-				{
-					in_previous_bitmap = 1;
-				}
-			}
-		}
-		block_descriptor_offset += relative_block_offset;
+		return( -1 );
+	}
+	if( store_descriptor->volume_size > (size64_t) INT64_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid store descriptor - volume size value out of bounds.",
+		 function );
 
-		if( buffer_size > block_size )
-		{
-			read_size = block_size;
-		}
-		else
-		{
-			read_size = buffer_size;
-		}
-#if defined( HAVE_DEBUG_OUTPUT )
-		if( libcnotify_verbose != 0 )
-		{
-			libcnotify_printf(
-			 "%s: store: %02d range: 0x%08" PRIx64 " - 0x%08" PRIx64 " size: %" PRIzd "",
-			 function,
-			 store_descriptor->index,
-			 block_offset,
-			 block_offset + block_size,
-			 block_size );
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
 
-			if( block_descriptor != NULL )
-			{
-				libcnotify_printf(
-				 ", flags: 0x%08" PRIx32 "",
-				 block_descriptor->flags );
-			}
-			libcnotify_printf(
-			 "\n" );
+		return( -1 );
+	}
+	if( range_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range offset.",
+		 function );
 
-			if( in_block_descriptor_list != 0 )
-			{
-				libcnotify_printf(
-				 "\tIn block list\n" );
-			}
-			if( block_descriptor != NULL )
-			{
-				if( ( block_descriptor->flags & LIBVSHADOW_BLOCK_FLAG_IS_OVERLAY ) != 0 )
-				{
-					libcnotify_printf(
-					 "\tIs overlay\n" );
-				}
-			}
-			if( in_reverse_block_descriptor_list != 0 )
-			{
-				libcnotify_printf(
-				 "\tIn reverse block list\n" );
-			}
-			if( in_current_bitmap != 0 )
-			{
-				libcnotify_printf(
-				 "\tIn current bitmap\n" );
-			}
-			if( ( store_descriptor->store_previous_bitmap_offset != 0 )
-			 && ( in_previous_bitmap != 0 ) )
-			{
-				libcnotify_printf(
-				 "\tIn previous bitmap\n" );
-			}
-			libcnotify_printf(
-			 "\n" );
-		}
-#endif
-		if( in_block_descriptor_list != 0 )
-		{
-			if( ( ( block_descriptor->flags & LIBVSHADOW_BLOCK_FLAG_IS_FORWARDER ) != 0 )
-			 && ( store_descriptor->next_store_descriptor != NULL ) )
-			{
-#if defined( HAVE_DEBUG_OUTPUT )
-				if( libcnotify_verbose != 0 )
-				{
-					libcnotify_printf(
-					 "%s: store: %02d reading block from next store at offset: 0x%08" PRIx64 "\n",
-					 function,
-					 store_descriptor->index,
-					 block_descriptor_offset );
-				}
-#endif
-				read_count = libvshadow_store_descriptor_read_buffer(
-					      store_descriptor->next_store_descriptor,
-					      file_io_handle,
-					      &( buffer[ buffer_offset ] ),
-					      read_size,
-					      block_descriptor_offset,
-					      active_store_descriptor,
-					      error );
+		return( -1 );
+	}
+	if( range_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range size.",
+		 function );
 
-				if( read_count != (ssize_t) read_size )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_IO,
-					 LIBCERROR_IO_ERROR_READ_FAILED,
-					 "%s: unable to read buffer from next store descriptor.",
-					 function );
+		return( -1 );
+	}
+	if( (size64_t) offset >= store_descriptor->volume_size )
+	{
+		return( 0 );
+	}
+	if( libvshadow_store_descriptor_get_extent_map(
+	     store_descriptor,
+	     file_io_handle,
+	     &extent_map,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve extent map.",
+		 function );
 
-					goto on_error;
-				}
-			}
-			else
-			{
-#if defined( HAVE_DEBUG_OUTPUT )
-				if( libcnotify_verbose != 0 )
-				{
-					libcnotify_printf(
-					 "%s: store: %02d reading block from current volume at offset: 0x%08" PRIx64 "\n",
-					 function,
-					 store_descriptor->index,
-					 block_descriptor_offset );
-				}
-#endif
-				if( libbfio_handle_seek_offset(
-				     file_io_handle,
-				     block_descriptor_offset,
-				     SEEK_SET,
-				     error ) == -1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_IO,
-					 LIBCERROR_IO_ERROR_SEEK_FAILED,
-					 "%s: unable to seek block offset: %" PRIi64 ".",
-					 function,
-					 block_descriptor_offset );
+		return( -1 );
+	}
+	result = libvshadow_extent_map_get_extent_index_at_offset(
+	          extent_map,
+	          offset,
+	          &extent_index,
+	          error );
 
-					goto on_error;
-				}
-				read_count = libbfio_handle_read_buffer(
-					      file_io_handle,
-					      &( buffer[ buffer_offset ] ),
-					      read_size,
-					      error );
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve extent for offset: 0x%08" PRIx64 ".",
+		 function,
+		 offset );
 
-				if( read_count != (ssize_t) read_size )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_IO,
-					 LIBCERROR_IO_ERROR_READ_FAILED,
-					 "%s: unable to read buffer from file IO handle.",
-					 function );
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		extent_index = extent_map->number_of_extents;
+	}
+	while( extent_index < extent_map->number_of_extents )
+	{
+		extent = &( extent_map->extents[ extent_index ] );
 
-					goto on_error;
-				}
-			}
-		}
-		else
+		if( extent->type == LIBVSHADOW_EXTENT_TYPE_SPARSE )
 		{
-			/* Check if the next store defines the block
-			 */
-			if( store_descriptor->next_store_descriptor != NULL )
+			if( data_offset != -1 )
 			{
-#if defined( HAVE_DEBUG_OUTPUT )
-				if( libcnotify_verbose != 0 )
-				{
-					libcnotify_printf(
-					 "%s: store: %02d reading block from next store at offset: 0x%08" PRIx64 "\n",
-					 function,
-					 store_descriptor->index,
-					 block_offset );
-				}
-#endif
-				read_count = libvshadow_store_descriptor_read_buffer(
-					      store_descriptor->next_store_descriptor,
-					      file_io_handle,
-					      &( buffer[ buffer_offset ] ),
-					      read_size,
-					      block_offset,
-					      active_store_descriptor,
-					      error );
-
-				if( read_count != (ssize_t) read_size )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_IO,
-					 LIBCERROR_IO_ERROR_READ_FAILED,
-					 "%s: unable to read buffer from next store descriptor.",
-					 function );
-
-					goto on_error;
-				}
+				break;
 			}
-			else if( ( in_reverse_block_descriptor_list == 0 )
-			      && ( in_current_bitmap != 0 )
-			      && ( in_previous_bitmap != 0 ) )
-			{
-#if defined( HAVE_DEBUG_OUTPUT )
-				if( libcnotify_verbose != 0 )
-				{
-					libcnotify_printf(
-					 "%s: store: %02d filling block with zero bytes\n",
-					 function,
-					 store_descriptor->index,
-					 block_offset,
-					 read_size );
-				}
-#endif
-				if( memory_set(
-				     &( buffer[ buffer_offset ] ),
-				     0,
-				     read_size ) == NULL )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_MEMORY,
-					 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-					 "%s: unable to clear buffer.",
-					 function );
+		}
+		else if( data_offset == -1 )
+		{
+			data_offset = extent->offset;
 
-					goto on_error;
-				}
-				read_count = (ssize_t) read_size;
-			}
-			else
+			if( data_offset < offset )
 			{
-#if defined( HAVE_DEBUG_OUTPUT )
-				if( libcnotify_verbose != 0 )
-				{
-					libcnotify_printf(
-					 "%s: store: %02d reading block from current volume at offset: 0x%08" PRIx64 "\n",
-					 function,
-					 store_descriptor->index,
-					 block_offset );
-				}
-#endif
-				if( libbfio_handle_seek_offset(
-				     file_io_handle,
-				     block_offset,
-				     SEEK_SET,
-				     error ) == -1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_IO,
-					 LIBCERROR_IO_ERROR_SEEK_FAILED,
-					 "%s: unable to seek block offset: %" PRIi64 ".",
-					 function,
-					 block_offset );
-
-					goto on_error;
-				}
-				read_count = libbfio_handle_read_buffer(
-					      file_io_handle,
-					      &( buffer[ buffer_offset ] ),
-					      read_size,
-					      error );
-
-				if( read_count != (ssize_t) read_size )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_IO,
-					 LIBCERROR_IO_ERROR_READ_FAILED,
-					 "%s: unable to read buffer from file IO handle.",
-					 function );
-
-					goto on_error;
-				}
+				data_offset = offset;
 			}
 		}
-		offset        += read_count;
-		buffer_offset += read_count;
-		buffer_size   -= read_count;
+		offset = extent->offset + (off64_t) extent->size;
 
-#if defined( HAVE_DEBUG_OUTPUT )
-		if( libcnotify_verbose != 0 )
+		extent_index++;
+	}
+	/* The data beyond the extent map is not defined by the store and read from the volume
+	 */
+	if( ( extent_index >= extent_map->number_of_extents )
+	 && ( (size64_t) offset < store_descriptor->volume_size ) )
+	{
+		if( data_offset == -1 )
 		{
-			libcnotify_printf(
-			 "\n" );
+			data_offset = offset;
 		}
-#endif
+		offset = (off64_t) store_descriptor->volume_size;
 	}
-#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
-	     store_descriptor->read_write_lock,
-	     error ) != 1 )
+	if( data_offset == -1 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
-		 function );
-
-		return( -1 );
+		return( 0 );
 	}
-#endif
-	return( (ssize_t) buffer_offset );
+	*range_offset = data_offset;
+	*range_size   = (size64_t) ( offset - data_offset );
 
-on_error:
-#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_read(
-	 store_descriptor->read_write_lock,
-	 NULL );
-#endif
-	return( -1 );
+	return( 1 );
 }
 
 /* Retrieves the volume size
@@ -3252,6 +5693,17 @@ int libvshadow_store_descriptor_get_number_of_blocks(
 
 		return( -1 );
 	}
+	if( number_of_blocks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of blocks.",
+		 function );
+
+		return( -1 );
+	}
 	/* This function will acquire the write lock
 	 */
 	if( libvshadow_store_descriptor_read_block_descriptors(
@@ -3283,20 +5735,131 @@ int libvshadow_store_descriptor_get_number_of_blocks(
 		return( -1 );
 	}
 #endif
-	if( libcdata_list_get_number_of_elements(
-	     store_descriptor->block_descriptors_list,
-	     number_of_blocks,
+	*number_of_blocks = store_descriptor->block_list_index->number_of_blocks;
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     store_descriptor->read_write_lock,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of block descriptors.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves a specific block descriptor
+ * The block descriptor is copied into the value block_descriptor is pointing to
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_store_descriptor_get_block_descriptor_by_index(
+     libvshadow_store_descriptor_t *store_descriptor,
+     libbfio_handle_t *file_io_handle,
+     int block_index,
+     libvshadow_block_descriptor_t *block_descriptor,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_store_descriptor_get_block_descriptor_by_index";
+	int result            = 1;
+
+	if( store_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( store_descriptor->has_in_volume_store_data == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store descriptor - missing in-volume store data.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	/* This function will acquire the write lock
+	 */
+	if( libvshadow_store_descriptor_read_block_descriptors(
+	     store_descriptor,
+	     file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read block descriptors.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     store_descriptor->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( ( block_index < 0 )
+	 || ( block_index >= store_descriptor->block_list_index->number_of_blocks ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid block index value out of bounds.",
 		 function );
 
 		result = -1;
 	}
+	else if( libvshadow_block_index_get_block_descriptor_by_index(
+	          store_descriptor->block_list_index,
+	          block_index,
+	          block_descriptor,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve block descriptor: %d from block list index.",
+		 function,
+		 block_index );
+
+		result = -1;
+	}
 #if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_read(
 	     store_descriptor->read_write_lock,
@@ -3315,17 +5878,27 @@ int libvshadow_store_descriptor_get_number_of_blocks(
 	return( result );
 }
 
-/* Retrieves a specific block descriptor
+/* Retrieves the values of a range of blocks
+ * The values are copied into the arrays, which must contain at least number of blocks entries,
+ * arrays of values that are not needed can be NULL
  * Returns 1 if successful or -1 on error
  */
-int libvshadow_store_descriptor_get_block_descriptor_by_index(
+int libvshadow_store_descriptor_get_block_values(
      libvshadow_store_descriptor_t *store_descriptor,
      libbfio_handle_t *file_io_handle,
-     int block_index,
-     libvshadow_block_descriptor_t **block_descriptor,
+     int first_block_index,
+     int number_of_blocks,
+     off64_t *original_offsets,
+     off64_t *relative_offsets,
+     off64_t *offsets,
+     uint32_t *flags,
+     uint32_t *bitmaps,
      libcerror_error_t **error )
 {
-	static char *function = "libvshadow_store_descriptor_get_block_descriptor_by_index";
+	libvshadow_block_descriptor_t block_descriptor;
+
+	static char *function = "libvshadow_store_descriptor_get_block_values";
+	int block_index       = 0;
 	int result            = 1;
 
 	if( store_descriptor == NULL )
@@ -3350,6 +5923,28 @@ int libvshadow_store_descriptor_get_block_descriptor_by_index(
 
 		return( -1 );
 	}
+	if( first_block_index < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid first block index value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_blocks < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of blocks value less than zero.",
+		 function );
+
+		return( -1 );
+	}
 	/* This function will acquire the write lock
 	 */
 	if( libvshadow_store_descriptor_read_block_descriptors(
@@ -3381,22 +5976,63 @@ int libvshadow_store_descriptor_get_block_descriptor_by_index(
 		return( -1 );
 	}
 #endif
-	if( libcdata_list_get_value_by_index(
-	     store_descriptor->block_descriptors_list,
-	     block_index,
-	     (intptr_t **) block_descriptor,
-	     error ) != 1 )
+	if( number_of_blocks > ( store_descriptor->block_list_index->number_of_blocks - first_block_index ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve block descriptor: %d.",
-		 function,
-		 block_index );
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of blocks value out of bounds.",
+		 function );
 
 		result = -1;
 	}
+	else
+	{
+		for( block_index = 0;
+		     block_index < number_of_blocks;
+		     block_index++ )
+		{
+			if( libvshadow_block_index_get_block_descriptor_by_index(
+			     store_descriptor->block_list_index,
+			     first_block_index + block_index,
+			     &block_descriptor,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve block descriptor: %d from block list index.",
+				 function,
+				 first_block_index + block_index );
+
+				result = -1;
+
+				break;
+			}
+			if( original_offsets != NULL )
+			{
+				original_offsets[ block_index ] = block_descriptor.original_offset;
+			}
+			if( relative_offsets != NULL )
+			{
+				relative_offsets[ block_index ] = block_descriptor.relative_offset;
+			}
+			if( offsets != NULL )
+			{
+				offsets[ block_index ] = block_descriptor.offset;
+			}
+			if( flags != NULL )
+			{
+				flags[ block_index ] = block_descriptor.flags;
+			}
+			if( bitmaps != NULL )
+			{
+				bitmaps[ block_index ] = block_descriptor.bitmap;
+			}
+		}
+	}
 #if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_read(
 	     store_descriptor->read_write_lock,
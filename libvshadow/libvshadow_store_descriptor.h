@@ -25,11 +25,17 @@
 #include <common.h>
 #include <types.h>
 
+#include "libvshadow_bitmap.h"
+#include "libvshadow_block_cache.h"
 #include "libvshadow_block_descriptor.h"
+#include "libvshadow_block_descriptor_arena.h"
+#include "libvshadow_block_index.h"
+#include "libvshadow_extent_map.h"
 #include "libvshadow_libbfio.h"
 #include "libvshadow_libcdata.h"
 #include "libvshadow_libcerror.h"
 #include "libvshadow_libcthreads.h"
+#include "libvshadow_metadata_reader.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -102,25 +108,48 @@ struct libvshadow_store_descriptor
 	 */
 	uint16_t service_machine_string_size;
 
-	/* The block descriptors list
+	/* The block list index
+	 * Contains the packed block descriptors in the order of the store block list
 	 */
-	libcdata_list_t *block_descriptors_list;
+	libvshadow_block_index_t *block_list_index;
 
 	/* The forward block descriptors B-tree
+	 * Only used while reading the block descriptors
 	 */
 	libcdata_btree_t *forward_block_descriptors_tree;
 
 	/* The reverse block descriptors B-tree
+	 * Only used while reading the block descriptors
 	 */
 	libcdata_btree_t *reverse_block_descriptors_tree;
 
-	/* The block offset list
+	/* The block descriptor arena
+	 * Contains the block descriptors of the block descriptors B-trees
 	 */
-	libcdata_range_list_t *block_offset_list;
+	libvshadow_block_descriptor_arena_t *block_descriptor_arena;
 
-	/* The previous block offset list
+	/* The (current) store bitmap
+	 * Contains a bit per 16 KiB block of the volume
 	 */
-	libcdata_range_list_t *previous_block_offset_list;
+	libvshadow_bitmap_t *bitmap;
+
+	/* The previous store bitmap
+	 */
+	libvshadow_bitmap_t *previous_bitmap;
+
+	/* The forward block index
+	 * Contains the block descriptors sorted by original offset
+	 */
+	libvshadow_block_index_t *forward_block_index;
+
+	/* The reverse block index
+	 * Contains the relative offsets of the forwarder block descriptors
+	 */
+	libvshadow_block_index_t *reverse_block_index;
+
+	/* The extent map
+	 */
+	libvshadow_extent_map_t *extent_map;
 
 	/* The previous store descriptor in the read chain
 	 */
@@ -139,9 +168,27 @@ struct libvshadow_store_descriptor
 	uint8_t has_in_volume_store_data;
 
 	/* Value to indicate the block descriptors have been read
+	 * This value is cleared when the metadata is released
 	 */
 	uint8_t block_descriptors_read;
 
+	/* Value to indicate the store block list has been read
+	 * The block descriptors are kept when the metadata is released,
+	 * hence the block indexes can be rebuilt without reading the store block list
+	 */
+	uint8_t block_list_read;
+
+	/* The sequence number of the last read
+	 * Used to release the metadata of the least recently read stores,
+	 * this value is protected by the read sequence mutex of the volume
+	 */
+	uint64_t last_read_sequence_number;
+
+	/* The releasable metadata size at the last read
+	 * This value is protected by the read sequence mutex of the volume
+	 */
+	size64_t last_releasable_metadata_size;
+
 #if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
 	/* The read/write lock
 	 */
@@ -181,45 +228,172 @@ int libvshadow_store_descriptor_read_catalog_entry(
 int libvshadow_store_descriptor_read_store_header(
      libvshadow_store_descriptor_t *store_descriptor,
      libbfio_handle_t *file_io_handle,
+     libvshadow_metadata_reader_t *metadata_reader,
      libcerror_error_t **error );
 
 int libvshadow_store_descriptor_read_store_bitmap(
      libvshadow_store_descriptor_t *store_descriptor,
      libbfio_handle_t *file_io_handle,
+     libvshadow_metadata_reader_t *metadata_reader,
      off64_t file_offset,
-     libcdata_range_list_t *offset_list,
-     off64_t *bitmap_offset,
+     libvshadow_bitmap_t *bitmap,
      off64_t *next_offset,
      libcerror_error_t **error );
 
 int libvshadow_store_descriptor_read_store_block_list(
      libvshadow_store_descriptor_t *store_descriptor,
      libbfio_handle_t *file_io_handle,
+     libvshadow_metadata_reader_t *metadata_reader,
      off64_t file_offset,
      off64_t *next_offset,
      libcerror_error_t **error );
 
+int libvshadow_store_descriptor_append_block_descriptor(
+     libvshadow_store_descriptor_t *store_descriptor,
+     libvshadow_block_descriptor_t *block_descriptor,
+     libcerror_error_t **error );
+
 int libvshadow_store_descriptor_read_store_block_range_list(
      libvshadow_store_descriptor_t *store_descriptor,
      libbfio_handle_t *file_io_handle,
+     libvshadow_metadata_reader_t *metadata_reader,
      off64_t file_offset,
      off64_t *next_offset,
      libcerror_error_t **error );
 
+int libvshadow_store_descriptor_build_block_indexes(
+     libvshadow_store_descriptor_t *store_descriptor,
+     libcerror_error_t **error );
+
+int libvshadow_store_descriptor_insert_block_descriptors(
+     libvshadow_store_descriptor_t *store_descriptor,
+     libcerror_error_t **error );
+
 int libvshadow_store_descriptor_read_block_descriptors(
      libvshadow_store_descriptor_t *store_descriptor,
      libbfio_handle_t *file_io_handle,
      libcerror_error_t **error );
 
+int libvshadow_store_descriptor_release_metadata(
+     libvshadow_store_descriptor_t *store_descriptor,
+     libcerror_error_t **error );
+
+int libvshadow_store_descriptor_get_metadata_size(
+     libvshadow_store_descriptor_t *store_descriptor,
+     size64_t *metadata_size,
+     size64_t *releasable_metadata_size,
+     libcerror_error_t **error );
+
+int libvshadow_store_descriptor_get_forward_block_descriptor_index(
+     libvshadow_store_descriptor_t *store_descriptor,
+     off64_t offset,
+     int *block_descriptor_index,
+     libcerror_error_t **error );
+
+int libvshadow_store_descriptor_get_reverse_block_descriptor_range(
+     libvshadow_store_descriptor_t *store_descriptor,
+     off64_t offset,
+     int *in_reverse_block_descriptors,
+     off64_t *range_end_offset,
+     libcerror_error_t **error );
+
+int libvshadow_store_descriptor_get_bitmap_range(
+     libvshadow_bitmap_t *bitmap,
+     off64_t offset,
+     int *in_bitmap,
+     off64_t *range_end_offset,
+     libcerror_error_t **error );
+
+int libvshadow_store_descriptor_append_unmapped_extents(
+     libvshadow_store_descriptor_t *store_descriptor,
+     libvshadow_store_descriptor_t *active_store_descriptor,
+     libvshadow_extent_map_t *extent_map,
+     off64_t offset,
+     size64_t size,
+     libcerror_error_t **error );
+
+int libvshadow_store_descriptor_append_block_descriptor_extents(
+     libvshadow_store_descriptor_t *store_descriptor,
+     libvshadow_store_descriptor_t *active_store_descriptor,
+     libvshadow_extent_map_t *extent_map,
+     libvshadow_block_descriptor_t *block_descriptor,
+     off64_t offset,
+     size64_t size,
+     libcerror_error_t **error );
+
+int libvshadow_store_descriptor_append_block_extents(
+     libvshadow_store_descriptor_t *store_descriptor,
+     libvshadow_store_descriptor_t *active_store_descriptor,
+     libvshadow_extent_map_t *extent_map,
+     libvshadow_block_descriptor_t *block_descriptor,
+     off64_t offset,
+     size64_t size,
+     libcerror_error_t **error );
+
+int libvshadow_store_descriptor_append_extents(
+     libvshadow_store_descriptor_t *store_descriptor,
+     libvshadow_store_descriptor_t *active_store_descriptor,
+     libvshadow_extent_map_t *extent_map,
+     off64_t offset,
+     size64_t size,
+     libcerror_error_t **error );
+
+int libvshadow_store_descriptor_read_extent_map(
+     libvshadow_store_descriptor_t *store_descriptor,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
 ssize_t libvshadow_store_descriptor_read_buffer(
          libvshadow_store_descriptor_t *store_descriptor,
          libbfio_handle_t *file_io_handle,
+         libvshadow_block_cache_t *block_cache,
          uint8_t *buffer,
          size_t buffer_size,
          off64_t offset,
-         libvshadow_store_descriptor_t *active_store_descriptor,
          libcerror_error_t **error );
 
+ssize_t libvshadow_store_descriptor_read_buffers(
+         libvshadow_store_descriptor_t *store_descriptor,
+         libbfio_handle_t *file_io_handle,
+         libvshadow_block_cache_t *block_cache,
+         uint8_t **buffers,
+         size_t *buffer_sizes,
+         off64_t *offsets,
+         int number_of_buffers,
+         libcerror_error_t **error );
+
+int libvshadow_store_descriptor_get_extent_at_offset(
+     libvshadow_store_descriptor_t *store_descriptor,
+     libbfio_handle_t *file_io_handle,
+     off64_t offset,
+     size64_t *extent_size,
+     off64_t *extent_data_offset,
+     uint8_t *extent_type,
+     libcerror_error_t **error );
+
+int libvshadow_store_descriptor_get_extent_map(
+     libvshadow_store_descriptor_t *store_descriptor,
+     libbfio_handle_t *file_io_handle,
+     libvshadow_extent_map_t **extent_map,
+     libcerror_error_t **error );
+
+int libvshadow_store_descriptor_get_next_changed_extent(
+     libvshadow_store_descriptor_t *store_descriptor,
+     libvshadow_store_descriptor_t *other_store_descriptor,
+     libbfio_handle_t *file_io_handle,
+     off64_t offset,
+     off64_t *extent_offset,
+     size64_t *extent_size,
+     libcerror_error_t **error );
+
+int libvshadow_store_descriptor_get_next_data_range(
+     libvshadow_store_descriptor_t *store_descriptor,
+     libbfio_handle_t *file_io_handle,
+     off64_t offset,
+     off64_t *range_offset,
+     size64_t *range_size,
+     libcerror_error_t **error );
+
 int libvshadow_store_descriptor_get_volume_size(
      libvshadow_store_descriptor_t *store_descriptor,
      size64_t *volume_size,
@@ -263,7 +437,19 @@ int libvshadow_store_descriptor_get_block_descriptor_by_index(
      libvshadow_store_descriptor_t *store_descriptor,
      libbfio_handle_t *file_io_handle,
      int block_index,
-     libvshadow_block_descriptor_t **block_descriptor,
+     libvshadow_block_descriptor_t *block_descriptor,
+     libcerror_error_t **error );
+
+int libvshadow_store_descriptor_get_block_values(
+     libvshadow_store_descriptor_t *store_descriptor,
+     libbfio_handle_t *file_io_handle,
+     int first_block_index,
+     int number_of_blocks,
+     off64_t *original_offsets,
+     off64_t *relative_offsets,
+     off64_t *offsets,
+     uint32_t *flags,
+     uint32_t *bitmaps,
      libcerror_error_t **error );
 
 #if defined( __cplusplus )
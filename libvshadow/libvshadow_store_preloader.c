@@ -0,0 +1,743 @@
+/*
+ * Store preloader functions
+ *
+ * Copyright (C) 2011-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libvshadow_io_handle.h"
+#include "libvshadow_libbfio.h"
+#include "libvshadow_libcdata.h"
+#include "libvshadow_libcerror.h"
+#include "libvshadow_libcnotify.h"
+#include "libvshadow_libcthreads.h"
+#include "libvshadow_store_descriptor.h"
+#include "libvshadow_store_preloader.h"
+
+/* Creates a store preloader
+ * Make sure the value store_preloader is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_store_preloader_initialize(
+     libvshadow_store_preloader_t **store_preloader,
+     libvshadow_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     int number_of_stores,
+     int (*progress_callback)(
+            int number_of_stores_read,
+            int number_of_stores,
+            void *callback_data ),
+     void *callback_data,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_store_preloader_initialize";
+
+	if( store_preloader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store preloader.",
+		 function );
+
+		return( -1 );
+	}
+	if( *store_preloader != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid store preloader value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_stores < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of stores value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	*store_preloader = memory_allocate_structure(
+	                    libvshadow_store_preloader_t );
+
+	if( *store_preloader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create store preloader.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *store_preloader,
+	     0,
+	     sizeof( libvshadow_store_preloader_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear store preloader.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_initialize(
+	     &( ( *store_preloader )->read_write_lock ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to intialize read/write lock.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	( *store_preloader )->io_handle          = io_handle;
+	( *store_preloader )->file_io_handle     = file_io_handle;
+	( *store_preloader )->number_of_stores   = number_of_stores;
+	( *store_preloader )->progress_callback  = progress_callback;
+	( *store_preloader )->callback_data      = callback_data;
+	( *store_preloader )->failed_store_index = -1;
+
+	return( 1 );
+
+on_error:
+	if( *store_preloader != NULL )
+	{
+		memory_free(
+		 *store_preloader );
+
+		*store_preloader = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a store preloader
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_store_preloader_free(
+     libvshadow_store_preloader_t **store_preloader,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_store_preloader_free";
+	int result            = 1;
+
+	if( store_preloader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store preloader.",
+		 function );
+
+		return( -1 );
+	}
+	if( *store_preloader != NULL )
+	{
+		/* The io_handle and file_io_handle references are freed elsewhere
+		 */
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_free(
+		     &( ( *store_preloader )->read_write_lock ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read/write lock.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		memory_free(
+		 *store_preloader );
+
+		*store_preloader = NULL;
+	}
+	return( result );
+}
+
+/* Reads a store
+ * This function is used as the callback of the thread pool, errors are
+ * recorded in the store preloader
+ * Returns 1 if successful, 0 if skipped or -1 on error
+ */
+int libvshadow_store_preloader_read_store(
+     libvshadow_store_descriptor_t *store_descriptor,
+     libvshadow_store_preloader_t *store_preloader )
+{
+	libcerror_error_t *error = NULL;
+	int read_result          = 0;
+	int store_index          = -1;
+
+	if( store_descriptor != NULL )
+	{
+		store_index = store_descriptor->index;
+	}
+	read_result = libvshadow_store_preloader_read_store_descriptor(
+	               store_preloader,
+	               store_descriptor,
+	               &error );
+
+	if( read_result == -1 )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	if( libvshadow_store_preloader_set_store_read(
+	     store_preloader,
+	     store_index,
+	     read_result,
+	     &error ) != 1 )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+
+		read_result = -1;
+	}
+	return( read_result );
+}
+
+/* Reads the block descriptors and the extent map of a store descriptor
+ * Returns 1 if successful, 0 if skipped because preloading was aborted or -1 on error
+ */
+int libvshadow_store_preloader_read_store_descriptor(
+     libvshadow_store_preloader_t *store_preloader,
+     libvshadow_store_descriptor_t *store_descriptor,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	static char *function            = "libvshadow_store_preloader_read_store_descriptor";
+	uint8_t abort                    = 0;
+	int result                       = 0;
+
+	if( store_preloader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store preloader.",
+		 function );
+
+		return( -1 );
+	}
+	if( store_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store descriptor.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     store_preloader->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( ( store_preloader->abort != 0 )
+	 || ( store_preloader->io_handle->abort != 0 ) )
+	{
+		abort = 1;
+	}
+	else if( store_preloader->clone_file_io_handle == 0 )
+	{
+		file_io_handle = store_preloader->file_io_handle;
+	}
+	/* Cloning is done while holding the lock since the clone
+	 * reads the state of the file IO handle that is shared by the workers
+	 */
+	else if( libbfio_handle_clone(
+	          &file_io_handle,
+	          store_preloader->file_io_handle,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to clone file IO handle.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     store_preloader->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	if( result == -1 )
+	{
+		goto on_error;
+	}
+	if( abort != 0 )
+	{
+		return( 0 );
+	}
+	if( store_preloader->clone_file_io_handle != 0 )
+	{
+		result = libbfio_handle_is_open(
+		          file_io_handle,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if cloned file IO handle is open.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			if( libbfio_handle_open(
+			     file_io_handle,
+			     LIBBFIO_OPEN_READ,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_OPEN_FAILED,
+				 "%s: unable to open cloned file IO handle.",
+				 function );
+
+				goto on_error;
+			}
+		}
+	}
+	/* The extent map requires the block descriptors of the store and of
+	 * the more recent stores, the block descriptors of each store are only read once
+	 */
+	if( libvshadow_store_descriptor_read_extent_map(
+	     store_descriptor,
+	     file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read extent map of store: %02d.",
+		 function,
+		 store_descriptor->index );
+
+		goto on_error;
+	}
+	if( store_preloader->clone_file_io_handle != 0 )
+	{
+		if( libbfio_handle_close(
+		     file_io_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close cloned file IO handle.",
+			 function );
+
+			goto on_error;
+		}
+		if( libbfio_handle_free(
+		     &file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free cloned file IO handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( ( store_preloader->clone_file_io_handle != 0 )
+	 && ( file_io_handle != NULL ) )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Marks a store as read and reports the progress
+ * The progress callback is called while holding the lock, hence it is never called concurrently
+ * Preloading is aborted if the store could not be read or if the progress callback returns 0
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_store_preloader_set_store_read(
+     libvshadow_store_preloader_t *store_preloader,
+     int store_index,
+     int read_result,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_store_preloader_set_store_read";
+
+	if( store_preloader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store preloader.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     store_preloader->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( read_result == -1 )
+	{
+		if( store_preloader->failed_store_index == -1 )
+		{
+			store_preloader->failed_store_index = store_index;
+		}
+		store_preloader->abort = 1;
+	}
+	else if( read_result == 1 )
+	{
+		store_preloader->number_of_stores_read += 1;
+
+		if( store_preloader->progress_callback != NULL )
+		{
+			if( store_preloader->progress_callback(
+			     store_preloader->number_of_stores_read,
+			     store_preloader->number_of_stores,
+			     store_preloader->callback_data ) == 0 )
+			{
+				store_preloader->abort = 1;
+			}
+		}
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     store_preloader->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Reads the block descriptors and the extent maps of all the stores
+ * The stores are read from the most recent to the oldest, since the extent map
+ * of a store depends on the block descriptors of the more recent stores
+ * If more than 1 thread is used the stores are read by a thread pool, where
+ * every store is read using its own clone of the file IO handle
+ * Returns 1 if successful, 0 if aborted or -1 on error
+ */
+int libvshadow_store_preloader_read_stores(
+     libvshadow_store_preloader_t *store_preloader,
+     libcdata_array_t *store_descriptors_array,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	libvshadow_store_descriptor_t *store_descriptor = NULL;
+	static char *function                           = "libvshadow_store_preloader_read_stores";
+	int read_result                                 = 0;
+	int store_descriptor_index                      = 0;
+
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	libcthreads_thread_pool_t *thread_pool          = NULL;
+#endif
+
+	if( store_preloader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store preloader.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_threads <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid number of threads value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_threads > store_preloader->number_of_stores )
+	{
+		number_of_threads = store_preloader->number_of_stores;
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( number_of_threads > 1 )
+	{
+		store_preloader->clone_file_io_handle = 1;
+
+		if( libcthreads_thread_pool_create(
+		     &thread_pool,
+		     NULL,
+		     number_of_threads,
+		     store_preloader->number_of_stores,
+		     (int (*)(intptr_t *, void *)) &libvshadow_store_preloader_read_store,
+		     (void *) store_preloader,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create thread pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
+	for( store_descriptor_index = store_preloader->number_of_stores - 1;
+	     store_descriptor_index >= 0;
+	     store_descriptor_index-- )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     store_descriptors_array,
+		     store_descriptor_index,
+		     (intptr_t **) &store_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve store descriptor: %d.",
+			 function,
+			 store_descriptor_index );
+
+			goto on_error;
+		}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+		if( thread_pool != NULL )
+		{
+			if( libcthreads_thread_pool_push(
+			     thread_pool,
+			     (intptr_t *) store_descriptor,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to push store descriptor: %d onto thread pool queue.",
+				 function,
+				 store_descriptor_index );
+
+				goto on_error;
+			}
+			continue;
+		}
+#endif
+		read_result = libvshadow_store_preloader_read_store_descriptor(
+		               store_preloader,
+		               store_descriptor,
+		               error );
+
+		if( read_result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read store: %02d.",
+			 function,
+			 store_descriptor_index );
+
+			goto on_error;
+		}
+		if( libvshadow_store_preloader_set_store_read(
+		     store_preloader,
+		     store_descriptor_index,
+		     read_result,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set store: %02d read.",
+			 function,
+			 store_descriptor_index );
+
+			goto on_error;
+		}
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( thread_pool != NULL )
+	{
+		if( libcthreads_thread_pool_join(
+		     &thread_pool,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join thread pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
+	if( store_preloader->failed_store_index != -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read store: %02d.",
+		 function,
+		 store_preloader->failed_store_index );
+
+		return( -1 );
+	}
+	if( store_preloader->number_of_stores_read != store_preloader->number_of_stores )
+	{
+		return( 0 );
+	}
+	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( thread_pool != NULL )
+	{
+		libcthreads_thread_pool_join(
+		 &thread_pool,
+		 NULL );
+	}
+#endif
+	return( -1 );
+}
+
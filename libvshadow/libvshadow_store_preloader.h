@@ -0,0 +1,132 @@
+/*
+ * Store preloader functions
+ *
+ * Copyright (C) 2011-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVSHADOW_STORE_PRELOADER_H )
+#define _LIBVSHADOW_STORE_PRELOADER_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvshadow_io_handle.h"
+#include "libvshadow_libbfio.h"
+#include "libvshadow_libcdata.h"
+#include "libvshadow_libcerror.h"
+#include "libvshadow_libcthreads.h"
+#include "libvshadow_store_descriptor.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libvshadow_store_preloader libvshadow_store_preloader_t;
+
+struct libvshadow_store_preloader
+{
+	/* The IO handle
+	 */
+	libvshadow_io_handle_t *io_handle;
+
+	/* The file IO handle
+	 * The workers read from a clone of this handle
+	 */
+	libbfio_handle_t *file_io_handle;
+
+	/* The number of stores
+	 */
+	int number_of_stores;
+
+	/* The number of stores that have been read
+	 */
+	int number_of_stores_read;
+
+	/* The progress callback function
+	 */
+	int (*progress_callback)(
+	       int number_of_stores_read,
+	       int number_of_stores,
+	       void *callback_data );
+
+	/* The progress callback data
+	 */
+	void *callback_data;
+
+	/* Value to indicate if the file IO handle should be cloned for every store
+	 */
+	uint8_t clone_file_io_handle;
+
+	/* Value to indicate if preloading was aborted
+	 */
+	uint8_t abort;
+
+	/* The index of the first store that could not be read or -1 if not set
+	 */
+	int failed_store_index;
+
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	/* The read/write lock
+	 */
+	libcthreads_read_write_lock_t *read_write_lock;
+#endif
+};
+
+int libvshadow_store_preloader_initialize(
+     libvshadow_store_preloader_t **store_preloader,
+     libvshadow_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     int number_of_stores,
+     int (*progress_callback)(
+            int number_of_stores_read,
+            int number_of_stores,
+            void *callback_data ),
+     void *callback_data,
+     libcerror_error_t **error );
+
+int libvshadow_store_preloader_free(
+     libvshadow_store_preloader_t **store_preloader,
+     libcerror_error_t **error );
+
+int libvshadow_store_preloader_read_store(
+     libvshadow_store_descriptor_t *store_descriptor,
+     libvshadow_store_preloader_t *store_preloader );
+
+int libvshadow_store_preloader_read_store_descriptor(
+     libvshadow_store_preloader_t *store_preloader,
+     libvshadow_store_descriptor_t *store_descriptor,
+     libcerror_error_t **error );
+
+int libvshadow_store_preloader_set_store_read(
+     libvshadow_store_preloader_t *store_preloader,
+     int store_index,
+     int read_result,
+     libcerror_error_t **error );
+
+int libvshadow_store_preloader_read_stores(
+     libvshadow_store_preloader_t *store_preloader,
+     libcdata_array_t *store_descriptors_array,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVSHADOW_STORE_PRELOADER_H ) */
+
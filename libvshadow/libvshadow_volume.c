@@ -25,16 +25,21 @@
 #include <types.h>
 #include <wide_string.h>
 
+#include "libvshadow_block_cache.h"
 #include "libvshadow_debug.h"
 #include "libvshadow_definitions.h"
+#include "libvshadow_index_cache.h"
 #include "libvshadow_io_handle.h"
 #include "libvshadow_libbfio.h"
 #include "libvshadow_libcdata.h"
 #include "libvshadow_libcerror.h"
 #include "libvshadow_libcnotify.h"
 #include "libvshadow_libcthreads.h"
+#include "libvshadow_metadata_reader.h"
+#include "libvshadow_read_list.h"
 #include "libvshadow_store.h"
 #include "libvshadow_store_descriptor.h"
+#include "libvshadow_store_preloader.h"
 #include "libvshadow_volume.h"
 
 /* Creates a volume
@@ -142,6 +147,19 @@ int libvshadow_volume_initialize(
 
 		goto on_error;
 	}
+	if( libcthreads_mutex_initialize(
+	     &( internal_volume->read_sequence_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to intialize read sequence mutex.",
+		 function );
+
+		goto on_error;
+	}
 #endif
 	*volume = (libvshadow_volume_t *) internal_volume;
 
@@ -150,6 +168,14 @@ int libvshadow_volume_initialize(
 on_error:
 	if( internal_volume != NULL )
 	{
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+		if( internal_volume->read_write_lock != NULL )
+		{
+			libcthreads_read_write_lock_free(
+			 &( internal_volume->read_write_lock ),
+			 NULL );
+		}
+#endif
 		if( internal_volume->store_descriptors_array != NULL )
 		{
 			libcdata_array_free(
@@ -221,6 +247,19 @@ int libvshadow_volume_free(
 
 			result = -1;
 		}
+		if( libcthreads_mutex_free(
+		     &( internal_volume->read_sequence_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read sequence mutex.",
+			 function );
+
+			result = -1;
+		}
 #endif
 		if( libcdata_array_free(
 		     &( internal_volume->store_descriptors_array ),
@@ -892,6 +931,7 @@ int libvshadow_volume_close(
 	}
 	internal_volume->file_io_handle = NULL;
 	internal_volume->size           = 0;
+	internal_volume->catalog_offset = 0;
 
 	if( libvshadow_io_handle_clear(
 	     internal_volume->io_handle,
@@ -920,6 +960,22 @@ int libvshadow_volume_close(
 
 		result = -1;
 	}
+	if( internal_volume->block_cache != NULL )
+	{
+		if( libvshadow_block_cache_free(
+		     &( internal_volume->block_cache ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free block cache.",
+			 function );
+
+			result = -1;
+		}
+	}
 #if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
 	     internal_volume->read_write_lock,
@@ -946,6 +1002,7 @@ int libvshadow_volume_open_read(
      libbfio_handle_t *file_io_handle,
      libcerror_error_t **error )
 {
+	libvshadow_metadata_reader_t *metadata_reader        = NULL;
 	libvshadow_store_descriptor_t *last_store_descriptor = NULL;
 	libvshadow_store_descriptor_t *store_descriptor      = NULL;
 	static char *function                                = "libvshadow_volume_open_read";
@@ -1035,8 +1092,28 @@ int libvshadow_volume_open_read(
 
 		goto on_error;
 	}
+	internal_volume->catalog_offset = catalog_offset;
+
 	if( catalog_offset > 0 )
 	{
+		/* The catalog and store headers are read through a single metadata reader
+		 * so that adjacent metadata blocks are read with fewer I/O operations
+		 */
+		if( libvshadow_metadata_reader_initialize(
+		     &metadata_reader,
+		     (size_t) internal_volume->io_handle->block_size,
+		     LIBVSHADOW_METADATA_READER_MAXIMUM_NUMBER_OF_BLOCKS,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create metadata reader.",
+			 function );
+
+			goto on_error;
+		}
 #if defined( HAVE_DEBUG_OUTPUT )
 		if( libcnotify_verbose != 0 )
 		{
@@ -1047,6 +1124,7 @@ int libvshadow_volume_open_read(
 		if( libvshadow_io_handle_read_catalog(
 		     internal_volume->io_handle,
 		     file_io_handle,
+		     metadata_reader,
 		     catalog_offset,
 		     &( internal_volume->size ),
 		     internal_volume->store_descriptors_array,
@@ -1122,6 +1200,7 @@ int libvshadow_volume_open_read(
 				if( libvshadow_store_descriptor_read_store_header(
 				     store_descriptor,
 				     file_io_handle,
+				     metadata_reader,
 				     error ) != 1 )
 				{
 					libcerror_error_set(
@@ -1145,6 +1224,37 @@ int libvshadow_volume_open_read(
 
 			store_descriptor = NULL;
 		}
+		if( libvshadow_metadata_reader_free(
+		     &metadata_reader,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free metadata reader.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( internal_volume->maximum_cache_size > 0 )
+	{
+		if( libvshadow_block_cache_initialize(
+		     &( internal_volume->block_cache ),
+		     internal_volume->maximum_cache_size,
+		     (size_t) internal_volume->io_handle->block_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create block cache.",
+			 function );
+
+			goto on_error;
+		}
 	}
 #if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
@@ -1164,7 +1274,20 @@ int libvshadow_volume_open_read(
 	return( 1 );
 
 on_error:
-	internal_volume->size = 0;
+	if( metadata_reader != NULL )
+	{
+		libvshadow_metadata_reader_free(
+		 &metadata_reader,
+		 NULL );
+	}
+	if( internal_volume->block_cache != NULL )
+	{
+		libvshadow_block_cache_free(
+		 &( internal_volume->block_cache ),
+		 NULL );
+	}
+	internal_volume->size           = 0;
+	internal_volume->catalog_offset = 0;
 
 	libcdata_array_empty(
 	 internal_volume->store_descriptors_array,
@@ -1520,3 +1643,2539 @@ on_error:
 	return( -1 );
 }
 
+/* Retrieves the next extent, at or after a specific offset, of which the data differs between 2 stores
+ * If other store index is -1 the store is compared to the current volume
+ * Only the metadata of the stores is used, the data is considered different
+ * when it is not stored at the same location in the volume
+ * Returns 1 if successful, 0 if no such extent or -1 on error
+ */
+int libvshadow_volume_get_next_changed_extent(
+     libvshadow_volume_t *volume,
+     int store_index,
+     int other_store_index,
+     off64_t offset,
+     off64_t *extent_offset,
+     size64_t *extent_size,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_volume_t *internal_volume         = NULL;
+	libvshadow_store_descriptor_t *other_store_descriptor = NULL;
+	libvshadow_store_descriptor_t *store_descriptor       = NULL;
+	static char *function                                 = "libvshadow_volume_get_next_changed_extent";
+	int result                                            = 0;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libvshadow_internal_volume_t *) volume;
+
+	if( other_store_index < -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid other store index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_volume->file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_array_get_entry_by_index(
+	     internal_volume->store_descriptors_array,
+	     store_index,
+	     (intptr_t **) &store_descriptor,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve store descriptor: %d.",
+		 function,
+		 store_index );
+
+		goto on_error;
+	}
+	if( other_store_index != -1 )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     internal_volume->store_descriptors_array,
+		     other_store_index,
+		     (intptr_t **) &other_store_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve store descriptor: %d.",
+			 function,
+			 other_store_index );
+
+			goto on_error;
+		}
+	}
+	result = libvshadow_store_descriptor_get_next_changed_extent(
+	          store_descriptor,
+	          other_store_descriptor,
+	          internal_volume->file_io_handle,
+	          offset,
+	          extent_offset,
+	          extent_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve next changed extent at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libvshadow_internal_volume_mark_store_read(
+	     internal_volume,
+	     store_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to mark store: %d as read.",
+		 function,
+		 store_index );
+
+		return( -1 );
+	}
+	if( other_store_index != -1 )
+	{
+		if( libvshadow_internal_volume_mark_store_read(
+		     internal_volume,
+		     other_store_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to mark store: %d as read.",
+			 function,
+			 other_store_index );
+
+			return( -1 );
+		}
+	}
+	return( result );
+
+on_error:
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_read(
+	 internal_volume->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Reads the data at a specific offset from all the stores
+ * The number of buffers must match the number of stores, where buffer contains the data of the store
+ * with the same index. The stores are resolved from the newest to the oldest store and the data of stores
+ * that resolves to the same locations in the volume is read only once. The identical store indexes are
+ * set to the index of the newer store with the same data, to the index of the store itself if its data
+ * differs from all newer stores, or to -1 if the store has no in-volume data, in which case its buffer
+ * is not changed. The data beyond the volume size is not read
+ * Returns the number of bytes read per buffer or -1 on error
+ */
+ssize_t libvshadow_volume_read_buffers_across_stores(
+         libvshadow_volume_t *volume,
+         void **buffers,
+         int number_of_buffers,
+         size_t buffer_size,
+         off64_t offset,
+         int *identical_store_indexes,
+         libcerror_error_t **error )
+{
+	libvshadow_extent_map_t *extent_map             = NULL;
+	libvshadow_internal_volume_t *internal_volume   = NULL;
+	libvshadow_read_list_t *read_list               = NULL;
+	libvshadow_read_segment_t *other_segment        = NULL;
+	libvshadow_read_segment_t *segment              = NULL;
+	libvshadow_store_descriptor_t *store_descriptor = NULL;
+	int *store_segment_ranges                       = NULL;
+	static char *function                           = "libvshadow_volume_read_buffers_across_stores";
+	size_t read_size                                = 0;
+	int first_segment_index                         = 0;
+	int number_of_segments                          = 0;
+	int number_of_stores                            = 0;
+	int other_store_index                           = 0;
+	int segment_index                               = 0;
+	int store_index                                 = 0;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libvshadow_internal_volume_t *) volume;
+
+	if( buffers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffers.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_buffers <= 0 )
+	 || ( (size_t) number_of_buffers > ( (size_t) SSIZE_MAX / ( 2 * sizeof( int ) ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of buffers value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( identical_store_indexes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid identical store indexes.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_volume->file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_array_get_number_of_entries(
+	     internal_volume->store_descriptors_array,
+	     &number_of_stores,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of stores.",
+		 function );
+
+		goto on_error;
+	}
+	if( number_of_buffers != number_of_stores )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of buffers value does not match number of stores.",
+		 function );
+
+		goto on_error;
+	}
+	if( (size64_t) offset < internal_volume->size )
+	{
+		read_size = buffer_size;
+
+		if( (size64_t) read_size > ( internal_volume->size - offset ) )
+		{
+			read_size = (size_t) ( internal_volume->size - offset );
+		}
+	}
+	/* The store segment ranges contain the first segment index and number of segments of each store
+	 */
+	store_segment_ranges = (int *) memory_allocate(
+	                                sizeof( int ) * 2 * number_of_stores );
+
+	if( store_segment_ranges == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create store segment ranges.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvshadow_read_list_initialize(
+	     &read_list,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create read list.",
+		 function );
+
+		goto on_error;
+	}
+	for( store_index = number_of_stores - 1;
+	     store_index >= 0;
+	     store_index-- )
+	{
+		identical_store_indexes[ store_index ] = -1;
+
+		if( libcdata_array_get_entry_by_index(
+		     internal_volume->store_descriptors_array,
+		     store_index,
+		     (intptr_t **) &store_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve store descriptor: %d.",
+			 function,
+			 store_index );
+
+			goto on_error;
+		}
+		if( store_descriptor->has_in_volume_store_data == 0 )
+		{
+			continue;
+		}
+		if( buffers[ store_index ] == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid buffer: %d.",
+			 function,
+			 store_index );
+
+			goto on_error;
+		}
+		/* The extent map contains the store data resolved over the following stores
+		 * and is only read once per store
+		 */
+		if( libvshadow_store_descriptor_get_extent_map(
+		     store_descriptor,
+		     internal_volume->file_io_handle,
+		     &extent_map,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve extent map of store descriptor: %d.",
+			 function,
+			 store_index );
+
+			goto on_error;
+		}
+		first_segment_index = read_list->number_of_segments;
+
+		if( libvshadow_read_list_append_range(
+		     read_list,
+		     first_segment_index,
+		     extent_map,
+		     (uint8_t *) buffers[ store_index ],
+		     read_size,
+		     offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append range of store descriptor: %d to read list.",
+			 function,
+			 store_index );
+
+			goto on_error;
+		}
+		number_of_segments = read_list->number_of_segments - first_segment_index;
+
+		store_segment_ranges[ 2 * store_index ]         = first_segment_index;
+		store_segment_ranges[ ( 2 * store_index ) + 1 ] = number_of_segments;
+
+		identical_store_indexes[ store_index ] = store_index;
+
+		/* The data of 2 stores is identical if their segments refer to the same data in the volume
+		 * at the same buffer offsets, since the remaining data is sparse in both stores
+		 */
+		for( other_store_index = store_index + 1;
+		     other_store_index < number_of_stores;
+		     other_store_index++ )
+		{
+			if( identical_store_indexes[ other_store_index ] != other_store_index )
+			{
+				continue;
+			}
+			if( store_segment_ranges[ ( 2 * other_store_index ) + 1 ] != number_of_segments )
+			{
+				continue;
+			}
+			for( segment_index = 0;
+			     segment_index < number_of_segments;
+			     segment_index++ )
+			{
+				segment       = &( read_list->segments[ first_segment_index + segment_index ] );
+				other_segment = &( read_list->segments[ store_segment_ranges[ 2 * other_store_index ] + segment_index ] );
+
+				if( ( segment->data_offset != other_segment->data_offset )
+				 || ( segment->size != other_segment->size )
+				 || ( ( segment->buffer - (uint8_t *) buffers[ store_index ] ) != ( other_segment->buffer - (uint8_t *) buffers[ other_store_index ] ) ) )
+				{
+					break;
+				}
+			}
+			if( segment_index >= number_of_segments )
+			{
+				identical_store_indexes[ store_index ] = other_store_index;
+
+				/* The segments of the store were appended last hence they can be removed
+				 */
+				read_list->number_of_segments = first_segment_index;
+
+				break;
+			}
+		}
+	}
+	if( libvshadow_read_list_read(
+	     read_list,
+	     internal_volume->file_io_handle,
+	     internal_volume->block_cache,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read data of read list.",
+		 function );
+
+		goto on_error;
+	}
+	for( store_index = 0;
+	     store_index < number_of_stores;
+	     store_index++ )
+	{
+		other_store_index = identical_store_indexes[ store_index ];
+
+		if( ( other_store_index == -1 )
+		 || ( other_store_index == store_index ) )
+		{
+			continue;
+		}
+		if( memory_copy(
+		     buffers[ store_index ],
+		     buffers[ other_store_index ],
+		     read_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy data of store: %d.",
+			 function,
+			 other_store_index );
+
+			goto on_error;
+		}
+	}
+	if( libvshadow_read_list_free(
+	     &read_list,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free read list.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 store_segment_ranges );
+
+	store_segment_ranges = NULL;
+
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	for( store_index = 0;
+	     store_index < number_of_stores;
+	     store_index++ )
+	{
+		if( identical_store_indexes[ store_index ] == -1 )
+		{
+			continue;
+		}
+		if( libvshadow_internal_volume_mark_store_read(
+		     internal_volume,
+		     store_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to mark store: %d as read.",
+			 function,
+			 store_index );
+
+			return( -1 );
+		}
+	}
+	return( (ssize_t) read_size );
+
+on_error:
+	if( read_list != NULL )
+	{
+		libvshadow_read_list_free(
+		 &read_list,
+		 NULL );
+	}
+	if( store_segment_ranges != NULL )
+	{
+		memory_free(
+		 store_segment_ranges );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_read(
+	 internal_volume->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Sets the maximum size of the block cache
+ * The block cache is disabled if the size is 0
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_volume_set_maximum_cache_size(
+     libvshadow_volume_t *volume,
+     size64_t maximum_cache_size,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_volume_t *internal_volume = NULL;
+	static char *function                         = "libvshadow_volume_set_maximum_cache_size";
+	int result                                    = 1;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libvshadow_internal_volume_t *) volume;
+
+	if( ( maximum_cache_size != 0 )
+	 && ( maximum_cache_size < (size64_t) internal_volume->io_handle->block_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid maximum cache size value too small.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	/* The block cache is used by the stores without holding the volume lock
+	 * hence it cannot be changed while the volume is open
+	 */
+	if( internal_volume->file_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid volume - file IO handle already set.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+		internal_volume->maximum_cache_size = maximum_cache_size;
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the number of block cache hits and misses
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_volume_get_cache_statistics(
+     libvshadow_volume_t *volume,
+     uint64_t *number_of_cache_hits,
+     uint64_t *number_of_cache_misses,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_volume_t *internal_volume = NULL;
+	static char *function                         = "libvshadow_volume_get_cache_statistics";
+	int result                                    = 1;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libvshadow_internal_volume_t *) volume;
+
+	if( number_of_cache_hits == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of cache hits.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_cache_misses == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of cache misses.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_volume->block_cache == NULL )
+	{
+		*number_of_cache_hits   = 0;
+		*number_of_cache_misses = 0;
+	}
+	else if( libvshadow_block_cache_get_statistics(
+	          internal_volume->block_cache,
+	          number_of_cache_hits,
+	          number_of_cache_misses,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve block cache statistics.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Sets the maximum size of the store metadata
+ * The metadata of the least recently read stores is released when the size of the releasable metadata
+ * of all the stores exceeds the maximum, it is read again when these stores are read
+ * The store metadata is not released if the size is 0
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_volume_set_maximum_metadata_size(
+     libvshadow_volume_t *volume,
+     size64_t maximum_metadata_size,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_volume_t *internal_volume = NULL;
+	static char *function                         = "libvshadow_volume_set_maximum_metadata_size";
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libvshadow_internal_volume_t *) volume;
+
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	internal_volume->maximum_metadata_size = maximum_metadata_size;
+
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the size of the metadata of all the stores
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_volume_get_metadata_size(
+     libvshadow_volume_t *volume,
+     size64_t *metadata_size,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_volume_t *internal_volume = NULL;
+	static char *function                         = "libvshadow_volume_get_metadata_size";
+	size64_t releasable_metadata_size             = 0;
+	int result                                    = 1;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libvshadow_internal_volume_t *) volume;
+
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libvshadow_internal_volume_get_metadata_size(
+	     internal_volume,
+	     metadata_size,
+	     &releasable_metadata_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve metadata size.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the size of the metadata of all the stores
+ * The releasable metadata size only contains the metadata that can be released
+ * The last releasable metadata size of the store descriptors is updated accordingly
+ * This function must be called while holding the read/write lock of the volume
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_internal_volume_get_metadata_size(
+     libvshadow_internal_volume_t *internal_volume,
+     size64_t *metadata_size,
+     size64_t *releasable_metadata_size,
+     libcerror_error_t **error )
+{
+	libvshadow_store_descriptor_t *store_descriptor = NULL;
+	static char *function                           = "libvshadow_internal_volume_get_metadata_size";
+	size64_t safe_metadata_size                     = 0;
+	size64_t safe_releasable_metadata_size          = 0;
+	size64_t store_metadata_size                    = 0;
+	size64_t store_releasable_metadata_size         = 0;
+	int number_of_stores                            = 0;
+	int store_index                                 = 0;
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( metadata_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata size.",
+		 function );
+
+		return( -1 );
+	}
+	if( releasable_metadata_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid releasable metadata size.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     internal_volume->store_descriptors_array,
+	     &number_of_stores,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of stores.",
+		 function );
+
+		return( -1 );
+	}
+	for( store_index = 0;
+	     store_index < number_of_stores;
+	     store_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     internal_volume->store_descriptors_array,
+		     store_index,
+		     (intptr_t **) &store_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve store descriptor: %d.",
+			 function,
+			 store_index );
+
+			return( -1 );
+		}
+		if( libvshadow_store_descriptor_get_metadata_size(
+		     store_descriptor,
+		     &store_metadata_size,
+		     &store_releasable_metadata_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve metadata size of store descriptor: %d.",
+			 function,
+			 store_index );
+
+			return( -1 );
+		}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_grab(
+		     internal_volume->read_sequence_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab read sequence mutex.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+		store_descriptor->last_releasable_metadata_size = store_releasable_metadata_size;
+
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_release(
+		     internal_volume->read_sequence_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release read sequence mutex.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+		safe_metadata_size            += store_metadata_size;
+		safe_releasable_metadata_size += store_releasable_metadata_size;
+	}
+	*metadata_size            = safe_metadata_size;
+	*releasable_metadata_size = safe_releasable_metadata_size;
+
+	return( 1 );
+}
+
+/* Marks a store as read and releases the metadata of the least recently read stores
+ * if the size of the releasable metadata of all the stores exceeds the maximum
+ * The metadata of the store that was read is not released
+ * This function must be called without holding the read/write lock of the volume
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_internal_volume_mark_store_read(
+     libvshadow_internal_volume_t *internal_volume,
+     int store_descriptor_index,
+     libcerror_error_t **error )
+{
+	libvshadow_store_descriptor_t *store_descriptor = NULL;
+	static char *function                           = "libvshadow_internal_volume_mark_store_read";
+	size64_t maximum_metadata_size                  = 0;
+	size64_t metadata_size                          = 0;
+	size64_t releasable_metadata_size               = 0;
+	uint8_t metadata_size_increased                 = 0;
+	int result                                      = 1;
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	maximum_metadata_size = internal_volume->maximum_metadata_size;
+
+	if( maximum_metadata_size != 0 )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     internal_volume->store_descriptors_array,
+		     store_descriptor_index,
+		     (intptr_t **) &store_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve store descriptor: %d.",
+			 function,
+			 store_descriptor_index );
+
+			result = -1;
+		}
+		else if( libvshadow_store_descriptor_get_metadata_size(
+		          store_descriptor,
+		          &metadata_size,
+		          &releasable_metadata_size,
+		          error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve metadata size of store descriptor: %d.",
+			 function,
+			 store_descriptor_index );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( ( result != 1 )
+	 || ( maximum_metadata_size == 0 ) )
+	{
+		return( result );
+	}
+	/* The read sequence mutex allows to mark a store as read without the write lock of the volume
+	 */
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     internal_volume->read_sequence_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read sequence mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	internal_volume->read_sequence_number += 1;
+
+	store_descriptor->last_read_sequence_number = internal_volume->read_sequence_number;
+
+	/* The releasable metadata of the stores only grows when the metadata of a store is read
+	 */
+	if( releasable_metadata_size > store_descriptor->last_releasable_metadata_size )
+	{
+		metadata_size_increased = 1;
+	}
+	else
+	{
+		store_descriptor->last_releasable_metadata_size = releasable_metadata_size;
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     internal_volume->read_sequence_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read sequence mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( metadata_size_increased != 0 )
+	{
+		if( libvshadow_internal_volume_release_metadata(
+		     internal_volume,
+		     store_descriptor_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to release metadata of stores.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Releases the metadata of the least recently read stores if the size of the releasable metadata
+ * of all the stores exceeds the maximum
+ * The metadata of the store with the store descriptor index is not released, where -1 represents none
+ * This function must be called without holding the read/write lock of the volume
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_internal_volume_release_metadata(
+     libvshadow_internal_volume_t *internal_volume,
+     int store_descriptor_index,
+     libcerror_error_t **error )
+{
+	libvshadow_store_descriptor_t *release_store_descriptor = NULL;
+	libvshadow_store_descriptor_t *store_descriptor         = NULL;
+	static char *function                                   = "libvshadow_internal_volume_release_metadata";
+	size64_t maximum_metadata_size                          = 0;
+	size64_t total_metadata_size                            = 0;
+	size64_t total_releasable_metadata_size                 = 0;
+	int number_of_stores                                    = 0;
+	int result                                              = 1;
+	int store_index                                         = 0;
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	maximum_metadata_size = internal_volume->maximum_metadata_size;
+
+	if( maximum_metadata_size != 0 )
+	{
+		if( libvshadow_internal_volume_get_metadata_size(
+		     internal_volume,
+		     &total_metadata_size,
+		     &total_releasable_metadata_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve metadata size.",
+			 function );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( ( result != 1 )
+	 || ( total_releasable_metadata_size <= maximum_metadata_size ) )
+	{
+		return( result );
+	}
+	/* The write lock of the volume ensures that no store metadata is used
+	 * while the metadata of the stores is released
+	 */
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	/* Another thread can have released the metadata or changed the maximum
+	 * before the write lock was obtained
+	 */
+	maximum_metadata_size = internal_volume->maximum_metadata_size;
+
+	if( libvshadow_internal_volume_get_metadata_size(
+	     internal_volume,
+	     &total_metadata_size,
+	     &total_releasable_metadata_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve metadata size.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_array_get_number_of_entries(
+	     internal_volume->store_descriptors_array,
+	     &number_of_stores,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of stores.",
+		 function );
+
+		goto on_error;
+	}
+	while( ( maximum_metadata_size != 0 )
+	    && ( total_releasable_metadata_size > maximum_metadata_size ) )
+	{
+		release_store_descriptor = NULL;
+
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_grab(
+		     internal_volume->read_sequence_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab read sequence mutex.",
+			 function );
+
+			goto on_error;
+		}
+#endif
+		for( store_index = 0;
+		     store_index < number_of_stores;
+		     store_index++ )
+		{
+			if( store_index == store_descriptor_index )
+			{
+				continue;
+			}
+			if( libcdata_array_get_entry_by_index(
+			     internal_volume->store_descriptors_array,
+			     store_index,
+			     (intptr_t **) &store_descriptor,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve store descriptor: %d.",
+				 function,
+				 store_index );
+
+				result = -1;
+
+				break;
+			}
+			/* The block descriptors read value is not changed while holding the write lock of the volume
+			 */
+			if( store_descriptor->block_descriptors_read == 0 )
+			{
+				continue;
+			}
+			if( ( release_store_descriptor == NULL )
+			 || ( store_descriptor->last_read_sequence_number < release_store_descriptor->last_read_sequence_number ) )
+			{
+				release_store_descriptor = store_descriptor;
+			}
+		}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_release(
+		     internal_volume->read_sequence_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release read sequence mutex.",
+			 function );
+
+			goto on_error;
+		}
+#endif
+		if( result != 1 )
+		{
+			goto on_error;
+		}
+		if( release_store_descriptor == NULL )
+		{
+			break;
+		}
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: releasing metadata of store descriptor: %d.\n",
+			 function,
+			 release_store_descriptor->index );
+		}
+#endif
+		if( libvshadow_store_descriptor_release_metadata(
+		     release_store_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to release metadata of store descriptor: %d.",
+			 function,
+			 release_store_descriptor->index );
+
+			goto on_error;
+		}
+		if( libvshadow_internal_volume_get_metadata_size(
+		     internal_volume,
+		     &total_metadata_size,
+		     &total_releasable_metadata_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve metadata size.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_volume->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Reads the block descriptors of all the stores in advance
+ * Returns 1 if successful, 0 if stopped or -1 on error
+ */
+int libvshadow_volume_preload_stores(
+     libvshadow_volume_t *volume,
+     int number_of_threads,
+     int (*progress_callback)(
+            int number_of_stores_read,
+            int number_of_stores,
+            void *callback_data ),
+     void *callback_data,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_volume_t *internal_volume = NULL;
+	libvshadow_store_preloader_t *store_preloader = NULL;
+	static char *function                         = "libvshadow_volume_preload_stores";
+	int number_of_stores                          = 0;
+	int result                                    = -1;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libvshadow_internal_volume_t *) volume;
+
+	if( number_of_threads <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid number of threads value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_volume->file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_array_get_number_of_entries(
+	     internal_volume->store_descriptors_array,
+	     &number_of_stores,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of store descriptors.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvshadow_store_preloader_initialize(
+	     &store_preloader,
+	     internal_volume->io_handle,
+	     internal_volume->file_io_handle,
+	     number_of_stores,
+	     progress_callback,
+	     callback_data,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create store preloader.",
+		 function );
+
+		goto on_error;
+	}
+	result = libvshadow_store_preloader_read_stores(
+	          store_preloader,
+	          internal_volume->store_descriptors_array,
+	          number_of_threads,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read stores.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvshadow_store_preloader_free(
+	     &store_preloader,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free store preloader.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libvshadow_internal_volume_release_metadata(
+	     internal_volume,
+	     -1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to release metadata of stores.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+
+on_error:
+	if( store_preloader != NULL )
+	{
+		libvshadow_store_preloader_free(
+		 &store_preloader,
+		 NULL );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_read(
+	 internal_volume->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Reads the index cache
+ * Returns 1 if successful, 0 if the index cache does not match or -1 on error
+ */
+int libvshadow_volume_read_index_cache(
+     libvshadow_volume_t *volume,
+     const char *filename,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	static char *function            = "libvshadow_volume_read_index_cache";
+	int result                       = 0;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_file_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_file_set_name(
+	     file_io_handle,
+	     filename,
+	     narrow_string_length(
+	      filename ) + 1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set filename in file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	result = libvshadow_volume_read_index_cache_file_io_handle(
+	          volume,
+	          file_io_handle,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read index cache: %s.",
+		 function,
+		 filename );
+
+		goto on_error;
+	}
+	if( libbfio_handle_free(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+/* Reads the index cache
+ * Returns 1 if successful, 0 if the index cache does not match or -1 on error
+ */
+int libvshadow_volume_read_index_cache_wide(
+     libvshadow_volume_t *volume,
+     const wchar_t *filename,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	static char *function            = "libvshadow_volume_read_index_cache_wide";
+	int result                       = 0;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_file_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_file_set_name_wide(
+	     file_io_handle,
+	     filename,
+	     wide_string_length(
+	      filename ) + 1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set filename in file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	result = libvshadow_volume_read_index_cache_file_io_handle(
+	          volume,
+	          file_io_handle,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read index cache: %ls.",
+		 function,
+		 filename );
+
+		goto on_error;
+	}
+	if( libbfio_handle_free(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+/* Reads the index cache using a Basic File IO (bfio) handle
+ * Returns 1 if successful, 0 if the index cache does not match or -1 on error
+ */
+int libvshadow_volume_read_index_cache_file_io_handle(
+     libvshadow_volume_t *volume,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_volume_t *internal_volume = NULL;
+	static char *function                         = "libvshadow_volume_read_index_cache_file_io_handle";
+	uint8_t file_io_handle_opened_in_library      = 0;
+	int file_io_handle_is_open                    = 0;
+	int result                                    = 0;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libvshadow_internal_volume_t *) volume;
+
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_volume->file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	file_io_handle_is_open = libbfio_handle_is_open(
+	                          file_io_handle,
+	                          error );
+
+	if( file_io_handle_is_open == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to determine if file IO handle is open.",
+		 function );
+
+		goto on_error;
+	}
+	else if( file_io_handle_is_open == 0 )
+	{
+		if( libbfio_handle_open(
+		     file_io_handle,
+		     LIBBFIO_OPEN_READ,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open file IO handle.",
+			 function );
+
+			goto on_error;
+		}
+		file_io_handle_opened_in_library = 1;
+	}
+	result = libvshadow_index_cache_read_file_io_handle(
+	          file_io_handle,
+	          internal_volume->size,
+	          internal_volume->catalog_offset,
+	          internal_volume->store_descriptors_array,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read index cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( file_io_handle_opened_in_library != 0 )
+	{
+		file_io_handle_opened_in_library = 0;
+
+		if( libbfio_handle_close(
+		     file_io_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close file IO handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+
+on_error:
+	if( file_io_handle_opened_in_library != 0 )
+	{
+		libbfio_handle_close(
+		 file_io_handle,
+		 NULL );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_read(
+	 internal_volume->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Writes the index cache
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_volume_write_index_cache(
+     libvshadow_volume_t *volume,
+     const char *filename,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	static char *function            = "libvshadow_volume_write_index_cache";
+	int result                       = 0;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_file_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_file_set_name(
+	     file_io_handle,
+	     filename,
+	     narrow_string_length(
+	      filename ) + 1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set filename in file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	result = libvshadow_volume_write_index_cache_file_io_handle(
+	          volume,
+	          file_io_handle,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write index cache: %s.",
+		 function,
+		 filename );
+
+		goto on_error;
+	}
+	if( libbfio_handle_free(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+/* Writes the index cache
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_volume_write_index_cache_wide(
+     libvshadow_volume_t *volume,
+     const wchar_t *filename,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	static char *function            = "libvshadow_volume_write_index_cache_wide";
+	int result                       = 0;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_file_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_file_set_name_wide(
+	     file_io_handle,
+	     filename,
+	     wide_string_length(
+	      filename ) + 1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set filename in file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	result = libvshadow_volume_write_index_cache_file_io_handle(
+	          volume,
+	          file_io_handle,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write index cache: %ls.",
+		 function,
+		 filename );
+
+		goto on_error;
+	}
+	if( libbfio_handle_free(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+/* Writes the index cache using a Basic File IO (bfio) handle
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_volume_write_index_cache_file_io_handle(
+     libvshadow_volume_t *volume,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_volume_t *internal_volume   = NULL;
+	libvshadow_store_descriptor_t *store_descriptor = NULL;
+	static char *function                           = "libvshadow_volume_write_index_cache_file_io_handle";
+	uint8_t file_io_handle_opened_in_library        = 0;
+	int file_io_handle_is_open                      = 0;
+	int number_of_store_descriptors                 = 0;
+	int result                                      = 1;
+	int store_descriptor_index                      = 0;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libvshadow_internal_volume_t *) volume;
+
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_volume->file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_array_get_number_of_entries(
+	     internal_volume->store_descriptors_array,
+	     &number_of_store_descriptors,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of store descriptors.",
+		 function );
+
+		goto on_error;
+	}
+	for( store_descriptor_index = 0;
+	     store_descriptor_index < number_of_store_descriptors;
+	     store_descriptor_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     internal_volume->store_descriptors_array,
+		     store_descriptor_index,
+		     (intptr_t **) &store_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve store descriptor: %d.",
+			 function,
+			 store_descriptor_index );
+
+			goto on_error;
+		}
+		if( libvshadow_store_descriptor_read_block_descriptors(
+		     store_descriptor,
+		     internal_volume->file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read block descriptors of store: %d.",
+			 function,
+			 store_descriptor_index );
+
+			goto on_error;
+		}
+	}
+	file_io_handle_is_open = libbfio_handle_is_open(
+	                          file_io_handle,
+	                          error );
+
+	if( file_io_handle_is_open == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to determine if file IO handle is open.",
+		 function );
+
+		goto on_error;
+	}
+	else if( file_io_handle_is_open == 0 )
+	{
+		if( libbfio_handle_open(
+		     file_io_handle,
+		     LIBBFIO_OPEN_WRITE_TRUNCATE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open file IO handle.",
+			 function );
+
+			goto on_error;
+		}
+		file_io_handle_opened_in_library = 1;
+	}
+	if( libvshadow_index_cache_write_file_io_handle(
+	     file_io_handle,
+	     internal_volume->size,
+	     internal_volume->catalog_offset,
+	     internal_volume->store_descriptors_array,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write index cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( file_io_handle_opened_in_library != 0 )
+	{
+		file_io_handle_opened_in_library = 0;
+
+		if( libbfio_handle_close(
+		     file_io_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close file IO handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+
+on_error:
+	if( file_io_handle_opened_in_library != 0 )
+	{
+		libbfio_handle_close(
+		 file_io_handle,
+		 NULL );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_read(
+	 internal_volume->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
@@ -26,6 +26,7 @@
 #include <types.h>
 
 #include "libvshadow_extern.h"
+#include "libvshadow_block_cache.h"
 #include "libvshadow_io_handle.h"
 #include "libvshadow_libbfio.h"
 #include "libvshadow_libcdata.h"
@@ -45,6 +46,10 @@ struct libvshadow_internal_volume
 	 */
 	size64_t size;
 
+	/* The catalog offset
+	 */
+	off64_t catalog_offset;
+
 	/* The store descriptors array
 	 */
 	libcdata_array_t *store_descriptors_array;
@@ -65,10 +70,32 @@ struct libvshadow_internal_volume
 	 */
 	uint8_t file_io_handle_opened_in_library;
 
+	/* The maximum (block) cache size
+	 */
+	size64_t maximum_cache_size;
+
+	/* The block cache
+	 */
+	libvshadow_block_cache_t *block_cache;
+
+	/* The maximum (store) metadata size
+	 */
+	size64_t maximum_metadata_size;
+
+	/* The read sequence number
+	 * Used to determine the least recently read stores
+	 */
+	uint64_t read_sequence_number;
+
 #if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
 	/* The read/write lock
 	 */
 	libcthreads_read_write_lock_t *read_write_lock;
+
+	/* The read sequence mutex
+	 * Protects the read sequence number and the last read values of the store descriptors
+	 */
+	libcthreads_mutex_t *read_sequence_mutex;
 #endif
 };
 
@@ -149,6 +176,122 @@ int libvshadow_volume_get_store_identifier(
      size_t size,
      libcerror_error_t **error );
 
+LIBVSHADOW_EXTERN \
+int libvshadow_volume_get_next_changed_extent(
+     libvshadow_volume_t *volume,
+     int store_index,
+     int other_store_index,
+     off64_t offset,
+     off64_t *extent_offset,
+     size64_t *extent_size,
+     libcerror_error_t **error );
+
+LIBVSHADOW_EXTERN \
+ssize_t libvshadow_volume_read_buffers_across_stores(
+         libvshadow_volume_t *volume,
+         void **buffers,
+         int number_of_buffers,
+         size_t buffer_size,
+         off64_t offset,
+         int *identical_store_indexes,
+         libcerror_error_t **error );
+
+LIBVSHADOW_EXTERN \
+int libvshadow_volume_set_maximum_cache_size(
+     libvshadow_volume_t *volume,
+     size64_t maximum_cache_size,
+     libcerror_error_t **error );
+
+LIBVSHADOW_EXTERN \
+int libvshadow_volume_get_cache_statistics(
+     libvshadow_volume_t *volume,
+     uint64_t *number_of_cache_hits,
+     uint64_t *number_of_cache_misses,
+     libcerror_error_t **error );
+
+LIBVSHADOW_EXTERN \
+int libvshadow_volume_set_maximum_metadata_size(
+     libvshadow_volume_t *volume,
+     size64_t maximum_metadata_size,
+     libcerror_error_t **error );
+
+LIBVSHADOW_EXTERN \
+int libvshadow_volume_get_metadata_size(
+     libvshadow_volume_t *volume,
+     size64_t *metadata_size,
+     libcerror_error_t **error );
+
+int libvshadow_internal_volume_get_metadata_size(
+     libvshadow_internal_volume_t *internal_volume,
+     size64_t *metadata_size,
+     size64_t *releasable_metadata_size,
+     libcerror_error_t **error );
+
+int libvshadow_internal_volume_mark_store_read(
+     libvshadow_internal_volume_t *internal_volume,
+     int store_descriptor_index,
+     libcerror_error_t **error );
+
+int libvshadow_internal_volume_release_metadata(
+     libvshadow_internal_volume_t *internal_volume,
+     int store_descriptor_index,
+     libcerror_error_t **error );
+
+LIBVSHADOW_EXTERN \
+int libvshadow_volume_preload_stores(
+     libvshadow_volume_t *volume,
+     int number_of_threads,
+     int (*progress_callback)(
+            int number_of_stores_read,
+            int number_of_stores,
+            void *callback_data ),
+     void *callback_data,
+     libcerror_error_t **error );
+
+LIBVSHADOW_EXTERN \
+int libvshadow_volume_read_index_cache(
+     libvshadow_volume_t *volume,
+     const char *filename,
+     libcerror_error_t **error );
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+LIBVSHADOW_EXTERN \
+int libvshadow_volume_read_index_cache_wide(
+     libvshadow_volume_t *volume,
+     const wchar_t *filename,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+LIBVSHADOW_EXTERN \
+int libvshadow_volume_read_index_cache_file_io_handle(
+     libvshadow_volume_t *volume,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+LIBVSHADOW_EXTERN \
+int libvshadow_volume_write_index_cache(
+     libvshadow_volume_t *volume,
+     const char *filename,
+     libcerror_error_t **error );
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+LIBVSHADOW_EXTERN \
+int libvshadow_volume_write_index_cache_wide(
+     libvshadow_volume_t *volume,
+     const wchar_t *filename,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+LIBVSHADOW_EXTERN \
+int libvshadow_volume_write_index_cache_file_io_handle(
+     libvshadow_volume_t *volume,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
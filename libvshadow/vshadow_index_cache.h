@@ -0,0 +1,196 @@
+/*
+ * The index cache file definition
+ *
+ * Copyright (C) 2011-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _VSHADOW_INDEX_CACHE_H )
+#define _VSHADOW_INDEX_CACHE_H
+
+#include <common.h>
+#include <types.h>
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The index cache file is not part of the VSS format, it contains the block
+ * descriptors and bitmaps of the stores as read by the library. All values are
+ * stored in little-endian and all sections are 8-byte aligned.
+ */
+
+typedef struct vshadow_index_cache_file_header vshadow_index_cache_file_header_t;
+
+struct vshadow_index_cache_file_header
+{
+	/* The signature
+	 * Consists of 8 bytes
+	 * Contains: "vshidxc\x00"
+	 */
+	uint8_t signature[ 8 ];
+
+	/* The format version
+	 * Consists of 4 bytes
+	 */
+	uint8_t format_version[ 4 ];
+
+	/* The number of stores
+	 * Consists of 4 bytes
+	 */
+	uint8_t number_of_stores[ 4 ];
+
+	/* The volume size
+	 * Consists of 8 bytes
+	 */
+	uint8_t volume_size[ 8 ];
+
+	/* The catalog offset
+	 * Consists of 8 bytes
+	 */
+	uint8_t catalog_offset[ 8 ];
+
+	/* The file size
+	 * Consists of 8 bytes
+	 */
+	uint8_t file_size[ 8 ];
+};
+
+typedef struct vshadow_index_cache_store_header vshadow_index_cache_store_header_t;
+
+struct vshadow_index_cache_store_header
+{
+	/* The (store) identifier
+	 * Consists of 16 bytes
+	 * Contains a GUID
+	 */
+	uint8_t identifier[ 16 ];
+
+	/* The creation date and time
+	 * Consists of 8 bytes
+	 * Contains a FILETIME
+	 */
+	uint8_t creation_time[ 8 ];
+
+	/* The store block list offset
+	 * Consists of 8 bytes
+	 */
+	uint8_t store_block_list_offset[ 8 ];
+
+	/* The store block range list offset
+	 * Consists of 8 bytes
+	 */
+	uint8_t store_block_range_list_offset[ 8 ];
+
+	/* The store bitmap offset
+	 * Consists of 8 bytes
+	 */
+	uint8_t store_bitmap_offset[ 8 ];
+
+	/* The store previous bitmap offset
+	 * Consists of 8 bytes
+	 */
+	uint8_t store_previous_bitmap_offset[ 8 ];
+
+	/* The number of forward block descriptors
+	 * Consists of 4 bytes
+	 */
+	uint8_t number_of_forward_block_descriptors[ 4 ];
+
+	/* The number of overlay block descriptors
+	 * Consists of 4 bytes
+	 */
+	uint8_t number_of_overlay_block_descriptors[ 4 ];
+
+	/* The number of reverse block descriptors
+	 * Consists of 4 bytes
+	 */
+	uint8_t number_of_reverse_block_descriptors[ 4 ];
+
+	/* The bitmap size
+	 * Consists of 4 bytes
+	 */
+	uint8_t bitmap_size[ 4 ];
+
+	/* The previous bitmap size
+	 * Consists of 4 bytes
+	 */
+	uint8_t previous_bitmap_size[ 4 ];
+
+	/* The number of block descriptors
+	 * Consists of 4 bytes
+	 * Contains the number of block descriptors in the order of the store block list
+	 */
+	uint8_t number_of_block_descriptors[ 4 ];
+};
+
+typedef struct vshadow_index_cache_block_descriptor vshadow_index_cache_block_descriptor_t;
+
+struct vshadow_index_cache_block_descriptor
+{
+	/* The original (volume) offset
+	 * Consists of 8 bytes
+	 */
+	uint8_t original_offset[ 8 ];
+
+	/* The (block) offset
+	 * Consists of 8 bytes
+	 */
+	uint8_t offset[ 8 ];
+
+	/* The relative (block) offset
+	 * Consists of 8 bytes
+	 */
+	uint8_t relative_offset[ 8 ];
+
+	/* The (block) flags
+	 * Consists of 4 bytes
+	 */
+	uint8_t flags[ 4 ];
+
+	/* The (allocation) bitmap
+	 * Consists of 4 bytes
+	 */
+	uint8_t bitmap[ 4 ];
+};
+
+typedef struct vshadow_index_cache_overlay_block_descriptor vshadow_index_cache_overlay_block_descriptor_t;
+
+struct vshadow_index_cache_overlay_block_descriptor
+{
+	/* The index of the forward block descriptor
+	 * Consists of 4 bytes
+	 */
+	uint8_t block_index[ 4 ];
+
+	/* Padding
+	 * Consists of 4 bytes
+	 */
+	uint8_t padding[ 4 ];
+
+	/* The block descriptor
+	 * Consists of 32 bytes
+	 */
+	vshadow_index_cache_block_descriptor_t block_descriptor;
+};
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _VSHADOW_INDEX_CACHE_H ) */
+
@@ -19,17 +19,29 @@ AC_DEFUN([AX_LIBFUSE_CHECK_LIB],
   AS_IF(
     [test "x$ac_cv_with_libfuse" = xno],
     [ac_cv_libfuse=no],
-    [dnl Check for a pkg-config file
+    [dnl Check for a pkg-config file, where fuse 3 is preferred over fuse 2
     AS_IF(
       [test "x$cross_compiling" != "xyes" && test "x$PKGCONFIG" != "x"],
       [PKG_CHECK_MODULES(
-        [fuse],
-        [fuse >= 2.6],
-        [ac_cv_libfuse=libfuse],
+        [fuse3],
+        [fuse3 >= 3.0],
+        [ac_cv_libfuse=libfuse3],
         [ac_cv_libfuse=no])
+
+      AS_IF(
+        [test "x$ac_cv_libfuse" = xno],
+        [PKG_CHECK_MODULES(
+          [fuse],
+          [fuse >= 2.6],
+          [ac_cv_libfuse=libfuse],
+          [ac_cv_libfuse=no])
+        ])
       ])
 
     AS_IF(
+      [test "x$ac_cv_libfuse" = xlibfuse3],
+      [ac_cv_libfuse_CPPFLAGS="$pkg_cv_fuse3_CFLAGS"
+      ac_cv_libfuse_LIBADD="$pkg_cv_fuse3_LIBS"],
       [test "x$ac_cv_libfuse" = xlibfuse],
       [ac_cv_libfuse_CPPFLAGS="$pkg_cv_fuse_CFLAGS"
       ac_cv_libfuse_LIBADD="$pkg_cv_fuse_LIBS"],
@@ -125,12 +137,19 @@ AC_DEFUN([AX_LIBFUSE_CHECK_LIB],
     ])
 
   AS_IF(
-    [test "x$ac_cv_libfuse" = xlibfuse],
+    [test "x$ac_cv_libfuse" = xlibfuse || test "x$ac_cv_libfuse" = xlibfuse3],
     [AC_DEFINE(
       [HAVE_LIBFUSE],
       [1],
       [Define to 1 if you have the 'fuse' library (-lfuse).])
     ])
+  AS_IF(
+    [test "x$ac_cv_libfuse" = xlibfuse3],
+    [AC_DEFINE(
+      [HAVE_LIBFUSE3],
+      [1],
+      [Define to 1 if you have the 'fuse3' library (-lfuse3).])
+    ])
   AS_IF(
     [test "x$ac_cv_libfuse" = xlibosxfuse],
     [AC_DEFINE(
@@ -181,6 +200,12 @@ AC_DEFUN([AX_LIBFUSE_CHECK_ENABLE],
       [ax_libfuse_pc_libs_private],
       [-lfuse])
     ])
+  AS_IF(
+    [test "x$ac_cv_libfuse" = xlibfuse3],
+    [AC_SUBST(
+      [ax_libfuse_pc_libs_private],
+      [-lfuse3])
+    ])
   AS_IF(
     [test "x$ac_cv_libfuse" = xlibosxfuse],
     [AC_SUBST(
@@ -197,5 +222,14 @@ AC_DEFUN([AX_LIBFUSE_CHECK_ENABLE],
       [ax_libfuse_spec_build_requires],
       [fuse-devel])
     ])
+  AS_IF(
+    [test "x$ac_cv_libfuse" = xlibfuse3],
+    [AC_SUBST(
+      [ax_libfuse_spec_requires],
+      [fuse3-libs])
+    AC_SUBST(
+      [ax_libfuse_spec_build_requires],
+      [fuse3-devel])
+    ])
   ])
 
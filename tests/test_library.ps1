@@ -6,7 +6,7 @@ $ExitSuccess = 0
 $ExitFailure = 1
 $ExitIgnore = 77
 
-$LibraryTests = "block block_descriptor block_range_descriptor block_tree error io_handle notify store store_block store_descriptor"
+$LibraryTests = "bitmap block block_cache block_descriptor block_descriptor_arena block_index block_range_descriptor block_tree error extent_map index_cache io_handle metadata_reader notify read_list store store_block store_descriptor store_preloader"
 $LibraryTestsWithInput = "support volume"
 
 $InputGlob = "*"
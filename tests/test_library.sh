@@ -7,7 +7,7 @@ EXIT_SUCCESS=0;
 EXIT_FAILURE=1;
 EXIT_IGNORE=77;
 
-LIBRARY_TESTS="block block_descriptor block_range_descriptor block_tree error io_handle notify store store_block store_descriptor";
+LIBRARY_TESTS="bitmap block block_cache block_descriptor block_descriptor_arena block_index block_range_descriptor block_tree error extent_map index_cache io_handle metadata_reader notify read_list store store_block store_descriptor store_preloader";
 LIBRARY_TESTS_WITH_INPUT="support volume";
 OPTION_SETS="";
 
@@ -0,0 +1,1532 @@
+/*
+ * Library bitmap functions test program
+ *
+ * Copyright (C) 2011-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "vshadow_test_libcerror.h"
+#include "vshadow_test_libvshadow.h"
+#include "vshadow_test_macros.h"
+#include "vshadow_test_memory.h"
+#include "vshadow_test_unused.h"
+
+#include "../libvshadow/libvshadow_bitmap.h"
+
+uint8_t vshadow_test_bitmap_data[ 20 ] = {
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0x0f, 0x00, 0x00, 0x00 };
+
+#if defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT )
+
+
+/* Tests the libvshadow_bitmap_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_bitmap_initialize(
+     void )
+{
+	libcerror_error_t *error        = NULL;
+	libvshadow_bitmap_t *bitmap     = NULL;
+	int result                      = 0;
+
+#if defined( HAVE_VSHADOW_TEST_MEMORY )
+	int number_of_malloc_fail_tests = 1;
+	int number_of_memset_fail_tests = 1;
+	int test_number                 = 0;
+#endif
+
+	/* Test bitmap initialization
+	 */
+	result = libvshadow_bitmap_initialize(
+	          &bitmap,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "bitmap",
+	 bitmap );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_bitmap_free(
+	          &bitmap,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "bitmap",
+	 bitmap );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvshadow_bitmap_initialize(
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	bitmap = (libvshadow_bitmap_t *) 0x12345678UL;
+
+	result = libvshadow_bitmap_initialize(
+	          &bitmap,
+	          &error );
+
+	bitmap = NULL;
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_VSHADOW_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvshadow_bitmap_initialize with malloc failing
+		 */
+		vshadow_test_malloc_attempts_before_fail = test_number;
+
+		result = libvshadow_bitmap_initialize(
+		          &bitmap,
+		          &error );
+
+		if( vshadow_test_malloc_attempts_before_fail != -1 )
+		{
+			vshadow_test_malloc_attempts_before_fail = -1;
+
+			if( bitmap != NULL )
+			{
+				libvshadow_bitmap_free(
+				 &bitmap,
+				 NULL );
+			}
+		}
+		else
+		{
+			VSHADOW_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VSHADOW_TEST_ASSERT_IS_NULL(
+			 "bitmap",
+			 bitmap );
+
+			VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvshadow_bitmap_initialize with memset failing
+		 */
+		vshadow_test_memset_attempts_before_fail = test_number;
+
+		result = libvshadow_bitmap_initialize(
+		          &bitmap,
+		          &error );
+
+		if( vshadow_test_memset_attempts_before_fail != -1 )
+		{
+			vshadow_test_memset_attempts_before_fail = -1;
+
+			if( bitmap != NULL )
+			{
+				libvshadow_bitmap_free(
+				 &bitmap,
+				 NULL );
+			}
+		}
+		else
+		{
+			VSHADOW_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VSHADOW_TEST_ASSERT_IS_NULL(
+			 "bitmap",
+			 bitmap );
+
+			VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_VSHADOW_TEST_MEMORY ) */
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( bitmap != NULL )
+	{
+		libvshadow_bitmap_free(
+		 &bitmap,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_bitmap_free function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_bitmap_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libvshadow_bitmap_free(
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_bitmap_clear function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_bitmap_clear(
+     void )
+{
+	libcerror_error_t *error    = NULL;
+	libvshadow_bitmap_t *bitmap = NULL;
+	size_t number_of_bits       = 0;
+	int result                  = 0;
+
+	/* Initialize test
+	 */
+	result = libvshadow_bitmap_initialize(
+	          &bitmap,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "bitmap",
+	 bitmap );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_bitmap_append_data(
+	          bitmap,
+	          vshadow_test_bitmap_data,
+	          20,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvshadow_bitmap_clear(
+	          bitmap,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SIZE(
+	 "bitmap->allocated_data_size",
+	 bitmap->allocated_data_size,
+	 (size_t) 0 );
+
+	result = libvshadow_bitmap_get_number_of_bits(
+	          bitmap,
+	          &number_of_bits,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SIZE(
+	 "number_of_bits",
+	 number_of_bits,
+	 (size_t) 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The data can be appended again after clearing
+	 */
+	result = libvshadow_bitmap_append_data(
+	          bitmap,
+	          vshadow_test_bitmap_data,
+	          20,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_bitmap_get_number_of_bits(
+	          bitmap,
+	          &number_of_bits,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SIZE(
+	 "number_of_bits",
+	 number_of_bits,
+	 (size_t) 160 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvshadow_bitmap_clear(
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvshadow_bitmap_free(
+	          &bitmap,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "bitmap",
+	 bitmap );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( bitmap != NULL )
+	{
+		libvshadow_bitmap_free(
+		 &bitmap,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_bitmap_append_data function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_bitmap_append_data(
+     void )
+{
+	libcerror_error_t *error    = NULL;
+	libvshadow_bitmap_t *bitmap = NULL;
+	size_t number_of_bits       = 0;
+	int result                  = 0;
+
+	/* Initialize test
+	 */
+	result = libvshadow_bitmap_initialize(
+	          &bitmap,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "bitmap",
+	 bitmap );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvshadow_bitmap_append_data(
+	          bitmap,
+	          vshadow_test_bitmap_data,
+	          20,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_bitmap_append_data(
+	          bitmap,
+	          vshadow_test_bitmap_data,
+	          20,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_bitmap_get_number_of_bits(
+	          bitmap,
+	          &number_of_bits,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SIZE(
+	 "number_of_bits",
+	 number_of_bits,
+	 (size_t) 320 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvshadow_bitmap_append_data(
+	          NULL,
+	          vshadow_test_bitmap_data,
+	          20,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_bitmap_append_data(
+	          bitmap,
+	          NULL,
+	          20,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_bitmap_append_data(
+	          bitmap,
+	          vshadow_test_bitmap_data,
+	          0,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_bitmap_get_number_of_bits(
+	          NULL,
+	          &number_of_bits,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_bitmap_get_number_of_bits(
+	          bitmap,
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvshadow_bitmap_free(
+	          &bitmap,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "bitmap",
+	 bitmap );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( bitmap != NULL )
+	{
+		libvshadow_bitmap_free(
+		 &bitmap,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_bitmap_get_bit_value and libvshadow_bitmap_get_run_at_bit_index functions
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_bitmap_get_bit_value(
+     void )
+{
+	libcerror_error_t *error    = NULL;
+	libvshadow_bitmap_t *bitmap = NULL;
+	size_t number_of_bits       = 0;
+	uint8_t bit_value           = 0;
+	int result                  = 0;
+
+	/* Initialize test
+	 */
+	result = libvshadow_bitmap_initialize(
+	          &bitmap,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "bitmap",
+	 bitmap );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_bitmap_append_data(
+	          bitmap,
+	          vshadow_test_bitmap_data,
+	          20,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_bitmap_append_data(
+	          bitmap,
+	          vshadow_test_bitmap_data,
+	          20,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvshadow_bitmap_get_bit_value(
+	          bitmap,
+	          0,
+	          &bit_value,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT8(
+	 "bit_value",
+	 bit_value,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_bitmap_get_bit_value(
+	          bitmap,
+	          291,
+	          &bit_value,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT8(
+	 "bit_value",
+	 bit_value,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_bitmap_get_bit_value(
+	          bitmap,
+	          320,
+	          &bit_value,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test run of unset bits that continues in the second appended data
+	 */
+	result = libvshadow_bitmap_get_run_at_bit_index(
+	          bitmap,
+	          132,
+	          &bit_value,
+	          &number_of_bits,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT8(
+	 "bit_value",
+	 bit_value,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SIZE(
+	 "number_of_bits",
+	 number_of_bits,
+	 (size_t) 92 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_bitmap_get_run_at_bit_index(
+	          bitmap,
+	          320,
+	          &bit_value,
+	          &number_of_bits,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvshadow_bitmap_get_bit_value(
+	          NULL,
+	          0,
+	          &bit_value,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_bitmap_get_bit_value(
+	          bitmap,
+	          0,
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_bitmap_get_run_at_bit_index(
+	          NULL,
+	          0,
+	          &bit_value,
+	          &number_of_bits,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvshadow_bitmap_free(
+	          &bitmap,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "bitmap",
+	 bitmap );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( bitmap != NULL )
+	{
+		libvshadow_bitmap_free(
+		 &bitmap,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_bitmap_get_number_of_set_bits function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_bitmap_get_number_of_set_bits(
+     void )
+{
+	libcerror_error_t *error    = NULL;
+	libvshadow_bitmap_t *bitmap = NULL;
+	size_t number_of_set_bits   = 0;
+	int result                  = 0;
+
+	/* Initialize test
+	 */
+	result = libvshadow_bitmap_initialize(
+	          &bitmap,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "bitmap",
+	 bitmap );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvshadow_bitmap_get_number_of_set_bits(
+	          bitmap,
+	          &number_of_set_bits,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SIZE(
+	 "number_of_set_bits",
+	 number_of_set_bits,
+	 (size_t) 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_bitmap_append_data(
+	          bitmap,
+	          vshadow_test_bitmap_data,
+	          20,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_bitmap_get_number_of_set_bits(
+	          bitmap,
+	          &number_of_set_bits,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SIZE(
+	 "number_of_set_bits",
+	 number_of_set_bits,
+	 (size_t) 68 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvshadow_bitmap_get_number_of_set_bits(
+	          NULL,
+	          &number_of_set_bits,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_bitmap_get_number_of_set_bits(
+	          bitmap,
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvshadow_bitmap_free(
+	          &bitmap,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "bitmap",
+	 bitmap );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( bitmap != NULL )
+	{
+		libvshadow_bitmap_free(
+		 &bitmap,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_bitmap_get_number_of_trailing_zero_bits function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_bitmap_get_number_of_trailing_zero_bits(
+     void )
+{
+	uint8_t number_of_zero_bits = 0;
+
+	/* Test regular cases
+	 */
+	number_of_zero_bits = libvshadow_bitmap_get_number_of_trailing_zero_bits(
+	                       0x0000000000000001ULL );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT8(
+	 "number_of_zero_bits",
+	 number_of_zero_bits,
+	 0 );
+
+	number_of_zero_bits = libvshadow_bitmap_get_number_of_trailing_zero_bits(
+	                       0x0000000000000080ULL );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT8(
+	 "number_of_zero_bits",
+	 number_of_zero_bits,
+	 7 );
+
+	number_of_zero_bits = libvshadow_bitmap_get_number_of_trailing_zero_bits(
+	                       0x0000000100000000ULL );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT8(
+	 "number_of_zero_bits",
+	 number_of_zero_bits,
+	 32 );
+
+	number_of_zero_bits = libvshadow_bitmap_get_number_of_trailing_zero_bits(
+	                       0x8000000000000000ULL );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT8(
+	 "number_of_zero_bits",
+	 number_of_zero_bits,
+	 63 );
+
+	number_of_zero_bits = libvshadow_bitmap_get_number_of_trailing_zero_bits(
+	                       0 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT8(
+	 "number_of_zero_bits",
+	 number_of_zero_bits,
+	 64 );
+
+	return( 1 );
+
+on_error:
+	return( 0 );
+}
+
+/* Tests the libvshadow_bitmap_get_population_count function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_bitmap_get_population_count(
+     void )
+{
+	uint8_t number_of_set_bits = 0;
+
+	/* Test regular cases
+	 */
+	number_of_set_bits = libvshadow_bitmap_get_population_count(
+	                      0 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT8(
+	 "number_of_set_bits",
+	 number_of_set_bits,
+	 0 );
+
+	number_of_set_bits = libvshadow_bitmap_get_population_count(
+	                      0x8000000000000001ULL );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT8(
+	 "number_of_set_bits",
+	 number_of_set_bits,
+	 2 );
+
+	number_of_set_bits = libvshadow_bitmap_get_population_count(
+	                      0x00000000f0f0f0f0ULL );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT8(
+	 "number_of_set_bits",
+	 number_of_set_bits,
+	 16 );
+
+	number_of_set_bits = libvshadow_bitmap_get_population_count(
+	                      0xffffffffffffffffULL );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT8(
+	 "number_of_set_bits",
+	 number_of_set_bits,
+	 64 );
+
+	return( 1 );
+
+on_error:
+	return( 0 );
+}
+
+/* Tests the libvshadow_bitmap_get_run function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_bitmap_get_run(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	size_t number_of_bits    = 0;
+	uint8_t bit_value        = 0;
+	int result               = 0;
+
+	/* Test run of unset bits that spans a 64-bit value
+	 */
+	result = libvshadow_bitmap_get_run(
+	          vshadow_test_bitmap_data,
+	          20,
+	          0,
+	          &bit_value,
+	          &number_of_bits,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT8(
+	 "bit_value",
+	 bit_value,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SIZE(
+	 "number_of_bits",
+	 number_of_bits,
+	 (size_t) 64 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test run of unset bits that starts within a 64-bit value
+	 */
+	result = libvshadow_bitmap_get_run(
+	          vshadow_test_bitmap_data,
+	          20,
+	          3,
+	          &bit_value,
+	          &number_of_bits,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT8(
+	 "bit_value",
+	 bit_value,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SIZE(
+	 "number_of_bits",
+	 number_of_bits,
+	 (size_t) 61 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test run of set bits that continues in the remaining bitmap data
+	 */
+	result = libvshadow_bitmap_get_run(
+	          vshadow_test_bitmap_data,
+	          20,
+	          64,
+	          &bit_value,
+	          &number_of_bits,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT8(
+	 "bit_value",
+	 bit_value,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SIZE(
+	 "number_of_bits",
+	 number_of_bits,
+	 (size_t) 68 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_bitmap_get_run(
+	          vshadow_test_bitmap_data,
+	          20,
+	          130,
+	          &bit_value,
+	          &number_of_bits,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT8(
+	 "bit_value",
+	 bit_value,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SIZE(
+	 "number_of_bits",
+	 number_of_bits,
+	 (size_t) 2 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test run of unset bits that ends at the end of the bitmap data
+	 */
+	result = libvshadow_bitmap_get_run(
+	          vshadow_test_bitmap_data,
+	          20,
+	          132,
+	          &bit_value,
+	          &number_of_bits,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT8(
+	 "bit_value",
+	 bit_value,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SIZE(
+	 "number_of_bits",
+	 number_of_bits,
+	 (size_t) 28 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test run of set bits that ends at the end of the bitmap data
+	 */
+	result = libvshadow_bitmap_get_run(
+	          vshadow_test_bitmap_data,
+	          16,
+	          64,
+	          &bit_value,
+	          &number_of_bits,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT8(
+	 "bit_value",
+	 bit_value,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SIZE(
+	 "number_of_bits",
+	 number_of_bits,
+	 (size_t) 64 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvshadow_bitmap_get_run(
+	          NULL,
+	          20,
+	          0,
+	          &bit_value,
+	          &number_of_bits,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_bitmap_get_run(
+	          vshadow_test_bitmap_data,
+	          0,
+	          0,
+	          &bit_value,
+	          &number_of_bits,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_bitmap_get_run(
+	          vshadow_test_bitmap_data,
+	          20,
+	          160,
+	          &bit_value,
+	          &number_of_bits,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_bitmap_get_run(
+	          vshadow_test_bitmap_data,
+	          20,
+	          0,
+	          NULL,
+	          &number_of_bits,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_bitmap_get_run(
+	          vshadow_test_bitmap_data,
+	          20,
+	          0,
+	          &bit_value,
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc VSHADOW_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] VSHADOW_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc VSHADOW_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] VSHADOW_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	VSHADOW_TEST_UNREFERENCED_PARAMETER( argc )
+	VSHADOW_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT )
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_bitmap_initialize",
+	 vshadow_test_bitmap_initialize );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_bitmap_free",
+	 vshadow_test_bitmap_free );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_bitmap_clear",
+	 vshadow_test_bitmap_clear );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_bitmap_append_data",
+	 vshadow_test_bitmap_append_data );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_bitmap_get_bit_value",
+	 vshadow_test_bitmap_get_bit_value );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_bitmap_get_number_of_set_bits",
+	 vshadow_test_bitmap_get_number_of_set_bits );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_bitmap_get_number_of_trailing_zero_bits",
+	 vshadow_test_bitmap_get_number_of_trailing_zero_bits );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_bitmap_get_population_count",
+	 vshadow_test_bitmap_get_population_count );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_bitmap_get_run",
+	 vshadow_test_bitmap_get_run );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
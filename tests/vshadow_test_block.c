@@ -88,6 +88,13 @@ int vshadow_test_block_initialize(
 	 "error",
 	 error );
 
+	/* The block contains a copy of the block descriptor
+	 */
+	VSHADOW_TEST_ASSERT_NOT_EQUAL_INTPTR(
+	 "block->block_descriptor",
+	 (intptr_t) ( (libvshadow_internal_block_t *) block )->block_descriptor,
+	 (intptr_t) block_descriptor );
+
 	result = libvshadow_block_free(
 	          &block,
 	          &error );
@@ -332,11 +339,12 @@ on_error:
 int vshadow_test_block_get_original_offset(
      void )
 {
-	libcerror_error_t *error                        = NULL;
-	libvshadow_block_t *block                       = NULL;
-	libvshadow_block_descriptor_t *block_descriptor = NULL;
-	off64_t original_offset                         = 0;
-	int result                                      = 0;
+	libcerror_error_t *error                                 = NULL;
+	libvshadow_block_t *block                                = NULL;
+	libvshadow_block_descriptor_t *block_descriptor          = NULL;
+	libvshadow_block_descriptor_t *internal_block_descriptor = NULL;
+	off64_t original_offset                                  = 0;
+	int result                                               = 0;
 
 	/* Initialize test
 	 */
@@ -427,6 +435,8 @@ int vshadow_test_block_get_original_offset(
 	libcerror_error_free(
 	 &error );
 
+	internal_block_descriptor = ( (libvshadow_internal_block_t *) block )->block_descriptor;
+
 	/* Test error case where internal block descriptor is NULL
 	 */
 	( (libvshadow_internal_block_t *) block )->block_descriptor = NULL;
@@ -448,6 +458,8 @@ int vshadow_test_block_get_original_offset(
 	libcerror_error_free(
 	 &error );
 
+	( (libvshadow_internal_block_t *) block )->block_descriptor = internal_block_descriptor;
+
 	/* Clean up
 	 */
 	result = libvshadow_block_free(
@@ -513,11 +525,12 @@ on_error:
 int vshadow_test_block_get_relative_offset(
      void )
 {
-	libcerror_error_t *error                        = NULL;
-	libvshadow_block_t *block                       = NULL;
-	libvshadow_block_descriptor_t *block_descriptor = NULL;
-	off64_t relative_offset                         = 0;
-	int result                                      = 0;
+	libcerror_error_t *error                                 = NULL;
+	libvshadow_block_t *block                                = NULL;
+	libvshadow_block_descriptor_t *block_descriptor          = NULL;
+	libvshadow_block_descriptor_t *internal_block_descriptor = NULL;
+	off64_t relative_offset                                  = 0;
+	int result                                               = 0;
 
 	/* Initialize test
 	 */
@@ -608,6 +621,8 @@ int vshadow_test_block_get_relative_offset(
 	libcerror_error_free(
 	 &error );
 
+	internal_block_descriptor = ( (libvshadow_internal_block_t *) block )->block_descriptor;
+
 	/* Test error case where internal block descriptor is NULL
 	 */
 	( (libvshadow_internal_block_t *) block )->block_descriptor = NULL;
@@ -629,6 +644,8 @@ int vshadow_test_block_get_relative_offset(
 	libcerror_error_free(
 	 &error );
 
+	( (libvshadow_internal_block_t *) block )->block_descriptor = internal_block_descriptor;
+
 	/* Clean up
 	 */
 	result = libvshadow_block_free(
@@ -694,11 +711,12 @@ on_error:
 int vshadow_test_block_get_offset(
      void )
 {
-	libcerror_error_t *error                        = NULL;
-	libvshadow_block_t *block                       = NULL;
-	libvshadow_block_descriptor_t *block_descriptor = NULL;
-	off64_t offset                                  = 0;
-	int result                                      = 0;
+	libcerror_error_t *error                                 = NULL;
+	libvshadow_block_t *block                                = NULL;
+	libvshadow_block_descriptor_t *block_descriptor          = NULL;
+	libvshadow_block_descriptor_t *internal_block_descriptor = NULL;
+	off64_t offset                                           = 0;
+	int result                                               = 0;
 
 	/* Initialize test
 	 */
@@ -789,6 +807,8 @@ int vshadow_test_block_get_offset(
 	libcerror_error_free(
 	 &error );
 
+	internal_block_descriptor = ( (libvshadow_internal_block_t *) block )->block_descriptor;
+
 	/* Test error case where internal block descriptor is NULL
 	 */
 	( (libvshadow_internal_block_t *) block )->block_descriptor = NULL;
@@ -810,6 +830,8 @@ int vshadow_test_block_get_offset(
 	libcerror_error_free(
 	 &error );
 
+	( (libvshadow_internal_block_t *) block )->block_descriptor = internal_block_descriptor;
+
 	/* Clean up
 	 */
 	result = libvshadow_block_free(
@@ -875,15 +897,16 @@ on_error:
 int vshadow_test_block_get_values(
      void )
 {
-	libcerror_error_t *error                        = NULL;
-	libvshadow_block_t *block                       = NULL;
-	libvshadow_block_descriptor_t *block_descriptor = NULL;
-	off64_t relative_offset                         = 0;
-	off64_t offset                                  = 0;
-	off64_t original_offset                         = 0;
-	uint32_t bitmap                                 = 0;
-	uint32_t flags                                  = 0;
-	int result                                      = 0;
+	libcerror_error_t *error                                 = NULL;
+	libvshadow_block_t *block                                = NULL;
+	libvshadow_block_descriptor_t *block_descriptor          = NULL;
+	libvshadow_block_descriptor_t *internal_block_descriptor = NULL;
+	off64_t relative_offset                                  = 0;
+	off64_t offset                                           = 0;
+	off64_t original_offset                                  = 0;
+	uint32_t bitmap                                          = 0;
+	uint32_t flags                                           = 0;
+	int result                                               = 0;
 
 	/* Initialize test
 	 */
@@ -1070,6 +1093,8 @@ int vshadow_test_block_get_values(
 	libcerror_error_free(
 	 &error );
 
+	internal_block_descriptor = ( (libvshadow_internal_block_t *) block )->block_descriptor;
+
 	/* Test error case where internal block descriptor is NULL
 	 */
 	( (libvshadow_internal_block_t *) block )->block_descriptor = NULL;
@@ -1095,6 +1120,8 @@ int vshadow_test_block_get_values(
 	libcerror_error_free(
 	 &error );
 
+	( (libvshadow_internal_block_t *) block )->block_descriptor = internal_block_descriptor;
+
 	/* Clean up
 	 */
 	result = libvshadow_block_free(
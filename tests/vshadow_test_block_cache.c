@@ -0,0 +1,837 @@
+/*
+ * Library block_cache type test program
+ *
+ * Copyright (C) 2011-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "vshadow_test_libbfio.h"
+#include "vshadow_test_libcerror.h"
+#include "vshadow_test_libvshadow.h"
+#include "vshadow_test_macros.h"
+#include "vshadow_test_memory.h"
+#include "vshadow_test_unused.h"
+
+#include "../libvshadow/libvshadow_block_cache.h"
+
+#if defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT )
+
+/* Tests the libvshadow_block_cache_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_block_cache_initialize(
+     void )
+{
+	libcerror_error_t *error              = NULL;
+	libvshadow_block_cache_t *block_cache = NULL;
+	int result                            = 0;
+
+#if defined( HAVE_VSHADOW_TEST_MEMORY )
+	int number_of_malloc_fail_tests       = 3;
+	int number_of_memset_fail_tests       = 2;
+	int test_number                       = 0;
+#endif
+
+	/* Test block_cache initialization
+	 */
+	result = libvshadow_block_cache_initialize(
+	          &block_cache,
+	          0x10000,
+	          0x4000,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "block_cache",
+	 block_cache );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_block_cache_free(
+	          &block_cache,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "block_cache",
+	 block_cache );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvshadow_block_cache_initialize(
+	          NULL,
+	          0x10000,
+	          0x4000,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	block_cache = (libvshadow_block_cache_t *) 0x12345678UL;
+
+	result = libvshadow_block_cache_initialize(
+	          &block_cache,
+	          0x10000,
+	          0x4000,
+	          &error );
+
+	block_cache = NULL;
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_block_cache_initialize(
+	          &block_cache,
+	          0x10000,
+	          0,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_block_cache_initialize(
+	          &block_cache,
+	          0x2000,
+	          0x4000,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_VSHADOW_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvshadow_block_cache_initialize with malloc failing
+		 */
+		vshadow_test_malloc_attempts_before_fail = test_number;
+
+		result = libvshadow_block_cache_initialize(
+		          &block_cache,
+		          0x10000,
+		          0x4000,
+		          &error );
+
+		if( vshadow_test_malloc_attempts_before_fail != -1 )
+		{
+			vshadow_test_malloc_attempts_before_fail = -1;
+
+			if( block_cache != NULL )
+			{
+				libvshadow_block_cache_free(
+				 &block_cache,
+				 NULL );
+			}
+		}
+		else
+		{
+			VSHADOW_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VSHADOW_TEST_ASSERT_IS_NULL(
+			 "block_cache",
+			 block_cache );
+
+			VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvshadow_block_cache_initialize with memset failing
+		 */
+		vshadow_test_memset_attempts_before_fail = test_number;
+
+		result = libvshadow_block_cache_initialize(
+		          &block_cache,
+		          0x10000,
+		          0x4000,
+		          &error );
+
+		if( vshadow_test_memset_attempts_before_fail != -1 )
+		{
+			vshadow_test_memset_attempts_before_fail = -1;
+
+			if( block_cache != NULL )
+			{
+				libvshadow_block_cache_free(
+				 &block_cache,
+				 NULL );
+			}
+		}
+		else
+		{
+			VSHADOW_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VSHADOW_TEST_ASSERT_IS_NULL(
+			 "block_cache",
+			 block_cache );
+
+			VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_VSHADOW_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( block_cache != NULL )
+	{
+		libvshadow_block_cache_free(
+		 &block_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_block_cache_free function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_block_cache_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libvshadow_block_cache_free(
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_block_cache_read_buffer function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_block_cache_read_buffer(
+     void )
+{
+	uint8_t buffer[ 0x5000 ];
+
+	libbfio_handle_t *file_io_handle      = NULL;
+	libcerror_error_t *error              = NULL;
+	libvshadow_block_cache_t *block_cache = NULL;
+	uint8_t *data                         = NULL;
+	uint64_t number_of_hits               = 0;
+	uint64_t number_of_misses             = 0;
+	ssize_t read_count                    = 0;
+	size_t data_index                     = 0;
+	int result                            = 0;
+
+	/* Initialize test
+	 * The data is 0x8800 bytes so the last block is partial
+	 */
+	data = (uint8_t *) malloc(
+	                    0x8800 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "data",
+	 data );
+
+	for( data_index = 0;
+	     data_index < 0x8800;
+	     data_index++ )
+	{
+		data[ data_index ] = (uint8_t) ( data_index / 0x100 );
+	}
+	result = libbfio_memory_range_initialize(
+	          &file_io_handle,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_memory_range_set(
+	          file_io_handle,
+	          data,
+	          0x8800,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_handle_open(
+	          file_io_handle,
+	          LIBBFIO_OPEN_READ,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* A cache of 2 blocks of 0x4000 bytes
+	 */
+	result = libvshadow_block_cache_initialize(
+	          &block_cache,
+	          0x8000,
+	          0x4000,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "block_cache",
+	 block_cache );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test read that spans 2 blocks
+	 */
+	read_count = libvshadow_block_cache_read_buffer(
+	              block_cache,
+	              file_io_handle,
+	              buffer,
+	              0x2000,
+	              0x3000,
+	              &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 0x2000 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT8(
+	 "buffer[ 0 ]",
+	 buffer[ 0 ],
+	 0x30 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT8(
+	 "buffer[ 0x1fff ]",
+	 buffer[ 0x1fff ],
+	 0x4f );
+
+	/* Test read of a cached block
+	 */
+	read_count = libvshadow_block_cache_read_buffer(
+	              block_cache,
+	              file_io_handle,
+	              buffer,
+	              0x100,
+	              0x4100,
+	              &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 0x100 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT8(
+	 "buffer[ 0 ]",
+	 buffer[ 0 ],
+	 0x41 );
+
+	/* Test read of the partial last block, which evicts the block at offset 0
+	 */
+	read_count = libvshadow_block_cache_read_buffer(
+	              block_cache,
+	              file_io_handle,
+	              buffer,
+	              0x2000,
+	              0x8000,
+	              &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 0x800 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT8(
+	 "buffer[ 0x7ff ]",
+	 buffer[ 0x7ff ],
+	 0x87 );
+
+	/* Test read of the block at offset 0x4000, which is still cached
+	 */
+	read_count = libvshadow_block_cache_read_buffer(
+	              block_cache,
+	              file_io_handle,
+	              buffer,
+	              0x100,
+	              0x7f00,
+	              &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 0x100 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT8(
+	 "buffer[ 0 ]",
+	 buffer[ 0 ],
+	 0x7f );
+
+	/* Test read of the block at offset 0, which was evicted
+	 */
+	read_count = libvshadow_block_cache_read_buffer(
+	              block_cache,
+	              file_io_handle,
+	              buffer,
+	              0x100,
+	              0x0200,
+	              &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 0x100 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT8(
+	 "buffer[ 0 ]",
+	 buffer[ 0 ],
+	 0x02 );
+
+	/* Test read beyond the end of the data
+	 */
+	read_count = libvshadow_block_cache_read_buffer(
+	              block_cache,
+	              file_io_handle,
+	              buffer,
+	              0x100,
+	              0x8900,
+	              &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test read larger than the block size, the block at offset 0 is cached
+	 * and only the block at offset 0x4000 is read
+	 */
+	read_count = libvshadow_block_cache_read_buffer(
+	              block_cache,
+	              file_io_handle,
+	              buffer,
+	              0x5000,
+	              0x1000,
+	              &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 0x5000 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT8(
+	 "buffer[ 0x4fff ]",
+	 buffer[ 0x4fff ],
+	 0x5f );
+
+	/* Test read larger than the block size of blocks that are cached
+	 */
+	read_count = libvshadow_block_cache_read_buffer(
+	              block_cache,
+	              file_io_handle,
+	              buffer,
+	              0x5000,
+	              0x1000,
+	              &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 0x5000 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT8(
+	 "buffer[ 0x4fff ]",
+	 buffer[ 0x4fff ],
+	 0x5f );
+
+	result = libvshadow_block_cache_get_statistics(
+	          block_cache,
+	          &number_of_hits,
+	          &number_of_misses,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "number_of_hits",
+	 number_of_hits,
+	 (uint64_t) 5 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "number_of_misses",
+	 number_of_misses,
+	 (uint64_t) 6 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	read_count = libvshadow_block_cache_read_buffer(
+	              NULL,
+	              file_io_handle,
+	              buffer,
+	              0x100,
+	              0,
+	              &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libvshadow_block_cache_read_buffer(
+	              block_cache,
+	              file_io_handle,
+	              NULL,
+	              0x100,
+	              0,
+	              &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libvshadow_block_cache_read_buffer(
+	              block_cache,
+	              file_io_handle,
+	              buffer,
+	              0x100,
+	              -1,
+	              &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_block_cache_get_statistics(
+	          NULL,
+	          &number_of_hits,
+	          &number_of_misses,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvshadow_block_cache_free(
+	          &block_cache,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "block_cache",
+	 block_cache );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_handle_close(
+	          file_io_handle,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_handle_free(
+	          &file_io_handle,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	free(
+	 data );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( block_cache != NULL )
+	{
+		libvshadow_block_cache_free(
+		 &block_cache,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( data != NULL )
+	{
+		free(
+		 data );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc VSHADOW_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] VSHADOW_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc VSHADOW_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] VSHADOW_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	VSHADOW_TEST_UNREFERENCED_PARAMETER( argc )
+	VSHADOW_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT )
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_block_cache_initialize",
+	 vshadow_test_block_cache_initialize );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_block_cache_free",
+	 vshadow_test_block_cache_free );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_block_cache_read_buffer",
+	 vshadow_test_block_cache_read_buffer );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
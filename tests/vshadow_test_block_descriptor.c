@@ -35,6 +35,7 @@
 #include "vshadow_test_unused.h"
 
 #include "../libvshadow/libvshadow_block_descriptor.h"
+#include "../libvshadow/libvshadow_definitions.h"
 
 uint8_t vshadow_test_block_descriptor_data[ 32 ] = {
 	0x00, 0x80, 0xfc, 0xb7, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00,
@@ -1530,6 +1531,224 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libvshadow_block_descriptor_pack and libvshadow_block_descriptor_unpack functions
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_block_descriptor_pack(
+     void )
+{
+	libvshadow_block_descriptor_t block_descriptor;
+	libvshadow_block_descriptor_t overlay_block_descriptor;
+	libvshadow_block_descriptor_t unpacked_block_descriptor;
+	libvshadow_packed_block_descriptor_t packed_block_descriptor;
+
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	block_descriptor.original_offset = 0x8000;
+	block_descriptor.offset          = 0x37e2cc000;
+	block_descriptor.relative_offset = 0x4000;
+	block_descriptor.flags           = LIBVSHADOW_BLOCK_FLAG_IS_FORWARDER;
+	block_descriptor.bitmap          = 0;
+	block_descriptor.index           = 3;
+	block_descriptor.reverse_index   = 5;
+	block_descriptor.overlay         = &overlay_block_descriptor;
+
+	/* Test regular cases
+	 */
+	result = libvshadow_block_descriptor_pack(
+	          &block_descriptor,
+	          &packed_block_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT32(
+	 "packed_block_descriptor.original_block_number",
+	 packed_block_descriptor.original_block_number,
+	 (uint32_t) 2 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT32(
+	 "packed_block_descriptor.block_number",
+	 packed_block_descriptor.block_number,
+	 (uint32_t) 0x000df8b3UL );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT32(
+	 "packed_block_descriptor.flags",
+	 packed_block_descriptor.flags,
+	 (uint32_t) ( LIBVSHADOW_PACKED_BLOCK_FLAG_HAS_OVERLAY | LIBVSHADOW_BLOCK_FLAG_IS_FORWARDER ) );
+
+	result = libvshadow_block_descriptor_unpack(
+	          &unpacked_block_descriptor,
+	          &packed_block_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT64(
+	 "unpacked_block_descriptor.original_offset",
+	 (int64_t) unpacked_block_descriptor.original_offset,
+	 (int64_t) 0x8000 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT64(
+	 "unpacked_block_descriptor.offset",
+	 (int64_t) unpacked_block_descriptor.offset,
+	 (int64_t) 0x37e2cc000 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT64(
+	 "unpacked_block_descriptor.relative_offset",
+	 (int64_t) unpacked_block_descriptor.relative_offset,
+	 (int64_t) 0x4000 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT32(
+	 "unpacked_block_descriptor.flags",
+	 unpacked_block_descriptor.flags,
+	 (uint32_t) LIBVSHADOW_BLOCK_FLAG_IS_FORWARDER );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "unpacked_block_descriptor.overlay",
+	 unpacked_block_descriptor.overlay );
+
+	/* Test a block descriptor that cannot be packed
+	 */
+	block_descriptor.relative_offset = 1;
+	block_descriptor.overlay         = NULL;
+
+	result = libvshadow_block_descriptor_pack(
+	          &block_descriptor,
+	          &packed_block_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT32(
+	 "packed_block_descriptor.flags",
+	 packed_block_descriptor.flags,
+	 (uint32_t) LIBVSHADOW_PACKED_BLOCK_FLAG_IS_EXTENDED );
+
+	/* Test error cases
+	 */
+	result = libvshadow_block_descriptor_pack(
+	          NULL,
+	          &packed_block_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_block_descriptor_pack(
+	          &block_descriptor,
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_block_descriptor_unpack(
+	          NULL,
+	          &packed_block_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_block_descriptor_unpack(
+	          &unpacked_block_descriptor,
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* An extended block descriptor cannot be unpacked
+	 */
+	result = libvshadow_block_descriptor_unpack(
+	          &unpacked_block_descriptor,
+	          &packed_block_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
 /* Tests the libvshadow_block_descriptor_read_data function
  * Returns 1 if successful or 0 if not
  */
@@ -1783,6 +2002,10 @@ int main(
 	 "libvshadow_block_descriptor_compare_range_by_relative_offset_value",
 	 vshadow_test_block_descriptor_compare_range_by_relative_offset_value );
 
+	VSHADOW_TEST_RUN(
+	 "libvshadow_block_descriptor_pack",
+	 vshadow_test_block_descriptor_pack );
+
 	VSHADOW_TEST_RUN(
 	 "libvshadow_block_descriptor_read_data",
 	 vshadow_test_block_descriptor_read_data );
@@ -0,0 +1,946 @@
+/*
+ * Library block_descriptor_arena type test program
+ *
+ * Copyright (C) 2011-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "vshadow_test_libcerror.h"
+#include "vshadow_test_libvshadow.h"
+#include "vshadow_test_macros.h"
+#include "vshadow_test_memory.h"
+#include "vshadow_test_unused.h"
+
+#include "../libvshadow/libvshadow_block_descriptor.h"
+#include "../libvshadow/libvshadow_block_descriptor_arena.h"
+#include "../libvshadow/libvshadow_definitions.h"
+
+#if defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT )
+
+/* Tests the libvshadow_block_descriptor_arena_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_block_descriptor_arena_initialize(
+     void )
+{
+	libcerror_error_t *error                                    = NULL;
+	libvshadow_block_descriptor_arena_t *block_descriptor_arena = NULL;
+	int result                                                  = 0;
+
+#if defined( HAVE_VSHADOW_TEST_MEMORY )
+	int number_of_malloc_fail_tests                             = 1;
+	int number_of_memset_fail_tests                             = 1;
+	int test_number                                             = 0;
+#endif
+
+	/* Test block descriptor arena initialization
+	 */
+	result = libvshadow_block_descriptor_arena_initialize(
+	          &block_descriptor_arena,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "block_descriptor_arena",
+	 block_descriptor_arena );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_block_descriptor_arena_free(
+	          &block_descriptor_arena,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "block_descriptor_arena",
+	 block_descriptor_arena );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvshadow_block_descriptor_arena_initialize(
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	block_descriptor_arena = (libvshadow_block_descriptor_arena_t *) 0x12345678UL;
+
+	result = libvshadow_block_descriptor_arena_initialize(
+	          &block_descriptor_arena,
+	          &error );
+
+	block_descriptor_arena = NULL;
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_VSHADOW_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvshadow_block_descriptor_arena_initialize with malloc failing
+		 */
+		vshadow_test_malloc_attempts_before_fail = test_number;
+
+		result = libvshadow_block_descriptor_arena_initialize(
+		          &block_descriptor_arena,
+		          &error );
+
+		if( vshadow_test_malloc_attempts_before_fail != -1 )
+		{
+			vshadow_test_malloc_attempts_before_fail = -1;
+
+			if( block_descriptor_arena != NULL )
+			{
+				libvshadow_block_descriptor_arena_free(
+				 &block_descriptor_arena,
+				 NULL );
+			}
+		}
+		else
+		{
+			VSHADOW_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VSHADOW_TEST_ASSERT_IS_NULL(
+			 "block_descriptor_arena",
+			 block_descriptor_arena );
+
+			VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvshadow_block_descriptor_arena_initialize with memset failing
+		 */
+		vshadow_test_memset_attempts_before_fail = test_number;
+
+		result = libvshadow_block_descriptor_arena_initialize(
+		          &block_descriptor_arena,
+		          &error );
+
+		if( vshadow_test_memset_attempts_before_fail != -1 )
+		{
+			vshadow_test_memset_attempts_before_fail = -1;
+
+			if( block_descriptor_arena != NULL )
+			{
+				libvshadow_block_descriptor_arena_free(
+				 &block_descriptor_arena,
+				 NULL );
+			}
+		}
+		else
+		{
+			VSHADOW_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VSHADOW_TEST_ASSERT_IS_NULL(
+			 "block_descriptor_arena",
+			 block_descriptor_arena );
+
+			VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_VSHADOW_TEST_MEMORY ) */
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( block_descriptor_arena != NULL )
+	{
+		libvshadow_block_descriptor_arena_free(
+		 &block_descriptor_arena,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_block_descriptor_arena_free function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_block_descriptor_arena_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libvshadow_block_descriptor_arena_free(
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_block_descriptor_arena_allocate function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_block_descriptor_arena_allocate(
+     void )
+{
+	libcerror_error_t *error                                    = NULL;
+	libvshadow_block_descriptor_arena_t *block_descriptor_arena = NULL;
+	libvshadow_block_descriptor_t *block_descriptor             = NULL;
+	libvshadow_block_descriptor_t *first_block_descriptor       = NULL;
+	int block_descriptor_index                                  = 0;
+	int number_of_block_descriptors                             = 0;
+	int result                                                  = 0;
+
+	/* Initialize test
+	 */
+	result = libvshadow_block_descriptor_arena_initialize(
+	          &block_descriptor_arena,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "block_descriptor_arena",
+	 block_descriptor_arena );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvshadow_block_descriptor_arena_allocate(
+	          block_descriptor_arena,
+	          &first_block_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "first_block_descriptor",
+	 first_block_descriptor );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "first_block_descriptor->index",
+	 first_block_descriptor->index,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "first_block_descriptor->reverse_index",
+	 first_block_descriptor->reverse_index,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "first_block_descriptor->overlay",
+	 first_block_descriptor->overlay );
+
+	first_block_descriptor->original_offset = 0xc0008000;
+
+	/* Test allocation across multiple slabs
+	 */
+	for( block_descriptor_index = 1;
+	     block_descriptor_index <= LIBVSHADOW_BLOCK_DESCRIPTOR_ARENA_SLAB_SIZE;
+	     block_descriptor_index++ )
+	{
+		block_descriptor = NULL;
+
+		result = libvshadow_block_descriptor_arena_allocate(
+		          block_descriptor_arena,
+		          &block_descriptor,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+		 "block_descriptor",
+		 block_descriptor );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "block_descriptor_arena->number_of_slabs",
+	 block_descriptor_arena->number_of_slabs,
+	 2 );
+
+	/* The block descriptors are not moved when a slab is added
+	 */
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "first_block_descriptor->original_offset",
+	 (uint64_t) first_block_descriptor->original_offset,
+	 (uint64_t) 0xc0008000UL );
+
+	result = libvshadow_block_descriptor_arena_get_number_of_block_descriptors(
+	          block_descriptor_arena,
+	          &number_of_block_descriptors,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "number_of_block_descriptors",
+	 number_of_block_descriptors,
+	 LIBVSHADOW_BLOCK_DESCRIPTOR_ARENA_SLAB_SIZE + 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	block_descriptor = NULL;
+
+	result = libvshadow_block_descriptor_arena_allocate(
+	          NULL,
+	          &block_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_block_descriptor_arena_allocate(
+	          block_descriptor_arena,
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_block_descriptor_arena_allocate(
+	          block_descriptor_arena,
+	          &first_block_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvshadow_block_descriptor_arena_free(
+	          &block_descriptor_arena,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "block_descriptor_arena",
+	 block_descriptor_arena );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( block_descriptor_arena != NULL )
+	{
+		libvshadow_block_descriptor_arena_free(
+		 &block_descriptor_arena,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_block_descriptor_arena_clone function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_block_descriptor_arena_clone(
+     void )
+{
+	libcerror_error_t *error                                       = NULL;
+	libvshadow_block_descriptor_arena_t *block_descriptor_arena    = NULL;
+	libvshadow_block_descriptor_t *destination_block_descriptor    = NULL;
+	libvshadow_block_descriptor_t *source_block_descriptor         = NULL;
+	libvshadow_block_descriptor_t *source_overlay_block_descriptor = NULL;
+	int number_of_block_descriptors                                = 0;
+	int result                                                     = 0;
+
+	/* Initialize test
+	 */
+	result = libvshadow_block_descriptor_arena_initialize(
+	          &block_descriptor_arena,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "block_descriptor_arena",
+	 block_descriptor_arena );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_block_descriptor_initialize(
+	          &source_block_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "source_block_descriptor",
+	 source_block_descriptor );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_block_descriptor_initialize(
+	          &source_overlay_block_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "source_overlay_block_descriptor",
+	 source_overlay_block_descriptor );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	source_block_descriptor->original_offset = 0xc0008000;
+	source_block_descriptor->relative_offset = 0x0419c000;
+	source_block_descriptor->offset          = 0x38241c000;
+	source_block_descriptor->flags           = 0x00000000;
+	source_block_descriptor->index           = 3;
+	source_block_descriptor->overlay         = source_overlay_block_descriptor;
+
+	source_overlay_block_descriptor->original_offset = 0xc0008000;
+	source_overlay_block_descriptor->relative_offset = 0x00000001;
+	source_overlay_block_descriptor->offset          = 0x38242c000;
+	source_overlay_block_descriptor->flags           = LIBVSHADOW_BLOCK_FLAG_IS_OVERLAY;
+	source_overlay_block_descriptor->bitmap          = 0x0000ffff;
+
+	/* Test regular cases
+	 */
+	result = libvshadow_block_descriptor_arena_clone(
+	          block_descriptor_arena,
+	          &destination_block_descriptor,
+	          source_block_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "destination_block_descriptor",
+	 destination_block_descriptor );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "destination_block_descriptor->offset",
+	 (uint64_t) destination_block_descriptor->offset,
+	 (uint64_t) 0x38241c000UL );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "destination_block_descriptor->index",
+	 destination_block_descriptor->index,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "destination_block_descriptor->overlay",
+	 destination_block_descriptor->overlay );
+
+	VSHADOW_TEST_ASSERT_NOT_EQUAL_INTPTR(
+	 "destination_block_descriptor->overlay",
+	 (intptr_t) destination_block_descriptor->overlay,
+	 (intptr_t) source_overlay_block_descriptor );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT32(
+	 "destination_block_descriptor->overlay->bitmap",
+	 destination_block_descriptor->overlay->bitmap,
+	 0x0000ffff );
+
+	result = libvshadow_block_descriptor_arena_get_number_of_block_descriptors(
+	          block_descriptor_arena,
+	          &number_of_block_descriptors,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "number_of_block_descriptors",
+	 number_of_block_descriptors,
+	 2 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	destination_block_descriptor = NULL;
+
+	result = libvshadow_block_descriptor_arena_clone(
+	          block_descriptor_arena,
+	          &destination_block_descriptor,
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "destination_block_descriptor",
+	 destination_block_descriptor );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvshadow_block_descriptor_arena_clone(
+	          NULL,
+	          &destination_block_descriptor,
+	          source_block_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "destination_block_descriptor",
+	 destination_block_descriptor );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_block_descriptor_arena_clone(
+	          block_descriptor_arena,
+	          NULL,
+	          source_block_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	source_block_descriptor->overlay = NULL;
+
+	result = libvshadow_block_descriptor_free(
+	          &source_overlay_block_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_block_descriptor_free(
+	          &source_block_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_block_descriptor_arena_free(
+	          &block_descriptor_arena,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "block_descriptor_arena",
+	 block_descriptor_arena );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( source_block_descriptor != NULL )
+	{
+		source_block_descriptor->overlay = NULL;
+
+		libvshadow_block_descriptor_free(
+		 &source_block_descriptor,
+		 NULL );
+	}
+	if( source_overlay_block_descriptor != NULL )
+	{
+		libvshadow_block_descriptor_free(
+		 &source_overlay_block_descriptor,
+		 NULL );
+	}
+	if( block_descriptor_arena != NULL )
+	{
+		libvshadow_block_descriptor_arena_free(
+		 &block_descriptor_arena,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_block_descriptor_arena_get_number_of_block_descriptors function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_block_descriptor_arena_get_number_of_block_descriptors(
+     void )
+{
+	libcerror_error_t *error                                    = NULL;
+	libvshadow_block_descriptor_arena_t *block_descriptor_arena = NULL;
+	int number_of_block_descriptors                             = 0;
+	int result                                                  = 0;
+
+	/* Initialize test
+	 */
+	result = libvshadow_block_descriptor_arena_initialize(
+	          &block_descriptor_arena,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "block_descriptor_arena",
+	 block_descriptor_arena );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvshadow_block_descriptor_arena_get_number_of_block_descriptors(
+	          block_descriptor_arena,
+	          &number_of_block_descriptors,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "number_of_block_descriptors",
+	 number_of_block_descriptors,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvshadow_block_descriptor_arena_get_number_of_block_descriptors(
+	          NULL,
+	          &number_of_block_descriptors,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_block_descriptor_arena_get_number_of_block_descriptors(
+	          block_descriptor_arena,
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvshadow_block_descriptor_arena_free(
+	          &block_descriptor_arena,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "block_descriptor_arena",
+	 block_descriptor_arena );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( block_descriptor_arena != NULL )
+	{
+		libvshadow_block_descriptor_arena_free(
+		 &block_descriptor_arena,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc VSHADOW_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] VSHADOW_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc VSHADOW_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] VSHADOW_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	VSHADOW_TEST_UNREFERENCED_PARAMETER( argc )
+	VSHADOW_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT )
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_block_descriptor_arena_initialize",
+	 vshadow_test_block_descriptor_arena_initialize );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_block_descriptor_arena_free",
+	 vshadow_test_block_descriptor_arena_free );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_block_descriptor_arena_allocate",
+	 vshadow_test_block_descriptor_arena_allocate );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_block_descriptor_arena_clone",
+	 vshadow_test_block_descriptor_arena_clone );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_block_descriptor_arena_get_number_of_block_descriptors",
+	 vshadow_test_block_descriptor_arena_get_number_of_block_descriptors );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
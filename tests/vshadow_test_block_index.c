@@ -0,0 +1,1435 @@
+/*
+ * Library block_index type test program
+ *
+ * Copyright (C) 2011-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "vshadow_test_libcerror.h"
+#include "vshadow_test_libvshadow.h"
+#include "vshadow_test_macros.h"
+#include "vshadow_test_memory.h"
+#include "vshadow_test_unused.h"
+
+#include "../libvshadow/libvshadow_block_descriptor.h"
+#include "../libvshadow/libvshadow_block_index.h"
+#include "../libvshadow/libvshadow_definitions.h"
+
+#if defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT )
+
+/* Tests the libvshadow_block_index_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_block_index_initialize(
+     void )
+{
+	libcerror_error_t *error            = NULL;
+	libvshadow_block_index_t *block_index = NULL;
+	int result                          = 0;
+
+#if defined( HAVE_VSHADOW_TEST_MEMORY )
+	int number_of_malloc_fail_tests     = 1;
+	int number_of_memset_fail_tests     = 1;
+	int test_number                     = 0;
+#endif
+
+	/* Test block_index initialization
+	 */
+	result = libvshadow_block_index_initialize(
+	          &block_index,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "block_index",
+	 block_index );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_block_index_free(
+	          &block_index,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "block_index",
+	 block_index );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvshadow_block_index_initialize(
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	block_index = (libvshadow_block_index_t *) 0x12345678UL;
+
+	result = libvshadow_block_index_initialize(
+	          &block_index,
+	          &error );
+
+	block_index = NULL;
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_VSHADOW_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvshadow_block_index_initialize with malloc failing
+		 */
+		vshadow_test_malloc_attempts_before_fail = test_number;
+
+		result = libvshadow_block_index_initialize(
+		          &block_index,
+		          &error );
+
+		if( vshadow_test_malloc_attempts_before_fail != -1 )
+		{
+			vshadow_test_malloc_attempts_before_fail = -1;
+
+			if( block_index != NULL )
+			{
+				libvshadow_block_index_free(
+				 &block_index,
+				 NULL );
+			}
+		}
+		else
+		{
+			VSHADOW_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VSHADOW_TEST_ASSERT_IS_NULL(
+			 "block_index",
+			 block_index );
+
+			VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvshadow_block_index_initialize with memset failing
+		 */
+		vshadow_test_memset_attempts_before_fail = test_number;
+
+		result = libvshadow_block_index_initialize(
+		          &block_index,
+		          &error );
+
+		if( vshadow_test_memset_attempts_before_fail != -1 )
+		{
+			vshadow_test_memset_attempts_before_fail = -1;
+
+			if( block_index != NULL )
+			{
+				libvshadow_block_index_free(
+				 &block_index,
+				 NULL );
+			}
+		}
+		else
+		{
+			VSHADOW_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VSHADOW_TEST_ASSERT_IS_NULL(
+			 "block_index",
+			 block_index );
+
+			VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_VSHADOW_TEST_MEMORY ) */
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( block_index != NULL )
+	{
+		libvshadow_block_index_free(
+		 &block_index,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_block_index_free function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_block_index_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libvshadow_block_index_free(
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_block_index_set_forward_block_descriptors function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_block_index_set_forward_block_descriptors(
+     void )
+{
+	libvshadow_block_descriptor_t block_descriptors[ 3 ];
+	libvshadow_block_descriptor_t block_descriptor;
+	libvshadow_block_descriptor_t overlay_block_descriptor;
+
+	libvshadow_block_descriptor_t *block_descriptors_array[ 3 ];
+
+	libcerror_error_t *error              = NULL;
+	libvshadow_block_index_t *block_index = NULL;
+	int block_descriptor_index            = 0;
+	int entry_index                       = 0;
+	int result                            = 0;
+
+	/* Initialize test
+	 */
+	for( block_descriptor_index = 0;
+	     block_descriptor_index < 3;
+	     block_descriptor_index++ )
+	{
+		block_descriptors[ block_descriptor_index ].original_offset = (off64_t) block_descriptor_index * 0x8000;
+		block_descriptors[ block_descriptor_index ].offset          = 0x37e2cc000 + ( (off64_t) block_descriptor_index * 0x4000 );
+		block_descriptors[ block_descriptor_index ].relative_offset = 0;
+		block_descriptors[ block_descriptor_index ].flags           = 0;
+		block_descriptors[ block_descriptor_index ].bitmap          = 0;
+		block_descriptors[ block_descriptor_index ].index           = -1;
+		block_descriptors[ block_descriptor_index ].reverse_index   = -1;
+		block_descriptors[ block_descriptor_index ].overlay         = NULL;
+
+		block_descriptors_array[ block_descriptor_index ] = &( block_descriptors[ block_descriptor_index ] );
+	}
+	overlay_block_descriptor.original_offset = 0x8000;
+	overlay_block_descriptor.offset          = 0x382404000;
+	overlay_block_descriptor.relative_offset = 1;
+	overlay_block_descriptor.flags           = LIBVSHADOW_BLOCK_FLAG_IS_OVERLAY;
+	overlay_block_descriptor.bitmap          = 0x0000ffffUL;
+	overlay_block_descriptor.index           = -1;
+	overlay_block_descriptor.reverse_index   = -1;
+	overlay_block_descriptor.overlay         = NULL;
+
+	block_descriptors[ 1 ].overlay = &overlay_block_descriptor;
+
+	/* A block descriptor with a bitmap cannot be packed
+	 */
+	block_descriptors[ 2 ].bitmap = 0x000000ffUL;
+
+	result = libvshadow_block_index_initialize(
+	          &block_index,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "block_index",
+	 block_index );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvshadow_block_index_set_forward_block_descriptors(
+	          block_index,
+	          block_descriptors_array,
+	          3,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "block_index->number_of_blocks",
+	 block_index->number_of_blocks,
+	 3 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "block_index->block_numbers",
+	 block_index->block_numbers );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "block_index->number_of_extended_block_descriptors",
+	 block_index->number_of_extended_block_descriptors,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "block_index->number_of_overlay_block_descriptors",
+	 block_index->number_of_overlay_block_descriptors,
+	 1 );
+
+	/* Test retrieving the index of the first block that ends after an offset
+	 */
+	result = libvshadow_block_index_get_index_by_offset(
+	          block_index,
+	          0,
+	          &entry_index,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "entry_index",
+	 entry_index,
+	 0 );
+
+	result = libvshadow_block_index_get_index_by_offset(
+	          block_index,
+	          0x3fff,
+	          &entry_index,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "entry_index",
+	 entry_index,
+	 0 );
+
+	result = libvshadow_block_index_get_index_by_offset(
+	          block_index,
+	          0x4000,
+	          &entry_index,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "entry_index",
+	 entry_index,
+	 1 );
+
+	result = libvshadow_block_index_get_index_by_offset(
+	          block_index,
+	          0x9000,
+	          &entry_index,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "entry_index",
+	 entry_index,
+	 1 );
+
+	result = libvshadow_block_index_get_index_by_offset(
+	          block_index,
+	          0x10000,
+	          &entry_index,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "entry_index",
+	 entry_index,
+	 2 );
+
+	result = libvshadow_block_index_get_index_by_offset(
+	          block_index,
+	          0x14000,
+	          &entry_index,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "entry_index",
+	 entry_index,
+	 3 );
+
+	result = libvshadow_block_index_get_block_descriptor_by_index(
+	          block_index,
+	          1,
+	          &block_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT64(
+	 "block_descriptor.original_offset",
+	 (int64_t) block_descriptor.original_offset,
+	 (int64_t) 0x8000 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT64(
+	 "block_descriptor.offset",
+	 (int64_t) block_descriptor.offset,
+	 (int64_t) 0x37e2d0000 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "block_descriptor.index",
+	 block_descriptor.index,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "block_descriptor.overlay",
+	 block_descriptor.overlay );
+
+	VSHADOW_TEST_ASSERT_NOT_EQUAL_INT64(
+	 "block_descriptor.overlay",
+	 (int64_t) (intptr_t) block_descriptor.overlay,
+	 (int64_t) (intptr_t) &overlay_block_descriptor );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT64(
+	 "block_descriptor.overlay->offset",
+	 (int64_t) block_descriptor.overlay->offset,
+	 (int64_t) 0x382404000 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT32(
+	 "block_descriptor.overlay->bitmap",
+	 block_descriptor.overlay->bitmap,
+	 (uint32_t) 0x0000ffffUL );
+
+	result = libvshadow_block_index_get_block_descriptor_by_index(
+	          block_index,
+	          2,
+	          &block_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT64(
+	 "block_descriptor.offset",
+	 (int64_t) block_descriptor.offset,
+	 (int64_t) 0x37e2d4000 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT32(
+	 "block_descriptor.bitmap",
+	 block_descriptor.bitmap,
+	 (uint32_t) 0x000000ffUL );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "block_descriptor.overlay",
+	 block_descriptor.overlay );
+
+	/* Test error cases
+	 */
+	result = libvshadow_block_index_set_forward_block_descriptors(
+	          block_index,
+	          block_descriptors_array,
+	          3,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_block_index_set_forward_block_descriptors(
+	          NULL,
+	          block_descriptors_array,
+	          3,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_block_index_get_block_descriptor_by_index(
+	          block_index,
+	          3,
+	          &block_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_block_index_get_index_by_offset(
+	          NULL,
+	          0,
+	          &entry_index,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_block_index_get_index_by_offset(
+	          block_index,
+	          0,
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvshadow_block_index_free(
+	          &block_index,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "block_index",
+	 block_index );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test unsorted block descriptors
+	 */
+	result = libvshadow_block_index_initialize(
+	          &block_index,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "block_index",
+	 block_index );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	block_descriptors_array[ 0 ] = &( block_descriptors[ 2 ] );
+	block_descriptors_array[ 2 ] = &( block_descriptors[ 0 ] );
+
+	result = libvshadow_block_index_set_forward_block_descriptors(
+	          block_index,
+	          block_descriptors_array,
+	          3,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvshadow_block_index_free(
+	          &block_index,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "block_index",
+	 block_index );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( block_index != NULL )
+	{
+		libvshadow_block_index_free(
+		 &block_index,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_block_index_set_reverse_block_descriptors function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_block_index_set_reverse_block_descriptors(
+     void )
+{
+	libvshadow_block_descriptor_t block_descriptors[ 2 ];
+	libvshadow_block_descriptor_t block_descriptor;
+
+	libvshadow_block_descriptor_t *block_descriptors_array[ 2 ];
+
+	libcerror_error_t *error              = NULL;
+	libvshadow_block_index_t *block_index = NULL;
+	off64_t relative_offset               = 0;
+	int entry_index                       = 0;
+	int result                            = 0;
+
+	/* Initialize test
+	 */
+	block_descriptors[ 0 ].original_offset = 0x10000;
+	block_descriptors[ 0 ].relative_offset = 0x4000;
+	block_descriptors[ 0 ].flags           = LIBVSHADOW_BLOCK_FLAG_IS_FORWARDER;
+	block_descriptors[ 0 ].overlay         = NULL;
+	block_descriptors[ 1 ].original_offset = 0;
+	block_descriptors[ 1 ].relative_offset = 0xc000;
+	block_descriptors[ 1 ].flags           = LIBVSHADOW_BLOCK_FLAG_IS_FORWARDER;
+	block_descriptors[ 1 ].overlay         = NULL;
+
+	block_descriptors_array[ 0 ] = &( block_descriptors[ 0 ] );
+	block_descriptors_array[ 1 ] = &( block_descriptors[ 1 ] );
+
+	result = libvshadow_block_index_initialize(
+	          &block_index,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "block_index",
+	 block_index );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test an empty block index
+	 */
+	result = libvshadow_block_index_get_index_by_offset(
+	          block_index,
+	          0x4000,
+	          &entry_index,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "entry_index",
+	 entry_index,
+	 0 );
+
+	/* Test regular cases
+	 */
+	result = libvshadow_block_index_set_reverse_block_descriptors(
+	          block_index,
+	          block_descriptors_array,
+	          2,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "block_index->number_of_blocks",
+	 block_index->number_of_blocks,
+	 2 );
+
+	result = libvshadow_block_index_get_index_by_offset(
+	          block_index,
+	          0,
+	          &entry_index,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "entry_index",
+	 entry_index,
+	 0 );
+
+	result = libvshadow_block_index_get_index_by_offset(
+	          block_index,
+	          0x8000,
+	          &entry_index,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "entry_index",
+	 entry_index,
+	 1 );
+
+	result = libvshadow_block_index_get_index_by_offset(
+	          block_index,
+	          0x10000,
+	          &entry_index,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "entry_index",
+	 entry_index,
+	 2 );
+
+	result = libvshadow_block_index_get_offset_by_index(
+	          block_index,
+	          1,
+	          &relative_offset,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT64(
+	 "relative_offset",
+	 (int64_t) relative_offset,
+	 (int64_t) 0xc000 );
+
+	/* The reverse block index does not contain block descriptors
+	 */
+	result = libvshadow_block_index_get_block_descriptor_by_index(
+	          block_index,
+	          0,
+	          &block_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test error cases
+	 */
+	result = libvshadow_block_index_set_reverse_block_descriptors(
+	          block_index,
+	          block_descriptors_array,
+	          2,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_block_index_set_reverse_block_descriptors(
+	          NULL,
+	          block_descriptors_array,
+	          2,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvshadow_block_index_free(
+	          &block_index,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "block_index",
+	 block_index );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test block descriptors with an unaligned relative offset
+	 */
+	block_descriptors[ 1 ].relative_offset = 0xc200;
+
+	result = libvshadow_block_index_initialize(
+	          &block_index,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "block_index",
+	 block_index );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_block_index_set_reverse_block_descriptors(
+	          block_index,
+	          block_descriptors_array,
+	          2,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "block_index->block_numbers",
+	 block_index->block_numbers );
+
+	result = libvshadow_block_index_get_index_by_offset(
+	          block_index,
+	          0x10000,
+	          &entry_index,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "entry_index",
+	 entry_index,
+	 1 );
+
+	result = libvshadow_block_index_get_index_by_offset(
+	          block_index,
+	          0x10200,
+	          &entry_index,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "entry_index",
+	 entry_index,
+	 2 );
+
+	result = libvshadow_block_index_get_offset_by_index(
+	          block_index,
+	          1,
+	          &relative_offset,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT64(
+	 "relative_offset",
+	 (int64_t) relative_offset,
+	 (int64_t) 0xc200 );
+
+	/* Clean up
+	 */
+	result = libvshadow_block_index_free(
+	          &block_index,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "block_index",
+	 block_index );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( block_index != NULL )
+	{
+		libvshadow_block_index_free(
+		 &block_index,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_block_index_append_block_descriptor function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_block_index_append_block_descriptor(
+     void )
+{
+	libvshadow_block_descriptor_t block_descriptors[ 3 ];
+	libvshadow_block_descriptor_t block_descriptor;
+	libvshadow_block_descriptor_t overlay_block_descriptor;
+
+	libcerror_error_t *error              = NULL;
+	libvshadow_block_index_t *block_index = NULL;
+	size64_t memory_size                  = 0;
+	int block_descriptor_index            = 0;
+	int result                            = 0;
+
+	/* Initialize test
+	 */
+	for( block_descriptor_index = 0;
+	     block_descriptor_index < 3;
+	     block_descriptor_index++ )
+	{
+		block_descriptors[ block_descriptor_index ].original_offset = 0x10000 - ( (off64_t) block_descriptor_index * 0x8000 );
+		block_descriptors[ block_descriptor_index ].offset          = 0x37e2cc000 + ( (off64_t) block_descriptor_index * 0x4000 );
+		block_descriptors[ block_descriptor_index ].relative_offset = 0x37e2cc000 + ( (off64_t) block_descriptor_index * 0x4000 );
+		block_descriptors[ block_descriptor_index ].flags           = 0;
+		block_descriptors[ block_descriptor_index ].bitmap          = 0;
+		block_descriptors[ block_descriptor_index ].index           = -1;
+		block_descriptors[ block_descriptor_index ].reverse_index   = -1;
+		block_descriptors[ block_descriptor_index ].overlay         = NULL;
+	}
+	overlay_block_descriptor.original_offset = 0x8000;
+	overlay_block_descriptor.offset          = 0x382404000;
+	overlay_block_descriptor.relative_offset = 1;
+	overlay_block_descriptor.flags           = LIBVSHADOW_BLOCK_FLAG_IS_OVERLAY;
+	overlay_block_descriptor.bitmap          = 0x0000ffffUL;
+	overlay_block_descriptor.index           = -1;
+	overlay_block_descriptor.reverse_index   = -1;
+	overlay_block_descriptor.overlay         = NULL;
+
+	/* The overlay block descriptor is not stored
+	 */
+	block_descriptors[ 0 ].overlay = &overlay_block_descriptor;
+
+	/* A block descriptor with a bitmap cannot be packed
+	 */
+	block_descriptors[ 1 ].bitmap = 0x000000ffUL;
+
+	result = libvshadow_block_index_initialize(
+	          &block_index,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "block_index",
+	 block_index );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	for( block_descriptor_index = 0;
+	     block_descriptor_index < 3;
+	     block_descriptor_index++ )
+	{
+		result = libvshadow_block_index_append_block_descriptor(
+		          block_index,
+		          &( block_descriptors[ block_descriptor_index ] ),
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "block_index->number_of_blocks",
+	 block_index->number_of_blocks,
+	 3 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "block_index->block_numbers",
+	 block_index->block_numbers );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "block_index->number_of_extended_block_descriptors",
+	 block_index->number_of_extended_block_descriptors,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "block_index->number_of_overlay_block_descriptors",
+	 block_index->number_of_overlay_block_descriptors,
+	 0 );
+
+	/* Test retrieving the block descriptors in the order they were appended
+	 */
+	for( block_descriptor_index = 0;
+	     block_descriptor_index < 3;
+	     block_descriptor_index++ )
+	{
+		result = libvshadow_block_index_get_block_descriptor_by_index(
+		          block_index,
+		          block_descriptor_index,
+		          &block_descriptor,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT64(
+		 "block_descriptor.original_offset",
+		 (int64_t) block_descriptor.original_offset,
+		 (int64_t) block_descriptors[ block_descriptor_index ].original_offset );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT64(
+		 "block_descriptor.offset",
+		 (int64_t) block_descriptor.offset,
+		 (int64_t) block_descriptors[ block_descriptor_index ].offset );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT64(
+		 "block_descriptor.relative_offset",
+		 (int64_t) block_descriptor.relative_offset,
+		 (int64_t) block_descriptors[ block_descriptor_index ].relative_offset );
+
+		VSHADOW_TEST_ASSERT_EQUAL_UINT32(
+		 "block_descriptor.bitmap",
+		 block_descriptor.bitmap,
+		 block_descriptors[ block_descriptor_index ].bitmap );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "block_descriptor.overlay",
+		 block_descriptor.overlay );
+	}
+	result = libvshadow_block_index_get_memory_size(
+	          block_index,
+	          &memory_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "memory_size",
+	 (uint64_t) memory_size,
+	 (uint64_t) ( sizeof( libvshadow_block_index_t ) + ( block_index->number_of_allocated_blocks * sizeof( libvshadow_packed_block_descriptor_t ) ) + ( block_index->number_of_allocated_extended_block_descriptors * sizeof( libvshadow_block_descriptor_t ) ) ) );
+
+	/* Test error cases
+	 */
+	result = libvshadow_block_index_append_block_descriptor(
+	          NULL,
+	          &( block_descriptors[ 0 ] ),
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_block_index_append_block_descriptor(
+	          block_index,
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvshadow_block_index_free(
+	          &block_index,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "block_index",
+	 block_index );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( block_index != NULL )
+	{
+		libvshadow_block_index_free(
+		 &block_index,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc VSHADOW_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] VSHADOW_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc VSHADOW_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] VSHADOW_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	VSHADOW_TEST_UNREFERENCED_PARAMETER( argc )
+	VSHADOW_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT )
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_block_index_initialize",
+	 vshadow_test_block_index_initialize );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_block_index_free",
+	 vshadow_test_block_index_free );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_block_index_set_forward_block_descriptors",
+	 vshadow_test_block_index_set_forward_block_descriptors );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_block_index_set_reverse_block_descriptors",
+	 vshadow_test_block_index_set_reverse_block_descriptors );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_block_index_append_block_descriptor",
+	 vshadow_test_block_index_append_block_descriptor );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
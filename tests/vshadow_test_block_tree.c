@@ -35,6 +35,7 @@
 #include "vshadow_test_unused.h"
 
 #include "../libvshadow/libvshadow_block_descriptor.h"
+#include "../libvshadow/libvshadow_block_descriptor_arena.h"
 #include "../libvshadow/libvshadow_block_tree.h"
 #include "../libvshadow/libvshadow_definitions.h"
 
@@ -46,11 +47,12 @@
 int vshadow_test_block_tree_insert(
      void )
 {
-	libcdata_btree_t *forward_block_tree            = NULL;
-	libcdata_btree_t *reverse_block_tree            = NULL;
-	libcerror_error_t *error                        = NULL;
-	libvshadow_block_descriptor_t *block_descriptor = NULL;
-	int result                                      = 0;
+	libcdata_btree_t *forward_block_tree                        = NULL;
+	libcdata_btree_t *reverse_block_tree                        = NULL;
+	libcerror_error_t *error                                    = NULL;
+	libvshadow_block_descriptor_arena_t *block_descriptor_arena = NULL;
+	libvshadow_block_descriptor_t *block_descriptor             = NULL;
+	int result                                                  = 0;
 
 	/* Initialize test
 	 */
@@ -90,6 +92,23 @@ int vshadow_test_block_tree_insert(
 	 "error",
 	 error );
 
+	result = libvshadow_block_descriptor_arena_initialize(
+	          &block_descriptor_arena,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "block_descriptor_arena",
+	 block_descriptor_arena );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
 	result = libvshadow_block_descriptor_initialize(
 	          &block_descriptor,
 	          &error );
@@ -118,6 +137,7 @@ int vshadow_test_block_tree_insert(
 	result = libvshadow_block_tree_insert(
 	          forward_block_tree,
 	          reverse_block_tree,
+	          block_descriptor_arena,
 	          block_descriptor,
 	          0,
 	          &error );
@@ -142,6 +162,7 @@ int vshadow_test_block_tree_insert(
 	result = libvshadow_block_tree_insert(
 	          forward_block_tree,
 	          reverse_block_tree,
+	          block_descriptor_arena,
 	          block_descriptor,
 	          0,
 	          &error );
@@ -166,6 +187,7 @@ int vshadow_test_block_tree_insert(
 	result = libvshadow_block_tree_insert(
 	          forward_block_tree,
 	          reverse_block_tree,
+	          block_descriptor_arena,
 	          block_descriptor,
 	          0,
 	          &error );
@@ -190,6 +212,7 @@ int vshadow_test_block_tree_insert(
 	result = libvshadow_block_tree_insert(
 	          forward_block_tree,
 	          reverse_block_tree,
+	          block_descriptor_arena,
 	          block_descriptor,
 	          0,
 	          &error );
@@ -214,6 +237,7 @@ int vshadow_test_block_tree_insert(
 	result = libvshadow_block_tree_insert(
 	          forward_block_tree,
 	          reverse_block_tree,
+	          block_descriptor_arena,
 	          block_descriptor,
 	          0,
 	          &error );
@@ -238,6 +262,7 @@ int vshadow_test_block_tree_insert(
 	result = libvshadow_block_tree_insert(
 	          forward_block_tree,
 	          reverse_block_tree,
+	          block_descriptor_arena,
 	          block_descriptor,
 	          0,
 	          &error );
@@ -262,6 +287,7 @@ int vshadow_test_block_tree_insert(
 	result = libvshadow_block_tree_insert(
 	          forward_block_tree,
 	          reverse_block_tree,
+	          block_descriptor_arena,
 	          block_descriptor,
 	          0,
 	          &error );
@@ -286,6 +312,7 @@ int vshadow_test_block_tree_insert(
 	result = libvshadow_block_tree_insert(
 	          forward_block_tree,
 	          reverse_block_tree,
+	          block_descriptor_arena,
 	          block_descriptor,
 	          0,
 	          &error );
@@ -310,6 +337,7 @@ int vshadow_test_block_tree_insert(
 	result = libvshadow_block_tree_insert(
 	          forward_block_tree,
 	          reverse_block_tree,
+	          block_descriptor_arena,
 	          block_descriptor,
 	          0,
 	          &error );
@@ -334,6 +362,7 @@ int vshadow_test_block_tree_insert(
 	result = libvshadow_block_tree_insert(
 	          forward_block_tree,
 	          reverse_block_tree,
+	          block_descriptor_arena,
 	          block_descriptor,
 	          0,
 	          &error );
@@ -358,6 +387,7 @@ int vshadow_test_block_tree_insert(
 	result = libvshadow_block_tree_insert(
 	          forward_block_tree,
 	          reverse_block_tree,
+	          block_descriptor_arena,
 	          block_descriptor,
 	          0,
 	          &error );
@@ -382,6 +412,7 @@ int vshadow_test_block_tree_insert(
 	result = libvshadow_block_tree_insert(
 	          forward_block_tree,
 	          reverse_block_tree,
+	          block_descriptor_arena,
 	          block_descriptor,
 	          0,
 	          &error );
@@ -406,6 +437,7 @@ int vshadow_test_block_tree_insert(
 	result = libvshadow_block_tree_insert(
 	          forward_block_tree,
 	          reverse_block_tree,
+	          block_descriptor_arena,
 	          block_descriptor,
 	          0,
 	          &error );
@@ -430,6 +462,7 @@ int vshadow_test_block_tree_insert(
 	result = libvshadow_block_tree_insert(
 	          forward_block_tree,
 	          reverse_block_tree,
+	          block_descriptor_arena,
 	          block_descriptor,
 	          0,
 	          &error );
@@ -450,6 +483,7 @@ int vshadow_test_block_tree_insert(
 	result = libvshadow_block_tree_insert(
 	          NULL,
 	          reverse_block_tree,
+	          block_descriptor_arena,
 	          block_descriptor,
 	          0,
 	          &error );
@@ -469,6 +503,7 @@ int vshadow_test_block_tree_insert(
 	result = libvshadow_block_tree_insert(
 	          forward_block_tree,
 	          NULL,
+	          block_descriptor_arena,
 	          block_descriptor,
 	          0,
 	          &error );
@@ -489,6 +524,27 @@ int vshadow_test_block_tree_insert(
 	          forward_block_tree,
 	          reverse_block_tree,
 	          NULL,
+	          block_descriptor,
+	          0,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_block_tree_insert(
+	          forward_block_tree,
+	          reverse_block_tree,
+	          block_descriptor_arena,
+	          NULL,
 	          0,
 	          &error );
 
@@ -506,13 +562,14 @@ int vshadow_test_block_tree_insert(
 
 #if defined( HAVE_VSHADOW_TEST_MEMORY )
 
-	/* Test libvshadow_block_tree_insert with libvshadow_block_descriptor_clone failing
+	/* Test libvshadow_block_tree_insert with libvshadow_block_descriptor_arena_clone failing
 	 */
 	vshadow_test_malloc_attempts_before_fail = 0;
 
 	result = libvshadow_block_tree_insert(
 	          forward_block_tree,
 	          reverse_block_tree,
+	          block_descriptor_arena,
 	          block_descriptor,
 	          0,
 	          &error );
@@ -552,12 +609,10 @@ int vshadow_test_block_tree_insert(
  */
 
 /* TODO test insert of block descriptor: is forwarder flag, points to itself
- * with libvshadow_block_descriptor_free failing
  */
 
 /* TODO test insert of block descriptor
  * with existing_block_descriptor == NULL
- * with is overlay and libvshadow_block_descriptor_free failing
  * with libcdata_btree_replace_value failing
  */
 
@@ -584,7 +639,7 @@ int vshadow_test_block_tree_insert(
 
 	result = libcdata_btree_free(
 	          &reverse_block_tree,
-	          (int (*)(intptr_t **, libcerror_error_t **)) &libvshadow_block_descriptor_free_reverse,
+	          NULL,
 	          &error );
 
 	VSHADOW_TEST_ASSERT_EQUAL_INT(
@@ -602,7 +657,7 @@ int vshadow_test_block_tree_insert(
 
 	result = libcdata_btree_free(
 	          &forward_block_tree,
-	          (int (*)(intptr_t **, libcerror_error_t **)) &libvshadow_block_descriptor_free,
+	          NULL,
 	          &error );
 
 	VSHADOW_TEST_ASSERT_EQUAL_INT(
@@ -618,6 +673,23 @@ int vshadow_test_block_tree_insert(
 	 "error",
 	 error );
 
+	result = libvshadow_block_descriptor_arena_free(
+	          &block_descriptor_arena,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "block_descriptor_arena",
+	 block_descriptor_arena );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
 	return( 1 );
 
 on_error:
@@ -636,14 +708,20 @@ on_error:
 	{
 		libcdata_btree_free(
 		 &reverse_block_tree,
-		 (int (*)(intptr_t **, libcerror_error_t **)) &libvshadow_block_descriptor_free_reverse,
+		 NULL,
 		 NULL );
 	}
 	if( forward_block_tree != NULL )
 	{
 		libcdata_btree_free(
 		 &forward_block_tree,
-		 (int (*)(intptr_t **, libcerror_error_t **)) &libvshadow_block_descriptor_free,
+		 NULL,
+		 NULL );
+	}
+	if( block_descriptor_arena != NULL )
+	{
+		libvshadow_block_descriptor_arena_free(
+		 &block_descriptor_arena,
 		 NULL );
 	}
 	return( 0 );
@@ -0,0 +1,853 @@
+/*
+ * Library extent_map type test program
+ *
+ * Copyright (C) 2011-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "vshadow_test_libcerror.h"
+#include "vshadow_test_libvshadow.h"
+#include "vshadow_test_macros.h"
+#include "vshadow_test_memory.h"
+#include "vshadow_test_unused.h"
+
+#include "../libvshadow/libvshadow_definitions.h"
+#include "../libvshadow/libvshadow_extent_map.h"
+
+#if defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT )
+
+/* Tests the libvshadow_extent_map_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_extent_map_initialize(
+     void )
+{
+	libcerror_error_t *error            = NULL;
+	libvshadow_extent_map_t *extent_map = NULL;
+	int result                          = 0;
+
+#if defined( HAVE_VSHADOW_TEST_MEMORY )
+	int number_of_malloc_fail_tests     = 1;
+	int number_of_memset_fail_tests     = 1;
+	int test_number                     = 0;
+#endif
+
+	/* Test extent_map initialization
+	 */
+	result = libvshadow_extent_map_initialize(
+	          &extent_map,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "extent_map",
+	 extent_map );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_extent_map_free(
+	          &extent_map,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "extent_map",
+	 extent_map );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvshadow_extent_map_initialize(
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	extent_map = (libvshadow_extent_map_t *) 0x12345678UL;
+
+	result = libvshadow_extent_map_initialize(
+	          &extent_map,
+	          &error );
+
+	extent_map = NULL;
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_VSHADOW_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvshadow_extent_map_initialize with malloc failing
+		 */
+		vshadow_test_malloc_attempts_before_fail = test_number;
+
+		result = libvshadow_extent_map_initialize(
+		          &extent_map,
+		          &error );
+
+		if( vshadow_test_malloc_attempts_before_fail != -1 )
+		{
+			vshadow_test_malloc_attempts_before_fail = -1;
+
+			if( extent_map != NULL )
+			{
+				libvshadow_extent_map_free(
+				 &extent_map,
+				 NULL );
+			}
+		}
+		else
+		{
+			VSHADOW_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VSHADOW_TEST_ASSERT_IS_NULL(
+			 "extent_map",
+			 extent_map );
+
+			VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvshadow_extent_map_initialize with memset failing
+		 */
+		vshadow_test_memset_attempts_before_fail = test_number;
+
+		result = libvshadow_extent_map_initialize(
+		          &extent_map,
+		          &error );
+
+		if( vshadow_test_memset_attempts_before_fail != -1 )
+		{
+			vshadow_test_memset_attempts_before_fail = -1;
+
+			if( extent_map != NULL )
+			{
+				libvshadow_extent_map_free(
+				 &extent_map,
+				 NULL );
+			}
+		}
+		else
+		{
+			VSHADOW_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VSHADOW_TEST_ASSERT_IS_NULL(
+			 "extent_map",
+			 extent_map );
+
+			VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_VSHADOW_TEST_MEMORY ) */
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( extent_map != NULL )
+	{
+		libvshadow_extent_map_free(
+		 &extent_map,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_extent_map_free function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_extent_map_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libvshadow_extent_map_free(
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_extent_map_append_extent function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_extent_map_append_extent(
+     void )
+{
+	libcerror_error_t *error            = NULL;
+	libvshadow_extent_map_t *extent_map = NULL;
+	int number_of_extents               = 0;
+	int result                          = 0;
+
+	/* Initialize test
+	 */
+	result = libvshadow_extent_map_initialize(
+	          &extent_map,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "extent_map",
+	 extent_map );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvshadow_extent_map_append_extent(
+	          extent_map,
+	          0x4000,
+	          0x00000000,
+	          LIBVSHADOW_EXTENT_TYPE_VOLUME_DATA,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test append of contiguous volume data, which is merged
+	 */
+	result = libvshadow_extent_map_append_extent(
+	          extent_map,
+	          0x4000,
+	          0x00004000,
+	          LIBVSHADOW_EXTENT_TYPE_VOLUME_DATA,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test append of store data
+	 */
+	result = libvshadow_extent_map_append_extent(
+	          extent_map,
+	          0x0200,
+	          0x37e2cc000,
+	          LIBVSHADOW_EXTENT_TYPE_STORE_DATA,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test append of non-contiguous store data, which is not merged
+	 */
+	result = libvshadow_extent_map_append_extent(
+	          extent_map,
+	          0x3e00,
+	          0x382404000,
+	          LIBVSHADOW_EXTENT_TYPE_STORE_DATA,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test append of sparse data, which is merged regardless of the data offset
+	 */
+	result = libvshadow_extent_map_append_extent(
+	          extent_map,
+	          0x4000,
+	          0x00010000,
+	          LIBVSHADOW_EXTENT_TYPE_SPARSE,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_extent_map_append_extent(
+	          extent_map,
+	          0x4000,
+	          0x00020000,
+	          LIBVSHADOW_EXTENT_TYPE_SPARSE,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_extent_map_get_number_of_extents(
+	          extent_map,
+	          &number_of_extents,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "number_of_extents",
+	 number_of_extents,
+	 4 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "extent_map->size",
+	 (uint64_t) extent_map->size,
+	 (uint64_t) 0x14000 );
+
+	/* Test error cases
+	 */
+	result = libvshadow_extent_map_append_extent(
+	          NULL,
+	          0x4000,
+	          0x00000000,
+	          LIBVSHADOW_EXTENT_TYPE_VOLUME_DATA,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_extent_map_append_extent(
+	          extent_map,
+	          0,
+	          0x00000000,
+	          LIBVSHADOW_EXTENT_TYPE_VOLUME_DATA,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_extent_map_append_extent(
+	          extent_map,
+	          0x4000,
+	          -1,
+	          LIBVSHADOW_EXTENT_TYPE_VOLUME_DATA,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_extent_map_append_extent(
+	          extent_map,
+	          0x4000,
+	          0x00000000,
+	          0xff,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvshadow_extent_map_free(
+	          &extent_map,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "extent_map",
+	 extent_map );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( extent_map != NULL )
+	{
+		libvshadow_extent_map_free(
+		 &extent_map,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_extent_map_get_extent_by_index and libvshadow_extent_map_get_extent_index_at_offset functions
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_extent_map_get_extent(
+     void )
+{
+	libcerror_error_t *error            = NULL;
+	libvshadow_extent_map_t *extent_map = NULL;
+	libvshadow_extent_t *extent         = NULL;
+	int extent_index                    = 0;
+	int result                          = 0;
+
+	/* Initialize test
+	 */
+	result = libvshadow_extent_map_initialize(
+	          &extent_map,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "extent_map",
+	 extent_map );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_extent_map_append_extent(
+	          extent_map,
+	          0x8000,
+	          0x00000000,
+	          LIBVSHADOW_EXTENT_TYPE_VOLUME_DATA,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_extent_map_append_extent(
+	          extent_map,
+	          0x4000,
+	          0x37e2cc000,
+	          LIBVSHADOW_EXTENT_TYPE_STORE_DATA,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_extent_map_append_extent(
+	          extent_map,
+	          0x4000,
+	          0x00000000,
+	          LIBVSHADOW_EXTENT_TYPE_SPARSE,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvshadow_extent_map_get_extent_index_at_offset(
+	          extent_map,
+	          0x9000,
+	          &extent_index,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "extent_index",
+	 extent_index,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_extent_map_get_extent_by_index(
+	          extent_map,
+	          extent_index,
+	          &extent,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "extent",
+	 extent );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT64(
+	 "extent->offset",
+	 (int64_t) extent->offset,
+	 (int64_t) 0x8000 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT64(
+	 "extent->data_offset",
+	 (int64_t) extent->data_offset,
+	 (int64_t) 0x37e2cc000 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT8(
+	 "extent->type",
+	 extent->type,
+	 LIBVSHADOW_EXTENT_TYPE_STORE_DATA );
+
+	result = libvshadow_extent_map_get_extent_index_at_offset(
+	          extent_map,
+	          0xfffe,
+	          &extent_index,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "extent_index",
+	 extent_index,
+	 2 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test offset beyond the extent map
+	 */
+	result = libvshadow_extent_map_get_extent_index_at_offset(
+	          extent_map,
+	          0x10000,
+	          &extent_index,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvshadow_extent_map_get_extent_by_index(
+	          extent_map,
+	          3,
+	          &extent,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_extent_map_get_extent_index_at_offset(
+	          NULL,
+	          0,
+	          &extent_index,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_extent_map_get_extent_index_at_offset(
+	          extent_map,
+	          0,
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvshadow_extent_map_free(
+	          &extent_map,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "extent_map",
+	 extent_map );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( extent_map != NULL )
+	{
+		libvshadow_extent_map_free(
+		 &extent_map,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc VSHADOW_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] VSHADOW_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc VSHADOW_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] VSHADOW_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	VSHADOW_TEST_UNREFERENCED_PARAMETER( argc )
+	VSHADOW_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT )
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_extent_map_initialize",
+	 vshadow_test_extent_map_initialize );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_extent_map_free",
+	 vshadow_test_extent_map_free );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_extent_map_append_extent",
+	 vshadow_test_extent_map_append_extent );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_extent_map_get_extent",
+	 vshadow_test_extent_map_get_extent );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
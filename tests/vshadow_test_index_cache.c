@@ -0,0 +1,911 @@
+/*
+ * Library index_cache functions test program
+ *
+ * Copyright (C) 2011-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "vshadow_test_libcerror.h"
+#include "vshadow_test_libvshadow.h"
+#include "vshadow_test_macros.h"
+#include "vshadow_test_memory.h"
+#include "vshadow_test_unused.h"
+
+#include "../libvshadow/libvshadow_bitmap.h"
+#include "../libvshadow/libvshadow_block_descriptor.h"
+#include "../libvshadow/libvshadow_block_index.h"
+#include "../libvshadow/libvshadow_index_cache.h"
+#include "../libvshadow/libvshadow_store_descriptor.h"
+
+uint8_t vshadow_test_index_cache_bitmap_data[ 10 ] = {
+	0xff, 0x0f, 0x00, 0x00, 0x80, 0x01, 0x00, 0x00, 0x00, 0x3c };
+
+#if defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT )
+
+/* Creates a store descriptor with block indexes and bitmaps for testing
+ * Returns 1 if successful or -1 on error
+ */
+int vshadow_test_index_cache_create_store_descriptor(
+     libvshadow_store_descriptor_t **store_descriptor,
+     libcerror_error_t **error )
+{
+	libvshadow_block_descriptor_t *block_descriptors_array[ 3 ];
+	libvshadow_block_descriptor_t block_descriptors[ 4 ];
+
+	int block_descriptor_index = 0;
+
+	if( libvshadow_store_descriptor_initialize(
+	     store_descriptor,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	( *store_descriptor )->identifier[ 0 ]               = 0x12;
+	( *store_descriptor )->identifier[ 15 ]              = 0x34;
+	( *store_descriptor )->creation_time                 = 0x01d3a1b2c3d4e5f6UL;
+	( *store_descriptor )->store_block_list_offset       = 0x00014000;
+	( *store_descriptor )->store_block_range_list_offset = 0x00018000;
+	( *store_descriptor )->store_bitmap_offset           = 0x0001c000;
+
+	if( memory_set(
+	     block_descriptors,
+	     0,
+	     sizeof( libvshadow_block_descriptor_t ) * 4 ) == NULL )
+	{
+		return( -1 );
+	}
+	for( block_descriptor_index = 0;
+	     block_descriptor_index < 3;
+	     block_descriptor_index++ )
+	{
+		block_descriptors[ block_descriptor_index ].original_offset = 0x00100000 + ( block_descriptor_index * 0x4000 );
+		block_descriptors[ block_descriptor_index ].offset          = 0x00200000 + ( block_descriptor_index * 0x4000 );
+		block_descriptors[ block_descriptor_index ].relative_offset = 0x00300000 + ( block_descriptor_index * 0x4000 );
+		block_descriptors[ block_descriptor_index ].flags           = (uint32_t) block_descriptor_index;
+
+		block_descriptors_array[ block_descriptor_index ] = &( block_descriptors[ block_descriptor_index ] );
+	}
+	block_descriptors[ 3 ].original_offset = 0x00104000;
+	block_descriptors[ 3 ].offset          = 0x00400000;
+	block_descriptors[ 3 ].relative_offset = 0x00104000;
+	block_descriptors[ 3 ].flags           = 0x00000002UL;
+	block_descriptors[ 3 ].bitmap          = 0x0000ffffUL;
+
+	block_descriptors[ 1 ].overlay = &( block_descriptors[ 3 ] );
+
+	if( libvshadow_block_index_initialize(
+	     &( ( *store_descriptor )->forward_block_index ),
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	if( libvshadow_block_index_set_forward_block_descriptors(
+	     ( *store_descriptor )->forward_block_index,
+	     block_descriptors_array,
+	     3,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	if( libvshadow_block_index_initialize(
+	     &( ( *store_descriptor )->reverse_block_index ),
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	if( libvshadow_block_index_set_reverse_block_descriptors(
+	     ( *store_descriptor )->reverse_block_index,
+	     block_descriptors_array,
+	     2,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	if( libvshadow_bitmap_append_data(
+	     ( *store_descriptor )->bitmap,
+	     vshadow_test_index_cache_bitmap_data,
+	     10,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	for( block_descriptor_index = 0;
+	     block_descriptor_index < 4;
+	     block_descriptor_index++ )
+	{
+		if( libvshadow_store_descriptor_append_block_descriptor(
+		     *store_descriptor,
+		     &( block_descriptors[ block_descriptor_index ] ),
+		     error ) != 1 )
+		{
+			return( -1 );
+		}
+	}
+	( *store_descriptor )->block_descriptors_read = 1;
+
+	return( 1 );
+}
+
+/* Tests the libvshadow_index_cache_get_store_data_size function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_index_cache_get_store_data_size(
+     void )
+{
+	libcerror_error_t *error                        = NULL;
+	libvshadow_store_descriptor_t *store_descriptor = NULL;
+	size_t data_size                                = 0;
+	int result                                      = 0;
+
+	/* Initialize test
+	 */
+	result = libvshadow_store_descriptor_initialize(
+	          &store_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error case where the block descriptors have not been read
+	 */
+	result = libvshadow_index_cache_get_store_data_size(
+	          store_descriptor,
+	          &data_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test regular cases
+	 */
+	store_descriptor->block_descriptors_read = 1;
+
+	result = libvshadow_index_cache_get_store_data_size(
+	          store_descriptor,
+	          &data_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SIZE(
+	 "data_size",
+	 data_size,
+	 (size_t) 80 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_store_descriptor_free(
+	          &store_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vshadow_test_index_cache_create_store_descriptor(
+	          &store_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_index_cache_get_store_data_size(
+	          store_descriptor,
+	          &data_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SIZE(
+	 "data_size",
+	 data_size,
+	 (size_t) 376 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvshadow_index_cache_get_store_data_size(
+	          NULL,
+	          &data_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_index_cache_get_store_data_size(
+	          store_descriptor,
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvshadow_store_descriptor_free(
+	          &store_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( store_descriptor != NULL )
+	{
+		libvshadow_store_descriptor_free(
+		 &store_descriptor,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_index_cache_write_store_data, libvshadow_index_cache_check_store_data
+ * and libvshadow_index_cache_read_store_data functions
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_index_cache_store_data(
+     void )
+{
+	uint8_t data[ 376 ];
+
+	libvshadow_block_descriptor_t block_descriptor;
+
+	libcerror_error_t *error                         = NULL;
+	libvshadow_store_descriptor_t *cached_descriptor = NULL;
+	libvshadow_store_descriptor_t *store_descriptor  = NULL;
+	size_t store_data_size                           = 0;
+	off64_t relative_offset                          = 0;
+	int result                                       = 0;
+
+	/* Initialize test
+	 */
+	result = vshadow_test_index_cache_create_store_descriptor(
+	          &store_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_store_descriptor_initialize(
+	          &cached_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	cached_descriptor->identifier[ 0 ]               = store_descriptor->identifier[ 0 ];
+	cached_descriptor->identifier[ 15 ]              = store_descriptor->identifier[ 15 ];
+	cached_descriptor->creation_time                 = store_descriptor->creation_time;
+	cached_descriptor->store_block_list_offset       = store_descriptor->store_block_list_offset;
+	cached_descriptor->store_block_range_list_offset = store_descriptor->store_block_range_list_offset;
+	cached_descriptor->store_bitmap_offset           = store_descriptor->store_bitmap_offset;
+
+	/* Test write
+	 */
+	result = libvshadow_index_cache_write_store_data(
+	          store_descriptor,
+	          data,
+	          376,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test check
+	 */
+	result = libvshadow_index_cache_check_store_data(
+	          cached_descriptor,
+	          data,
+	          376,
+	          &store_data_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SIZE(
+	 "store_data_size",
+	 store_data_size,
+	 (size_t) 376 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test check with a store that does not match
+	 */
+	cached_descriptor->creation_time += 1;
+
+	result = libvshadow_index_cache_check_store_data(
+	          cached_descriptor,
+	          data,
+	          376,
+	          &store_data_size,
+	          &error );
+
+	cached_descriptor->creation_time -= 1;
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test read
+	 */
+	result = libvshadow_index_cache_read_store_data(
+	          cached_descriptor,
+	          data,
+	          376,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT8(
+	 "cached_descriptor->block_descriptors_read",
+	 cached_descriptor->block_descriptors_read,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "cached_descriptor->forward_block_index",
+	 cached_descriptor->forward_block_index );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "cached_descriptor->forward_block_index->number_of_blocks",
+	 cached_descriptor->forward_block_index->number_of_blocks,
+	 3 );
+
+	result = libvshadow_block_index_get_block_descriptor_by_index(
+	          cached_descriptor->forward_block_index,
+	          2,
+	          &block_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT64(
+	 "block_descriptor.offset",
+	 (int64_t) block_descriptor.offset,
+	 (int64_t) 0x00208000 );
+
+	result = libvshadow_block_index_get_block_descriptor_by_index(
+	          cached_descriptor->forward_block_index,
+	          0,
+	          &block_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "block_descriptor.overlay",
+	 block_descriptor.overlay );
+
+	result = libvshadow_block_index_get_block_descriptor_by_index(
+	          cached_descriptor->forward_block_index,
+	          1,
+	          &block_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "block_descriptor.overlay",
+	 block_descriptor.overlay );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT32(
+	 "block_descriptor.overlay->bitmap",
+	 block_descriptor.overlay->bitmap,
+	 (uint32_t) 0x0000ffffUL );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "cached_descriptor->reverse_block_index",
+	 cached_descriptor->reverse_block_index );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "cached_descriptor->reverse_block_index->number_of_blocks",
+	 cached_descriptor->reverse_block_index->number_of_blocks,
+	 2 );
+
+	result = libvshadow_block_index_get_offset_by_index(
+	          cached_descriptor->reverse_block_index,
+	          1,
+	          &relative_offset,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT64(
+	 "relative_offset",
+	 (int64_t) relative_offset,
+	 (int64_t) 0x00304000 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "cached_descriptor->block_list_index->number_of_blocks",
+	 cached_descriptor->block_list_index->number_of_blocks,
+	 4 );
+
+	result = libvshadow_block_index_get_block_descriptor_by_index(
+	          cached_descriptor->block_list_index,
+	          3,
+	          &block_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT32(
+	 "block_descriptor.bitmap",
+	 block_descriptor.bitmap,
+	 (uint32_t) 0x0000ffffUL );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SIZE(
+	 "cached_descriptor->bitmap->data_size",
+	 cached_descriptor->bitmap->data_size,
+	 (size_t) 10 );
+
+	result = memory_compare(
+	          cached_descriptor->bitmap->data,
+	          vshadow_test_index_cache_bitmap_data,
+	          10 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SIZE(
+	 "cached_descriptor->previous_bitmap->data_size",
+	 cached_descriptor->previous_bitmap->data_size,
+	 (size_t) 0 );
+
+	/* Test error cases
+	 */
+	result = libvshadow_index_cache_write_store_data(
+	          store_descriptor,
+	          data,
+	          200,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_index_cache_check_store_data(
+	          cached_descriptor,
+	          data,
+	          200,
+	          &store_data_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_index_cache_check_store_data(
+	          NULL,
+	          data,
+	          376,
+	          &store_data_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_index_cache_check_store_data(
+	          cached_descriptor,
+	          NULL,
+	          376,
+	          &store_data_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test error case where an overlay block descriptor refers to a non-existing block
+	 */
+	data[ 80 + ( 3 * 32 ) ] = 0x03;
+
+	result = libvshadow_index_cache_read_store_data(
+	          store_descriptor,
+	          data,
+	          376,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test where an overlay block descriptor does not match the original offset of its forward block descriptor
+	 */
+	data[ 80 + ( 3 * 32 ) ]     = 0x01;
+	data[ 80 + ( 3 * 32 ) + 9 ] = 0x80;
+
+	result = libvshadow_index_cache_check_store_data(
+	          cached_descriptor,
+	          data,
+	          376,
+	          &store_data_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Clean up
+	 */
+	result = libvshadow_store_descriptor_free(
+	          &cached_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_store_descriptor_free(
+	          &store_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( cached_descriptor != NULL )
+	{
+		libvshadow_store_descriptor_free(
+		 &cached_descriptor,
+		 NULL );
+	}
+	if( store_descriptor != NULL )
+	{
+		libvshadow_store_descriptor_free(
+		 &store_descriptor,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_index_cache_read_file_io_handle function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_index_cache_read_file_io_handle(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libvshadow_index_cache_read_file_io_handle(
+	          NULL,
+	          0,
+	          0,
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_index_cache_write_file_io_handle function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_index_cache_write_file_io_handle(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libvshadow_index_cache_write_file_io_handle(
+	          NULL,
+	          0,
+	          0,
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc VSHADOW_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] VSHADOW_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc VSHADOW_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] VSHADOW_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	VSHADOW_TEST_UNREFERENCED_PARAMETER( argc )
+	VSHADOW_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT )
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_index_cache_get_store_data_size",
+	 vshadow_test_index_cache_get_store_data_size );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_index_cache_store_data",
+	 vshadow_test_index_cache_store_data );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_index_cache_write_file_io_handle",
+	 vshadow_test_index_cache_write_file_io_handle );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_index_cache_read_file_io_handle",
+	 vshadow_test_index_cache_read_file_io_handle );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,853 @@
+/*
+ * Library metadata_reader type test program
+ *
+ * Copyright (C) 2011-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "vshadow_test_libbfio.h"
+#include "vshadow_test_libcerror.h"
+#include "vshadow_test_libvshadow.h"
+#include "vshadow_test_macros.h"
+#include "vshadow_test_memory.h"
+#include "vshadow_test_unused.h"
+
+#include "../libvshadow/libvshadow_definitions.h"
+#include "../libvshadow/libvshadow_metadata_reader.h"
+
+#if defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT )
+
+/* Tests the libvshadow_metadata_reader_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_metadata_reader_initialize(
+     void )
+{
+	libcerror_error_t *error                      = NULL;
+	libvshadow_metadata_reader_t *metadata_reader = NULL;
+	int result                                    = 0;
+
+#if defined( HAVE_VSHADOW_TEST_MEMORY )
+	int number_of_malloc_fail_tests               = 4;
+	int number_of_memset_fail_tests               = 2;
+	int test_number                               = 0;
+#endif
+
+	/* Test metadata_reader initialization
+	 */
+	result = libvshadow_metadata_reader_initialize(
+	          &metadata_reader,
+	          0x4000,
+	          LIBVSHADOW_METADATA_READER_MAXIMUM_NUMBER_OF_BLOCKS,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "metadata_reader",
+	 metadata_reader );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_metadata_reader_free(
+	          &metadata_reader,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "metadata_reader",
+	 metadata_reader );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvshadow_metadata_reader_initialize(
+	          NULL,
+	          0x4000,
+	          LIBVSHADOW_METADATA_READER_MAXIMUM_NUMBER_OF_BLOCKS,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	metadata_reader = (libvshadow_metadata_reader_t *) 0x12345678UL;
+
+	result = libvshadow_metadata_reader_initialize(
+	          &metadata_reader,
+	          0x4000,
+	          LIBVSHADOW_METADATA_READER_MAXIMUM_NUMBER_OF_BLOCKS,
+	          &error );
+
+	metadata_reader = NULL;
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_metadata_reader_initialize(
+	          &metadata_reader,
+	          0,
+	          LIBVSHADOW_METADATA_READER_MAXIMUM_NUMBER_OF_BLOCKS,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_metadata_reader_initialize(
+	          &metadata_reader,
+	          0x4000,
+	          0,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_VSHADOW_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvshadow_metadata_reader_initialize with malloc failing
+		 */
+		vshadow_test_malloc_attempts_before_fail = test_number;
+
+		result = libvshadow_metadata_reader_initialize(
+		          &metadata_reader,
+		          0x4000,
+		          LIBVSHADOW_METADATA_READER_MAXIMUM_NUMBER_OF_BLOCKS,
+		          &error );
+
+		if( vshadow_test_malloc_attempts_before_fail != -1 )
+		{
+			vshadow_test_malloc_attempts_before_fail = -1;
+
+			if( metadata_reader != NULL )
+			{
+				libvshadow_metadata_reader_free(
+				 &metadata_reader,
+				 NULL );
+			}
+		}
+		else
+		{
+			VSHADOW_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VSHADOW_TEST_ASSERT_IS_NULL(
+			 "metadata_reader",
+			 metadata_reader );
+
+			VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvshadow_metadata_reader_initialize with memset failing
+		 */
+		vshadow_test_memset_attempts_before_fail = test_number;
+
+		result = libvshadow_metadata_reader_initialize(
+		          &metadata_reader,
+		          0x4000,
+		          LIBVSHADOW_METADATA_READER_MAXIMUM_NUMBER_OF_BLOCKS,
+		          &error );
+
+		if( vshadow_test_memset_attempts_before_fail != -1 )
+		{
+			vshadow_test_memset_attempts_before_fail = -1;
+
+			if( metadata_reader != NULL )
+			{
+				libvshadow_metadata_reader_free(
+				 &metadata_reader,
+				 NULL );
+			}
+		}
+		else
+		{
+			VSHADOW_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VSHADOW_TEST_ASSERT_IS_NULL(
+			 "metadata_reader",
+			 metadata_reader );
+
+			VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_VSHADOW_TEST_MEMORY ) */
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( metadata_reader != NULL )
+	{
+		libvshadow_metadata_reader_free(
+		 &metadata_reader,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_metadata_reader_free function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_metadata_reader_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libvshadow_metadata_reader_free(
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_metadata_reader_read_block_data function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_metadata_reader_read_block_data(
+     void )
+{
+	libbfio_handle_t *file_io_handle              = NULL;
+	libcerror_error_t *error                      = NULL;
+	libvshadow_metadata_reader_t *metadata_reader = NULL;
+	const uint8_t *block_data                     = NULL;
+	uint8_t *data                                 = NULL;
+	size_t data_index                             = 0;
+	int result                                    = 0;
+
+	/* Initialize test
+	 */
+	data = (uint8_t *) malloc(
+	                    0x20000 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "data",
+	 data );
+
+	for( data_index = 0;
+	     data_index < 0x20000;
+	     data_index++ )
+	{
+		data[ data_index ] = (uint8_t) ( data_index / 0x1000 );
+	}
+	result = libbfio_memory_range_initialize(
+	          &file_io_handle,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_memory_range_set(
+	          file_io_handle,
+	          data,
+	          0x20000,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_handle_open(
+	          file_io_handle,
+	          LIBBFIO_OPEN_READ,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_metadata_reader_initialize(
+	          &metadata_reader,
+	          0x1000,
+	          4,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "metadata_reader",
+	 metadata_reader );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases - initial read of 2 blocks
+	 */
+	result = libvshadow_metadata_reader_read_block_data(
+	          metadata_reader,
+	          file_io_handle,
+	          (off64_t) 0x00000,
+	          &block_data,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "block_data",
+	 block_data );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT8(
+	 "block_data[ 0 ]",
+	 block_data[ 0 ],
+	 (uint8_t) ( 0x00000 / 0x1000 ) );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "metadata_reader->number_of_reads",
+	 metadata_reader->number_of_reads,
+	 (uint64_t) 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SIZE(
+	 "metadata_reader->buffer_size",
+	 metadata_reader->buffer_size,
+	 (size_t) 0x2000 );
+
+	/* Test regular cases - block in buffer
+	 */
+	result = libvshadow_metadata_reader_read_block_data(
+	          metadata_reader,
+	          file_io_handle,
+	          (off64_t) 0x01000,
+	          &block_data,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "block_data",
+	 block_data );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT8(
+	 "block_data[ 0 ]",
+	 block_data[ 0 ],
+	 (uint8_t) ( 0x01000 / 0x1000 ) );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "metadata_reader->number_of_reads",
+	 metadata_reader->number_of_reads,
+	 (uint64_t) 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SIZE(
+	 "metadata_reader->buffer_size",
+	 metadata_reader->buffer_size,
+	 (size_t) 0x2000 );
+
+	/* Test regular cases - adjacent block doubles the number of blocks
+	 */
+	result = libvshadow_metadata_reader_read_block_data(
+	          metadata_reader,
+	          file_io_handle,
+	          (off64_t) 0x02000,
+	          &block_data,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "block_data",
+	 block_data );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT8(
+	 "block_data[ 0 ]",
+	 block_data[ 0 ],
+	 (uint8_t) ( 0x02000 / 0x1000 ) );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "metadata_reader->number_of_reads",
+	 metadata_reader->number_of_reads,
+	 (uint64_t) 2 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SIZE(
+	 "metadata_reader->buffer_size",
+	 metadata_reader->buffer_size,
+	 (size_t) 0x4000 );
+
+	/* Test regular cases - block in buffer
+	 */
+	result = libvshadow_metadata_reader_read_block_data(
+	          metadata_reader,
+	          file_io_handle,
+	          (off64_t) 0x05000,
+	          &block_data,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "block_data",
+	 block_data );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT8(
+	 "block_data[ 0 ]",
+	 block_data[ 0 ],
+	 (uint8_t) ( 0x05000 / 0x1000 ) );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "metadata_reader->number_of_reads",
+	 metadata_reader->number_of_reads,
+	 (uint64_t) 2 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SIZE(
+	 "metadata_reader->buffer_size",
+	 metadata_reader->buffer_size,
+	 (size_t) 0x4000 );
+
+	/* Test regular cases - adjacent block, number of blocks is at maximum
+	 */
+	result = libvshadow_metadata_reader_read_block_data(
+	          metadata_reader,
+	          file_io_handle,
+	          (off64_t) 0x06000,
+	          &block_data,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "block_data",
+	 block_data );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT8(
+	 "block_data[ 0 ]",
+	 block_data[ 0 ],
+	 (uint8_t) ( 0x06000 / 0x1000 ) );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "metadata_reader->number_of_reads",
+	 metadata_reader->number_of_reads,
+	 (uint64_t) 3 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SIZE(
+	 "metadata_reader->buffer_size",
+	 metadata_reader->buffer_size,
+	 (size_t) 0x4000 );
+
+	/* Test regular cases - non-adjacent block resets the number of blocks
+	 */
+	result = libvshadow_metadata_reader_read_block_data(
+	          metadata_reader,
+	          file_io_handle,
+	          (off64_t) 0x10000,
+	          &block_data,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "block_data",
+	 block_data );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT8(
+	 "block_data[ 0 ]",
+	 block_data[ 0 ],
+	 (uint8_t) ( 0x10000 / 0x1000 ) );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "metadata_reader->number_of_reads",
+	 metadata_reader->number_of_reads,
+	 (uint64_t) 4 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SIZE(
+	 "metadata_reader->buffer_size",
+	 metadata_reader->buffer_size,
+	 (size_t) 0x2000 );
+
+	/* Test regular cases - last block, read ahead is beyond the end of the data
+	 */
+	result = libvshadow_metadata_reader_read_block_data(
+	          metadata_reader,
+	          file_io_handle,
+	          (off64_t) 0x1f000,
+	          &block_data,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "block_data",
+	 block_data );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT8(
+	 "block_data[ 0 ]",
+	 block_data[ 0 ],
+	 (uint8_t) ( 0x1f000 / 0x1000 ) );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "metadata_reader->number_of_reads",
+	 metadata_reader->number_of_reads,
+	 (uint64_t) 5 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SIZE(
+	 "metadata_reader->buffer_size",
+	 metadata_reader->buffer_size,
+	 (size_t) 0x1000 );
+
+	/* Test error cases
+	 */
+	result = libvshadow_metadata_reader_read_block_data(
+	          NULL,
+	          file_io_handle,
+	          0,
+	          &block_data,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_metadata_reader_read_block_data(
+	          metadata_reader,
+	          file_io_handle,
+	          0,
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_metadata_reader_read_block_data(
+	          metadata_reader,
+	          file_io_handle,
+	          (off64_t) 0x20000,
+	          &block_data,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvshadow_metadata_reader_free(
+	          &metadata_reader,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "metadata_reader",
+	 metadata_reader );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_handle_close(
+	          file_io_handle,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_handle_free(
+	          &file_io_handle,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	free(
+	 data );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( metadata_reader != NULL )
+	{
+		libvshadow_metadata_reader_free(
+		 &metadata_reader,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( data != NULL )
+	{
+		free(
+		 data );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc VSHADOW_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] VSHADOW_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc VSHADOW_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] VSHADOW_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	VSHADOW_TEST_UNREFERENCED_PARAMETER( argc )
+	VSHADOW_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT )
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_metadata_reader_initialize",
+	 vshadow_test_metadata_reader_initialize );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_metadata_reader_free",
+	 vshadow_test_metadata_reader_free );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_metadata_reader_read_block_data",
+	 vshadow_test_metadata_reader_read_block_data );
+
+	/* TODO: add tests for libvshadow_metadata_reader_read_store_block */
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,1148 @@
+/*
+ * Library read_list type test program
+ *
+ * Copyright (C) 2011-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "vshadow_test_libbfio.h"
+#include "vshadow_test_libcerror.h"
+#include "vshadow_test_libvshadow.h"
+#include "vshadow_test_macros.h"
+#include "vshadow_test_memory.h"
+#include "vshadow_test_unused.h"
+
+#include "../libvshadow/libvshadow_definitions.h"
+#include "../libvshadow/libvshadow_extent_map.h"
+#include "../libvshadow/libvshadow_read_list.h"
+
+#if defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT )
+
+/* Tests the libvshadow_read_list_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_read_list_initialize(
+     void )
+{
+	libcerror_error_t *error          = NULL;
+	libvshadow_read_list_t *read_list = NULL;
+	int result                        = 0;
+
+#if defined( HAVE_VSHADOW_TEST_MEMORY )
+	int number_of_malloc_fail_tests   = 1;
+	int number_of_memset_fail_tests   = 1;
+	int test_number                   = 0;
+#endif
+
+	/* Test read_list initialization
+	 */
+	result = libvshadow_read_list_initialize(
+	          &read_list,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "read_list",
+	 read_list );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_read_list_free(
+	          &read_list,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "read_list",
+	 read_list );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvshadow_read_list_initialize(
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_list = (libvshadow_read_list_t *) 0x12345678UL;
+
+	result = libvshadow_read_list_initialize(
+	          &read_list,
+	          &error );
+
+	read_list = NULL;
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_VSHADOW_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvshadow_read_list_initialize with malloc failing
+		 */
+		vshadow_test_malloc_attempts_before_fail = test_number;
+
+		result = libvshadow_read_list_initialize(
+		          &read_list,
+		          &error );
+
+		if( vshadow_test_malloc_attempts_before_fail != -1 )
+		{
+			vshadow_test_malloc_attempts_before_fail = -1;
+
+			if( read_list != NULL )
+			{
+				libvshadow_read_list_free(
+				 &read_list,
+				 NULL );
+			}
+		}
+		else
+		{
+			VSHADOW_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VSHADOW_TEST_ASSERT_IS_NULL(
+			 "read_list",
+			 read_list );
+
+			VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvshadow_read_list_initialize with memset failing
+		 */
+		vshadow_test_memset_attempts_before_fail = test_number;
+
+		result = libvshadow_read_list_initialize(
+		          &read_list,
+		          &error );
+
+		if( vshadow_test_memset_attempts_before_fail != -1 )
+		{
+			vshadow_test_memset_attempts_before_fail = -1;
+
+			if( read_list != NULL )
+			{
+				libvshadow_read_list_free(
+				 &read_list,
+				 NULL );
+			}
+		}
+		else
+		{
+			VSHADOW_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VSHADOW_TEST_ASSERT_IS_NULL(
+			 "read_list",
+			 read_list );
+
+			VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_VSHADOW_TEST_MEMORY ) */
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( read_list != NULL )
+	{
+		libvshadow_read_list_free(
+		 &read_list,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_read_list_free function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_read_list_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libvshadow_read_list_free(
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_read_list_append_segment function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_read_list_append_segment(
+     void )
+{
+	uint8_t buffer[ 0x400 ];
+
+	libcerror_error_t *error          = NULL;
+	libvshadow_read_list_t *read_list = NULL;
+	int result                        = 0;
+
+	/* Initialize test
+	 */
+	result = libvshadow_read_list_initialize(
+	          &read_list,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "read_list",
+	 read_list );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvshadow_read_list_append_segment(
+	          read_list,
+	          0,
+	          0x1000,
+	          0x100,
+	          buffer,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The segment is contiguous with the previous segment both in the volume and in the buffer
+	 */
+	result = libvshadow_read_list_append_segment(
+	          read_list,
+	          0,
+	          0x1100,
+	          0x100,
+	          &( buffer[ 0x100 ] ),
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "read_list->number_of_segments",
+	 read_list->number_of_segments,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SIZE(
+	 "read_list->segments[ 0 ].size",
+	 read_list->segments[ 0 ].size,
+	 (size_t) 0x200 );
+
+	/* The segment is not contiguous with the previous segment in the volume
+	 */
+	result = libvshadow_read_list_append_segment(
+	          read_list,
+	          0,
+	          0x4000,
+	          0x100,
+	          &( buffer[ 0x200 ] ),
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "read_list->number_of_segments",
+	 read_list->number_of_segments,
+	 2 );
+
+	/* The segment is contiguous with the previous segment but the previous segment
+	 * is stored before the first segment index
+	 */
+	result = libvshadow_read_list_append_segment(
+	          read_list,
+	          2,
+	          0x4100,
+	          0x100,
+	          &( buffer[ 0x300 ] ),
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "read_list->number_of_segments",
+	 read_list->number_of_segments,
+	 3 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SIZE(
+	 "read_list->segments[ 1 ].size",
+	 read_list->segments[ 1 ].size,
+	 (size_t) 0x100 );
+
+	/* Test error cases
+	 */
+	result = libvshadow_read_list_append_segment(
+	          NULL,
+	          0,
+	          0x1000,
+	          0x100,
+	          buffer,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_read_list_append_segment(
+	          read_list,
+	          -1,
+	          0x1000,
+	          0x100,
+	          buffer,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_read_list_append_segment(
+	          read_list,
+	          0,
+	          -1,
+	          0x100,
+	          buffer,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_read_list_append_segment(
+	          read_list,
+	          0,
+	          0x1000,
+	          0x100,
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvshadow_read_list_free(
+	          &read_list,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "read_list",
+	 read_list );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( read_list != NULL )
+	{
+		libvshadow_read_list_free(
+		 &read_list,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_read_list_append_range function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_read_list_append_range(
+     void )
+{
+	uint8_t buffer[ 0x3000 ];
+
+	libcerror_error_t *error            = NULL;
+	libvshadow_extent_map_t *extent_map = NULL;
+	libvshadow_read_list_t *read_list   = NULL;
+	size_t buffer_index                 = 0;
+	int result                          = 0;
+
+	/* Initialize test
+	 */
+	result = libvshadow_extent_map_initialize(
+	          &extent_map,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_extent_map_append_extent(
+	          extent_map,
+	          0x1000,
+	          0x8000,
+	          LIBVSHADOW_EXTENT_TYPE_STORE_DATA,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libvshadow_extent_map_append_extent(
+	          extent_map,
+	          0x1000,
+	          0,
+	          LIBVSHADOW_EXTENT_TYPE_SPARSE,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_read_list_initialize(
+	          &read_list,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_set(
+	          buffer,
+	          0xff,
+	          0x3000 ) == NULL;
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test regular cases
+	 * The data beyond the extent map is read from the volume at the same offset
+	 */
+	result = libvshadow_read_list_append_range(
+	          read_list,
+	          0,
+	          extent_map,
+	          buffer,
+	          0x3000,
+	          0x0800,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "read_list->number_of_segments",
+	 read_list->number_of_segments,
+	 2 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT64(
+	 "read_list->segments[ 0 ].data_offset",
+	 (int64_t) read_list->segments[ 0 ].data_offset,
+	 (int64_t) 0x8800 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SIZE(
+	 "read_list->segments[ 0 ].size",
+	 read_list->segments[ 0 ].size,
+	 (size_t) 0x0800 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT64(
+	 "read_list->segments[ 1 ].data_offset",
+	 (int64_t) read_list->segments[ 1 ].data_offset,
+	 (int64_t) 0x2000 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SIZE(
+	 "read_list->segments[ 1 ].size",
+	 read_list->segments[ 1 ].size,
+	 (size_t) 0x1800 );
+
+	for( buffer_index = 0x0800;
+	     buffer_index < 0x1800;
+	     buffer_index++ )
+	{
+		VSHADOW_TEST_ASSERT_EQUAL_UINT8(
+		 "buffer[ buffer_index ]",
+		 buffer[ buffer_index ],
+		 (uint8_t) 0 );
+	}
+	/* Test error cases
+	 */
+	result = libvshadow_read_list_append_range(
+	          NULL,
+	          0,
+	          extent_map,
+	          buffer,
+	          0x3000,
+	          0,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_read_list_append_range(
+	          read_list,
+	          0,
+	          NULL,
+	          buffer,
+	          0x3000,
+	          0,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_read_list_append_range(
+	          read_list,
+	          0,
+	          extent_map,
+	          buffer,
+	          0x3000,
+	          -1,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvshadow_read_list_free(
+	          &read_list,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_extent_map_free(
+	          &extent_map,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( read_list != NULL )
+	{
+		libvshadow_read_list_free(
+		 &read_list,
+		 NULL );
+	}
+	if( extent_map != NULL )
+	{
+		libvshadow_extent_map_free(
+		 &extent_map,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_read_list_read function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_read_list_read(
+     void )
+{
+	uint8_t buffer1[ 0x2000 ];
+	uint8_t buffer2[ 0x1000 ];
+	uint8_t buffer3[ 0x1000 ];
+	uint8_t buffer4[ 0x0800 ];
+	uint8_t buffer5[ 0x0800 ];
+
+	libbfio_handle_t *file_io_handle  = NULL;
+	libcerror_error_t *error          = NULL;
+	libvshadow_read_list_t *read_list = NULL;
+	uint8_t *data                     = NULL;
+	size_t data_index                 = 0;
+	int result                        = 0;
+
+	/* Initialize test
+	 */
+	data = (uint8_t *) malloc(
+	                    0x10000 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "data",
+	 data );
+
+	for( data_index = 0;
+	     data_index < 0x10000;
+	     data_index++ )
+	{
+		data[ data_index ] = (uint8_t) ( data_index % 251 );
+	}
+	result = libbfio_memory_range_initialize(
+	          &file_io_handle,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_memory_range_set(
+	          file_io_handle,
+	          data,
+	          0x10000,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_handle_open(
+	          file_io_handle,
+	          LIBBFIO_OPEN_READ,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_read_list_initialize(
+	          &read_list,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The segments of buffer 1, 2 and 3 overlap or are adjacent and the segment
+	 * of buffer 5 is contained in the segment of buffer 4
+	 */
+	result = libvshadow_read_list_append_segment(
+	          read_list,
+	          0,
+	          0x8000,
+	          0x0800,
+	          buffer4,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libvshadow_read_list_append_segment(
+	          read_list,
+	          0,
+	          0x3000,
+	          0x1000,
+	          buffer3,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libvshadow_read_list_append_segment(
+	          read_list,
+	          0,
+	          0x1800,
+	          0x1000,
+	          buffer2,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libvshadow_read_list_append_segment(
+	          read_list,
+	          0,
+	          0x1000,
+	          0x2000,
+	          buffer1,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libvshadow_read_list_append_segment(
+	          read_list,
+	          0,
+	          0x8000,
+	          0x0800,
+	          buffer5,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvshadow_read_list_read(
+	          read_list,
+	          file_io_handle,
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          buffer1,
+	          &( data[ 0x1000 ] ),
+	          0x2000 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = memory_compare(
+	          buffer2,
+	          &( data[ 0x1800 ] ),
+	          0x1000 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = memory_compare(
+	          buffer3,
+	          &( data[ 0x3000 ] ),
+	          0x1000 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = memory_compare(
+	          buffer4,
+	          &( data[ 0x8000 ] ),
+	          0x0800 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = memory_compare(
+	          buffer5,
+	          &( data[ 0x8000 ] ),
+	          0x0800 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libvshadow_read_list_read(
+	          NULL,
+	          file_io_handle,
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvshadow_read_list_free(
+	          &read_list,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_handle_close(
+	          file_io_handle,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_handle_free(
+	          &file_io_handle,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	free(
+	 data );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( read_list != NULL )
+	{
+		libvshadow_read_list_free(
+		 &read_list,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( data != NULL )
+	{
+		free(
+		 data );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc VSHADOW_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] VSHADOW_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc VSHADOW_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] VSHADOW_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	VSHADOW_TEST_UNREFERENCED_PARAMETER( argc )
+	VSHADOW_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT )
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_read_list_initialize",
+	 vshadow_test_read_list_initialize );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_read_list_free",
+	 vshadow_test_read_list_free );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_read_list_append_segment",
+	 vshadow_test_read_list_append_segment );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_read_list_append_range",
+	 vshadow_test_read_list_append_range );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_read_list_read",
+	 vshadow_test_read_list_read );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -383,7 +383,9 @@ int main(
 	/* TODO add tests for libvshadow_internal_store_read_buffer_from_file_io_handle */
 	/* TODO add tests for libvshadow_store_read_buffer */
 	/* TODO add tests for libvshadow_store_read_buffer_from_file_io_handle */
+	/* TODO add tests for libvshadow_store_read_buffer_at_offset_from_file_io_handle */
 	/* TODO add tests for libvshadow_store_read_buffer_at_offset */
+	/* TODO add tests for libvshadow_store_read_buffers_at_offsets */
 	/* TODO add tests for libvshadow_internal_store_seek_offset */
 	/* TODO add tests for libvshadow_store_seek_offset */
 	/* TODO add tests for libvshadow_store_get_offset */
@@ -396,6 +398,10 @@ int main(
 	/* TODO add tests for libvshadow_store_get_attribute_flags */
 	/* TODO add tests for libvshadow_store_get_number_of_blocks */
 	/* TODO add tests for libvshadow_store_get_block_by_index */
+	/* TODO add tests for libvshadow_store_get_block_values */
+	/* TODO add tests for libvshadow_store_get_extent_at_offset */
+	/* TODO add tests for libvshadow_store_get_next_data_range */
+	/* TODO add tests for libvshadow_store_get_metadata_size */
 
 #endif /* defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT ) */
 
@@ -21,18 +21,24 @@
 
 #include <common.h>
 #include <file_stream.h>
+#include <memory.h>
 #include <types.h>
 
 #if defined( HAVE_STDLIB_H ) || defined( WINAPI )
 #include <stdlib.h>
 #endif
 
+#include "vshadow_test_libbfio.h"
 #include "vshadow_test_libcerror.h"
 #include "vshadow_test_libvshadow.h"
 #include "vshadow_test_macros.h"
 #include "vshadow_test_memory.h"
 #include "vshadow_test_unused.h"
 
+#include "../libvshadow/libvshadow_bitmap.h"
+#include "../libvshadow/libvshadow_block_descriptor.h"
+#include "../libvshadow/libvshadow_definitions.h"
+#include "../libvshadow/libvshadow_extent_map.h"
 #include "../libvshadow/libvshadow_store_descriptor.h"
 
 #if defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT )
@@ -639,6 +645,2022 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libvshadow_store_descriptor_get_block_values function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_store_descriptor_get_block_values(
+     void )
+{
+	libvshadow_block_descriptor_t block_descriptor;
+
+	libcerror_error_t *error                        = NULL;
+	libvshadow_store_descriptor_t *store_descriptor = NULL;
+	off64_t original_offsets[ 3 ];
+	off64_t relative_offsets[ 3 ];
+	uint32_t bitmaps[ 3 ];
+	int block_index                                 = 0;
+	int result                                      = 0;
+
+	/* Initialize test
+	 */
+	result = libvshadow_store_descriptor_initialize(
+	          &store_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "store_descriptor",
+	 store_descriptor );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_set(
+	 &block_descriptor,
+	 0,
+	 sizeof( libvshadow_block_descriptor_t ) );
+
+	for( block_index = 0;
+	     block_index < 3;
+	     block_index++ )
+	{
+		block_descriptor.original_offset = (off64_t) block_index * 0x4000;
+		block_descriptor.relative_offset = (off64_t) block_index * 0x4000 + 0x100000;
+		block_descriptor.bitmap          = (uint32_t) block_index + 1;
+
+		result = libvshadow_store_descriptor_append_block_descriptor(
+		          store_descriptor,
+		          &block_descriptor,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	store_descriptor->has_in_volume_store_data = 1;
+	store_descriptor->block_descriptors_read   = 1;
+
+	/* Test regular cases
+	 */
+	result = libvshadow_store_descriptor_get_block_values(
+	          store_descriptor,
+	          NULL,
+	          1,
+	          2,
+	          original_offsets,
+	          relative_offsets,
+	          NULL,
+	          NULL,
+	          bitmaps,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT64(
+	 "original_offsets[ 1 ]",
+	 (int64_t) original_offsets[ 1 ],
+	 (int64_t) 0x8000 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT64(
+	 "relative_offsets[ 0 ]",
+	 (int64_t) relative_offsets[ 0 ],
+	 (int64_t) 0x104000 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT32(
+	 "bitmaps[ 1 ]",
+	 bitmaps[ 1 ],
+	 3 );
+
+	/* Test error cases
+	 */
+	result = libvshadow_store_descriptor_get_block_values(
+	          NULL,
+	          NULL,
+	          0,
+	          1,
+	          original_offsets,
+	          NULL,
+	          NULL,
+	          NULL,
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_store_descriptor_get_block_values(
+	          store_descriptor,
+	          NULL,
+	          -1,
+	          1,
+	          original_offsets,
+	          NULL,
+	          NULL,
+	          NULL,
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_store_descriptor_get_block_values(
+	          store_descriptor,
+	          NULL,
+	          2,
+	          2,
+	          original_offsets,
+	          NULL,
+	          NULL,
+	          NULL,
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvshadow_store_descriptor_free(
+	          &store_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "store_descriptor",
+	 store_descriptor );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( store_descriptor != NULL )
+	{
+		libvshadow_store_descriptor_free(
+		 &store_descriptor,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_store_descriptor_get_extent_at_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_store_descriptor_get_extent_at_offset(
+     void )
+{
+	libcerror_error_t *error                        = NULL;
+	libvshadow_store_descriptor_t *store_descriptor = NULL;
+	size64_t extent_size                            = 0;
+	off64_t extent_data_offset                      = 0;
+	uint8_t extent_type                             = 0;
+	int result                                      = 0;
+
+	/* Initialize test
+	 */
+	result = libvshadow_store_descriptor_initialize(
+	          &store_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "store_descriptor",
+	 store_descriptor );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_extent_map_initialize(
+	          &( store_descriptor->extent_map ),
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_extent_map_append_extent(
+	          store_descriptor->extent_map,
+	          0x4000,
+	          0,
+	          LIBVSHADOW_EXTENT_TYPE_VOLUME_DATA,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libvshadow_extent_map_append_extent(
+	          store_descriptor->extent_map,
+	          0x4000,
+	          0x100000,
+	          LIBVSHADOW_EXTENT_TYPE_STORE_DATA,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libvshadow_extent_map_append_extent(
+	          store_descriptor->extent_map,
+	          0x4000,
+	          0x104000,
+	          LIBVSHADOW_EXTENT_TYPE_STORE_DATA,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libvshadow_extent_map_append_extent(
+	          store_descriptor->extent_map,
+	          0x4000,
+	          0,
+	          LIBVSHADOW_EXTENT_TYPE_SPARSE,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	store_descriptor->has_in_volume_store_data = 1;
+	store_descriptor->volume_size              = 0x14000;
+
+	/* Test regular cases
+	 */
+	result = libvshadow_store_descriptor_get_extent_at_offset(
+	          store_descriptor,
+	          NULL,
+	          0x2000,
+	          &extent_size,
+	          &extent_data_offset,
+	          &extent_type,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "extent_size",
+	 extent_size,
+	 (uint64_t) 0x2000 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT64(
+	 "extent_data_offset",
+	 (int64_t) extent_data_offset,
+	 (int64_t) 0x2000 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT8(
+	 "extent_type",
+	 extent_type,
+	 LIBVSHADOW_EXTENT_TYPE_VOLUME_DATA );
+
+	/* The contiguous store data extents are returned as a single extent
+	 */
+	result = libvshadow_store_descriptor_get_extent_at_offset(
+	          store_descriptor,
+	          NULL,
+	          0x5000,
+	          &extent_size,
+	          &extent_data_offset,
+	          &extent_type,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "extent_size",
+	 extent_size,
+	 (uint64_t) 0x7000 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT64(
+	 "extent_data_offset",
+	 (int64_t) extent_data_offset,
+	 (int64_t) 0x101000 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT8(
+	 "extent_type",
+	 extent_type,
+	 LIBVSHADOW_EXTENT_TYPE_STORE_DATA );
+
+	result = libvshadow_store_descriptor_get_extent_at_offset(
+	          store_descriptor,
+	          NULL,
+	          0xc000,
+	          &extent_size,
+	          &extent_data_offset,
+	          &extent_type,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "extent_size",
+	 extent_size,
+	 (uint64_t) 0x4000 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT8(
+	 "extent_type",
+	 extent_type,
+	 LIBVSHADOW_EXTENT_TYPE_SPARSE );
+
+	/* The data beyond the extent map is volume data
+	 */
+	result = libvshadow_store_descriptor_get_extent_at_offset(
+	          store_descriptor,
+	          NULL,
+	          0x12000,
+	          &extent_size,
+	          &extent_data_offset,
+	          &extent_type,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "extent_size",
+	 extent_size,
+	 (uint64_t) 0x2000 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT64(
+	 "extent_data_offset",
+	 (int64_t) extent_data_offset,
+	 (int64_t) 0x12000 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT8(
+	 "extent_type",
+	 extent_type,
+	 LIBVSHADOW_EXTENT_TYPE_VOLUME_DATA );
+
+	result = libvshadow_store_descriptor_get_extent_at_offset(
+	          store_descriptor,
+	          NULL,
+	          0x14000,
+	          &extent_size,
+	          &extent_data_offset,
+	          &extent_type,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvshadow_store_descriptor_get_extent_at_offset(
+	          NULL,
+	          NULL,
+	          0,
+	          &extent_size,
+	          &extent_data_offset,
+	          &extent_type,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_store_descriptor_get_extent_at_offset(
+	          store_descriptor,
+	          NULL,
+	          -1,
+	          &extent_size,
+	          &extent_data_offset,
+	          &extent_type,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_store_descriptor_get_extent_at_offset(
+	          store_descriptor,
+	          NULL,
+	          0,
+	          NULL,
+	          &extent_data_offset,
+	          &extent_type,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvshadow_store_descriptor_free(
+	          &store_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "store_descriptor",
+	 store_descriptor );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( store_descriptor != NULL )
+	{
+		libvshadow_store_descriptor_free(
+		 &store_descriptor,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_store_descriptor_get_next_changed_extent function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_store_descriptor_get_next_changed_extent(
+     void )
+{
+	libcerror_error_t *error                              = NULL;
+	libvshadow_store_descriptor_t *other_store_descriptor = NULL;
+	libvshadow_store_descriptor_t *store_descriptor       = NULL;
+	size64_t extent_size                                  = 0;
+	off64_t extent_offset                                 = 0;
+	int result                                            = 0;
+
+	/* Initialize test
+	 */
+	result = libvshadow_store_descriptor_initialize(
+	          &store_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "store_descriptor",
+	 store_descriptor );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_extent_map_initialize(
+	          &( store_descriptor->extent_map ),
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_extent_map_append_extent(
+	          store_descriptor->extent_map,
+	          0x4000,
+	          0,
+	          LIBVSHADOW_EXTENT_TYPE_VOLUME_DATA,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libvshadow_extent_map_append_extent(
+	          store_descriptor->extent_map,
+	          0x4000,
+	          0x100000,
+	          LIBVSHADOW_EXTENT_TYPE_STORE_DATA,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libvshadow_extent_map_append_extent(
+	          store_descriptor->extent_map,
+	          0x4000,
+	          0x8000,
+	          LIBVSHADOW_EXTENT_TYPE_VOLUME_DATA,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libvshadow_extent_map_append_extent(
+	          store_descriptor->extent_map,
+	          0x4000,
+	          0,
+	          LIBVSHADOW_EXTENT_TYPE_SPARSE,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	store_descriptor->has_in_volume_store_data = 1;
+	store_descriptor->volume_size              = 0x10000;
+
+	result = libvshadow_store_descriptor_initialize(
+	          &other_store_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "other_store_descriptor",
+	 other_store_descriptor );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_extent_map_initialize(
+	          &( other_store_descriptor->extent_map ),
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_extent_map_append_extent(
+	          other_store_descriptor->extent_map,
+	          0x4000,
+	          0,
+	          LIBVSHADOW_EXTENT_TYPE_VOLUME_DATA,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libvshadow_extent_map_append_extent(
+	          other_store_descriptor->extent_map,
+	          0x4000,
+	          0x100000,
+	          LIBVSHADOW_EXTENT_TYPE_STORE_DATA,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libvshadow_extent_map_append_extent(
+	          other_store_descriptor->extent_map,
+	          0x4000,
+	          0x200000,
+	          LIBVSHADOW_EXTENT_TYPE_STORE_DATA,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libvshadow_extent_map_append_extent(
+	          other_store_descriptor->extent_map,
+	          0x4000,
+	          0xc000,
+	          LIBVSHADOW_EXTENT_TYPE_VOLUME_DATA,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	other_store_descriptor->has_in_volume_store_data = 1;
+	other_store_descriptor->volume_size              = 0x10000;
+
+	/* Test regular cases
+	 */
+	result = libvshadow_store_descriptor_get_next_changed_extent(
+	          store_descriptor,
+	          other_store_descriptor,
+	          NULL,
+	          0,
+	          &extent_offset,
+	          &extent_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT64(
+	 "extent_offset",
+	 (int64_t) extent_offset,
+	 (int64_t) 0x8000 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "extent_size",
+	 extent_size,
+	 (uint64_t) 0x8000 );
+
+	result = libvshadow_store_descriptor_get_next_changed_extent(
+	          store_descriptor,
+	          other_store_descriptor,
+	          NULL,
+	          0x10000,
+	          &extent_offset,
+	          &extent_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test comparison with the current volume
+	 */
+	result = libvshadow_store_descriptor_get_next_changed_extent(
+	          store_descriptor,
+	          NULL,
+	          NULL,
+	          0,
+	          &extent_offset,
+	          &extent_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT64(
+	 "extent_offset",
+	 (int64_t) extent_offset,
+	 (int64_t) 0x4000 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "extent_size",
+	 extent_size,
+	 (uint64_t) 0x4000 );
+
+	result = libvshadow_store_descriptor_get_next_changed_extent(
+	          store_descriptor,
+	          NULL,
+	          NULL,
+	          0x8000,
+	          &extent_offset,
+	          &extent_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT64(
+	 "extent_offset",
+	 (int64_t) extent_offset,
+	 (int64_t) 0xc000 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "extent_size",
+	 extent_size,
+	 (uint64_t) 0x4000 );
+
+	/* Test error cases
+	 */
+	result = libvshadow_store_descriptor_get_next_changed_extent(
+	          NULL,
+	          NULL,
+	          NULL,
+	          0,
+	          &extent_offset,
+	          &extent_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_store_descriptor_get_next_changed_extent(
+	          store_descriptor,
+	          NULL,
+	          NULL,
+	          -1,
+	          &extent_offset,
+	          &extent_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_store_descriptor_get_next_changed_extent(
+	          store_descriptor,
+	          NULL,
+	          NULL,
+	          0,
+	          NULL,
+	          &extent_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvshadow_store_descriptor_free(
+	          &other_store_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "other_store_descriptor",
+	 other_store_descriptor );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_store_descriptor_free(
+	          &store_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "store_descriptor",
+	 store_descriptor );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( other_store_descriptor != NULL )
+	{
+		libvshadow_store_descriptor_free(
+		 &other_store_descriptor,
+		 NULL );
+	}
+	if( store_descriptor != NULL )
+	{
+		libvshadow_store_descriptor_free(
+		 &store_descriptor,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_store_descriptor_get_next_data_range function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_store_descriptor_get_next_data_range(
+     void )
+{
+	libcerror_error_t *error                        = NULL;
+	libvshadow_store_descriptor_t *store_descriptor = NULL;
+	size64_t range_size                             = 0;
+	off64_t range_offset                            = 0;
+	int result                                      = 0;
+
+	/* Initialize test
+	 */
+	result = libvshadow_store_descriptor_initialize(
+	          &store_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "store_descriptor",
+	 store_descriptor );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_extent_map_initialize(
+	          &( store_descriptor->extent_map ),
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_extent_map_append_extent(
+	          store_descriptor->extent_map,
+	          0x4000,
+	          0,
+	          LIBVSHADOW_EXTENT_TYPE_SPARSE,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libvshadow_extent_map_append_extent(
+	          store_descriptor->extent_map,
+	          0x4000,
+	          0x4000,
+	          LIBVSHADOW_EXTENT_TYPE_VOLUME_DATA,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libvshadow_extent_map_append_extent(
+	          store_descriptor->extent_map,
+	          0x4000,
+	          0x100000,
+	          LIBVSHADOW_EXTENT_TYPE_STORE_DATA,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libvshadow_extent_map_append_extent(
+	          store_descriptor->extent_map,
+	          0x4000,
+	          0,
+	          LIBVSHADOW_EXTENT_TYPE_SPARSE,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libvshadow_extent_map_append_extent(
+	          store_descriptor->extent_map,
+	          0x4000,
+	          0x10000,
+	          LIBVSHADOW_EXTENT_TYPE_VOLUME_DATA,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	store_descriptor->has_in_volume_store_data = 1;
+	store_descriptor->volume_size              = 0x18000;
+
+	/* Test regular cases
+	 */
+	result = libvshadow_store_descriptor_get_next_data_range(
+	          store_descriptor,
+	          NULL,
+	          0,
+	          &range_offset,
+	          &range_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT64(
+	 "range_offset",
+	 (int64_t) range_offset,
+	 (int64_t) 0x4000 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "range_size",
+	 range_size,
+	 (uint64_t) 0x8000 );
+
+	result = libvshadow_store_descriptor_get_next_data_range(
+	          store_descriptor,
+	          NULL,
+	          0x9000,
+	          &range_offset,
+	          &range_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT64(
+	 "range_offset",
+	 (int64_t) range_offset,
+	 (int64_t) 0x9000 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "range_size",
+	 range_size,
+	 (uint64_t) 0x3000 );
+
+	/* The data beyond the extent map is part of the last data range
+	 */
+	result = libvshadow_store_descriptor_get_next_data_range(
+	          store_descriptor,
+	          NULL,
+	          0xc000,
+	          &range_offset,
+	          &range_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT64(
+	 "range_offset",
+	 (int64_t) range_offset,
+	 (int64_t) 0x10000 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "range_size",
+	 range_size,
+	 (uint64_t) 0x8000 );
+
+	result = libvshadow_store_descriptor_get_next_data_range(
+	          store_descriptor,
+	          NULL,
+	          0x18000,
+	          &range_offset,
+	          &range_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvshadow_store_descriptor_get_next_data_range(
+	          NULL,
+	          NULL,
+	          0,
+	          &range_offset,
+	          &range_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_store_descriptor_get_next_data_range(
+	          store_descriptor,
+	          NULL,
+	          -1,
+	          &range_offset,
+	          &range_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_store_descriptor_get_next_data_range(
+	          store_descriptor,
+	          NULL,
+	          0,
+	          NULL,
+	          &range_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvshadow_store_descriptor_free(
+	          &store_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "store_descriptor",
+	 store_descriptor );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( store_descriptor != NULL )
+	{
+		libvshadow_store_descriptor_free(
+		 &store_descriptor,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_store_descriptor_release_metadata and libvshadow_store_descriptor_get_metadata_size functions
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_store_descriptor_release_metadata(
+     void )
+{
+	uint8_t bitmap_data[ 16 ] = {
+		0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+
+	libvshadow_block_descriptor_t block_descriptor;
+
+	libcerror_error_t *error                        = NULL;
+	libvshadow_store_descriptor_t *store_descriptor = NULL;
+	size64_t block_list_index_size                  = 0;
+	size64_t metadata_size                          = 0;
+	size64_t releasable_metadata_size               = 0;
+	int result                                      = 0;
+
+	/* Initialize test
+	 */
+	result = libvshadow_store_descriptor_initialize(
+	          &store_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "store_descriptor",
+	 store_descriptor );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_store_descriptor_get_metadata_size(
+	          store_descriptor,
+	          &metadata_size,
+	          &releasable_metadata_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "releasable_metadata_size",
+	 (uint64_t) releasable_metadata_size,
+	 (uint64_t) 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_bitmap_append_data(
+	          store_descriptor->bitmap,
+	          bitmap_data,
+	          16,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_bitmap_append_data(
+	          store_descriptor->previous_bitmap,
+	          bitmap_data,
+	          16,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_extent_map_initialize(
+	          &( store_descriptor->extent_map ),
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_extent_map_append_extent(
+	          store_descriptor->extent_map,
+	          0x4000,
+	          0x4000,
+	          LIBVSHADOW_EXTENT_TYPE_VOLUME_DATA,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_set(
+	 &block_descriptor,
+	 0,
+	 sizeof( libvshadow_block_descriptor_t ) );
+
+	block_descriptor.original_offset = 0x00100000;
+	block_descriptor.relative_offset = 0x00200000;
+	block_descriptor.offset          = 0x00200000;
+
+	result = libvshadow_store_descriptor_append_block_descriptor(
+	          store_descriptor,
+	          &block_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_block_index_get_memory_size(
+	          store_descriptor->block_list_index,
+	          &block_list_index_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	store_descriptor->block_descriptors_read = 1;
+	store_descriptor->block_list_read        = 1;
+
+	/* Test regular cases
+	 */
+	result = libvshadow_store_descriptor_get_metadata_size(
+	          store_descriptor,
+	          &metadata_size,
+	          &releasable_metadata_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "releasable_metadata_size",
+	 (uint64_t) releasable_metadata_size,
+	 (uint64_t) ( store_descriptor->bitmap->allocated_data_size + store_descriptor->previous_bitmap->allocated_data_size + ( store_descriptor->extent_map->number_of_allocated_extents * sizeof( libvshadow_extent_t ) ) ) );
+
+	/* The block list index is not releasable
+	 */
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "metadata_size",
+	 (uint64_t) metadata_size,
+	 (uint64_t) ( releasable_metadata_size + block_list_index_size ) );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_store_descriptor_release_metadata(
+	          store_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT8(
+	 "store_descriptor->block_descriptors_read",
+	 store_descriptor->block_descriptors_read,
+	 (uint8_t) 0 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT8(
+	 "store_descriptor->block_list_read",
+	 store_descriptor->block_list_read,
+	 (uint8_t) 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "store_descriptor->extent_map",
+	 store_descriptor->extent_map );
+
+	result = libvshadow_store_descriptor_get_metadata_size(
+	          store_descriptor,
+	          &metadata_size,
+	          &releasable_metadata_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "releasable_metadata_size",
+	 (uint64_t) releasable_metadata_size,
+	 (uint64_t) 0 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "metadata_size",
+	 (uint64_t) metadata_size,
+	 (uint64_t) block_list_index_size );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvshadow_store_descriptor_release_metadata(
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_store_descriptor_get_metadata_size(
+	          NULL,
+	          &metadata_size,
+	          &releasable_metadata_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_store_descriptor_get_metadata_size(
+	          store_descriptor,
+	          NULL,
+	          &releasable_metadata_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_store_descriptor_get_metadata_size(
+	          store_descriptor,
+	          &metadata_size,
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvshadow_store_descriptor_free(
+	          &store_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "store_descriptor",
+	 store_descriptor );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( store_descriptor != NULL )
+	{
+		libvshadow_store_descriptor_free(
+		 &store_descriptor,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_store_descriptor_read_buffers function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_store_descriptor_read_buffers(
+     void )
+{
+	uint8_t buffer0[ 0x4000 ];
+	uint8_t buffer1[ 0x1000 ];
+	uint8_t buffer2[ 0x0800 ];
+	uint8_t buffer3[ 0x0100 ];
+
+	uint8_t *buffers[ 4 ]                           = { buffer0, buffer1, buffer2, buffer3 };
+	size_t buffer_sizes[ 4 ]                        = { 0x4000, 0x1000, 0x0800, 0x0100 };
+	off64_t offsets[ 4 ]                            = { 0x2000, 0x1000, 0xc000, 0x9000 };
+
+	libbfio_handle_t *file_io_handle                = NULL;
+	libcerror_error_t *error                        = NULL;
+	libvshadow_store_descriptor_t *store_descriptor = NULL;
+	uint8_t *data                                   = NULL;
+	ssize_t read_count                              = 0;
+	size_t data_index                               = 0;
+	int result                                      = 0;
+
+	/* Initialize test
+	 */
+	data = (uint8_t *) malloc(
+	                    0x20000 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "data",
+	 data );
+
+	for( data_index = 0;
+	     data_index < 0x20000;
+	     data_index++ )
+	{
+		data[ data_index ] = (uint8_t) ( data_index / 0x100 );
+	}
+	result = libbfio_memory_range_initialize(
+	          &file_io_handle,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_memory_range_set(
+	          file_io_handle,
+	          data,
+	          0x20000,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_handle_open(
+	          file_io_handle,
+	          LIBBFIO_OPEN_READ,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_store_descriptor_initialize(
+	          &store_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "store_descriptor",
+	 store_descriptor );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_extent_map_initialize(
+	          &( store_descriptor->extent_map ),
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_extent_map_append_extent(
+	          store_descriptor->extent_map,
+	          0x4000,
+	          0x10000,
+	          LIBVSHADOW_EXTENT_TYPE_STORE_DATA,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libvshadow_extent_map_append_extent(
+	          store_descriptor->extent_map,
+	          0x4000,
+	          0,
+	          LIBVSHADOW_EXTENT_TYPE_SPARSE,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libvshadow_extent_map_append_extent(
+	          store_descriptor->extent_map,
+	          0x4000,
+	          0x8000,
+	          LIBVSHADOW_EXTENT_TYPE_VOLUME_DATA,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libvshadow_extent_map_append_extent(
+	          store_descriptor->extent_map,
+	          0x4000,
+	          0x14000,
+	          LIBVSHADOW_EXTENT_TYPE_STORE_DATA,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	store_descriptor->has_in_volume_store_data = 1;
+	store_descriptor->volume_size              = 0x10000;
+
+	/* Test regular cases
+	 * The store data of buffers 1, 0 and 2 is adjacent in the volume and read with a single read
+	 */
+	read_count = libvshadow_store_descriptor_read_buffers(
+	              store_descriptor,
+	              file_io_handle,
+	              NULL,
+	              buffers,
+	              buffer_sizes,
+	              offsets,
+	              4,
+	              &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 0x5900 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          buffer0,
+	          &( data[ 0x12000 ] ),
+	          0x2000 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	for( data_index = 0x2000;
+	     data_index < 0x4000;
+	     data_index++ )
+	{
+		VSHADOW_TEST_ASSERT_EQUAL_UINT8(
+		 "buffer0[ data_index ]",
+		 buffer0[ data_index ],
+		 (uint8_t) 0 );
+	}
+	result = memory_compare(
+	          buffer1,
+	          &( data[ 0x11000 ] ),
+	          0x1000 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = memory_compare(
+	          buffer2,
+	          &( data[ 0x14000 ] ),
+	          0x0800 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = memory_compare(
+	          buffer3,
+	          &( data[ 0x9000 ] ),
+	          0x0100 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	read_count = libvshadow_store_descriptor_read_buffers(
+	              NULL,
+	              file_io_handle,
+	              NULL,
+	              buffers,
+	              buffer_sizes,
+	              offsets,
+	              4,
+	              &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libvshadow_store_descriptor_read_buffers(
+	              store_descriptor,
+	              file_io_handle,
+	              NULL,
+	              NULL,
+	              buffer_sizes,
+	              offsets,
+	              4,
+	              &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libvshadow_store_descriptor_read_buffers(
+	              store_descriptor,
+	              file_io_handle,
+	              NULL,
+	              buffers,
+	              buffer_sizes,
+	              offsets,
+	              -1,
+	              &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvshadow_store_descriptor_free(
+	          &store_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "store_descriptor",
+	 store_descriptor );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_handle_close(
+	          file_io_handle,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_handle_free(
+	          &file_io_handle,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	free(
+	 data );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( store_descriptor != NULL )
+	{
+		libvshadow_store_descriptor_free(
+		 &store_descriptor,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( data != NULL )
+	{
+		free(
+		 data );
+	}
+	return( 0 );
+}
+
 #endif /* defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT ) */
 
 /* The main program
@@ -682,10 +2704,20 @@ int main(
 
 	/* TODO: add tests for libvshadow_store_descriptor_read_store_block_range_list */
 
+	/* TODO: add tests for libvshadow_store_descriptor_insert_block_descriptors */
+
 	/* TODO: add tests for libvshadow_store_descriptor_read_block_descriptors */
 
+	VSHADOW_TEST_RUN(
+	 "libvshadow_store_descriptor_release_metadata",
+	 vshadow_test_store_descriptor_release_metadata );
+
 	/* TODO: add tests for libvshadow_store_descriptor_read_buffer */
 
+	VSHADOW_TEST_RUN(
+	 "libvshadow_store_descriptor_read_buffers",
+	 vshadow_test_store_descriptor_read_buffers );
+
 	VSHADOW_TEST_RUN(
 	 "libvshadow_store_descriptor_get_volume_size",
 	 vshadow_test_store_descriptor_get_volume_size );
@@ -708,6 +2740,22 @@ int main(
 
 	/* TODO: add tests for libvshadow_store_descriptor_get_block_descriptor_by_index */
 
+	VSHADOW_TEST_RUN(
+	 "libvshadow_store_descriptor_get_block_values",
+	 vshadow_test_store_descriptor_get_block_values );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_store_descriptor_get_extent_at_offset",
+	 vshadow_test_store_descriptor_get_extent_at_offset );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_store_descriptor_get_next_changed_extent",
+	 vshadow_test_store_descriptor_get_next_changed_extent );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_store_descriptor_get_next_data_range",
+	 vshadow_test_store_descriptor_get_next_data_range );
+
 #endif /* defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT ) */
 
 	return( EXIT_SUCCESS );
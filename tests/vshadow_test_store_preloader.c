@@ -0,0 +1,749 @@
+/*
+ * Library store_preloader type test program
+ *
+ * Copyright (C) 2011-2018, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "vshadow_test_libbfio.h"
+#include "vshadow_test_libcerror.h"
+#include "vshadow_test_libvshadow.h"
+#include "vshadow_test_macros.h"
+#include "vshadow_test_memory.h"
+#include "vshadow_test_unused.h"
+
+#include "../libvshadow/libvshadow_io_handle.h"
+#include "../libvshadow/libvshadow_store_preloader.h"
+
+#if defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT )
+
+/* Progress callback that stops preloading after 2 stores
+ * Returns 1 to continue or 0 to stop
+ */
+int vshadow_test_store_preloader_progress(
+     int number_of_stores_read,
+     int number_of_stores VSHADOW_TEST_ATTRIBUTE_UNUSED,
+     void *callback_data )
+{
+	VSHADOW_TEST_UNREFERENCED_PARAMETER( number_of_stores )
+
+	*( (int *) callback_data ) += 1;
+
+	if( number_of_stores_read >= 2 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Tests the libvshadow_store_preloader_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_store_preloader_initialize(
+     void )
+{
+	libbfio_handle_t *file_io_handle              = NULL;
+	libcerror_error_t *error                      = NULL;
+	libvshadow_io_handle_t *io_handle             = NULL;
+	libvshadow_store_preloader_t *store_preloader = NULL;
+	int result                                    = 0;
+
+#if defined( HAVE_VSHADOW_TEST_MEMORY )
+	int number_of_malloc_fail_tests               = 1;
+	int number_of_memset_fail_tests               = 1;
+	int test_number                               = 0;
+#endif
+
+	/* Initialize test
+	 */
+	result = libvshadow_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_memory_range_initialize(
+	          &file_io_handle,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test store_preloader initialization
+	 */
+	result = libvshadow_store_preloader_initialize(
+	          &store_preloader,
+	          io_handle,
+	          file_io_handle,
+	          3,
+	          NULL,
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "store_preloader",
+	 store_preloader );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "store_preloader->failed_store_index",
+	 store_preloader->failed_store_index,
+	 -1 );
+
+	result = libvshadow_store_preloader_free(
+	          &store_preloader,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "store_preloader",
+	 store_preloader );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvshadow_store_preloader_initialize(
+	          NULL,
+	          io_handle,
+	          file_io_handle,
+	          3,
+	          NULL,
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	store_preloader = (libvshadow_store_preloader_t *) 0x12345678UL;
+
+	result = libvshadow_store_preloader_initialize(
+	          &store_preloader,
+	          io_handle,
+	          file_io_handle,
+	          3,
+	          NULL,
+	          NULL,
+	          &error );
+
+	store_preloader = NULL;
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_store_preloader_initialize(
+	          &store_preloader,
+	          NULL,
+	          file_io_handle,
+	          3,
+	          NULL,
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_store_preloader_initialize(
+	          &store_preloader,
+	          io_handle,
+	          NULL,
+	          3,
+	          NULL,
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_store_preloader_initialize(
+	          &store_preloader,
+	          io_handle,
+	          file_io_handle,
+	          -1,
+	          NULL,
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_VSHADOW_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvshadow_store_preloader_initialize with malloc failing
+		 */
+		vshadow_test_malloc_attempts_before_fail = test_number;
+
+		result = libvshadow_store_preloader_initialize(
+		          &store_preloader,
+		          io_handle,
+		          file_io_handle,
+		          3,
+		          NULL,
+		          NULL,
+		          &error );
+
+		if( vshadow_test_malloc_attempts_before_fail != -1 )
+		{
+			vshadow_test_malloc_attempts_before_fail = -1;
+
+			if( store_preloader != NULL )
+			{
+				libvshadow_store_preloader_free(
+				 &store_preloader,
+				 NULL );
+			}
+		}
+		else
+		{
+			VSHADOW_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VSHADOW_TEST_ASSERT_IS_NULL(
+			 "store_preloader",
+			 store_preloader );
+
+			VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvshadow_store_preloader_initialize with memset failing
+		 */
+		vshadow_test_memset_attempts_before_fail = test_number;
+
+		result = libvshadow_store_preloader_initialize(
+		          &store_preloader,
+		          io_handle,
+		          file_io_handle,
+		          3,
+		          NULL,
+		          NULL,
+		          &error );
+
+		if( vshadow_test_memset_attempts_before_fail != -1 )
+		{
+			vshadow_test_memset_attempts_before_fail = -1;
+
+			if( store_preloader != NULL )
+			{
+				libvshadow_store_preloader_free(
+				 &store_preloader,
+				 NULL );
+			}
+		}
+		else
+		{
+			VSHADOW_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VSHADOW_TEST_ASSERT_IS_NULL(
+			 "store_preloader",
+			 store_preloader );
+
+			VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_VSHADOW_TEST_MEMORY ) */
+
+	/* Clean up
+	 */
+	result = libbfio_handle_free(
+	          &file_io_handle,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( store_preloader != NULL )
+	{
+		libvshadow_store_preloader_free(
+		 &store_preloader,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libvshadow_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_store_preloader_free function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_store_preloader_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libvshadow_store_preloader_free(
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_store_preloader_set_store_read function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_store_preloader_set_store_read(
+     void )
+{
+	libbfio_handle_t *file_io_handle              = NULL;
+	libcerror_error_t *error                      = NULL;
+	libvshadow_io_handle_t *io_handle             = NULL;
+	libvshadow_store_preloader_t *store_preloader = NULL;
+	int number_of_progress_calls                  = 0;
+	int result                                    = 0;
+
+	/* Initialize test
+	 */
+	result = libvshadow_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_memory_range_initialize(
+	          &file_io_handle,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_store_preloader_initialize(
+	          &store_preloader,
+	          io_handle,
+	          file_io_handle,
+	          3,
+	          &vshadow_test_store_preloader_progress,
+	          (void *) &number_of_progress_calls,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvshadow_store_preloader_set_store_read(
+	          store_preloader,
+	          2,
+	          1,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "number_of_progress_calls",
+	 number_of_progress_calls,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT8(
+	 "store_preloader->abort",
+	 store_preloader->abort,
+	 0 );
+
+	/* Test a skipped store, which does not report progress
+	 */
+	result = libvshadow_store_preloader_set_store_read(
+	          store_preloader,
+	          1,
+	          0,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "number_of_progress_calls",
+	 number_of_progress_calls,
+	 1 );
+
+	/* Test the progress callback stopping the preloading
+	 */
+	result = libvshadow_store_preloader_set_store_read(
+	          store_preloader,
+	          1,
+	          1,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "number_of_progress_calls",
+	 number_of_progress_calls,
+	 2 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT8(
+	 "store_preloader->abort",
+	 store_preloader->abort,
+	 1 );
+
+	/* Test a store that could not be read
+	 */
+	result = libvshadow_store_preloader_set_store_read(
+	          store_preloader,
+	          0,
+	          -1,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "store_preloader->failed_store_index",
+	 store_preloader->failed_store_index,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "store_preloader->number_of_stores_read",
+	 store_preloader->number_of_stores_read,
+	 2 );
+
+	/* Test error cases
+	 */
+	result = libvshadow_store_preloader_set_store_read(
+	          NULL,
+	          0,
+	          1,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvshadow_store_preloader_free(
+	          &store_preloader,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_handle_free(
+	          &file_io_handle,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( store_preloader != NULL )
+	{
+		libvshadow_store_preloader_free(
+		 &store_preloader,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libvshadow_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc VSHADOW_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] VSHADOW_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc VSHADOW_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] VSHADOW_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	VSHADOW_TEST_UNREFERENCED_PARAMETER( argc )
+	VSHADOW_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT )
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_store_preloader_initialize",
+	 vshadow_test_store_preloader_initialize );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_store_preloader_free",
+	 vshadow_test_store_preloader_free );
+
+	/* TODO: add tests for libvshadow_store_preloader_read_store */
+
+	/* TODO: add tests for libvshadow_store_preloader_read_store_descriptor */
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_store_preloader_set_store_read",
+	 vshadow_test_store_preloader_set_store_read );
+
+	/* TODO: add tests for libvshadow_store_preloader_read_stores */
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -1513,6 +1513,138 @@ on_error:
 	return( 0 );
 }
 
+/* Counts the number of stores read by libvshadow_volume_preload_stores
+ * Returns 1 to continue
+ */
+int vshadow_test_volume_preload_stores_progress(
+     int number_of_stores_read,
+     int number_of_stores VSHADOW_TEST_ATTRIBUTE_UNUSED,
+     void *callback_data )
+{
+	VSHADOW_TEST_UNREFERENCED_PARAMETER( number_of_stores )
+
+	*( (int *) callback_data ) = number_of_stores_read;
+
+	return( 1 );
+}
+
+/* Tests the libvshadow_volume_preload_stores function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_volume_preload_stores(
+     libvshadow_volume_t *volume )
+{
+	libcerror_error_t *error  = NULL;
+	int number_of_stores      = 0;
+	int number_of_stores_read = 0;
+	int result                = 0;
+
+	result = libvshadow_volume_get_number_of_stores(
+	          volume,
+	          &number_of_stores,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvshadow_volume_preload_stores(
+	          volume,
+	          2,
+	          &vshadow_test_volume_preload_stores_progress,
+	          (void *) &number_of_stores_read,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "number_of_stores_read",
+	 number_of_stores_read,
+	 number_of_stores );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test preloading stores that have already been read
+	 */
+	result = libvshadow_volume_preload_stores(
+	          volume,
+	          1,
+	          NULL,
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvshadow_volume_preload_stores(
+	          NULL,
+	          1,
+	          NULL,
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_volume_preload_stores(
+	          volume,
+	          0,
+	          NULL,
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
 /* The main program
  */
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
@@ -1752,6 +1884,23 @@ int main(
 
 		/* TODO: add tests for libvshadow_volume_get_store_identifier */
 
+		/* TODO: add tests for libvshadow_volume_get_next_changed_extent */
+
+		/* TODO: add tests for libvshadow_volume_read_buffers_across_stores */
+
+		/* TODO: add tests for libvshadow_volume_set_maximum_metadata_size */
+
+		/* TODO: add tests for libvshadow_volume_get_metadata_size */
+
+		VSHADOW_TEST_RUN_WITH_ARGS(
+		 "libvshadow_volume_preload_stores",
+		 vshadow_test_volume_preload_stores,
+		 volume );
+
+		/* TODO: add tests for libvshadow_volume_read_index_cache */
+
+		/* TODO: add tests for libvshadow_volume_write_index_cache */
+
 		/* Clean up
 		 */
 		result = vshadow_test_volume_close_source(
@@ -560,15 +560,14 @@ int info_handle_close(
 int info_handle_block_fprint(
      info_handle_t *info_handle,
      int block_index,
-     libvshadow_block_t *block,
+     off64_t original_offset,
+     off64_t relative_offset,
+     off64_t offset,
+     uint32_t flags,
+     uint32_t bitmap,
      libcerror_error_t **error )
 {
-	static char *function   = "info_handle_block_fprint";
-	off64_t original_offset = 0;
-	off64_t offset          = 0;
-	off64_t relative_offset = 0;
-	uint32_t flags          = 0;
-	uint32_t bitmap         = 0;
+	static char *function = "info_handle_block_fprint";
 
 	if( info_handle == NULL )
 	{
@@ -581,25 +580,6 @@ int info_handle_block_fprint(
 
 		return( -1 );
 	}
-	if( libvshadow_block_get_values(
-	     block,
-	     &original_offset,
-	     &relative_offset,
-	     &offset,
-	     &flags,
-	     &bitmap,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve block: %d values.",
-		 function,
-		 block_index );
-
-		return( -1 );
-	}
 	fprintf(
 	 info_handle->notify_stream,
 	 "\n" );
@@ -649,18 +629,24 @@ int info_handle_store_fprint(
 	system_character_t byte_size_string[ 16 ];
 	system_character_t filetime_string[ 32 ];
 	system_character_t guid_string[ 48 ];
+	off64_t original_offsets[ INFO_HANDLE_NUMBER_OF_CHUNK_BLOCKS ];
+	off64_t relative_offsets[ INFO_HANDLE_NUMBER_OF_CHUNK_BLOCKS ];
+	off64_t offsets[ INFO_HANDLE_NUMBER_OF_CHUNK_BLOCKS ];
+	uint32_t flags[ INFO_HANDLE_NUMBER_OF_CHUNK_BLOCKS ];
+	uint32_t bitmaps[ INFO_HANDLE_NUMBER_OF_CHUNK_BLOCKS ];
 	uint8_t guid_buffer[ 16 ];
 
 	libfdatetime_filetime_t *filetime = NULL;
 	libfguid_identifier_t *guid       = NULL;
-	libvshadow_block_t *block         = NULL;
 	static char *function             = "info_handle_store_fprint";
 	size64_t volume_size              = 0;
 	uint64_t value_64bit              = 0;
 	uint32_t attribute_flags          = 0;
 	int block_index                   = 0;
+	int chunk_block_index             = 0;
 	int has_in_volume_store_data      = 0;
 	int number_of_blocks              = 0;
+	int number_of_chunk_blocks        = 0;
 	int result                        = 0;
 
 	if( info_handle == NULL )
@@ -1094,47 +1080,57 @@ int info_handle_store_fprint(
 		 "\tNumber of blocks\t: %d\n",
 		 number_of_blocks );
 
+		/* The block values are retrieved in chunks to avoid
+		 * creating a block object for every block
+		 */
 		for( block_index = 0;
 		     block_index < number_of_blocks;
-		     block_index++ )
+		     block_index += number_of_chunk_blocks )
 		{
-			if( libvshadow_store_get_block_by_index(
+			number_of_chunk_blocks = number_of_blocks - block_index;
+
+			if( number_of_chunk_blocks > INFO_HANDLE_NUMBER_OF_CHUNK_BLOCKS )
+			{
+				number_of_chunk_blocks = INFO_HANDLE_NUMBER_OF_CHUNK_BLOCKS;
+			}
+			if( libvshadow_store_get_block_values(
 			     store,
 			     block_index,
-			     &block,
+			     number_of_chunk_blocks,
+			     original_offsets,
+			     relative_offsets,
+			     offsets,
+			     flags,
+			     bitmaps,
 			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve block: %d.",
+				 "%s: unable to retrieve values of blocks: %d to %d.",
 				 function,
-				 block_index );
+				 block_index,
+				 block_index + number_of_chunk_blocks - 1 );
 
 				goto on_error;
 			}
-			if( info_handle_block_fprint(
-			     info_handle,
-			     block_index,
-			     block,
-			     error ) != 1 )
-			{
-				goto on_error;
-			}
-			if( libvshadow_block_free(
-			     &block,
-			     error ) != 1 )
+			for( chunk_block_index = 0;
+			     chunk_block_index < number_of_chunk_blocks;
+			     chunk_block_index++ )
 			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-				 "%s: unable to free block: %d.",
-				 function,
-				 block_index );
-
-				goto on_error;
+				if( info_handle_block_fprint(
+				     info_handle,
+				     block_index + chunk_block_index,
+				     original_offsets[ chunk_block_index ],
+				     relative_offsets[ chunk_block_index ],
+				     offsets[ chunk_block_index ],
+				     flags[ chunk_block_index ],
+				     bitmaps[ chunk_block_index ],
+				     error ) != 1 )
+				{
+					goto on_error;
+				}
 			}
 		}
 	}
@@ -1145,12 +1141,6 @@ int info_handle_store_fprint(
 	return( 1 );
 
 on_error:
-	if( block != NULL )
-	{
-		libvshadow_block_free(
-		 &block,
-		 NULL );
-	}
 	if( guid != NULL )
 	{
 		libfguid_identifier_free(
@@ -34,6 +34,10 @@
 extern "C" {
 #endif
 
+/* The number of blocks of which the values are retrieved at once
+ */
+#define INFO_HANDLE_NUMBER_OF_CHUNK_BLOCKS	256
+
 typedef struct info_handle info_handle_t;
 
 struct info_handle
@@ -98,7 +102,11 @@ int info_handle_close(
 int info_handle_block_fprint(
      info_handle_t *info_handle,
      int block_index,
-     libvshadow_block_t *block,
+     off64_t original_offset,
+     off64_t relative_offset,
+     off64_t offset,
+     uint32_t flags,
+     uint32_t bitmap,
      libcerror_error_t **error );
 
 int info_handle_store_fprint(
@@ -40,6 +40,15 @@ int libvshadow_volume_open_file_io_handle(
      int access_flags,
      libvshadow_error_t **error );
 
+extern \
+ssize_t libvshadow_store_read_buffer_at_offset_from_file_io_handle(
+         libvshadow_store_t *store,
+         libbfio_handle_t *file_io_handle,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libvshadow_error_t **error );
+
 extern \
 int libvshadow_check_volume_signature_file_io_handle(
      libbfio_handle_t *file_io_handle,
@@ -248,11 +257,54 @@ int mount_handle_initialize(
 
 		goto on_error;
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *mount_handle )->file_io_handles_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize file IO handles mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_mutex_initialize(
+	     &( ( *mount_handle )->changed_extents_lists_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize changed extents lists mutex.",
+		 function );
+
+		goto on_error;
+	}
+	( *mount_handle )->maximum_number_of_file_io_handles = MOUNT_HANDLE_MAXIMUM_NUMBER_OF_FILE_IO_HANDLES;
+#endif
 	return( 1 );
 
 on_error:
 	if( *mount_handle != NULL )
 	{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( ( *mount_handle )->file_io_handles_mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *mount_handle )->file_io_handles_mutex ),
+			 NULL );
+		}
+#endif
+		if( ( *mount_handle )->input_volume != NULL )
+		{
+			libvshadow_volume_free(
+			 &( ( *mount_handle )->input_volume ),
+			 NULL );
+		}
 		if( ( *mount_handle )->input_file_io_handle != NULL )
 		{
 			libbfio_handle_free(
@@ -332,6 +384,34 @@ int mount_handle_free(
 
 			result = -1;
 		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_free(
+		     &( ( *mount_handle )->file_io_handles_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free file IO handles mutex.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *mount_handle )->changed_extents_lists_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free changed extents lists mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
 		memory_free(
 		 *mount_handle );
 
@@ -436,6 +516,7 @@ int mount_handle_open_input(
 	static char *function  = "mount_handle_open";
 	size_t filename_length = 0;
 	int result             = 0;
+	int store_index        = 0;
 
 	if( mount_handle == NULL )
 	{
@@ -563,14 +644,158 @@ int mount_handle_open_input(
 
 			goto on_error;
 		}
+		/* The stores are retrieved in advance so that they can be read concurrently
+		 */
+		for( store_index = 0;
+		     store_index < mount_handle->number_of_inputs;
+		     store_index++ )
+		{
+			if( libvshadow_volume_get_store(
+			     mount_handle->input_volume,
+			     store_index,
+			     &( mount_handle->inputs[ store_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve input: %d from input volume.",
+				 function,
+				 store_index );
+
+				goto on_error;
+			}
+		}
+		mount_handle->changed_extents_lists = (uint8_t **) memory_allocate(
+		                                                     sizeof( uint8_t * ) * mount_handle->number_of_inputs );
+
+		if( mount_handle->changed_extents_lists == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create changed extents lists.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_set(
+		     mount_handle->changed_extents_lists,
+		     0,
+		     sizeof( uint8_t * ) * mount_handle->number_of_inputs ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear changed extents lists.",
+			 function );
+
+			goto on_error;
+		}
+		mount_handle->changed_extents_list_sizes = (size_t *) memory_allocate(
+		                                                       sizeof( size_t ) * mount_handle->number_of_inputs );
+
+		if( mount_handle->changed_extents_list_sizes == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create changed extents list sizes.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_set(
+		     mount_handle->changed_extents_list_sizes,
+		     0,
+		     sizeof( size_t ) * mount_handle->number_of_inputs ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear changed extents list sizes.",
+			 function );
+
+			goto on_error;
+		}
+		if( mount_handle->maximum_number_of_file_io_handles > 0 )
+		{
+			mount_handle->file_io_handles = (libbfio_handle_t **) memory_allocate(
+			                                                       sizeof( libbfio_handle_t * ) * mount_handle->maximum_number_of_file_io_handles );
+
+			if( mount_handle->file_io_handles == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to create file IO handles.",
+				 function );
+
+				goto on_error;
+			}
+			mount_handle->available_file_io_handles = (libbfio_handle_t **) memory_allocate(
+			                                                                 sizeof( libbfio_handle_t * ) * mount_handle->maximum_number_of_file_io_handles );
+
+			if( mount_handle->available_file_io_handles == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to create available file IO handles.",
+				 function );
+
+				goto on_error;
+			}
+		}
 	}
 	return( result );
 
 on_error:
+	if( mount_handle->file_io_handles != NULL )
+	{
+		memory_free(
+		 mount_handle->file_io_handles );
+
+		mount_handle->file_io_handles = NULL;
+	}
+	if( mount_handle->changed_extents_list_sizes != NULL )
+	{
+		memory_free(
+		 mount_handle->changed_extents_list_sizes );
+
+		mount_handle->changed_extents_list_sizes = NULL;
+	}
+	if( mount_handle->changed_extents_lists != NULL )
+	{
+		memory_free(
+		 mount_handle->changed_extents_lists );
+
+		mount_handle->changed_extents_lists = NULL;
+	}
 	if( mount_handle->inputs != NULL )
 	{
+		for( store_index = 0;
+		     store_index < mount_handle->number_of_inputs;
+		     store_index++ )
+		{
+			if( mount_handle->inputs[ store_index ] != NULL )
+			{
+				libvshadow_store_free(
+				 &( mount_handle->inputs[ store_index ] ),
+				 NULL );
+			}
+		}
 		memory_free(
 		 mount_handle->inputs );
+
+		mount_handle->inputs = NULL;
 	}
 	return( -1 );
 }
@@ -582,9 +807,10 @@ int mount_handle_close_input(
      mount_handle_t *mount_handle,
      libcerror_error_t **error )
 {
-	static char *function = "mount_handle_close_input";
-	int result            = 0;
-	int store_index       = 0;
+	static char *function    = "mount_handle_close_input";
+	int file_io_handle_index = 0;
+	int result               = 0;
+	int store_index          = 0;
 
 	if( mount_handle == NULL )
 	{
@@ -623,6 +849,81 @@ int mount_handle_close_input(
 		}
 		memory_free(
 		 mount_handle->inputs );
+
+		mount_handle->inputs = NULL;
+	}
+	if( mount_handle->file_io_handles != NULL )
+	{
+		for( file_io_handle_index = 0;
+		     file_io_handle_index < mount_handle->number_of_file_io_handles;
+		     file_io_handle_index++ )
+		{
+			if( libbfio_handle_close(
+			     mount_handle->file_io_handles[ file_io_handle_index ],
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close file IO handle: %d.",
+				 function,
+				 file_io_handle_index );
+
+				result = -1;
+			}
+			if( libbfio_handle_free(
+			     &( mount_handle->file_io_handles[ file_io_handle_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free file IO handle: %d.",
+				 function,
+				 file_io_handle_index );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 mount_handle->file_io_handles );
+
+		mount_handle->file_io_handles           = NULL;
+		mount_handle->number_of_file_io_handles = 0;
+	}
+	if( mount_handle->available_file_io_handles != NULL )
+	{
+		memory_free(
+		 mount_handle->available_file_io_handles );
+
+		mount_handle->available_file_io_handles           = NULL;
+		mount_handle->number_of_available_file_io_handles = 0;
+	}
+	if( mount_handle->changed_extents_lists != NULL )
+	{
+		for( store_index = 0;
+		     store_index < mount_handle->number_of_inputs;
+		     store_index++ )
+		{
+			if( mount_handle->changed_extents_lists[ store_index ] != NULL )
+			{
+				memory_free(
+				 mount_handle->changed_extents_lists[ store_index ] );
+			}
+		}
+		memory_free(
+		 mount_handle->changed_extents_lists );
+
+		mount_handle->changed_extents_lists = NULL;
+	}
+	if( mount_handle->changed_extents_list_sizes != NULL )
+	{
+		memory_free(
+		 mount_handle->changed_extents_list_sizes );
+
+		mount_handle->changed_extents_list_sizes = NULL;
 	}
 	if( libvshadow_volume_close(
 	     mount_handle->input_volume,
@@ -640,18 +941,19 @@ int mount_handle_close_input(
 	return( result );
 }
 
-/* Read a buffer from the specified input
- * Returns the number of bytes read if successful or -1 on error
+/* Grabs a file IO handle to read the inputs
+ * A clone of the input file IO handle is used if available, otherwise the input file IO handle
+ * is shared, which is serialized by its lock
+ * Returns 1 if successful or -1 on error
  */
-ssize_t mount_handle_read_buffer(
-         mount_handle_t *mount_handle,
-         int store_index,
-         uint8_t *buffer,
-         size_t size,
-         libcerror_error_t **error )
+int mount_handle_grab_file_io_handle(
+     mount_handle_t *mount_handle,
+     libbfio_handle_t **file_io_handle,
+     libcerror_error_t **error )
 {
-	static char *function = "mount_handle_read_buffer";
-	ssize_t read_count    = 0;
+	libbfio_handle_t *safe_file_io_handle = NULL;
+	static char *function                 = "mount_handle_grab_file_io_handle";
+	int result                            = 0;
 
 	if( mount_handle == NULL )
 	{
@@ -664,132 +966,1287 @@ ssize_t mount_handle_read_buffer(
 
 		return( -1 );
 	}
-	if( ( store_index < 0 )
-	 || ( store_index >= mount_handle->number_of_inputs ) )
+	if( file_io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: unsupported to store index value out of bounds.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( mount_handle->inputs[ store_index ] == NULL )
-	{
-		if( libvshadow_volume_get_store(
-		     mount_handle->input_volume,
-		     store_index,
-		     &( mount_handle->inputs[ store_index ] ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-			 "%s: unable to retrieve input: %d from input volume.",
-			 function,
-			 store_index );
-
-			return( -1 );
-		}
-	}
-	read_count = libvshadow_store_read_buffer(
-	              mount_handle->inputs[ store_index ],
-	              buffer,
-	              size,
-	              error );
-
-	if( read_count == -1 )
+	if( mount_handle->file_io_handles == NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read buffer from input: %d.",
-		 function,
-		 store_index );
+		*file_io_handle = mount_handle->input_file_io_handle;
 
-		return( -1 );
+		return( 1 );
 	}
-	return( read_count );
-}
-
-/* Seeks a specific offset from the specified input
- * Returns the offset if successful or -1 on error
- */
-off64_t mount_handle_seek_offset(
-         mount_handle_t *mount_handle,
-         int store_index,
-         off64_t offset,
-         int whence,
-         libcerror_error_t **error )
-{
-	static char *function = "mount_handle_seek_offset";
-
-	if( mount_handle == NULL )
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     mount_handle->file_io_handles_mutex,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid mount handle.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab file IO handles mutex.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( store_index < 0 )
-	 || ( store_index >= mount_handle->number_of_inputs ) )
+#endif
+	if( mount_handle->number_of_available_file_io_handles > 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: unsupported to store index value out of bounds: %d.",
-		 function,
-		 store_index );
+		mount_handle->number_of_available_file_io_handles -= 1;
 
-		return( -1 );
+		safe_file_io_handle = mount_handle->available_file_io_handles[ mount_handle->number_of_available_file_io_handles ];
 	}
-	if( mount_handle->inputs[ store_index ] == NULL )
+	else if( mount_handle->number_of_file_io_handles < mount_handle->maximum_number_of_file_io_handles )
 	{
-		if( libvshadow_volume_get_store(
-		     mount_handle->input_volume,
-		     store_index,
-		     &( mount_handle->inputs[ store_index ] ),
+		if( libbfio_handle_clone(
+		     &safe_file_io_handle,
+		     mount_handle->input_file_io_handle,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-			 "%s: unable to retrieve input: %d from input volume.",
-			 function,
-			 store_index );
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to clone input file IO handle.",
+			 function );
 
-			return( -1 );
+			goto on_error;
+		}
+		result = libbfio_handle_is_open(
+		          safe_file_io_handle,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if file IO handle is open.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			if( libbfio_handle_open(
+			     safe_file_io_handle,
+			     LIBBFIO_OPEN_READ,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_OPEN_FAILED,
+				 "%s: unable to open file IO handle.",
+				 function );
+
+				goto on_error;
+			}
 		}
+		mount_handle->file_io_handles[ mount_handle->number_of_file_io_handles ] = safe_file_io_handle;
+
+		mount_handle->number_of_file_io_handles += 1;
+	}
+	else
+	{
+		safe_file_io_handle = mount_handle->input_file_io_handle;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     mount_handle->file_io_handles_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release file IO handles mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*file_io_handle = safe_file_io_handle;
+
+	return( 1 );
+
+on_error:
+	if( safe_file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &safe_file_io_handle,
+		 NULL );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	libcthreads_mutex_release(
+	 mount_handle->file_io_handles_mutex,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Releases a file IO handle that was grabbed to read the inputs
+ * Returns 1 if successful or -1 on error
+ */
+int mount_handle_release_file_io_handle(
+     mount_handle_t *mount_handle,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_handle_release_file_io_handle";
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle == mount_handle->input_file_io_handle )
+	{
+		return( 1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     mount_handle->file_io_handles_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab file IO handles mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	mount_handle->available_file_io_handles[ mount_handle->number_of_available_file_io_handles ] = file_io_handle;
+
+	mount_handle->number_of_available_file_io_handles += 1;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     mount_handle->file_io_handles_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release file IO handles mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Reads a buffer from the specified input at a specific offset
+ * This function can be called concurrently, every call uses its own file IO handle if available
+ * Returns the number of bytes read if successful or -1 on error
+ */
+ssize_t mount_handle_read_buffer_at_offset(
+         mount_handle_t *mount_handle,
+         int store_index,
+         uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	static char *function            = "mount_handle_read_buffer_at_offset";
+	ssize_t read_count               = 0;
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( store_index < 0 )
+	 || ( store_index >= mount_handle->number_of_inputs ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: unsupported to store index value out of bounds: %d.",
+		 function,
+		 store_index );
+
+		return( -1 );
+	}
+	if( mount_handle->inputs[ store_index ] == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid mount handle - missing input: %d.",
+		 function,
+		 store_index );
+
+		return( -1 );
+	}
+	if( mount_handle_grab_file_io_handle(
+	     mount_handle,
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to grab file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	/* Only reads using the input file IO handle use the block cache of the input volume
+	 */
+	if( file_io_handle == mount_handle->input_file_io_handle )
+	{
+		read_count = libvshadow_store_read_buffer_at_offset(
+		              mount_handle->inputs[ store_index ],
+		              buffer,
+		              size,
+		              offset,
+		              error );
+	}
+	else
+	{
+		read_count = libvshadow_store_read_buffer_at_offset_from_file_io_handle(
+		              mount_handle->inputs[ store_index ],
+		              file_io_handle,
+		              buffer,
+		              size,
+		              offset,
+		              error );
+	}
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer from input: %d.",
+		 function,
+		 store_index );
+
+		mount_handle_release_file_io_handle(
+		 mount_handle,
+		 file_io_handle,
+		 NULL );
+
+		return( -1 );
+	}
+	if( mount_handle_release_file_io_handle(
+	     mount_handle,
+	     file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( read_count );
+}
+
+/* Retrieves the extent of the specified input at a specific offset
+ * The extent file offset contains the offset of the data relative to the start of the source file
+ * Returns 1 if successful, 0 if the offset is beyond the input size or -1 on error
+ */
+int mount_handle_get_extent_at_offset(
+     mount_handle_t *mount_handle,
+     int store_index,
+     off64_t offset,
+     size64_t *extent_size,
+     off64_t *extent_file_offset,
+     uint8_t *extent_type,
+     libcerror_error_t **error )
+{
+	static char *function      = "mount_handle_get_extent_at_offset";
+	off64_t extent_data_offset = 0;
+	int result                 = 0;
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( store_index < 0 )
+	 || ( store_index >= mount_handle->number_of_inputs ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: unsupported to store index value out of bounds: %d.",
+		 function,
+		 store_index );
+
+		return( -1 );
+	}
+	if( mount_handle->inputs[ store_index ] == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid mount handle - missing input: %d.",
+		 function,
+		 store_index );
+
+		return( -1 );
+	}
+	if( extent_file_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent file offset.",
+		 function );
+
+		return( -1 );
 	}
-	offset = libvshadow_store_seek_offset(
+	result = libvshadow_store_get_extent_at_offset(
 	          mount_handle->inputs[ store_index ],
 	          offset,
-	          whence,
+	          extent_size,
+	          &extent_data_offset,
+	          extent_type,
 	          error );
 
-	if( offset == -1 )
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset in input: %d.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve extent at offset: %" PRIi64 " from input: %d.",
 		 function,
+		 offset,
 		 store_index );
 
 		return( -1 );
 	}
-	return( offset );
+	else if( result != 0 )
+	{
+		*extent_file_offset = mount_handle->volume_offset + extent_data_offset;
+	}
+	return( result );
+}
+
+/* Retrieves the next range of the specified input, at or after a specific offset, that contains data
+ * Returns 1 if successful, 0 if no such range or -1 on error
+ */
+int mount_handle_get_next_data_range(
+     mount_handle_t *mount_handle,
+     int store_index,
+     off64_t offset,
+     off64_t *range_offset,
+     size64_t *range_size,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_handle_get_next_data_range";
+	int result            = 0;
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( store_index < 0 )
+	 || ( store_index >= mount_handle->number_of_inputs ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: unsupported to store index value out of bounds: %d.",
+		 function,
+		 store_index );
+
+		return( -1 );
+	}
+	if( mount_handle->inputs[ store_index ] == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid mount handle - missing input: %d.",
+		 function,
+		 store_index );
+
+		return( -1 );
+	}
+	result = libvshadow_store_get_next_data_range(
+	          mount_handle->inputs[ store_index ],
+	          offset,
+	          range_offset,
+	          range_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve next data range at offset: %" PRIi64 " from input: %d.",
+		 function,
+		 offset,
+		 store_index );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Retrieves the index of the store the changes of the specified input are relative to
+ * The changes of a store are relative to the next newer store, the changes of the newest
+ * store are relative to the current volume, in which case the other store index is -1
+ * Returns 1 if successful or -1 on error
+ */
+int mount_handle_get_changes_comparison_index(
+     mount_handle_t *mount_handle,
+     int store_index,
+     int *other_store_index,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_handle_get_changes_comparison_index";
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( store_index < 0 )
+	 || ( store_index >= mount_handle->number_of_inputs ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: unsupported to store index value out of bounds: %d.",
+		 function,
+		 store_index );
+
+		return( -1 );
+	}
+	if( other_store_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid other store index.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( store_index + 1 ) < mount_handle->number_of_inputs )
+	{
+		*other_store_index = store_index + 1;
+	}
+	else
+	{
+		*other_store_index = -1;
+	}
+	return( 1 );
+}
+
+/* Reads a part of the changed blocks bitmap of the specified input at a specific offset
+ * Every bit represents a block of MOUNT_HANDLE_CHANGED_BLOCK_SIZE bytes, starting with
+ * the least significant bit of the first byte, that is set if the block was changed
+ * The bitmap is determined from the store metadata, no store data is read
+ * Returns the number of bytes read if successful or -1 on error
+ */
+ssize_t mount_handle_read_changed_blocks_at_offset(
+         mount_handle_t *mount_handle,
+         int store_index,
+         uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	static char *function = "mount_handle_read_changed_blocks_at_offset";
+	size64_t bitmap_size  = 0;
+	size64_t extent_size  = 0;
+	size64_t volume_size  = 0;
+	uint64_t block_index  = 0;
+	uint64_t first_block  = 0;
+	uint64_t last_block   = 0;
+	off64_t extent_end    = 0;
+	off64_t extent_offset = 0;
+	off64_t range_end     = 0;
+	off64_t range_offset  = 0;
+	off64_t search_offset = 0;
+	int other_store_index = 0;
+	int result            = 0;
+
+	if( mount_handle_get_changes_comparison_index(
+	     mount_handle,
+	     store_index,
+	     &other_store_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve comparison index of input: %d.",
+		 function,
+		 store_index );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvshadow_volume_get_size(
+	     mount_handle->input_volume,
+	     &volume_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve size from input volume.",
+		 function );
+
+		return( -1 );
+	}
+	bitmap_size = ( ( volume_size + MOUNT_HANDLE_CHANGED_BLOCK_SIZE - 1 ) / MOUNT_HANDLE_CHANGED_BLOCK_SIZE + 7 ) / 8;
+
+	if( (size64_t) offset >= bitmap_size )
+	{
+		return( 0 );
+	}
+	if( (size64_t) size > ( bitmap_size - offset ) )
+	{
+		size = (size_t) ( bitmap_size - offset );
+	}
+	if( memory_set(
+	     buffer,
+	     0,
+	     size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear buffer.",
+		 function );
+
+		return( -1 );
+	}
+	first_block   = (uint64_t) offset * 8;
+	range_offset  = (off64_t) ( first_block * MOUNT_HANDLE_CHANGED_BLOCK_SIZE );
+	range_end     = range_offset + (off64_t) ( (uint64_t) size * 8 * MOUNT_HANDLE_CHANGED_BLOCK_SIZE );
+	search_offset = range_offset;
+
+	while( search_offset < range_end )
+	{
+		result = libvshadow_volume_get_next_changed_extent(
+		          mount_handle->input_volume,
+		          store_index,
+		          other_store_index,
+		          search_offset,
+		          &extent_offset,
+		          &extent_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve next changed extent at offset: %" PRIi64 " of input: %d.",
+			 function,
+			 search_offset,
+			 store_index );
+
+			return( -1 );
+		}
+		else if( ( result == 0 )
+		      || ( extent_size == 0 )
+		      || ( extent_offset >= range_end ) )
+		{
+			break;
+		}
+		extent_end = extent_offset + (off64_t) extent_size;
+
+		if( extent_offset < range_offset )
+		{
+			extent_offset = range_offset;
+		}
+		if( extent_end > range_end )
+		{
+			extent_end = range_end;
+		}
+		block_index = ( (uint64_t) extent_offset / MOUNT_HANDLE_CHANGED_BLOCK_SIZE ) - first_block;
+		last_block  = ( ( (uint64_t) extent_end + MOUNT_HANDLE_CHANGED_BLOCK_SIZE - 1 ) / MOUNT_HANDLE_CHANGED_BLOCK_SIZE ) - first_block;
+
+		while( block_index < last_block )
+		{
+			buffer[ block_index / 8 ] |= (uint8_t) ( 1 << ( block_index % 8 ) );
+
+			block_index++;
+		}
+		search_offset = extent_end;
+	}
+	return( (ssize_t) size );
+}
+
+/* Creates the changed extents list of the specified input if not already created
+ * The list is a comma separated values (CSV) text with the offset and size of every
+ * changed extent, which is determined from the store metadata when the list is first used
+ * Returns 1 if successful or -1 on error
+ */
+int mount_handle_create_changed_extents_list(
+     mount_handle_t *mount_handle,
+     int store_index,
+     libcerror_error_t **error )
+{
+	char line[ 64 ];
+
+	uint8_t *reallocation    = NULL;
+	uint8_t *safe_list_data  = NULL;
+	static char *function    = "mount_handle_create_changed_extents_list";
+	size64_t extent_size     = 0;
+	size_t allocated_size    = 0;
+	size_t line_length       = 0;
+	size_t safe_list_size    = 0;
+	off64_t extent_offset    = 0;
+	off64_t search_offset    = 0;
+	int other_store_index    = 0;
+	int print_count          = 0;
+	int result               = 0;
+
+	if( mount_handle_get_changes_comparison_index(
+	     mount_handle,
+	     store_index,
+	     &other_store_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve comparison index of input: %d.",
+		 function,
+		 store_index );
+
+		return( -1 );
+	}
+	if( mount_handle->changed_extents_lists == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid mount handle - missing changed extents lists.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     mount_handle->changed_extents_lists_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab changed extents lists mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( mount_handle->changed_extents_lists[ store_index ] == NULL )
+	{
+		allocated_size = 4096;
+
+		safe_list_data = (uint8_t *) memory_allocate(
+		                              sizeof( uint8_t ) * allocated_size );
+
+		if( safe_list_data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create list data.",
+			 function );
+
+			goto on_error;
+		}
+		safe_list_size = 12;
+
+		if( memory_copy(
+		     safe_list_data,
+		     "offset,size\n",
+		     safe_list_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy list header.",
+			 function );
+
+			goto on_error;
+		}
+		do
+		{
+			result = libvshadow_volume_get_next_changed_extent(
+			          mount_handle->input_volume,
+			          store_index,
+			          other_store_index,
+			          search_offset,
+			          &extent_offset,
+			          &extent_size,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve next changed extent at offset: %" PRIi64 " of input: %d.",
+				 function,
+				 search_offset,
+				 store_index );
+
+				goto on_error;
+			}
+			else if( ( result == 0 )
+			      || ( extent_size == 0 ) )
+			{
+				break;
+			}
+			print_count = narrow_string_snprintf(
+			               line,
+			               64,
+			               "%" PRIi64 ",%" PRIu64 "\n",
+			               extent_offset,
+			               extent_size );
+
+			if( ( print_count < 0 )
+			 || ( print_count >= 64 ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set list line.",
+				 function );
+
+				goto on_error;
+			}
+			line_length = (size_t) print_count;
+
+			if( ( safe_list_size + line_length ) > allocated_size )
+			{
+				allocated_size *= 2;
+
+				reallocation = (uint8_t *) memory_reallocate(
+				                            safe_list_data,
+				                            sizeof( uint8_t ) * allocated_size );
+
+				if( reallocation == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+					 "%s: unable to resize list data.",
+					 function );
+
+					goto on_error;
+				}
+				safe_list_data = reallocation;
+			}
+			if( memory_copy(
+			     &( safe_list_data[ safe_list_size ] ),
+			     line,
+			     line_length ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy list line.",
+				 function );
+
+				goto on_error;
+			}
+			safe_list_size += line_length;
+
+			search_offset = extent_offset + (off64_t) extent_size;
+		}
+		while( result == 1 );
+
+		mount_handle->changed_extents_lists[ store_index ]      = safe_list_data;
+		mount_handle->changed_extents_list_sizes[ store_index ] = safe_list_size;
+
+		safe_list_data = NULL;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     mount_handle->changed_extents_lists_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release changed extents lists mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( safe_list_data != NULL )
+	{
+		memory_free(
+		 safe_list_data );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	libcthreads_mutex_release(
+	 mount_handle->changed_extents_lists_mutex,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Reads the changed extents list of the specified input at a specific offset
+ * The list is created if not already created
+ * Returns the number of bytes read if successful or -1 on error
+ */
+ssize_t mount_handle_read_changed_extents_list_at_offset(
+         mount_handle_t *mount_handle,
+         int store_index,
+         uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	static char *function = "mount_handle_read_changed_extents_list_at_offset";
+	size_t list_data_size = 0;
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( mount_handle->changed_extents_lists == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid mount handle - missing changed extents lists.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( store_index < 0 )
+	 || ( store_index >= mount_handle->number_of_inputs ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: unsupported to store index value out of bounds: %d.",
+		 function,
+		 store_index );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( mount_handle_create_changed_extents_list(
+	     mount_handle,
+	     store_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create changed extents list of input: %d.",
+		 function,
+		 store_index );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     mount_handle->changed_extents_lists_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab changed extents lists mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	list_data_size = mount_handle->changed_extents_list_sizes[ store_index ];
+
+	if( (size64_t) offset >= (size64_t) list_data_size )
+	{
+		size = 0;
+	}
+	else if( size > ( list_data_size - (size_t) offset ) )
+	{
+		size = list_data_size - (size_t) offset;
+	}
+	if( size > 0 )
+	{
+		if( memory_copy(
+		     buffer,
+		     &( ( mount_handle->changed_extents_lists[ store_index ] )[ offset ] ),
+		     size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy changed extents list data.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     mount_handle->changed_extents_lists_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release changed extents lists mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( (ssize_t) size );
+
+on_error:
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	libcthreads_mutex_release(
+	 mount_handle->changed_extents_lists_mutex,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Retrieves the size of the changes of the specified input in a specific format
+ * The changed extents list is created if not already created to determine its size
+ * Returns 1 if successful or -1 on error
+ */
+int mount_handle_get_changes_size(
+     mount_handle_t *mount_handle,
+     int store_index,
+     int changes_format,
+     size64_t *size,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_handle_get_changes_size";
+	size64_t volume_size  = 0;
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid size.",
+		 function );
+
+		return( -1 );
+	}
+	switch( changes_format )
+	{
+		case MOUNT_HANDLE_CHANGES_FORMAT_BLOCKS_BITMAP:
+			if( libvshadow_volume_get_size(
+			     mount_handle->input_volume,
+			     &volume_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve size from input volume.",
+				 function );
+
+				return( -1 );
+			}
+			*size = ( ( volume_size + MOUNT_HANDLE_CHANGED_BLOCK_SIZE - 1 ) / MOUNT_HANDLE_CHANGED_BLOCK_SIZE + 7 ) / 8;
+
+			break;
+
+		case MOUNT_HANDLE_CHANGES_FORMAT_EXTENTS_LIST:
+			if( mount_handle_create_changed_extents_list(
+			     mount_handle,
+			     store_index,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create changed extents list of input: %d.",
+				 function,
+				 store_index );
+
+				return( -1 );
+			}
+			/* The list is not changed once created
+			 */
+			*size = (size64_t) mount_handle->changed_extents_list_sizes[ store_index ];
+
+			break;
+
+		default:
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported changes format.",
+			 function );
+
+			return( -1 );
+	}
+	return( 1 );
+}
+
+/* Reads the changes of the specified input in a specific format at a specific offset
+ * Returns the number of bytes read if successful or -1 on error
+ */
+ssize_t mount_handle_read_changes_at_offset(
+         mount_handle_t *mount_handle,
+         int store_index,
+         int changes_format,
+         uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	static char *function = "mount_handle_read_changes_at_offset";
+	ssize_t read_count    = 0;
+
+	switch( changes_format )
+	{
+		case MOUNT_HANDLE_CHANGES_FORMAT_BLOCKS_BITMAP:
+			read_count = mount_handle_read_changed_blocks_at_offset(
+			              mount_handle,
+			              store_index,
+			              buffer,
+			              size,
+			              offset,
+			              error );
+
+			if( read_count == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read changed blocks of input: %d.",
+				 function,
+				 store_index );
+
+				return( -1 );
+			}
+			break;
+
+		case MOUNT_HANDLE_CHANGES_FORMAT_EXTENTS_LIST:
+			read_count = mount_handle_read_changed_extents_list_at_offset(
+			              mount_handle,
+			              store_index,
+			              buffer,
+			              size,
+			              offset,
+			              error );
+
+			if( read_count == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read changed extents list of input: %d.",
+				 function,
+				 store_index );
+
+				return( -1 );
+			}
+			break;
+
+		default:
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported changes format.",
+			 function );
+
+			return( -1 );
+	}
+	return( read_count );
 }
 
 /* Retrieves the size of the input volume
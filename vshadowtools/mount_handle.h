@@ -28,12 +28,26 @@
 
 #include "vshadowtools_libbfio.h"
 #include "vshadowtools_libcerror.h"
+#include "vshadowtools_libcthreads.h"
 #include "vshadowtools_libvshadow.h"
 
 #if defined( __cplusplus )
 extern "C" {
 #endif
 
+#define MOUNT_HANDLE_MAXIMUM_NUMBER_OF_FILE_IO_HANDLES	16
+
+/* The size of the blocks represented by a bit in the changed blocks bitmap
+ * This matches the block size used by VSS
+ */
+#define MOUNT_HANDLE_CHANGED_BLOCK_SIZE			16384
+
+enum MOUNT_HANDLE_CHANGES_FORMATS
+{
+	MOUNT_HANDLE_CHANGES_FORMAT_BLOCKS_BITMAP	= 1,
+	MOUNT_HANDLE_CHANGES_FORMAT_EXTENTS_LIST	= 2
+};
+
 typedef struct mount_handle mount_handle_t;
 
 struct mount_handle
@@ -58,6 +72,49 @@ struct mount_handle
 	 */
 	int number_of_inputs;
 
+	/* The file IO handles used to read the inputs concurrently
+	 * Contains clones of the input file IO handle
+	 */
+	libbfio_handle_t **file_io_handles;
+
+	/* The number of file IO handles
+	 */
+	int number_of_file_io_handles;
+
+	/* The maximum number of file IO handles
+	 */
+	int maximum_number_of_file_io_handles;
+
+	/* The file IO handles that are not in use
+	 */
+	libbfio_handle_t **available_file_io_handles;
+
+	/* The number of file IO handles that are not in use
+	 */
+	int number_of_available_file_io_handles;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The file IO handles mutex
+	 */
+	libcthreads_mutex_t *file_io_handles_mutex;
+#endif
+
+	/* The changed extents lists of the inputs
+	 * Contains a comma separated values (CSV) text per input that is created when first used
+	 * and kept until the mount handle is closed
+	 */
+	uint8_t **changed_extents_lists;
+
+	/* The sizes of the changed extents lists
+	 */
+	size_t *changed_extents_list_sizes;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The changed extents lists mutex
+	 */
+	libcthreads_mutex_t *changed_extents_lists_mutex;
+#endif
+
 	/* The notification output stream
 	 */
 	FILE *notify_stream;
@@ -99,18 +156,82 @@ int mount_handle_close_input(
      mount_handle_t *mount_handle,
      libcerror_error_t **error );
 
-ssize_t mount_handle_read_buffer(
+int mount_handle_grab_file_io_handle(
+     mount_handle_t *mount_handle,
+     libbfio_handle_t **file_io_handle,
+     libcerror_error_t **error );
+
+int mount_handle_release_file_io_handle(
+     mount_handle_t *mount_handle,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+ssize_t mount_handle_read_buffer_at_offset(
          mount_handle_t *mount_handle,
          int store_index,
          uint8_t *buffer,
          size_t size,
+         off64_t offset,
          libcerror_error_t **error );
 
-off64_t mount_handle_seek_offset(
+int mount_handle_get_extent_at_offset(
+     mount_handle_t *mount_handle,
+     int store_index,
+     off64_t offset,
+     size64_t *extent_size,
+     off64_t *extent_file_offset,
+     uint8_t *extent_type,
+     libcerror_error_t **error );
+
+int mount_handle_get_next_data_range(
+     mount_handle_t *mount_handle,
+     int store_index,
+     off64_t offset,
+     off64_t *range_offset,
+     size64_t *range_size,
+     libcerror_error_t **error );
+
+int mount_handle_get_changes_comparison_index(
+     mount_handle_t *mount_handle,
+     int store_index,
+     int *other_store_index,
+     libcerror_error_t **error );
+
+ssize_t mount_handle_read_changed_blocks_at_offset(
+         mount_handle_t *mount_handle,
+         int store_index,
+         uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+int mount_handle_create_changed_extents_list(
+     mount_handle_t *mount_handle,
+     int store_index,
+     libcerror_error_t **error );
+
+ssize_t mount_handle_read_changed_extents_list_at_offset(
+         mount_handle_t *mount_handle,
+         int store_index,
+         uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+int mount_handle_get_changes_size(
+     mount_handle_t *mount_handle,
+     int store_index,
+     int changes_format,
+     size64_t *size,
+     libcerror_error_t **error );
+
+ssize_t mount_handle_read_changes_at_offset(
          mount_handle_t *mount_handle,
          int store_index,
+         int changes_format,
+         uint8_t *buffer,
+         size_t size,
          off64_t offset,
-         int whence,
          libcerror_error_t **error );
 
 int mount_handle_get_size(
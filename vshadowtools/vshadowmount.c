@@ -44,6 +44,10 @@
 #include <unistd.h>
 #endif
 
+#if defined( HAVE_FCNTL_H )
+#include <fcntl.h>
+#endif
+
 #if !defined( WINAPI ) || defined( USE_CRT_FUNCTIONS )
 #if defined( TIME_WITH_SYS_TIME )
 #include <sys/time.h>
@@ -56,7 +60,12 @@
 #endif
 
 #if defined( HAVE_LIBFUSE ) || defined( HAVE_LIBOSXFUSE )
+
+#if defined( HAVE_LIBFUSE3 )
+#define FUSE_USE_VERSION	30
+#else
 #define FUSE_USE_VERSION	26
+#endif
 
 #if defined( HAVE_LIBFUSE )
 #include <fuse.h>
@@ -65,6 +74,24 @@
 #include <osxfuse/fuse.h>
 #endif
 
+/* The read_buf operation was introduced in fuse 2.9
+ */
+#if defined( HAVE_LIBFUSE ) && defined( FUSE_VERSION ) && ( FUSE_VERSION >= 29 )
+#define VSHADOWMOUNT_HAVE_FUSE_READ_BUF
+#endif
+
+/* The connection capabilities were introduced in fuse 2.8
+ */
+#if defined( FUSE_VERSION ) && ( FUSE_VERSION >= 28 )
+#define VSHADOWMOUNT_HAVE_FUSE_CONNECTION_CAPABILITIES
+#endif
+
+/* The lseek operation was introduced in fuse 3.8
+ */
+#if defined( HAVE_LIBFUSE3 ) && defined( FUSE_VERSION ) && ( FUSE_VERSION >= FUSE_MAKE_VERSION( 3, 8 ) ) && defined( SEEK_DATA ) && defined( SEEK_HOLE )
+#define VSHADOWMOUNT_HAVE_FUSE_LSEEK
+#endif
+
 #elif defined( HAVE_LIBDOKAN )
 #include <dokan.h>
 #endif
@@ -79,6 +106,8 @@
 #include "vshadowtools_signal.h"
 #include "vshadowtools_unused.h"
 
+#define VSHADOWMOUNT_DEFAULT_CACHE_TIMEOUT		3600
+
 mount_handle_t *vshadowmount_mount_handle = NULL;
 int vshadowmount_abort                    = 0;
 
@@ -94,20 +123,98 @@ void usage_fprint(
 	fprintf( stream, "Use vshadowmount to mount a Windows NT Volume Shadow Snapshot (VSS)\n"
 	                 "volume\n\n" );
 
-	fprintf( stream, "Usage: vshadowmount [ -o offset ] [ -X extended_options ]\n"
-	                 "                    [ -hvV ] source mount_point\n\n" );
+	fprintf( stream, "Usage: vshadowmount [ -a readahead_size ] [ -o offset ]\n"
+	                 "                    [ -r read_size ] [ -t timeout ]\n"
+	                 "                    [ -X extended_options ] [ -hnvV ] source\n"
+	                 "                    mount_point\n\n" );
 
 	fprintf( stream, "\tsource:      the source file or device\n" );
 	fprintf( stream, "\tmount_point: the directory to serve as mount point\n\n" );
 
+	fprintf( stream, "\t-a:          specify an upper bound of the kernel read ahead size\n"
+	                 "\t             in bytes, by default the kernel read ahead size is used\n" );
 	fprintf( stream, "\t-h:          shows this help\n" );
+	fprintf( stream, "\t-n:          do not use the kernel page cache (direct I/O) and\n"
+	                 "\t             do not cache the attributes and entries\n" );
 	fprintf( stream, "\t-o:          specify the volume offset in bytes\n" );
+	fprintf( stream, "\t-r:          specify an upper bound of the read request size in bytes,\n"
+	                 "\t             by default the fuse read request size is used\n" );
+	fprintf( stream, "\t-t:          specify the number of seconds the attributes and\n"
+	                 "\t             entries are cached (default is 3600)\n" );
 	fprintf( stream, "\t-v:          verbose output to stderr\n"
 	                 "\t             vshadowmount will remain running in the foreground\n" );
 	fprintf( stream, "\t-V:          print version\n" );
 	fprintf( stream, "\t-X:          extended options to pass to sub system\n" );
 }
 
+/* Copies a size or time out value from an option string
+ * Returns 1 if successful or -1 on error
+ */
+int vshadowmount_copy_option_value_from_string(
+     const system_character_t *string,
+     uint32_t *value_32bit,
+     libcerror_error_t **error )
+{
+	static char *function = "vshadowmount_copy_option_value_from_string";
+	size_t string_length  = 0;
+	uint64_t value_64bit  = 0;
+
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_32bit == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value 32-bit.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( vshadowtools_system_string_copy_from_64_bit_in_decimal(
+	     string,
+	     string_length + 1,
+	     &value_64bit,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to 64-bit decimal.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_64bit > (uint64_t) INT32_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	*value_32bit = (uint32_t) value_64bit;
+
+	return( 1 );
+}
+
 /* Signal handler for vshadowmount
  */
 void vshadowmount_signal_handler(
@@ -161,10 +268,194 @@ void vshadowmount_signal_handler(
 static char *vshadowmount_fuse_path_prefix         = "/vss";
 static size_t vshadowmount_fuse_path_prefix_length = 4;
 
+/* The suffixes of the files that contain the changes of a store relative to the next newer store
+ */
+static char *vshadowmount_fuse_changed_blocks_suffix          = ".changed_blocks";
+static size_t vshadowmount_fuse_changed_blocks_suffix_length  = 15;
+static char *vshadowmount_fuse_changed_extents_suffix         = ".changed_extents.csv";
+static size_t vshadowmount_fuse_changed_extents_suffix_length = 20;
+
 #if defined( HAVE_TIME )
 time_t vshadowmount_timestamp                      = 0;
 #endif
 
+#if defined( VSHADOWMOUNT_HAVE_FUSE_READ_BUF )
+int vshadowmount_source_file_descriptor            = -1;
+#endif
+
+/* The contents of the stores do not change, which allows the kernel to cache them
+ * unless direct I/O is used
+ */
+uint8_t vshadowmount_fuse_direct_io                = 0;
+uint32_t vshadowmount_fuse_maximum_readahead_size  = 0;
+
+/* Determines the input index and changes format from a path
+ * The changes format is 0 if the path refers to the input itself
+ * Returns 1 if successful, 0 if the path is not supported or -1 on error
+ */
+int vshadowmount_fuse_get_input_index_from_path(
+     const char *path,
+     int *input_index,
+     int *changes_format,
+     libcerror_error_t **error )
+{
+	static char *function    = "vshadowmount_fuse_get_input_index_from_path";
+	size_t path_length       = 0;
+	size_t string_index      = 0;
+	size_t suffix_length     = 0;
+	int safe_changes_format  = 0;
+	int safe_input_index     = 0;
+
+	if( path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path.",
+		 function );
+
+		return( -1 );
+	}
+	if( input_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid input index.",
+		 function );
+
+		return( -1 );
+	}
+	if( changes_format == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid changes format.",
+		 function );
+
+		return( -1 );
+	}
+	path_length = narrow_string_length(
+	               path );
+
+	if( ( path_length <= vshadowmount_fuse_path_prefix_length )
+	 || ( narrow_string_compare(
+	       path,
+	       vshadowmount_fuse_path_prefix,
+	       vshadowmount_fuse_path_prefix_length ) != 0 ) )
+	{
+		return( 0 );
+	}
+	if( ( path_length > vshadowmount_fuse_changed_blocks_suffix_length )
+	 && ( narrow_string_compare(
+	       &( path[ path_length - vshadowmount_fuse_changed_blocks_suffix_length ] ),
+	       vshadowmount_fuse_changed_blocks_suffix,
+	       vshadowmount_fuse_changed_blocks_suffix_length ) == 0 ) )
+	{
+		safe_changes_format = MOUNT_HANDLE_CHANGES_FORMAT_BLOCKS_BITMAP;
+		suffix_length       = vshadowmount_fuse_changed_blocks_suffix_length;
+	}
+	else if( ( path_length > vshadowmount_fuse_changed_extents_suffix_length )
+	      && ( narrow_string_compare(
+	            &( path[ path_length - vshadowmount_fuse_changed_extents_suffix_length ] ),
+	            vshadowmount_fuse_changed_extents_suffix,
+	            vshadowmount_fuse_changed_extents_suffix_length ) == 0 ) )
+	{
+		safe_changes_format = MOUNT_HANDLE_CHANGES_FORMAT_EXTENTS_LIST;
+		suffix_length       = vshadowmount_fuse_changed_extents_suffix_length;
+	}
+	path_length -= suffix_length;
+
+	if( ( path_length <= vshadowmount_fuse_path_prefix_length )
+	 || ( path_length > ( vshadowmount_fuse_path_prefix_length + 3 ) ) )
+	{
+		return( 0 );
+	}
+	for( string_index = vshadowmount_fuse_path_prefix_length;
+	     string_index < path_length;
+	     string_index++ )
+	{
+		if( ( path[ string_index ] < '0' )
+		 || ( path[ string_index ] > '9' ) )
+		{
+			return( 0 );
+		}
+		safe_input_index *= 10;
+		safe_input_index += path[ string_index ] - '0';
+	}
+	if( safe_input_index == 0 )
+	{
+		return( 0 );
+	}
+	*input_index    = safe_input_index - 1;
+	*changes_format = safe_changes_format;
+
+	return( 1 );
+}
+
+/* Initializes the fuse connection
+ * Returns the private data of the fuse context
+ */
+#if defined( HAVE_LIBFUSE3 )
+void *vshadowmount_fuse_init(
+       struct fuse_conn_info *connection_info,
+       struct fuse_config *configuration VSHADOWTOOLS_ATTRIBUTE_UNUSED )
+#else
+void *vshadowmount_fuse_init(
+       struct fuse_conn_info *connection_info )
+#endif
+{
+	struct fuse_context *fuse_context = NULL;
+
+#if defined( HAVE_LIBFUSE3 )
+	VSHADOWTOOLS_UNREFERENCED_PARAMETER( configuration )
+#endif
+
+	if( connection_info != NULL )
+	{
+		/* The read ahead size can only be lowered from the one proposed by the kernel
+		 */
+		if( ( vshadowmount_fuse_maximum_readahead_size != 0 )
+		 && ( vshadowmount_fuse_maximum_readahead_size < connection_info->max_readahead ) )
+		{
+			connection_info->max_readahead = vshadowmount_fuse_maximum_readahead_size;
+		}
+
+#if defined( VSHADOWMOUNT_HAVE_FUSE_CONNECTION_CAPABILITIES )
+		if( ( connection_info->capable & FUSE_CAP_ASYNC_READ ) != 0 )
+		{
+			connection_info->want |= FUSE_CAP_ASYNC_READ;
+		}
+#endif
+#if defined( VSHADOWMOUNT_HAVE_FUSE_READ_BUF )
+		/* Allow fuse to splice the data referenced by file descriptor to the kernel
+		 */
+		if( vshadowmount_source_file_descriptor != -1 )
+		{
+			if( ( connection_info->capable & FUSE_CAP_SPLICE_WRITE ) != 0 )
+			{
+				connection_info->want |= FUSE_CAP_SPLICE_WRITE;
+			}
+			if( ( connection_info->capable & FUSE_CAP_SPLICE_MOVE ) != 0 )
+			{
+				connection_info->want |= FUSE_CAP_SPLICE_MOVE;
+			}
+		}
+#endif
+	}
+	fuse_context = fuse_get_context();
+
+	if( fuse_context == NULL )
+	{
+		return( NULL );
+	}
+	return( fuse_context->private_data );
+}
+
 /* Opens a file
  * Returns 0 if successful or a negative errno value otherwise
  */
@@ -174,7 +465,8 @@ int vshadowmount_fuse_open(
 {
 	libcerror_error_t *error = NULL;
 	static char *function    = "vshadowmount_fuse_open";
-	size_t path_length       = 0;
+	int changes_format       = 0;
+	int input_index          = 0;
 	int result               = 0;
 
 	if( path == NULL )
@@ -203,15 +495,26 @@ int vshadowmount_fuse_open(
 
 		goto on_error;
 	}
-	path_length = narrow_string_length(
-	               path );
+	result = vshadowmount_fuse_get_input_index_from_path(
+	          path,
+	          &input_index,
+	          &changes_format,
+	          &error );
 
-	if( ( path_length <= vshadowmount_fuse_path_prefix_length )
-	 || ( path_length > ( vshadowmount_fuse_path_prefix_length + 3 ) )
-	 || ( narrow_string_compare(
-	       path,
-	       vshadowmount_fuse_path_prefix,
-	       vshadowmount_fuse_path_prefix_length ) != 0 ) )
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine input index from path.",
+		 function );
+
+		result = -EIO;
+
+		goto on_error;
+	}
+	else if( result == 0 )
 	{
 		libcerror_error_set(
 		 &error,
@@ -220,23 +523,575 @@ int vshadowmount_fuse_open(
 		 "%s: unsupported path.",
 		 function );
 
-		result = -ENOENT;
+		result = -ENOENT;
+
+		goto on_error;
+	}
+	if( input_index >= vshadowmount_mount_handle->number_of_inputs )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid input index value out of bounds.",
+		 function );
+
+		result = -ENOENT;
+
+		goto on_error;
+	}
+	if( ( file_info->flags & 0x03 ) != O_RDONLY )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: write access currently not supported.",
+		 function );
+
+		result = -EACCES;
+
+		goto on_error;
+	}
+	/* The changed extents list is created on the first getattr or open of the file
+	 */
+	if( changes_format == MOUNT_HANDLE_CHANGES_FORMAT_EXTENTS_LIST )
+	{
+		if( mount_handle_create_changed_extents_list(
+		     vshadowmount_mount_handle,
+		     input_index,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create changed extents list.",
+			 function );
+
+			result = -EIO;
+
+			goto on_error;
+		}
+	}
+	if( vshadowmount_fuse_direct_io != 0 )
+	{
+		file_info->direct_io = 1;
+	}
+	else
+	{
+		file_info->keep_cache = 1;
+	}
+	return( 0 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	return( result );
+}
+
+/* Reads a buffer of data at the specified offset
+ * Returns number of bytes read if successful or a negative errno value otherwise
+ */
+int vshadowmount_fuse_read(
+     const char *path,
+     char *buffer,
+     size_t size,
+     off_t offset,
+     struct fuse_file_info *file_info )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "vshadowmount_fuse_read";
+	ssize_t read_count       = 0;
+	int changes_format       = 0;
+	int input_index          = 0;
+	int result               = 0;
+
+	if( path == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path.",
+		 function );
+
+		result = -EINVAL;
+
+		goto on_error;
+	}
+	if( size > (size_t) INT_MAX )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		result = -EINVAL;
+
+		goto on_error;
+	}
+	if( file_info == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file info.",
+		 function );
+
+		result = -EINVAL;
+
+		goto on_error;
+	}
+	result = vshadowmount_fuse_get_input_index_from_path(
+	          path,
+	          &input_index,
+	          &changes_format,
+	          &error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine input index from path.",
+		 function );
+
+		result = -EIO;
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported path.",
+		 function );
+
+		result = -ENOENT;
+
+		goto on_error;
+	}
+
+	if( changes_format != 0 )
+	{
+		read_count = mount_handle_read_changes_at_offset(
+		              vshadowmount_mount_handle,
+		              input_index,
+		              changes_format,
+		              (uint8_t *) buffer,
+		              size,
+		              (off64_t) offset,
+		              &error );
+	}
+	else
+	{
+		read_count = mount_handle_read_buffer_at_offset(
+		              vshadowmount_mount_handle,
+		              input_index,
+		              (uint8_t *) buffer,
+		              size,
+		              (off64_t) offset,
+		              &error );
+	}
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read from mount handle.",
+		 function );
+
+		result = -EIO;
+
+		goto on_error;
+	}
+	return( (int) read_count );
+
+on_error:
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	return( result );
+}
+
+#if defined( VSHADOWMOUNT_HAVE_FUSE_READ_BUF )
+
+/* Reads a buffer of data at the specified offset into a buffer vector
+ * The data of extents that are stored in the source file is referenced by file descriptor,
+ * which allows fuse to splice it, only sparse extents are filled in memory
+ * Returns 0 if successful or a negative errno value otherwise
+ */
+int vshadowmount_fuse_read_buf(
+     const char *path,
+     struct fuse_bufvec **buffer_vector,
+     size_t size,
+     off_t offset,
+     struct fuse_file_info *file_info )
+{
+	struct fuse_bufvec *reallocation       = NULL;
+	struct fuse_bufvec *safe_buffer_vector = NULL;
+	struct fuse_buf *buffer                = NULL;
+	libcerror_error_t *error               = NULL;
+	uint8_t *segment_data                  = NULL;
+	static char *function                  = "vshadowmount_fuse_read_buf";
+	size64_t extent_size                   = 0;
+	off64_t extent_file_offset             = 0;
+	size_t number_of_segments              = 0;
+	size_t segment_index                   = 0;
+	size_t segment_size                    = 0;
+	ssize_t read_count                     = 0;
+	uint8_t extent_type                    = 0;
+	int changes_format                     = 0;
+	int input_index                        = 0;
+	int result                             = 0;
+
+	if( path == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path.",
+		 function );
+
+		result = -EINVAL;
+
+		goto on_error;
+	}
+	if( buffer_vector == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer vector.",
+		 function );
+
+		result = -EINVAL;
+
+		goto on_error;
+	}
+	if( size > (size_t) INT_MAX )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		result = -EINVAL;
+
+		goto on_error;
+	}
+	if( file_info == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file info.",
+		 function );
+
+		result = -EINVAL;
+
+		goto on_error;
+	}
+	result = vshadowmount_fuse_get_input_index_from_path(
+	          path,
+	          &input_index,
+	          &changes_format,
+	          &error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine input index from path.",
+		 function );
+
+		result = -EIO;
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported path.",
+		 function );
+
+		result = -ENOENT;
+
+		goto on_error;
+	}
+
+	/* The buffer vector and the memory of its buffers are freed by fuse
+	 */
+	safe_buffer_vector = (struct fuse_bufvec *) memory_allocate(
+	                                             sizeof( struct fuse_bufvec ) );
+
+	if( safe_buffer_vector == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffer vector.",
+		 function );
+
+		result = -ENOMEM;
+
+		goto on_error;
+	}
+	if( memory_set(
+	     safe_buffer_vector,
+	     0,
+	     sizeof( struct fuse_bufvec ) ) == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear buffer vector.",
+		 function );
+
+		result = -ENOMEM;
+
+		goto on_error;
+	}
+	number_of_segments = 1;
+
+	/* The changes are generated in memory
+	 */
+	if( ( changes_format != 0 )
+	 && ( size > 0 ) )
+	{
+		segment_data = (uint8_t *) memory_allocate(
+		                            sizeof( uint8_t ) * size );
+
+		if( segment_data == NULL )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create segment data.",
+			 function );
+
+			result = -ENOMEM;
+
+			goto on_error;
+		}
+		read_count = mount_handle_read_changes_at_offset(
+		              vshadowmount_mount_handle,
+		              input_index,
+		              changes_format,
+		              segment_data,
+		              size,
+		              (off64_t) offset,
+		              &error );
+
+		if( read_count == -1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read changes from mount handle.",
+			 function );
+
+			result = -EIO;
+
+			goto on_error;
+		}
+		buffer = &( safe_buffer_vector->buf[ 0 ] );
+
+		buffer->mem  = segment_data;
+		buffer->size = (size_t) read_count;
+		buffer->fd   = -1;
+		segment_data = NULL;
+
+		safe_buffer_vector->count = 1;
+
+		size = 0;
+	}
+	while( size > 0 )
+	{
+		result = mount_handle_get_extent_at_offset(
+		          vshadowmount_mount_handle,
+		          input_index,
+		          (off64_t) offset,
+		          &extent_size,
+		          &extent_file_offset,
+		          &extent_type,
+		          &error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve extent from mount handle.",
+			 function );
+
+			result = -EIO;
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			break;
+		}
+		segment_size = size;
+
+		if( extent_size < (size64_t) segment_size )
+		{
+			segment_size = (size_t) extent_size;
+		}
+		if( safe_buffer_vector->count >= number_of_segments )
+		{
+			reallocation = (struct fuse_bufvec *) memory_reallocate(
+			                                       safe_buffer_vector,
+			                                       sizeof( struct fuse_bufvec ) + ( sizeof( struct fuse_buf ) * ( ( number_of_segments * 2 ) - 1 ) ) );
+
+			if( reallocation == NULL )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to resize buffer vector.",
+				 function );
+
+				result = -ENOMEM;
+
+				goto on_error;
+			}
+			safe_buffer_vector  = reallocation;
+			number_of_segments *= 2;
+		}
+		buffer = &( safe_buffer_vector->buf[ safe_buffer_vector->count ] );
+
+		if( memory_set(
+		     buffer,
+		     0,
+		     sizeof( struct fuse_buf ) ) == NULL )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear buffer.",
+			 function );
+
+			result = -ENOMEM;
+
+			goto on_error;
+		}
+		if( ( extent_type != LIBVSHADOW_EXTENT_TYPE_SPARSE )
+		 && ( vshadowmount_source_file_descriptor != -1 ) )
+		{
+			buffer->flags = FUSE_BUF_IS_FD | FUSE_BUF_FD_SEEK;
+			buffer->fd    = vshadowmount_source_file_descriptor;
+			buffer->pos   = (off_t) extent_file_offset;
+		}
+		else
+		{
+			segment_data = (uint8_t *) memory_allocate(
+			                            sizeof( uint8_t ) * segment_size );
+
+			if( segment_data == NULL )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to create segment data.",
+				 function );
 
-		goto on_error;
-	}
-	if( ( file_info->flags & 0x03 ) != O_RDONLY )
-	{
-		libcerror_error_set(
-		 &error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
-		 "%s: write access currently not supported.",
-		 function );
+				result = -ENOMEM;
 
-		result = -EACCES;
+				goto on_error;
+			}
+			if( extent_type == LIBVSHADOW_EXTENT_TYPE_SPARSE )
+			{
+				if( memory_set(
+				     segment_data,
+				     0,
+				     segment_size ) == NULL )
+				{
+					libcerror_error_set(
+					 &error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+					 "%s: unable to clear segment data.",
+					 function );
+
+					result = -ENOMEM;
+
+					goto on_error;
+				}
+			}
+			else
+			{
+				read_count = mount_handle_read_buffer_at_offset(
+				              vshadowmount_mount_handle,
+				              input_index,
+				              segment_data,
+				              segment_size,
+				              (off64_t) offset,
+				              &error );
+
+				if( read_count != (ssize_t) segment_size )
+				{
+					libcerror_error_set(
+					 &error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read from mount handle.",
+					 function );
+
+					result = -EIO;
+
+					goto on_error;
+				}
+			}
+			buffer->mem  = segment_data;
+			buffer->fd   = -1;
+			segment_data = NULL;
+		}
+		buffer->size = segment_size;
 
-		goto on_error;
+		safe_buffer_vector->count += 1;
+
+		offset += (off_t) segment_size;
+		size   -= segment_size;
 	}
+	*buffer_vector = safe_buffer_vector;
+
 	return( 0 );
 
 on_error:
@@ -247,26 +1102,51 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
+	if( segment_data != NULL )
+	{
+		memory_free(
+		 segment_data );
+	}
+	if( safe_buffer_vector != NULL )
+	{
+		for( segment_index = 0;
+		     segment_index < safe_buffer_vector->count;
+		     segment_index++ )
+		{
+			if( safe_buffer_vector->buf[ segment_index ].mem != NULL )
+			{
+				memory_free(
+				 safe_buffer_vector->buf[ segment_index ].mem );
+			}
+		}
+		memory_free(
+		 safe_buffer_vector );
+	}
 	return( result );
 }
 
-/* Reads a buffer of data at the specified offset
- * Returns number of bytes read if successful or a negative errno value otherwise
+#endif /* defined( VSHADOWMOUNT_HAVE_FUSE_READ_BUF ) */
+
+#if defined( VSHADOWMOUNT_HAVE_FUSE_LSEEK )
+
+/* Determines the offset of the next data or hole at or after the specified offset
+ * The data and holes are determined from the store metadata, without reading data
+ * Returns the offset if successful or a negative errno value otherwise
  */
-int vshadowmount_fuse_read(
-     const char *path,
-     char *buffer,
-     size_t size,
-     off_t offset,
-     struct fuse_file_info *file_info )
+off_t vshadowmount_fuse_lseek(
+       const char *path,
+       off_t offset,
+       int whence,
+       struct fuse_file_info *file_info )
 {
 	libcerror_error_t *error = NULL;
-	static char *function    = "vshadowmount_fuse_read";
-	size_t path_length       = 0;
-	ssize_t read_count       = 0;
+	static char *function    = "vshadowmount_fuse_lseek";
+	size64_t range_size      = 0;
+	size64_t file_size       = 0;
+	off64_t range_offset     = 0;
+	off_t result             = 0;
+	int changes_format       = 0;
 	int input_index          = 0;
-	int result               = 0;
-	int string_index         = 0;
 
 	if( path == NULL )
 	{
@@ -281,13 +1161,14 @@ int vshadowmount_fuse_read(
 
 		goto on_error;
 	}
-	if( size > (size_t) INT_MAX )
+	if( ( whence != SEEK_DATA )
+	 && ( whence != SEEK_HOLE ) )
 	{
 		libcerror_error_set(
 		 &error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid size value exceeds maximum.",
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported whence.",
 		 function );
 
 		result = -EINVAL;
@@ -307,15 +1188,26 @@ int vshadowmount_fuse_read(
 
 		goto on_error;
 	}
-	path_length = narrow_string_length(
-	               path );
+	result = vshadowmount_fuse_get_input_index_from_path(
+	          path,
+	          &input_index,
+	          &changes_format,
+	          &error );
 
-	if( ( path_length <= vshadowmount_fuse_path_prefix_length )
-	 || ( path_length > ( vshadowmount_fuse_path_prefix_length + 3 ) )
-	 || ( narrow_string_compare(
-	       path,
-	       vshadowmount_fuse_path_prefix,
-	       vshadowmount_fuse_path_prefix_length ) != 0 ) )
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine input index from path.",
+		 function );
+
+		result = -EIO;
+
+		goto on_error;
+	}
+	else if( result == 0 )
 	{
 		libcerror_error_set(
 		 &error,
@@ -328,61 +1220,110 @@ int vshadowmount_fuse_read(
 
 		goto on_error;
 	}
-	string_index = vshadowmount_fuse_path_prefix_length;
 
-	input_index = path[ string_index++ ] - '0';
-
-	if( string_index < (int) path_length )
-	{
-		input_index *= 10;
-		input_index += path[ string_index++ ] - '0';
-	}
-	if( string_index < (int) path_length )
+	if( changes_format != 0 )
 	{
-		input_index *= 10;
-		input_index += path[ string_index++ ] - '0';
-	}
-	input_index -= 1;
+		if( mount_handle_get_changes_size(
+		     vshadowmount_mount_handle,
+		     input_index,
+		     changes_format,
+		     &file_size,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve changes size.",
+			 function );
 
-	if( mount_handle_seek_offset(
-	     vshadowmount_mount_handle,
-	     input_index,
-	     (off64_t) offset,
-	     SEEK_SET,
-	     &error ) == -1 )
+			result = -EIO;
+
+			goto on_error;
+		}
+	}
+	else if( mount_handle_get_size(
+	          vshadowmount_mount_handle,
+	          &file_size,
+	          &error ) != 1 )
 	{
 		libcerror_error_set(
 		 &error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset in mount handle.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve volume size.",
 		 function );
 
 		result = -EIO;
 
 		goto on_error;
 	}
-	read_count = mount_handle_read_buffer(
-	              vshadowmount_mount_handle,
-	              input_index,
-	              (uint8_t *) buffer,
-	              size,
-	              &error );
-
-	if( read_count == -1 )
+	/* Offsets at or beyond the end of the file are not valid for SEEK_DATA and SEEK_HOLE
+	 */
+	if( ( offset < 0 )
+	 || ( (size64_t) offset >= file_size ) )
 	{
-		libcerror_error_set(
-		 &error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read from mount handle.",
-		 function );
+		return( -ENXIO );
+	}
+	/* The changes files are generated and contain no holes
+	 */
+	if( changes_format != 0 )
+	{
+		if( whence == SEEK_DATA )
+		{
+			return( offset );
+		}
+		return( (off_t) file_size );
+	}
+	switch( mount_handle_get_next_data_range(
+	         vshadowmount_mount_handle,
+	         input_index,
+	         (off64_t) offset,
+	         &range_offset,
+	         &range_size,
+	         &error ) )
+	{
+		case 1:
+			if( whence == SEEK_DATA )
+			{
+				result = (off_t) range_offset;
+			}
+			else if( range_offset > (off64_t) offset )
+			{
+				result = offset;
+			}
+			else
+			{
+				/* The end of the volume is an implicit hole
+				 */
+				result = (off_t) ( range_offset + range_size );
+			}
+			break;
 
-		result = -EIO;
+		case 0:
+			if( whence == SEEK_DATA )
+			{
+				result = -ENXIO;
+			}
+			else
+			{
+				result = offset;
+			}
+			break;
 
-		goto on_error;
+		default:
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve next data range from mount handle.",
+			 function );
+
+			result = -EIO;
+
+			goto on_error;
 	}
-	return( (int) read_count );
+	return( result );
 
 on_error:
 	if( error != NULL )
@@ -395,6 +1336,8 @@ on_error:
 	return( result );
 }
 
+#endif /* defined( VSHADOWMOUNT_HAVE_FUSE_LSEEK ) */
+
 /* Sets the values in a stat info structure
  * Returns 1 if successful or -1 on error
  */
@@ -481,13 +1424,12 @@ int vshadowmount_fuse_filldir(
      char *name,
      size_t name_size,
      struct stat *stat_info,
-     mount_handle_t *mount_handle,
+     size64_t size,
+     int number_of_sub_items,
      uint8_t use_mount_time,
      libcerror_error_t **error )
 {
-	static char *function   = "vshadowmount_fuse_filldir";
-	size64_t volume_size    = 0;
-	int number_of_sub_items = 0;
+	static char *function = "vshadowmount_fuse_filldir";
 
 	if( filler == NULL )
 	{
@@ -500,28 +1442,6 @@ int vshadowmount_fuse_filldir(
 
 		return( -1 );
 	}
-	if( mount_handle == NULL )
-	{
-		number_of_sub_items = 1;
-	}
-	else
-	{
-/* TODO get creation time */
-		if( mount_handle_get_size(
-		     mount_handle,
-		     &volume_size,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve volume size.",
-			 function );
-
-			return( -1 );
-		}
-	}
 	if( memory_set(
 	     stat_info,
 	     0,
@@ -538,7 +1458,7 @@ int vshadowmount_fuse_filldir(
 	}
 	if( vshadowmount_fuse_set_stat_info(
 	     stat_info,
-	     volume_size,
+	     size,
 	     number_of_sub_items,
 	     use_mount_time,
 	     error ) != 1 )
@@ -552,11 +1472,20 @@ int vshadowmount_fuse_filldir(
 
 		return( -1 );
 	}
+#if defined( HAVE_LIBFUSE3 )
+	if( filler(
+	     buffer,
+	     name,
+	     stat_info,
+	     0,
+	     0 ) == 1 )
+#else
 	if( filler(
 	     buffer,
 	     name,
 	     stat_info,
 	     0 ) == 1 )
+#endif
 	{
 		libcerror_error_set(
 		 error,
@@ -573,18 +1502,30 @@ int vshadowmount_fuse_filldir(
 /* Reads a directory
  * Returns 0 if successful or a negative errno value otherwise
  */
+#if defined( HAVE_LIBFUSE3 )
+int vshadowmount_fuse_readdir(
+     const char *path,
+     void *buffer,
+     fuse_fill_dir_t filler,
+     off_t offset VSHADOWTOOLS_ATTRIBUTE_UNUSED,
+     struct fuse_file_info *file_info VSHADOWTOOLS_ATTRIBUTE_UNUSED,
+     enum fuse_readdir_flags flags VSHADOWTOOLS_ATTRIBUTE_UNUSED )
+#else
 int vshadowmount_fuse_readdir(
      const char *path,
      void *buffer,
      fuse_fill_dir_t filler,
      off_t offset VSHADOWTOOLS_ATTRIBUTE_UNUSED,
      struct fuse_file_info *file_info VSHADOWTOOLS_ATTRIBUTE_UNUSED )
+#endif
 {
-	char vshadowmount_fuse_path[ 9 ];
+	char vshadowmount_fuse_path[ 32 ];
 
 	libcerror_error_t *error = NULL;
 	struct stat *stat_info   = NULL;
 	static char *function    = "vshadowmount_fuse_readdir";
+	size64_t changes_size    = 0;
+	size64_t volume_size     = 0;
 	size_t path_length       = 0;
 	int input_index          = 0;
 	int number_of_inputs     = 0;
@@ -594,6 +1535,10 @@ int vshadowmount_fuse_readdir(
 	VSHADOWTOOLS_UNREFERENCED_PARAMETER( offset )
 	VSHADOWTOOLS_UNREFERENCED_PARAMETER( file_info )
 
+#if defined( HAVE_LIBFUSE3 )
+	VSHADOWTOOLS_UNREFERENCED_PARAMETER( flags )
+#endif
+
 	if( path == NULL )
 	{
 		libcerror_error_set(
@@ -692,7 +1637,8 @@ int vshadowmount_fuse_readdir(
 	     ".",
 	     2,
 	     stat_info,
-	     NULL,
+	     0,
+	     1,
 	     1,
 	     &error ) != 1 )
 	{
@@ -713,7 +1659,8 @@ int vshadowmount_fuse_readdir(
 	     "..",
 	     3,
 	     stat_info,
-	     NULL,
+	     0,
+	     1,
 	     0,
 	     &error ) != 1 )
 	{
@@ -726,32 +1673,147 @@ int vshadowmount_fuse_readdir(
 
 		result = -EIO;
 
-		goto on_error;
-	}
-	for( input_index = 1;
-	     input_index <= number_of_inputs;
-	     input_index++ )
-	{
-		string_index = vshadowmount_fuse_path_prefix_length;
+		goto on_error;
+	}
+/* TODO get creation time */
+	if( mount_handle_get_size(
+	     vshadowmount_mount_handle,
+	     &volume_size,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve volume size.",
+		 function );
+
+		result = -EIO;
+
+		goto on_error;
+	}
+	for( input_index = 1;
+	     input_index <= number_of_inputs;
+	     input_index++ )
+	{
+		string_index = vshadowmount_fuse_path_prefix_length;
+
+		if( input_index >= 100 )
+		{
+			vshadowmount_fuse_path[ string_index++ ] = '0' + (char) ( input_index / 100 );
+		}
+		if( input_index >= 10 )
+		{
+			vshadowmount_fuse_path[ string_index++ ] = '0' + (char) ( input_index / 10 );
+		}
+		vshadowmount_fuse_path[ string_index++ ] = '0' + (char) ( input_index % 10 );
+		vshadowmount_fuse_path[ string_index++ ] = 0;
+
+		if( vshadowmount_fuse_filldir(
+		     buffer,
+		     filler,
+		     &( vshadowmount_fuse_path[ 1 ] ),
+		     string_index - 1,
+		     stat_info,
+		     volume_size,
+		     0,
+		     1,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set directory entry.",
+			 function );
+
+			result = -EIO;
+
+			goto on_error;
+		}
+		if( mount_handle_get_changes_size(
+		     vshadowmount_mount_handle,
+		     input_index - 1,
+		     MOUNT_HANDLE_CHANGES_FORMAT_BLOCKS_BITMAP,
+		     &changes_size,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve changed blocks size.",
+			 function );
+
+			result = -EIO;
 
-		if( input_index >= 100 )
+			goto on_error;
+		}
+		if( memory_copy(
+		     &( vshadowmount_fuse_path[ string_index - 1 ] ),
+		     vshadowmount_fuse_changed_blocks_suffix,
+		     vshadowmount_fuse_changed_blocks_suffix_length + 1 ) == NULL )
 		{
-			vshadowmount_fuse_path[ string_index++ ] = '0' + (char) ( input_index / 100 );
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy changed blocks suffix.",
+			 function );
+
+			result = -EIO;
+
+			goto on_error;
 		}
-		if( input_index >= 10 )
+		if( vshadowmount_fuse_filldir(
+		     buffer,
+		     filler,
+		     &( vshadowmount_fuse_path[ 1 ] ),
+		     string_index - 1 + vshadowmount_fuse_changed_blocks_suffix_length,
+		     stat_info,
+		     changes_size,
+		     0,
+		     1,
+		     &error ) != 1 )
 		{
-			vshadowmount_fuse_path[ string_index++ ] = '0' + (char) ( input_index / 10 );
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set directory entry.",
+			 function );
+
+			result = -EIO;
+
+			goto on_error;
 		}
-		vshadowmount_fuse_path[ string_index++ ] = '0' + (char) ( input_index % 10 );
-		vshadowmount_fuse_path[ string_index++ ] = 0;
+		/* The size of the changed extents list is reported by getattr, which creates the list
+		 * on first use, the size in the directory entry is not used by fuse
+		 */
+		if( memory_copy(
+		     &( vshadowmount_fuse_path[ string_index - 1 ] ),
+		     vshadowmount_fuse_changed_extents_suffix,
+		     vshadowmount_fuse_changed_extents_suffix_length + 1 ) == NULL )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy changed extents suffix.",
+			 function );
+
+			result = -EIO;
 
+			goto on_error;
+		}
 		if( vshadowmount_fuse_filldir(
 		     buffer,
 		     filler,
 		     &( vshadowmount_fuse_path[ 1 ] ),
-		     string_index - 1,
+		     string_index - 1 + vshadowmount_fuse_changed_extents_suffix_length,
 		     stat_info,
-		     vshadowmount_mount_handle,
+		     0,
+		     0,
 		     1,
 		     &error ) != 1 )
 		{
@@ -791,18 +1853,31 @@ on_error:
 /* Retrieves the file stat info
  * Returns 0 if successful or a negative errno value otherwise
  */
+#if defined( HAVE_LIBFUSE3 )
+int vshadowmount_fuse_getattr(
+     const char *path,
+     struct stat *stat_info,
+     struct fuse_file_info *file_info VSHADOWTOOLS_ATTRIBUTE_UNUSED )
+#else
 int vshadowmount_fuse_getattr(
      const char *path,
      struct stat *stat_info )
+#endif
 {
 	libcerror_error_t *error = NULL;
 	static char *function    = "vshadowmount_fuse_getattr";
 	size64_t volume_size     = 0;
 	size_t path_length       = 0;
 	uint8_t use_mount_time   = 0;
+	int changes_format       = 0;
+	int input_index          = 0;
 	int number_of_sub_items  = 0;
 	int result               = -ENOENT;
 
+#if defined( HAVE_LIBFUSE3 )
+	VSHADOWTOOLS_UNREFERENCED_PARAMETER( file_info )
+#endif
+
 	if( path == NULL )
 	{
 		libcerror_error_set(
@@ -857,13 +1932,55 @@ int vshadowmount_fuse_getattr(
 			result              = 0;
 		}
 	}
-	else if( ( path_length > vshadowmount_fuse_path_prefix_length )
-	      && ( path_length <= ( vshadowmount_fuse_path_prefix_length + 3 ) ) )
+	else
 	{
-		if( narrow_string_compare(
-		     path,
-		     vshadowmount_fuse_path_prefix,
-		     vshadowmount_fuse_path_prefix_length ) == 0 )
+		result = vshadowmount_fuse_get_input_index_from_path(
+		          path,
+		          &input_index,
+		          &changes_format,
+		          &error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine input index from path.",
+			 function );
+
+			result = -EIO;
+
+			goto on_error;
+		}
+		else if( ( result == 0 )
+		      || ( input_index >= vshadowmount_mount_handle->number_of_inputs ) )
+		{
+			result = -ENOENT;
+		}
+		else if( changes_format != 0 )
+		{
+			if( mount_handle_get_changes_size(
+			     vshadowmount_mount_handle,
+			     input_index,
+			     changes_format,
+			     &volume_size,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve changes size.",
+				 function );
+
+				result = -EIO;
+
+				goto on_error;
+			}
+			result = 0;
+		}
+		else
 		{
 			if( mount_handle_get_size(
 			     vshadowmount_mount_handle,
@@ -1294,29 +2411,12 @@ int __stdcall vshadowmount_dokan_ReadFile(
 	}
 	input_index -= 1;
 
-	if( mount_handle_seek_offset(
-	     vshadowmount_mount_handle,
-	     input_index,
-	     (off64_t) offset,
-	     SEEK_SET,
-	     &error ) == -1 )
-	{
-		libcerror_error_set(
-		 &error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset in mount handle.",
-		 function );
-
-		result = -ERROR_SEEK_ON_DEVICE;
-
-		goto on_error;
-	}
-	read_count = mount_handle_read_buffer(
+	read_count = mount_handle_read_buffer_at_offset(
 		      vshadowmount_mount_handle,
 		      input_index,
 		      (uint8_t *) buffer,
 		      (size_t) number_of_bytes_to_read,
+		      (off64_t) offset,
 		      &error );
 
 	if( read_count == -1 )
@@ -2057,21 +3157,33 @@ int main( int argc, char * const argv[] )
 {
 	libvshadow_error_t *error                    = NULL;
 	system_character_t *mount_point              = NULL;
+	system_character_t *option_cache_timeout     = NULL;
 	system_character_t *option_extended_options  = NULL;
+	system_character_t *option_maximum_read_size = NULL;
+	system_character_t *option_readahead_size    = NULL;
 	system_character_t *option_volume_offset     = NULL;
 	system_character_t *source                   = NULL;
 	char *program                                = "vshadowmount";
 	system_integer_t option                      = 0;
+	uint32_t cache_timeout                       = VSHADOWMOUNT_DEFAULT_CACHE_TIMEOUT;
+	uint32_t maximum_read_size                   = 0;
+	uint32_t maximum_readahead_size              = 0;
+	uint8_t direct_io                            = 0;
 	int result                                   = 0;
 	int verbose                                  = 0;
 
 #if defined( HAVE_LIBFUSE ) || defined( HAVE_LIBOSXFUSE )
 	struct fuse_operations vshadowmount_fuse_operations;
 
+	char vshadowmount_fuse_options[ 128 ];
+
 	struct fuse_args vshadowmount_fuse_arguments = FUSE_ARGS_INIT(0, NULL);
-	struct fuse_chan *vshadowmount_fuse_channel  = NULL;
 	struct fuse *vshadowmount_fuse_handle        = NULL;
 
+#if !defined( HAVE_LIBFUSE3 )
+	struct fuse_chan *vshadowmount_fuse_channel  = NULL;
+#endif
+
 #elif defined( HAVE_LIBDOKAN )
 	DOKAN_OPERATIONS vshadowmount_dokan_operations;
 	DOKAN_OPTIONS vshadowmount_dokan_options;
@@ -2110,7 +3222,7 @@ int main( int argc, char * const argv[] )
 	while( ( option = vshadowtools_getopt(
 	                   argc,
 	                   argv,
-	                   _SYSTEM_STRING( "ho:vVX:" ) ) ) != (system_integer_t) -1 )
+	                   _SYSTEM_STRING( "a:hno:r:t:vVX:" ) ) ) != (system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -2126,17 +3238,37 @@ int main( int argc, char * const argv[] )
 
 				return( EXIT_FAILURE );
 
+			case (system_integer_t) 'a':
+				option_readahead_size = optarg;
+
+				break;
+
 			case (system_integer_t) 'h':
 				usage_fprint(
 				 stdout );
 
 				return( EXIT_SUCCESS );
 
+			case (system_integer_t) 'n':
+				direct_io = 1;
+
+				break;
+
 			case (system_integer_t) 'o':
 				option_volume_offset = optarg;
 
 				break;
 
+			case (system_integer_t) 'r':
+				option_maximum_read_size = optarg;
+
+				break;
+
+			case (system_integer_t) 't':
+				option_cache_timeout = optarg;
+
+				break;
+
 			case (system_integer_t) 'v':
 				verbose = 1;
 
@@ -2216,6 +3348,71 @@ int main( int argc, char * const argv[] )
 			 vshadowmount_mount_handle->volume_offset );
 		}
 	}
+	if( direct_io != 0 )
+	{
+		cache_timeout = 0;
+	}
+	if( option_cache_timeout != NULL )
+	{
+		if( vshadowmount_copy_option_value_from_string(
+		     option_cache_timeout,
+		     &cache_timeout,
+		     &error ) != 1 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+
+			cache_timeout = VSHADOWMOUNT_DEFAULT_CACHE_TIMEOUT;
+
+			fprintf(
+			 stderr,
+			 "Unsupported cache timeout defaulting to: %" PRIu32 ".\n",
+			 cache_timeout );
+		}
+	}
+	if( option_maximum_read_size != NULL )
+	{
+		if( ( vshadowmount_copy_option_value_from_string(
+		       option_maximum_read_size,
+		       &maximum_read_size,
+		       &error ) != 1 )
+		 || ( maximum_read_size < 4096 ) )
+		{
+			if( error != NULL )
+			{
+				libcnotify_print_error_backtrace(
+				 error );
+				libcerror_error_free(
+				 &error );
+			}
+			maximum_read_size = 0;
+
+			fprintf(
+			 stderr,
+			 "Unsupported maximum read size, using the fuse default.\n" );
+		}
+	}
+	if( option_readahead_size != NULL )
+	{
+		if( vshadowmount_copy_option_value_from_string(
+		     option_readahead_size,
+		     &maximum_readahead_size,
+		     &error ) != 1 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+
+			maximum_readahead_size = 0;
+
+			fprintf(
+			 stderr,
+			 "Unsupported read ahead size, using the kernel default.\n" );
+		}
+	}
 	result = mount_handle_open_input(
 	          vshadowmount_mount_handle,
 	          source,
@@ -2250,20 +3447,75 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
-	if( option_extended_options != NULL )
+	vshadowmount_fuse_direct_io              = direct_io;
+	vshadowmount_fuse_maximum_readahead_size = maximum_readahead_size;
+
+	/* The snapshots are read-only and do not change while mounted, hence
+	 * the kernel can cache the attributes, entries and data
+	 */
+	if( maximum_read_size == 0 )
+	{
+		result = narrow_string_snprintf(
+		          vshadowmount_fuse_options,
+		          128,
+		          "ro,attr_timeout=%" PRIu32 ",entry_timeout=%" PRIu32 "",
+		          cache_timeout,
+		          cache_timeout );
+	}
+	else
 	{
-		/* This argument is required but ignored
+		/* The max_read option can only lower the read request size of fuse
 		 */
-		if( fuse_opt_add_arg(
-		     &vshadowmount_fuse_arguments,
-		     "" ) != 0 )
-		{
-			fprintf(
-			 stderr,
-			 "Unable add fuse arguments.\n" );
+		result = narrow_string_snprintf(
+		          vshadowmount_fuse_options,
+		          128,
+		          "ro,attr_timeout=%" PRIu32 ",entry_timeout=%" PRIu32 ",max_read=%" PRIu32 "",
+		          cache_timeout,
+		          cache_timeout,
+		          maximum_read_size );
+	}
+	if( result < 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to set fuse options.\n" );
 
-			goto on_error;
-		}
+		goto on_error;
+	}
+	/* This argument is required but ignored
+	 */
+	if( fuse_opt_add_arg(
+	     &vshadowmount_fuse_arguments,
+	     "" ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable add fuse arguments.\n" );
+
+		goto on_error;
+	}
+	if( fuse_opt_add_arg(
+	     &vshadowmount_fuse_arguments,
+	     "-o" ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable add fuse arguments.\n" );
+
+		goto on_error;
+	}
+	if( fuse_opt_add_arg(
+	     &vshadowmount_fuse_arguments,
+	     vshadowmount_fuse_options ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable add fuse arguments.\n" );
+
+		goto on_error;
+	}
+	if( option_extended_options != NULL )
+	{
 		if( fuse_opt_add_arg(
 		     &vshadowmount_fuse_arguments,
 		     "-o" ) != 0 )
@@ -2290,7 +3542,57 @@ int main( int argc, char * const argv[] )
 	vshadowmount_fuse_operations.readdir = &vshadowmount_fuse_readdir;
 	vshadowmount_fuse_operations.getattr = &vshadowmount_fuse_getattr;
 	vshadowmount_fuse_operations.destroy = &vshadowmount_fuse_destroy;
+	vshadowmount_fuse_operations.init    = &vshadowmount_fuse_init;
+
+#if defined( VSHADOWMOUNT_HAVE_FUSE_LSEEK )
+	vshadowmount_fuse_operations.lseek   = &vshadowmount_fuse_lseek;
+#endif
+#if defined( VSHADOWMOUNT_HAVE_FUSE_READ_BUF )
+	/* The source file is opened a second time so that fuse can read (splice) the data
+	 * that is stored in the source file, without it being copied by vshadowmount
+	 */
+	vshadowmount_source_file_descriptor = open(
+	                                       source,
+	                                       O_RDONLY );
+
+	if( vshadowmount_source_file_descriptor != -1 )
+	{
+		vshadowmount_fuse_operations.read_buf = &vshadowmount_fuse_read_buf;
+	}
+	else if( verbose != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open source file descriptor, data will be copied.\n" );
+	}
+#endif
+
+#if defined( HAVE_LIBFUSE3 )
+	vshadowmount_fuse_handle = fuse_new(
+	                            &vshadowmount_fuse_arguments,
+	                            &vshadowmount_fuse_operations,
+	                            sizeof( struct fuse_operations ),
+	                            vshadowmount_mount_handle );
 
+	if( vshadowmount_fuse_handle == NULL )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create fuse handle.\n" );
+
+		goto on_error;
+	}
+	if( fuse_mount(
+	     vshadowmount_fuse_handle,
+	     mount_point ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to mount fuse handle.\n" );
+
+		goto on_error;
+	}
+#else
 	vshadowmount_fuse_channel = fuse_mount(
 	                             mount_point,
 	                             &vshadowmount_fuse_arguments );
@@ -2318,6 +3620,8 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
+#endif /* defined( HAVE_LIBFUSE3 ) */
+
 	if( verbose == 0 )
 	{
 		if( fuse_daemonize(
@@ -2330,8 +3634,20 @@ int main( int argc, char * const argv[] )
 			goto on_error;
 		}
 	}
+	/* The mount handle reads the inputs at specific offsets, which allows
+	 * the fuse requests to be handled by multiple threads
+	 */
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && defined( HAVE_LIBFUSE3 )
+	result = fuse_loop_mt(
+	          vshadowmount_fuse_handle,
+	          0 );
+#elif defined( HAVE_MULTI_THREAD_SUPPORT )
+	result = fuse_loop_mt(
+	          vshadowmount_fuse_handle );
+#else
 	result = fuse_loop(
 	          vshadowmount_fuse_handle );
+#endif
 
 	if( result != 0 )
 	{
@@ -2341,12 +3657,25 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
+#if defined( HAVE_LIBFUSE3 )
+	fuse_unmount(
+	 vshadowmount_fuse_handle );
+#endif
 	fuse_destroy(
 	 vshadowmount_fuse_handle );
 
 	fuse_opt_free_args(
 	 &vshadowmount_fuse_arguments );
 
+#if defined( VSHADOWMOUNT_HAVE_FUSE_READ_BUF )
+	if( vshadowmount_source_file_descriptor != -1 )
+	{
+		close(
+		 vshadowmount_source_file_descriptor );
+
+		vshadowmount_source_file_descriptor = -1;
+	}
+#endif
 	return( EXIT_SUCCESS );
 #elif defined( HAVE_LIBDOKAN )
 	if( memory_set(
@@ -2485,11 +3814,23 @@ on_error:
 #if defined( HAVE_LIBFUSE ) || defined( HAVE_LIBOSXFUSE )
 	if( vshadowmount_fuse_handle != NULL )
 	{
+#if defined( HAVE_LIBFUSE3 )
+		fuse_unmount(
+		 vshadowmount_fuse_handle );
+#endif
 		fuse_destroy(
 		 vshadowmount_fuse_handle );
 	}
 	fuse_opt_free_args(
 	 &vshadowmount_fuse_arguments );
+
+#if defined( VSHADOWMOUNT_HAVE_FUSE_READ_BUF )
+	if( vshadowmount_source_file_descriptor != -1 )
+	{
+		close(
+		 vshadowmount_source_file_descriptor );
+	}
+#endif
 #endif
 	if( vshadowmount_mount_handle != NULL )
 	{